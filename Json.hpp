@@ -6,24 +6,96 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <cfloat>
+#include <climits>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <iterator>
+#include <limits>
 #include <map>
+#include <mutex>
+#include <regex>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#if __cplusplus >= 201703L
+#include <optional>
+#include <variant>
+#endif
+
+#if defined( __unix__ ) or defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined( __SSE2__ ) or defined( _M_X64 )
+#include <emmintrin.h>
+#endif
+
 #ifdef INCLUDE_GMP
 #include <gmp.h>
 #endif
 
+#ifdef INCLUDE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef INCLUDE_ZSTD
+#include <zstd.h>
+#endif
+
+/**
+ * Exception thrown when JSON text, or a binary encoding of it, is malformed.
+ * The message names the step of the parser that failed and the offset into
+ * the input at which it did.
+ */
+class ParseError : public std::runtime_error
+{
+private:
+	uint64_t mOffset;
+
+public:
+	/**
+	 * Constructor.
+	 * @param context Name of the step of the parser that failed, e.g. "parseObject".
+	 * @param source Const reference to the source being parsed, whose read position is
+	 *               where the malformed input starts.
+	 * @param offset Number of bytes past the read position of the error. [default: 0]
+	 */
+	template < typename Source >
+	ParseError( const char* context, const Source& source, uint64_t offset = 0 ) :
+		std::runtime_error( std::string( context ) + ": malformed input at offset " + std::to_string( source.position() + offset ) ),
+		mOffset( source.position() + offset )
+	{
+	}
+
+	/**
+	 * Retrieve the offset into the input at which the error was found.
+	 * @return The offset, in bytes from the start of the input.
+	 */
+	uint64_t offset() const noexcept
+	{
+		return mOffset;
+	}
+};
+
 /**
  * Class for representing a JSON value, as defined in the ECMA-404 specification, in C++.
  * Reference: https://www.json.org/json-en.html
@@ -33,13 +105,17 @@
  *      have a similar syntactic feel to ECMAScript when manipulating
  *      JSON. The dump(s) and load(s) functions are present for those
  *      that may be coming out of Python.
- *    - This implementation is only safe for single threaded use.
- *      And there is no effort put into protecting the tree.
+ *    - A document may be read by any number of threads at once, so long as none
+ *      modifies it meanwhile, e.g. one parsed configuration shared by every worker.
+ *      Const member functions keep no hidden state: they cache nothing and create
+ *      nothing, so the const operator[] throws where the non-const one would add.
+ *    - Modifying a document, including through the non-const operator[], requires
+ *      that no other thread uses it at the same time. No effort is made to lock it.
  */
 class JsonValue
 {
 public:
-	using ObjectType = std::map< std::string, JsonValue >;
+	using ObjectType = std::map< std::string, JsonValue, std::less<> >;
 	using ArrayType = std::vector< JsonValue >;
 
 	/**
@@ -66,6 +142,16 @@ public:
 		NONE    ///< Use no indentation.
 	};
 
+	/**
+	 * The compression of a dumped or loaded JSON document.
+	 */
+	enum class Compression
+	{
+		NONE,  ///< Plain JSON text.
+		GZIP,  ///< gzip, or when loading also zlib; requires INCLUDE_ZLIB and linking with zlib.
+		ZSTD   ///< Zstandard; requires INCLUDE_ZSTD and linking with libzstd.
+	};
+
 private:
 	/*
 	 * Enumeration of number types, which is
@@ -83,21 +169,219 @@ private:
 		NONE                          // We've not resolved the numeric type
 	};
 
+	// Operations of a JSON Patch (RFC 6902)
+	enum class ePatchOperation
+	{
+		ADD,
+		REMOVE,
+		REPLACE,
+		MOVE,
+		COPY,
+		TEST
+	};
+
+	// Steps of the undo log of an atomic JSON Patch, each reversing one change to the document
+	enum class ePatchUndo
+	{
+		ERASE,    // Take out the value added at the path
+		INSERT,   // Put the removed value back at the path
+		RESTORE   // Swap the replaced value back in at the path
+	};
+
+	// CBOR (RFC 8949) major types, the high 3 bits of the initial byte of a data item
+	enum class eCBORMajorType : uint8_t
+	{
+		UNSIGNED_INTEGER,
+		NEGATIVE_INTEGER,
+		BYTE_STRING,
+		TEXT_STRING,
+		ARRAY,
+		MAP,
+		TAG,
+		SIMPLE
+	};
+
+	// MessagePack markers, the first byte of each object, other than the fixed forms
+	// that carry their value or length in the low bits of the marker itself.
+	enum class eMessagePackMarker : uint8_t
+	{
+		NIL = 0xC0,
+		FALSE_VALUE = 0xC2,
+		TRUE_VALUE = 0xC3,
+		BINARY8 = 0xC4,
+		BINARY16 = 0xC5,
+		BINARY32 = 0xC6,
+		EXTENSION8 = 0xC7,
+		EXTENSION16 = 0xC8,
+		EXTENSION32 = 0xC9,
+		FLOAT32 = 0xCA,
+		FLOAT64 = 0xCB,
+		UINT8 = 0xCC,
+		UINT16 = 0xCD,
+		UINT32 = 0xCE,
+		UINT64 = 0xCF,
+		INT8 = 0xD0,
+		INT16 = 0xD1,
+		INT32 = 0xD2,
+		INT64 = 0xD3,
+		FIXED_EXTENSION1 = 0xD4,
+		FIXED_EXTENSION2 = 0xD5,
+		FIXED_EXTENSION4 = 0xD6,
+		FIXED_EXTENSION8 = 0xD7,
+		FIXED_EXTENSION16 = 0xD8,
+		STRING8 = 0xD9,
+		STRING16 = 0xDA,
+		STRING32 = 0xDB,
+		ARRAY16 = 0xDC,
+		ARRAY32 = 0xDD,
+		MAP16 = 0xDE,
+		MAP32 = 0xDF
+	};
+
+	// BSON element types, the byte that precedes the key of each element of a document.
+	enum class eBSONType : uint8_t
+	{
+		END = 0x00,
+		DOUBLE = 0x01,
+		STRING = 0x02,
+		DOCUMENT = 0x03,
+		ARRAY = 0x04,
+		BINARY = 0x05,
+		UNDEFINED = 0x06,
+		OBJECT_ID = 0x07,
+		BOOLEAN = 0x08,
+		DATETIME = 0x09,
+		NULL_VALUE = 0x0A,
+		REGULAR_EXPRESSION = 0x0B,
+		DB_POINTER = 0x0C,
+		JAVASCRIPT = 0x0D,
+		SYMBOL = 0x0E,
+		JAVASCRIPT_WITH_SCOPE = 0x0F,
+		INT32 = 0x10,
+		TIMESTAMP = 0x11,
+		INT64 = 0x12,
+		DECIMAL128 = 0x13,
+		MAX_KEY = 0x7F,
+		MIN_KEY = 0xFF
+	};
+
+	// UBJSON markers, the first byte of each value, and the BJData additions of unsigned
+	// integers, half precision and bytes. Container headers use TYPE and COUNT.
+	enum class eUBJSONMarker : uint8_t
+	{
+		NULL_VALUE = 'Z',
+		NO_OP = 'N',
+		TRUE_VALUE = 'T',
+		FALSE_VALUE = 'F',
+		INT8 = 'i',
+		UINT8 = 'U',
+		INT16 = 'I',
+		INT32 = 'l',
+		INT64 = 'L',
+		FLOAT32 = 'd',
+		FLOAT64 = 'D',
+		HIGH_PRECISION = 'H',
+		CHAR = 'C',
+		STRING = 'S',
+		ARRAY_START = '[',
+		ARRAY_END = ']',
+		OBJECT_START = '{',
+		OBJECT_END = '}',
+		TYPE = '$',
+		COUNT = '#',
+		UINT16 = 'u',
+		UINT32 = 'm',
+		UINT64 = 'M',
+		FLOAT16 = 'h',
+		BYTE = 'B'
+	};
+
+	// Kinds of node in a tape, the flat binary form written by toTape()
+	enum class eTapeKind : uint64_t
+	{
+		UNDEFINED,
+		NULL_VALUE,
+		FALSE_VALUE,
+		TRUE_VALUE,
+		SIGNED_INTEGRAL,
+		UNSIGNED_INTEGRAL,
+		FLOATING,
+		STRING,
+		ARRAY,
+		OBJECT
+	};
+
+	// Layout of a tape: a header of the magic "JSONTAPE", the byte order mark and the size
+	// of a long double as two 32 bit words, the length of the tape and a reserved word; then
+	// the nodes, each a kind and a value word, with any payload directly after them.
+	enum eTapeLayout : uint64_t
+	{
+		TAPE_HEADER_SIZE = 32,
+		TAPE_NODE_SIZE = 16,
+		TAPE_BYTE_ORDER = 0x01020304
+	};
+
+	// Node of a Literal: a value in the kinds of a tape, with the count of elements or members
+	// of a container and where its children start in the table, or the length of a string
+	// and where its characters start in the text
+	struct LiteralNode
+	{
+		eTapeKind kind = eTapeKind::UNDEFINED;
+		size_t count = 0;
+		size_t offset = 0;
+		uintmax_t integral = 0;
+		long double floating = 0.0L;
+	};
+
+	// Size of the blocks that compressed sources are read in, and that
+	// compressed sinks gather their input in before compressing it
+	enum eCompressionLayout : size_t
+	{
+		COMPRESSION_BLOCK_SIZE = 64 * 1024
+	};
+
+	// Number of characters of a string checked at once for the end of a run of plain characters
+	enum eStringLayout : size_t
+	{
+		STRING_BLOCK_SIZE = 16
+	};
+
+	// Bound on the cells of the table an array diff aligns elements with. Arrays whose
+	// middles need more are aligned on the elements that occur once on each side instead.
+	enum eDiffLayout : size_t
+	{
+		DIFF_ALIGNMENT_CELLS = size_t( 1 ) << 22
+	};
+
+	// Deepest nesting the binary decoders read, each level being a stack frame.
+	// Deeper input is rejected rather than left to overflow the stack. Typed UBJSON
+	// arrays of null or boolean values carry no payload, so their count is bounded too.
+	enum eDecoderLimit : size_t
+	{
+		DECODER_NESTING_DEPTH = 1024,
+		DECODER_PAYLOAD_FREE_COUNT = 65536
+	};
+
+	class Compressor;
+
 	// Enumeration of sink types
 	enum class eSinkType
 	{
 		STRING,
 		FILE,
-		OFSTREAM
+		OFSTREAM,
+		COMPRESSOR
 	};
 
 	// Class for abstracting the sink
 	class JsonSink
 	{
 	public:
-		std::string& stringSink;
-		std::ofstream& ofStreamSink;
+		// Only the sink of sinkType is set, the others are null.
+		std::string* stringSink;
+		std::ofstream* ofStreamSink;
 		FILE* fileSink;
+		Compressor* compressorSink;
 
 		eSinkType sinkType;
 		JsonValue::Indent indentation;
@@ -105,7 +389,10 @@ private:
 
 		// String constructor
 		JsonSink( std::string& sink, JsonValue::Indent indent, size_t indentLevel ) :
-			stringSink( sink )
+			stringSink( &sink ),
+			ofStreamSink( nullptr ),
+			fileSink( nullptr ),
+			compressorSink( nullptr )
 		{
 			sinkType = eSinkType::STRING;
 			indentation = indent;
@@ -114,7 +401,10 @@ private:
 
 		// FILE constructor
 		JsonSink( FILE* sink, JsonValue::Indent indent, size_t indentLevel ) :
-			fileSink( sink )
+			stringSink( nullptr ),
+			ofStreamSink( nullptr ),
+			fileSink( sink ),
+			compressorSink( nullptr )
 		{
 			sinkType = eSinkType::FILE;
 			indentation = indent;
@@ -123,13 +413,28 @@ private:
 
 		// OFStream constructor
 		JsonSink( std::ofstream& sink, JsonValue::Indent indent, size_t indentLevel ) :
-			ofStreamSink( sink )
+			stringSink( nullptr ),
+			ofStreamSink( &sink ),
+			fileSink( nullptr ),
+			compressorSink( nullptr )
 		{
 			sinkType = eSinkType::OFSTREAM;
 			indentation = indent;
 			indentSpaces = indentLevel;
 		}
 
+		// Compressor constructor
+		JsonSink( Compressor& sink, JsonValue::Indent indent, size_t indentLevel ) :
+			stringSink( nullptr ),
+			ofStreamSink( nullptr ),
+			fileSink( nullptr ),
+			compressorSink( &sink )
+		{
+			sinkType = eSinkType::COMPRESSOR;
+			indentation = indent;
+			indentSpaces = indentLevel;
+		}
+
 		// Append the given string to the sink
 		void append( const std::string& string )
 		{
@@ -140,7 +445,7 @@ private:
 
 			if ( eSinkType::STRING == sinkType )
 			{
-				stringSink.append( string );
+				stringSink->append( string );
 			}
 
 			if ( eSinkType::FILE == sinkType )
@@ -150,434 +455,889 @@ private:
 
 			if ( eSinkType::OFSTREAM == sinkType )
 			{
-				ofStreamSink << string;
+				*ofStreamSink << string;
+			}
+
+			if ( eSinkType::COMPRESSOR == sinkType )
+			{
+				compressorSink->write( string.data(), string.length() );
 			}
 		}
-	};
 
-	// Class for parsing JSON from a source
-	class ParseSource
-	{
-	private:
-		// Where are we pulling data from
-		enum class Source
+		// Append {@param length} raw bytes from {@param data} to the sink
+		void append( const char* data, size_t length )
 		{
-			STRING,    // std::string
-			FILE,      // FILE
-			IFSTREAM,  // std::ifstream
-			NO_SOURCE  // No source
-		};
+			if ( 0 == length )
+			{
+				return;
+			}
 
-		const std::string& mStringSource;
-		std::ifstream& mIFStreamSource;
-		FILE* mFileSource;
+			if ( eSinkType::STRING == sinkType )
+			{
+				stringSink->append( data, length );
+			}
 
-		Source mSource;
-		uint64_t mLastReadPosition;
-		uint64_t mCurrentReadPosition;
+			if ( eSinkType::FILE == sinkType )
+			{
+				fwrite( data, 1, length, fileSink );
+			}
 
-		char* mBuffer;
-		size_t mBufferSize;
-		size_t mBufferLength;
+			if ( eSinkType::OFSTREAM == sinkType )
+			{
+				ofStreamSink->write( data, std::streamsize( length ) );
+			}
 
-		// Initialize the other variables
-		void _initializeVariables( Source source )
-		{
-			mSource = source;
-			mLastReadPosition = 0;
-			mCurrentReadPosition = 0;
-			mBuffer = static_cast< char* >( calloc( 1024, 1 ) );
-			mBufferSize = 1024;
-			mBufferLength = 0;
+			if ( eSinkType::COMPRESSOR == sinkType )
+			{
+				compressorSink->write( data, length );
+			}
 		}
+	};
 
-	public:
-		// Delete default constructor
-		ParseSource() = delete;
-
-		// Parse from a std::string
-		ParseSource( const std::string& stringSource ) :
-			mStringSource( stringSource )
-		{
-			_initializeVariables( Source::STRING );
-		}
+	// Compresses the bytes written to it a block at a time and writes the compressed
+	// blocks to the sink it wraps, so the uncompressed text is never held in whole.
+	class Compressor
+	{
+	private:
+		JsonSink& mOutput;
+		Compression mCompression;
+		std::string mPending;
+		std::vector< char > mBlock;
+#ifdef INCLUDE_ZLIB
+		z_stream mZlib;
+#endif
+#ifdef INCLUDE_ZSTD
+		ZSTD_CStream* mZstd;
+#endif
 
-		// Parse from a FILE
-		ParseSource( FILE* fileSource ) :
-			mFileSource( fileSource )
+		// Compress {@param length} bytes of {@param data} out to the sink,
+		// then end the compressed stream if {@param isFinal} is set.
+		void _compress( const char* data, size_t length, bool isFinal )
 		{
-			_initializeVariables( Source::FILE );
-		}
+#if not defined( INCLUDE_ZLIB ) and not defined( INCLUDE_ZSTD )
+			// Only the codecs end a stream; stored output has nothing to finish.
+			( void )isFinal;
+#endif
 
-		// Parse from a std::ifstream
-		ParseSource( std::ifstream& ifstreamSource ) :
-			mIFStreamSource( ifstreamSource )
-		{
-			_initializeVariables( Source::IFSTREAM );
-		}
+			switch ( mCompression )
+			{
+			case Compression::NONE:
+				mOutput.append( data, length );
+				break;
 
-		// Free up the memory we've allocated
-		~ParseSource()
-		{
-			if ( nullptr != mBuffer )
+#ifdef INCLUDE_ZLIB
+			case Compression::GZIP:
 			{
-				free( mBuffer );
-				mBuffer = nullptr;
-			}
-		}
+				mZlib.next_in = reinterpret_cast< Bytef* >( const_cast< char* >( data ) );
+				mZlib.avail_in = uInt( length );
+				int status;
 
-		// Copy from the current read position
-		// into {@param destination} for {@param length} bytes.
-		void copy( std::string& destination, size_t length )
-		{
-		}
+				do
+				{
+					mZlib.next_out = reinterpret_cast< Bytef* >( mBlock.data() );
+					mZlib.avail_out = uInt( mBlock.size() );
+					status = deflate( &mZlib, isFinal ? Z_FINISH : Z_NO_FLUSH );
 
-		// Check if we're at the end of the source
-		bool endOfSource() const
-		{
-			switch ( mSource )
+					if ( Z_STREAM_ERROR == status )
+					{
+						throw std::runtime_error( "gzip compression failed" );
+					}
+
+					mOutput.append( mBlock.data(), mBlock.size() - mZlib.avail_out );
+				}
+				while ( isFinal ? ( Z_STREAM_END != status ) : ( 0 == mZlib.avail_out ) );
+				break;
+			}
+#endif
+
+#ifdef INCLUDE_ZSTD
+			case Compression::ZSTD:
 			{
-			case Source::STRING:
-				return mCurrentReadPosition == mStringSource.length();
+				ZSTD_inBuffer input = { data, length, 0 };
+				size_t remaining;
 
-			case Source::FILE:
-				return 0 != feof( mFileSource );
+				do
+				{
+					ZSTD_outBuffer output = { mBlock.data(), mBlock.size(), 0 };
+					remaining = ( input.pos < input.size ) ? ZSTD_compressStream( mZstd, &output, &input )
+						: ( isFinal ? ZSTD_endStream( mZstd, &output ) : 0 );
 
-			case Source::IFSTREAM:
-				return mIFStreamSource.eof();
+					if ( ZSTD_isError( remaining ) )
+					{
+						throw std::runtime_error( std::string( "zstd compression failed: " ) + ZSTD_getErrorName( remaining ) );
+					}
+
+					mOutput.append( static_cast< const char* >( output.dst ), output.pos );
+				}
+				while ( ( input.pos < input.size ) or ( isFinal and ( 0 != remaining ) ) );
+				break;
 			}
+#endif
 
-			return true;
+			default:
+				break;
+			}
 		}
 
-		// Peek {@param offset} bytes from current read position
-		char peek( uint32_t offset = 0 ) const
+	public:
+		// Compress to {@param output}. The compressed stream is complete once finish() is called.
+		Compressor( JsonSink& output, Compression compression ) :
+			mOutput( output ),
+			mCompression( compression ),
+			mBlock( COMPRESSION_BLOCK_SIZE )
 		{
-			if ( this->endOfSource() )
+			switch ( compression )
 			{
-				return '\0';
-			}
+			case Compression::NONE:
+				break;
 
-			switch ( mSource )
-			{
-			case Source::STRING:
-				if ( mStringSource.length() < ( mCurrentReadPosition + offset ) )
+			case Compression::GZIP:
+#ifdef INCLUDE_ZLIB
+				std::memset( &mZlib, 0, sizeof( mZlib ) );
+
+				// 15 window bits, plus 16 to write a gzip rather than a zlib header.
+				if ( Z_OK != deflateInit2( &mZlib, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY ) )
 				{
-					mLastReadPosition = mStringSource.length();
-					return '\0';
+					throw std::runtime_error( "Cannot initialize gzip compression" );
 				}
+				break;
+#else
+				throw std::runtime_error( "gzip compression requires INCLUDE_ZLIB" );
+#endif
 
-				mLastReadPosition = mCurrentReadPosition + offset;
-				return mStringSource[ mLastReadPosition ];
-
-			case Source::FILE:
-			case Source::IFSTREAM:
+			case Compression::ZSTD:
+#ifdef INCLUDE_ZSTD
+				mZstd = ZSTD_createCStream();
+				if ( ( nullptr == mZstd ) or ZSTD_isError( ZSTD_initCStream( mZstd, ZSTD_CLEVEL_DEFAULT ) ) )
+				{
+					ZSTD_freeCStream( mZstd );
+					throw std::runtime_error( "Cannot initialize zstd compression" );
+				}
+				break;
+#else
+				throw std::runtime_error( "zstd compression requires INCLUDE_ZSTD" );
+#endif
 			}
 
-			return '\0';
+			mPending.reserve( COMPRESSION_BLOCK_SIZE );
 		}
 
-		// Compare {@param length} bytes of
-		// source with the given {@param string} buffer.
-		bool strncmp( const char* const string, size_t length )
+		Compressor( const Compressor& ) = delete;
+		Compressor& operator=( const Compressor& ) = delete;
+
+		// Release the compression state
+		~Compressor()
 		{
-			if ( this->endOfSource() )
+#ifdef INCLUDE_ZLIB
+			if ( Compression::GZIP == mCompression )
 			{
-				return false;
+				deflateEnd( &mZlib );
 			}
-
-			return false;
+#endif
+#ifdef INCLUDE_ZSTD
+			if ( Compression::ZSTD == mCompression )
+			{
+				ZSTD_freeCStream( mZstd );
+			}
+#endif
 		}
 
-		// Update the current read position
-		// by the requested {@param offset} bytes.
-		void update( uint32_t offset = 1 )
+		// Queue {@param length} bytes of {@param data}, compressing a block whenever one fills.
+		void write( const char* data, size_t length )
 		{
-			if ( this->endOfSource() )
+			while ( ( mPending.length() + length ) >= COMPRESSION_BLOCK_SIZE )
 			{
-				return;
+				const size_t chunkLength = COMPRESSION_BLOCK_SIZE - mPending.length();
+				mPending.append( data, chunkLength );
+				_compress( mPending.data(), mPending.length(), false );
+				mPending.clear();
+				data += chunkLength;
+				length -= chunkLength;
 			}
 
-			if ( 0 < offset )
-			{
-			}
+			mPending.append( data, length );
+		}
+
+		// Compress the last of the queued bytes and end the compressed stream.
+		void finish()
+		{
+			_compress( mPending.data(), mPending.length(), true );
+			mPending.clear();
 		}
 	};
 
-#ifdef INCLUDE_GMP
-	std::string _mpzToString( mpz_t integralValue )
+	// Reads a compressed source and yields its decompressed bytes a block at a time,
+	// so the decompressed text is never held in whole. A gzip source may also be a zlib
+	// stream, and it may hold several gzip members, which decompress to their concatenation.
+	class Decompressor
 	{
-		std::string mpzString;
-		char* cstring = nullptr;
+	private:
+		FILE* mFileInput;
+		std::ifstream* mStreamInput;
+		Compression mCompression;
+		std::vector< char > mBlock;
+		const char* mInput;
+		size_t mInputStart;
+		size_t mInputLength;
+		bool mIsStreamComplete;
+		bool mIsFinished;
+#ifdef INCLUDE_ZLIB
+		z_stream mZlib;
+#endif
+#ifdef INCLUDE_ZSTD
+		ZSTD_DStream* mZstd;
+#endif
 
-		cstring = mpz_get_str( nullptr, 10, mNumericValue.MPFloatValue );
-		mpzString = std::string( cstring );
+		// Set up the decompression state
+		void _initialize( Compression compression )
+		{
+			mCompression = compression;
+			mInputStart = 0;
+			mIsStreamComplete = Compression::NONE == compression;
+			mIsFinished = false;
 
-		mp_get_memory_functions( nullptr, nullptr, &freeFunction );
-		freeFunction( cstring, strlen( cstring ) + 1 );
-		cstring = nullptr;
+			switch ( compression )
+			{
+			case Compression::NONE:
+				break;
 
-		return mpzString;
-	}
+			case Compression::GZIP:
+#ifdef INCLUDE_ZLIB
+				std::memset( &mZlib, 0, sizeof( mZlib ) );
 
-	std::string _mpfToString( mpf_t floatValue )
-	{
-		mp_exp_t exponent;
-		char* 
-	}
+				// 15 window bits, plus 32 to accept either a gzip or a zlib header.
+				if ( Z_OK != inflateInit2( &mZlib, 15 + 32 ) )
+				{
+					throw std::runtime_error( "Cannot initialize gzip decompression" );
+				}
+				break;
+#else
+				throw std::runtime_error( "gzip decompression requires INCLUDE_ZLIB" );
 #endif
 
-public:
-	/**
-	 * Mutable iterator object for iterating over object and array type JSON values.
-	 */
-	class iterator
-	{
-	private:
-		friend class JsonValue;
-
-		ObjectType::iterator mObjectIterator;
-		ArrayType::iterator mArrayIterator;
-		JsonValue::Type mValueType;
-
-		// ObjectType iterator constructor.
-		iterator( ObjectType::iterator iterator )
-		{
-			mObjectIterator = iterator;
-			mValueType = JsonValue::Type::object;
+			case Compression::ZSTD:
+#ifdef INCLUDE_ZSTD
+				mZstd = ZSTD_createDStream();
+				if ( ( nullptr == mZstd ) or ZSTD_isError( ZSTD_initDStream( mZstd ) ) )
+				{
+					ZSTD_freeDStream( mZstd );
+					throw std::runtime_error( "Cannot initialize zstd decompression" );
+				}
+				break;
+#else
+				throw std::runtime_error( "zstd decompression requires INCLUDE_ZSTD" );
+#endif
+			}
 		}
 
-		// ArrayType iterator constructor.
-		iterator( ArrayType::iterator iterator )
+		// Read the next block of input once the current one is consumed.
+		// Returns false at the end of the input.
+		bool _fillInput()
 		{
-			mArrayIterator = iterator;
-			mValueType = JsonValue::Type::array;
-		}
+			if ( mInputStart < mInputLength )
+			{
+				return true;
+			}
 
-		// Copy assignment
-		void _copyAssign( const iterator& other )
-		{
-			mObjectIterator = other.mObjectIterator;
-			mArrayIterator = other.mArrayIterator;
-			mValueType = other.mValueType;
-		}
+			mInputStart = 0;
+			mInputLength = 0;
 
-		// Move assignment
-		void _moveAssign( iterator&& other )
-		{
-			mObjectIterator = std::move( other.mObjectIterator );
-			mArrayIterator = std::move( other.mArrayIterator );
-			mValueType = std::exchange( other.mValueType, JsonValue::Type::undefined );
+			if ( nullptr != mFileInput )
+			{
+				mInputLength = fread( mBlock.data(), 1, mBlock.size(), mFileInput );
+			}
+			else if ( nullptr != mStreamInput )
+			{
+				mStreamInput->read( mBlock.data(), std::streamsize( mBlock.size() ) );
+				mInputLength = size_t( mStreamInput->gcount() );
+			}
+
+			return 0 < mInputLength;
 		}
 
 	public:
-		using iterator_category = std::forward_iterator_tag;
-		using difference_type   = std::ptrdiff_t;
-		using value_type        = JsonValue;
-		using pointer           = JsonValue*;
-		using reference         = JsonValue&;
-
-		/**
-		 * Default constructor to an empty iterator.
-		 */
-		iterator()
+		// Decompress a std::string, which is read in place
+		Decompressor( const std::string& input, Compression compression ) :
+			mFileInput( nullptr ),
+			mStreamInput( nullptr ),
+			mInput( input.data() ),
+			mInputLength( input.length() )
 		{
-			mValueType = JsonValue::Type::undefined;
+			_initialize( compression );
 		}
 
-		/**
-		 * Move constructor.
-		 * @param other R-Value to iterator to move to this instance.
-		 */
-		iterator( iterator&& other )
+		// Decompress a FILE
+		Decompressor( FILE* input, Compression compression ) :
+			mFileInput( input ),
+			mStreamInput( nullptr ),
+			mBlock( COMPRESSION_BLOCK_SIZE ),
+			mInput( mBlock.data() ),
+			mInputLength( 0 )
 		{
-			_moveAssign( std::move( other ) );
+			_initialize( compression );
 		}
 
-		/**
-		 * Copy constructor.
-		 * @param other Const reference to iterator to copy to this instance.
-		 */
-		iterator( const iterator& other )
+		// Decompress a std::ifstream
+		Decompressor( std::ifstream& input, Compression compression ) :
+			mFileInput( nullptr ),
+			mStreamInput( &input ),
+			mBlock( COMPRESSION_BLOCK_SIZE ),
+			mInput( mBlock.data() ),
+			mInputLength( 0 )
 		{
-			_copyAssign( other );
+			_initialize( compression );
 		}
 
-		/**
-		 * Move assignment operator.
-		 * @param other R-value to iterator to move to this instance.
-		 * @return Reference to this iterator instance is returned.
-		 */
-		iterator& operator=( iterator&& other )
+		Decompressor( const Decompressor& ) = delete;
+		Decompressor& operator=( const Decompressor& ) = delete;
+
+		// Release the decompression state, and return any input read ahead but
+		// not consumed to seekable streams.
+		~Decompressor()
 		{
-			if ( this != &other )
+			const size_t unreadLength = mInputLength - mInputStart;
+			if ( ( nullptr != mFileInput ) and ( 0 < unreadLength ) )
 			{
-				_moveAssign( std::move( other ) );
+				fseek( mFileInput, -long( unreadLength ), SEEK_CUR );
+			}
+			else if ( ( nullptr != mStreamInput ) and ( 0 < unreadLength ) )
+			{
+				mStreamInput->clear();
+				mStreamInput->seekg( -std::streamoff( unreadLength ), std::ios_base::cur );
 			}
 
-			return *this;
+#ifdef INCLUDE_ZLIB
+			if ( Compression::GZIP == mCompression )
+			{
+				inflateEnd( &mZlib );
+			}
+#endif
+#ifdef INCLUDE_ZSTD
+			if ( Compression::ZSTD == mCompression )
+			{
+				ZSTD_freeDStream( mZstd );
+			}
+#endif
 		}
 
-		/**
-		 * Copy assignment operator.
-		 * @param other Const reference to iterator to copy to this instance.
-		 * @return Reference to this iterator instance is returned.
-		 */
-		iterator& operator=( const iterator& other )
+		// Decompress up to {@param capacity} bytes into {@param destination}.
+		// Returns the number of bytes decompressed, which is 0 only at the end of the source.
+		// Throws std::runtime_error if the source is corrupt or ends within a compressed stream.
+		size_t read( char* destination, size_t capacity )
 		{
-			if ( this != &other )
+			size_t produced = 0;
+
+			while ( ( 0 == produced ) and not mIsFinished and ( 0 < capacity ) )
 			{
-				_copyAssign( other );
+				if ( not _fillInput() )
+				{
+					if ( not mIsStreamComplete )
+					{
+						throw std::runtime_error( "Compressed source is truncated" );
+					}
+
+					mIsFinished = true;
+					break;
+				}
+
+				const size_t available = mInputLength - mInputStart;
+
+				switch ( mCompression )
+				{
+				case Compression::NONE:
+					produced = std::min( capacity, available );
+					std::memcpy( destination, mInput + mInputStart, produced );
+					mInputStart += produced;
+					break;
+
+#ifdef INCLUDE_ZLIB
+				case Compression::GZIP:
+				{
+					const uInt inputLength = uInt( std::min< size_t >( available, UINT_MAX ) );
+					const uInt outputLength = uInt( std::min< size_t >( capacity, UINT_MAX ) );
+					mZlib.next_in = reinterpret_cast< Bytef* >( const_cast< char* >( mInput + mInputStart ) );
+					mZlib.avail_in = inputLength;
+					mZlib.next_out = reinterpret_cast< Bytef* >( destination );
+					mZlib.avail_out = outputLength;
+
+					const int status = inflate( &mZlib, Z_NO_FLUSH );
+					mInputStart += inputLength - mZlib.avail_in;
+					produced = outputLength - mZlib.avail_out;
+					mIsStreamComplete = false;
+
+					if ( Z_STREAM_END == status )
+					{
+						mIsStreamComplete = true;
+
+						// Carry on into a following gzip member, or stop at anything else.
+						if ( _fillInput() and ( 0x1F == uint8_t( mInput[ mInputStart ] ) ) )
+						{
+							inflateReset( &mZlib );
+						}
+						else
+						{
+							mIsFinished = true;
+						}
+					}
+					else if ( ( Z_OK != status ) and ( Z_BUF_ERROR != status ) )
+					{
+						throw std::runtime_error( "Corrupt gzip data" );
+					}
+					break;
+				}
+#endif
+
+#ifdef INCLUDE_ZSTD
+				case Compression::ZSTD:
+				{
+					ZSTD_inBuffer input = { mInput + mInputStart, available, 0 };
+					ZSTD_outBuffer output = { destination, capacity, 0 };
+
+					// Returns 0 once a frame is complete; a following frame is decompressed in turn.
+					const size_t status = ZSTD_decompressStream( mZstd, &output, &input );
+					if ( ZSTD_isError( status ) )
+					{
+						throw std::runtime_error( std::string( "Corrupt zstd data: " ) + ZSTD_getErrorName( status ) );
+					}
+
+					mInputStart += input.pos;
+					produced = output.pos;
+					mIsStreamComplete = 0 == status;
+					break;
+				}
+#endif
+
+				default:
+					break;
+				}
 			}
 
-			return *this;
+			return produced;
 		}
+	};
 
-		/**
-		 * Compare iterators for equality.
-		 * @param other Const reference to the iterator to compare against this iterator.
-		 * @return True is returned if this and {@param other} compare equal.
-		 */
-		bool operator==( const iterator& other ) const
+	// Class for parsing JSON from a source
+	class ParseSource
+	{
+	private:
+		// Where are we pulling data from
+		enum class Source
 		{
-			if ( mValueType != other.mValueType )
+			STRING,    // std::string
+			FILE,      // FILE
+			IFSTREAM,      // std::ifstream
+			DECOMPRESSOR,  // Decompressed std::string, FILE or std::ifstream
+			NO_SOURCE      // No source
+		};
+
+		// Only the source of mSource is set, the others are null.
+		const std::string* mStringSource;
+		std::ifstream* mIFStreamSource;
+		FILE* mFileSource;
+		Decompressor* mDecompressor;
+
+		Source mSource;
+		uint64_t mLastReadPosition;
+		uint64_t mCurrentReadPosition;
+
+		char* mBuffer;
+		size_t mBufferSize;
+		size_t mBufferLength;
+		size_t mBufferStart;
+
+		// Initialize the other variables
+		void _initializeVariables( Source source )
+		{
+			mSource = source;
+			mLastReadPosition = 0;
+			mCurrentReadPosition = 0;
+			mBuffer = static_cast< char* >( calloc( 1024, 1 ) );
+			mBufferSize = 1024;
+			mBufferLength = 0;
+			mBufferStart = 0;
+		}
+
+		// Make at least {@param length} bytes from the current read position available in
+		// mBuffer, reading from the FILE or std::ifstream as needed. Returns false if the
+		// source ends before that many bytes could be read.
+		bool _fill( size_t length )
+		{
+			if ( length <= ( mBufferLength - mBufferStart ) )
 			{
-				return false;
+				return true;
 			}
 
-			if ( JsonValue::Type::object == mValueType )
+			// Shift the unread bytes to the front, and grow if they still do not fit.
+			std::memmove( mBuffer, mBuffer + mBufferStart, mBufferLength - mBufferStart );
+			mBufferLength -= mBufferStart;
+			mBufferStart = 0;
+
+			if ( mBufferSize < length )
 			{
-				return mObjectIterator == other.mObjectIterator;
+				size_t bufferSize = std::max( length, 2 * mBufferSize );
+				char* buffer = static_cast< char* >( realloc( mBuffer, bufferSize ) );
+				if ( nullptr == buffer )
+				{
+					throw std::bad_alloc();
+				}
+
+				mBuffer = buffer;
+				mBufferSize = bufferSize;
 			}
 
-			if ( JsonValue::Type::array == mValueType )
+			while ( mBufferLength < length )
 			{
-				return mArrayIterator == other.mArrayIterator;
+				size_t bytesRead = 0;
+
+				if ( Source::FILE == mSource )
+				{
+					bytesRead = fread( mBuffer + mBufferLength, 1, mBufferSize - mBufferLength, mFileSource );
+				}
+				else if ( Source::IFSTREAM == mSource )
+				{
+					mIFStreamSource->read( mBuffer + mBufferLength, std::streamsize( mBufferSize - mBufferLength ) );
+					bytesRead = size_t( mIFStreamSource->gcount() );
+				}
+				else if ( Source::DECOMPRESSOR == mSource )
+				{
+					bytesRead = mDecompressor->read( mBuffer + mBufferLength, mBufferSize - mBufferLength );
+				}
+
+				if ( 0 == bytesRead )
+				{
+					return false;
+				}
+
+				mBufferLength += bytesRead;
 			}
 
-			return false;
+			return true;
 		}
 
-		/**
-		 * Compare iterators for inequality.
-		 * @param other Const reference to the iterator to compare against this iterator.
-		 * @return True is returned if this and {@param other} compare not equal.
-		 */
-		bool operator!=( const iterator& other ) const
+	public:
+		// Delete default constructor
+		ParseSource() = delete;
+
+		// Parse from a std::string
+		ParseSource( const std::string& stringSource ) :
+			mStringSource( &stringSource ),
+			mIFStreamSource( nullptr ),
+			mFileSource( nullptr ),
+			mDecompressor( nullptr )
 		{
-			return not this->operator==( other );
+			_initializeVariables( Source::STRING );
 		}
 
-		/**
-		 * Pointer access to a JsonValue. If the iterator is
-		 * not defined, then a null pointer is returned.
-		 * @return Return pointer to a JsonValue.
-		 */
-		pointer operator->()
+		// Parse from a FILE
+		ParseSource( FILE* fileSource ) :
+			mStringSource( nullptr ),
+			mIFStreamSource( nullptr ),
+			mFileSource( fileSource ),
+			mDecompressor( nullptr )
 		{
-			if ( JsonValue::Type::object == mValueType )
-			{
-				return &mObjectIterator.operator*().second;
-			}
+			_initializeVariables( Source::FILE );
+		}
 
-			if ( JsonValue::Type::array == mValueType )
-			{
-				return mArrayIterator.operator->();
-			}
+		// Parse from a std::ifstream
+		ParseSource( std::ifstream& ifstreamSource ) :
+			mStringSource( nullptr ),
+			mIFStreamSource( &ifstreamSource ),
+			mFileSource( nullptr ),
+			mDecompressor( nullptr )
+		{
+			_initializeVariables( Source::IFSTREAM );
+		}
 
-			return static_cast< pointer >( nullptr );
+		// Parse from a compressed std::string
+		ParseSource( const std::string& stringSource, Compression compression ) :
+			mStringSource( nullptr ),
+			mIFStreamSource( nullptr ),
+			mFileSource( nullptr ),
+			mDecompressor( new Decompressor( stringSource, compression ) )
+		{
+			_initializeVariables( Source::DECOMPRESSOR );
 		}
 
-		/**
-		 * Reference access to a JsonValue. If the iterator is
-		 * not defined, then a reference from a null pointer is returned.
-		 * @return Reference to a JsonValue object.
-		 */
-		reference operator*()
+		// Parse from a compressed FILE
+		ParseSource( FILE* fileSource, Compression compression ) :
+			mStringSource( nullptr ),
+			mIFStreamSource( nullptr ),
+			mFileSource( nullptr ),
+			mDecompressor( new Decompressor( fileSource, compression ) )
 		{
-			if ( JsonValue::Type::object == mValueType )
+			_initializeVariables( Source::DECOMPRESSOR );
+		}
+
+		// Parse from a compressed std::ifstream
+		ParseSource( std::ifstream& ifstreamSource, Compression compression ) :
+			mStringSource( nullptr ),
+			mIFStreamSource( nullptr ),
+			mFileSource( nullptr ),
+			mDecompressor( new Decompressor( ifstreamSource, compression ) )
+		{
+			_initializeVariables( Source::DECOMPRESSOR );
+		}
+
+		// Free up the memory we've allocated, and return any bytes read ahead but not
+		// consumed to seekable streams, so the next read starts after the parsed value.
+		~ParseSource()
+		{
+			const size_t unreadLength = mBufferLength - mBufferStart;
+			if ( 0 < unreadLength )
 			{
-				return mObjectIterator.operator*().second;
+				if ( Source::FILE == mSource )
+				{
+					fseek( mFileSource, -long( unreadLength ), SEEK_CUR );
+				}
+				else if ( Source::IFSTREAM == mSource )
+				{
+					mIFStreamSource->clear();
+					mIFStreamSource->seekg( -std::streamoff( unreadLength ), std::ios_base::cur );
+				}
 			}
 
-			if ( JsonValue::Type::array == mValueType )
+			if ( nullptr != mBuffer )
 			{
-				return mArrayIterator.operator*();
+				free( mBuffer );
+				mBuffer = nullptr;
 			}
 
-			return *static_cast< pointer >( nullptr );
+			delete mDecompressor;
 		}
 
-		/**
-		 * Post-increment operator.
-		 * @return Return the iterator prior to incrementing.
-		 */
-		iterator operator++( int )
+		// Check if {@param length} bytes are available from the current read position
+		bool available( size_t length )
 		{
-			iterator previous( *this );
-			this->operator++();
-			return previous;
+			if ( Source::STRING == mSource )
+			{
+				return ( mCurrentReadPosition + length ) <= mStringSource->length();
+			}
+
+			return _fill( length );
 		}
 
-		/**
-		 * Pre-increment operator.
-		 * @return Return the iterator post increment.
-		 */
-		iterator& operator++()
+		// Append {@param length} bytes from the current read position to {@param destination},
+		// and move past them. The bytes are copied once, straight out of the source or buffer.
+		// Returns false if the source ends first.
+		bool append( std::string& destination, size_t length )
 		{
-			if ( JsonValue::Type::object == mValueType )
+			if ( Source::STRING == mSource )
 			{
-				mObjectIterator.operator++();
+				if ( ( mStringSource->length() - mCurrentReadPosition ) < length )
+				{
+					return false;
+				}
+
+				destination.append( *mStringSource, mCurrentReadPosition, length );
+				mCurrentReadPosition += length;
+				return true;
 			}
 
-			if ( JsonValue::Type::array == mValueType )
+			while ( 0 < length )
 			{
-				mArrayIterator.operator++();
+				if ( not _fill( 1 ) )
+				{
+					return false;
+				}
+
+				const size_t chunkLength = std::min( length, mBufferLength - mBufferStart );
+				destination.append( mBuffer + mBufferStart, chunkLength );
+				mBufferStart += chunkLength;
+				mCurrentReadPosition += chunkLength;
+				length -= chunkLength;
 			}
 
-			return *this;
+			return true;
 		}
 
-		/**
-		 * Swap the value of this iterator with another.
-		 * @param other Reference to the iterator with which to swap values.
-		 */
-		void swap( iterator& other )
+		// Copy from the current read position
+		// into {@param destination} for {@param length} bytes.
+		void copy( std::string& destination, size_t length )
 		{
-			std::swap( mValueType, other.mValueType );
-			std::swap( mObjectIterator, other.mObjectIterator );
-			std::swap( mArrayIterator, other.mArrayIterator );
+			if ( Source::STRING == mSource )
+			{
+				destination.assign( *mStringSource, mCurrentReadPosition, length );
+				return;
+			}
+
+			_fill( length );
+			destination.assign( mBuffer + mBufferStart, std::min( length, mBufferLength - mBufferStart ) );
+		}
+
+		// Check if we're at the end of the source
+		bool endOfSource()
+		{
+			switch ( mSource )
+			{
+			case Source::STRING:
+				return mStringSource->length() <= mCurrentReadPosition;
+
+			case Source::FILE:
+			case Source::IFSTREAM:
+			case Source::DECOMPRESSOR:
+				return not _fill( 1 );
+
+			case Source::NO_SOURCE:
+				break;
+			}
+
+			return true;
+		}
+
+		// Peek {@param offset} bytes from current read position
+		char peek( uint32_t offset = 0 )
+		{
+			if ( not available( size_t( offset ) + 1 ) )
+			{
+				mLastReadPosition = mCurrentReadPosition + offset;
+				return '\0';
+			}
+
+			mLastReadPosition = mCurrentReadPosition + offset;
+
+			if ( Source::STRING == mSource )
+			{
+				return ( *mStringSource )[ mLastReadPosition ];
+			}
+
+			return mBuffer[ mBufferStart + offset ];
+		}
+
+		// Compare {@param length} bytes of
+		// source with the given {@param string} buffer.
+		bool strncmp( const char* const string, size_t length )
+		{
+			if ( not available( length ) )
+			{
+				return false;
+			}
+
+			if ( Source::STRING == mSource )
+			{
+				return 0 == mStringSource->compare( mCurrentReadPosition, length, string, length );
+			}
+
+			return 0 == std::memcmp( mBuffer + mBufferStart, string, length );
+		}
+
+		// Offset of the current read position from the start of the source
+		uint64_t position() const noexcept
+		{
+			return mCurrentReadPosition;
+		}
+
+		// Move past {@param length} bytes without examining them, reading through the
+		// buffer in pieces rather than growing it. Returns false if the source ends first.
+		bool skip( uint64_t length )
+		{
+			if ( Source::STRING == mSource )
+			{
+				if ( ( mStringSource->length() - mCurrentReadPosition ) < length )
+				{
+					return false;
+				}
+
+				mCurrentReadPosition += length;
+				return true;
+			}
+
+			while ( 0 < length )
+			{
+				if ( not _fill( 1 ) )
+				{
+					return false;
+				}
+
+				const size_t skipLength = size_t( std::min< uint64_t >( length, mBufferLength - mBufferStart ) );
+				mBufferStart += skipLength;
+				mCurrentReadPosition += skipLength;
+				length -= skipLength;
+			}
+
+			return true;
+		}
+
+		// Update the current read position
+		// by the requested {@param offset} bytes.
+		void update( uint32_t offset = 1 )
+		{
+			if ( Source::STRING == mSource )
+			{
+				mCurrentReadPosition = std::min< uint64_t >( mCurrentReadPosition + offset, mStringSource->length() );
+				return;
+			}
+
+			_fill( offset );
+			const size_t consumed = std::min< size_t >( offset, mBufferLength - mBufferStart );
+			mBufferStart += consumed;
+			mCurrentReadPosition += consumed;
+		}
+
+		// Make {@param length} bytes from {@param offset} bytes past the current read position
+		// contiguous, and return a pointer to the first. Returns nullptr if the source ends first.
+		const char* window( size_t offset, size_t length )
+		{
+			if ( not available( offset + length ) )
+			{
+				return nullptr;
+			}
+
+			return ( Source::STRING == mSource ) ? ( mStringSource->data() + mCurrentReadPosition + offset ) : ( mBuffer + mBufferStart + offset );
 		}
 	};
 
+#ifdef INCLUDE_GMP
+	std::string _mpzToString( mpz_t integralValue )
+	{
+		std::string mpzString;
+		char* cstring = nullptr;
+
+		cstring = mpz_get_str( nullptr, 10, mNumericValue.MPFloatValue );
+		mpzString = std::string( cstring );
+
+		mp_get_memory_functions( nullptr, nullptr, &freeFunction );
+		freeFunction( cstring, strlen( cstring ) + 1 );
+		cstring = nullptr;
+
+		return mpzString;
+	}
+
+	std::string _mpfToString( mpf_t floatValue )
+	{
+		mp_exp_t exponent;
+		char* 
+	}
+#endif
+
+public:
 	/**
-	 * Immutable iterator object for iterating over object and array type JSON values.
+	 * Mutable iterator object for iterating over object and array type JSON values.
 	 */
-	class const_iterator
+	class iterator
 	{
 	private:
 		friend class JsonValue;
 
-		ObjectType::const_iterator mObjectIterator;
-		ArrayType::const_iterator mArrayIterator;
+		ObjectType::iterator mObjectIterator;
+		ArrayType::iterator mArrayIterator;
 		JsonValue::Type mValueType;
 
 		// ObjectType iterator constructor.
-		const_iterator( ObjectType::const_iterator iterator )
+		iterator( ObjectType::iterator iterator )
 		{
 			mObjectIterator = iterator;
 			mValueType = JsonValue::Type::object;
 		}
 
 		// ArrayType iterator constructor.
-		const_iterator( ArrayType::const_iterator iterator )
+		iterator( ArrayType::iterator iterator )
 		{
 			mArrayIterator = iterator;
 			mValueType = JsonValue::Type::array;
 		}
 
 		// Copy assignment
-		void _copyAssign( const const_iterator& other )
+		void _copyAssign( const iterator& other )
 		{
 			mObjectIterator = other.mObjectIterator;
 			mArrayIterator = other.mArrayIterator;
@@ -585,7 +1345,7 @@ public:
 		}
 
 		// Move assignment
-		void _moveAssign( const_iterator&& other )
+		void _moveAssign( iterator&& other )
 		{
 			mObjectIterator = std::move( other.mObjectIterator );
 			mArrayIterator = std::move( other.mArrayIterator );
@@ -596,13 +1356,13 @@ public:
 		using iterator_category = std::forward_iterator_tag;
 		using difference_type   = std::ptrdiff_t;
 		using value_type        = JsonValue;
-		using pointer           = const JsonValue*;
-		using reference         = const JsonValue&;
+		using pointer           = JsonValue*;
+		using reference         = JsonValue&;
 
 		/**
 		 * Default constructor to an empty iterator.
 		 */
-		const_iterator()
+		iterator()
 		{
 			mValueType = JsonValue::Type::undefined;
 		}
@@ -611,7 +1371,7 @@ public:
 		 * Move constructor.
 		 * @param other R-Value to iterator to move to this instance.
 		 */
-		const_iterator( const_iterator&& other )
+		iterator( iterator&& other )
 		{
 			_moveAssign( std::move( other ) );
 		}
@@ -620,7 +1380,7 @@ public:
 		 * Copy constructor.
 		 * @param other Const reference to iterator to copy to this instance.
 		 */
-		const_iterator( const const_iterator& other )
+		iterator( const iterator& other )
 		{
 			_copyAssign( other );
 		}
@@ -630,7 +1390,7 @@ public:
 		 * @param other R-value to iterator to move to this instance.
 		 * @return Reference to this iterator instance is returned.
 		 */
-		const_iterator& operator=( const_iterator&& other )
+		iterator& operator=( iterator&& other )
 		{
 			if ( this != &other )
 			{
@@ -645,7 +1405,7 @@ public:
 		 * @param other Const reference to iterator to copy to this instance.
 		 * @return Reference to this iterator instance is returned.
 		 */
-		const_iterator& operator=( const const_iterator& other )
+		iterator& operator=( const iterator& other )
 		{
 			if ( this != &other )
 			{
@@ -660,7 +1420,7 @@ public:
 		 * @param other Const reference to the iterator to compare against this iterator.
 		 * @return True is returned if this and {@param other} compare equal.
 		 */
-		bool operator==( const const_iterator& other ) const
+		bool operator==( const iterator& other ) const
 		{
 			if ( mValueType != other.mValueType )
 			{
@@ -685,15 +1445,15 @@ public:
 		 * @param other Const reference to the iterator to compare against this iterator.
 		 * @return True is returned if this and {@param other} compare not equal.
 		 */
-		bool operator!=( const const_iterator& other ) const
+		bool operator!=( const iterator& other ) const
 		{
 			return not this->operator==( other );
 		}
 
 		/**
-		 * Const pointer access to a JsonValue. If the iterator is
+		 * Pointer access to a JsonValue. If the iterator is
 		 * not defined, then a null pointer is returned.
-		 * @return Return const pointer to a JsonValue.
+		 * @return Return pointer to a JsonValue.
 		 */
 		pointer operator->()
 		{
@@ -711,9 +1471,9 @@ public:
 		}
 
 		/**
-		 * Const reference access to a JsonValue. If the iterator is
-		 * not defined, then a const reference from a null pointer is returned.
-		 * @return Const reference to a JsonValue object.
+		 * Reference access to a JsonValue. If the iterator is
+		 * not defined, then a reference from a null pointer is returned.
+		 * @return Reference to a JsonValue object.
 		 */
 		reference operator*()
 		{
@@ -732,9 +1492,9 @@ public:
 
 		/**
 		 * Post-increment operator.
-		 * @return Return the const_iterator prior to incrementing.
+		 * @return Return the iterator prior to incrementing.
 		 */
-		const_iterator operator++( int )
+		iterator operator++( int )
 		{
 			iterator previous( *this );
 			this->operator++();
@@ -743,9 +1503,9 @@ public:
 
 		/**
 		 * Pre-increment operator.
-		 * @return Return the const_iterator post increment.
+		 * @return Return the iterator post increment.
 		 */
-		const_iterator& operator++()
+		iterator& operator++()
 		{
 			if ( JsonValue::Type::object == mValueType )
 			{
@@ -764,7 +1524,7 @@ public:
 		 * Swap the value of this iterator with another.
 		 * @param other Reference to the iterator with which to swap values.
 		 */
-		void swap( const_iterator& other )
+		void swap( iterator& other )
 		{
 			std::swap( mValueType, other.mValueType );
 			std::swap( mObjectIterator, other.mObjectIterator );
@@ -773,1614 +1533,14659 @@ public:
 	};
 
 	/**
-	 * Default constructor.
-	 * @param type Type to initialize the JsonValue to. [default: undefined]
+	 * Immutable iterator object for iterating over object and array type JSON values.
 	 */
-	JsonValue( Type type = Type::undefined ) noexcept
+	class const_iterator
 	{
-		_initPrimitiveVariables( type );
-	}
+	private:
+		friend class JsonValue;
 
-	/**
-	 * Copy constructor.
-	 * @param other Const reference to the JsonValue to copy.
-	 */
-	JsonValue( const JsonValue& other )
-	{
-		_copyAssign( other );
-	}
+		ObjectType::const_iterator mObjectIterator;
+		ArrayType::const_iterator mArrayIterator;
+		JsonValue::Type mValueType;
 
-	/**
-	 * Move constructor.
-	 * @param other R-Value of the JsonValue to move to this instance.
-	 */
-	JsonValue( JsonValue&& other )
-	{
-		_moveAssign( std::move( other ) );
-	}
+		// ObjectType iterator constructor.
+		const_iterator( ObjectType::const_iterator iterator )
+		{
+			mObjectIterator = iterator;
+			mValueType = JsonValue::Type::object;
+		}
 
-	/**
-	 * Object copy initialization constructor.
-	 * @param object Const reference to an ObjectType to initialize the JsonValue to.
-	 */
-	JsonValue( const ObjectType& object )
-	{
-		_initPrimitiveVariables( Type::object );
-		mMembers = object;
-	}
+		// ArrayType iterator constructor.
+		const_iterator( ArrayType::const_iterator iterator )
+		{
+			mArrayIterator = iterator;
+			mValueType = JsonValue::Type::array;
+		}
 
-	/**
-	 * Object move initialization constructor.
-	 * @param object R-Value to an ObjectType to initialize the JsonValue to.
-	 */
-	JsonValue( ObjectType&& object )
-	{
-		_initPrimitiveVariables( Type::object );
-		mMembers = std::move( object );
-	}
+		// Copy assignment
+		void _copyAssign( const const_iterator& other )
+		{
+			mObjectIterator = other.mObjectIterator;
+			mArrayIterator = other.mArrayIterator;
+			mValueType = other.mValueType;
+		}
 
-	/**
-	 * Array copy initialization constructor.
-	 * @param array Const reference to an ArrayType to initialize the JsonValue to.
-	 */
+		// Move assignment
+		void _moveAssign( const_iterator&& other )
+		{
+			mObjectIterator = std::move( other.mObjectIterator );
+			mArrayIterator = std::move( other.mArrayIterator );
+			mValueType = std::exchange( other.mValueType, JsonValue::Type::undefined );
+		}
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using difference_type   = std::ptrdiff_t;
+		using value_type        = JsonValue;
+		using pointer           = const JsonValue*;
+		using reference         = const JsonValue&;
+
+		/**
+		 * Default constructor to an empty iterator.
+		 */
+		const_iterator()
+		{
+			mValueType = JsonValue::Type::undefined;
+		}
+
+		/**
+		 * Move constructor.
+		 * @param other R-Value to iterator to move to this instance.
+		 */
+		const_iterator( const_iterator&& other )
+		{
+			_moveAssign( std::move( other ) );
+		}
+
+		/**
+		 * Copy constructor.
+		 * @param other Const reference to iterator to copy to this instance.
+		 */
+		const_iterator( const const_iterator& other )
+		{
+			_copyAssign( other );
+		}
+
+		/**
+		 * Move assignment operator.
+		 * @param other R-value to iterator to move to this instance.
+		 * @return Reference to this iterator instance is returned.
+		 */
+		const_iterator& operator=( const_iterator&& other )
+		{
+			if ( this != &other )
+			{
+				_moveAssign( std::move( other ) );
+			}
+
+			return *this;
+		}
+
+		/**
+		 * Copy assignment operator.
+		 * @param other Const reference to iterator to copy to this instance.
+		 * @return Reference to this iterator instance is returned.
+		 */
+		const_iterator& operator=( const const_iterator& other )
+		{
+			if ( this != &other )
+			{
+				_copyAssign( other );
+			}
+
+			return *this;
+		}
+
+		/**
+		 * Compare iterators for equality.
+		 * @param other Const reference to the iterator to compare against this iterator.
+		 * @return True is returned if this and {@param other} compare equal.
+		 */
+		bool operator==( const const_iterator& other ) const
+		{
+			if ( mValueType != other.mValueType )
+			{
+				return false;
+			}
+
+			if ( JsonValue::Type::object == mValueType )
+			{
+				return mObjectIterator == other.mObjectIterator;
+			}
+
+			if ( JsonValue::Type::array == mValueType )
+			{
+				return mArrayIterator == other.mArrayIterator;
+			}
+
+			return false;
+		}
+
+		/**
+		 * Compare iterators for inequality.
+		 * @param other Const reference to the iterator to compare against this iterator.
+		 * @return True is returned if this and {@param other} compare not equal.
+		 */
+		bool operator!=( const const_iterator& other ) const
+		{
+			return not this->operator==( other );
+		}
+
+		/**
+		 * Const pointer access to a JsonValue. If the iterator is
+		 * not defined, then a null pointer is returned.
+		 * @return Return const pointer to a JsonValue.
+		 */
+		pointer operator->()
+		{
+			if ( JsonValue::Type::object == mValueType )
+			{
+				return &mObjectIterator.operator*().second;
+			}
+
+			if ( JsonValue::Type::array == mValueType )
+			{
+				return mArrayIterator.operator->();
+			}
+
+			return static_cast< pointer >( nullptr );
+		}
+
+		/**
+		 * Const reference access to a JsonValue. If the iterator is
+		 * not defined, then a const reference from a null pointer is returned.
+		 * @return Const reference to a JsonValue object.
+		 */
+		reference operator*()
+		{
+			if ( JsonValue::Type::object == mValueType )
+			{
+				return mObjectIterator.operator*().second;
+			}
+
+			if ( JsonValue::Type::array == mValueType )
+			{
+				return mArrayIterator.operator*();
+			}
+
+			return *static_cast< pointer >( nullptr );
+		}
+
+		/**
+		 * Post-increment operator.
+		 * @return Return the const_iterator prior to incrementing.
+		 */
+		const_iterator operator++( int )
+		{
+			const_iterator previous( *this );
+			this->operator++();
+			return previous;
+		}
+
+		/**
+		 * Pre-increment operator.
+		 * @return Return the const_iterator post increment.
+		 */
+		const_iterator& operator++()
+		{
+			if ( JsonValue::Type::object == mValueType )
+			{
+				mObjectIterator.operator++();
+			}
+
+			if ( JsonValue::Type::array == mValueType )
+			{
+				mArrayIterator.operator++();
+			}
+
+			return *this;
+		}
+
+		/**
+		 * Swap the value of this iterator with another.
+		 * @param other Reference to the iterator with which to swap values.
+		 */
+		void swap( const_iterator& other )
+		{
+			std::swap( mValueType, other.mValueType );
+			std::swap( mObjectIterator, other.mObjectIterator );
+			std::swap( mArrayIterator, other.mArrayIterator );
+		}
+	};
+
+	/**
+	 * Range over a pair of iterators, for use with range-based for loops.
+	 */
+	template < typename Iterator >
+	class range
+	{
+	private:
+		Iterator mBegin;
+		Iterator mEnd;
+
+	public:
+		/**
+		 * Construct a range from a pair of iterators.
+		 * @param begin Iterator to the first item of the range.
+		 * @param end Iterator past the last item of the range.
+		 */
+		range( Iterator begin, Iterator end ) :
+			mBegin( begin ),
+			mEnd( end )
+		{
+		}
+
+		/**
+		 * Return an iterator to the first item of the range.
+		 * @return The iterator to the first item of the range.
+		 */
+		Iterator begin() const
+		{
+			return mBegin;
+		}
+
+		/**
+		 * Check if the range has no items.
+		 * @return True is returned if the range is empty.
+		 */
+		bool empty() const
+		{
+			return mBegin == mEnd;
+		}
+
+		/**
+		 * Return an iterator past the last item of the range.
+		 * @return The iterator past the last item of the range.
+		 */
+		Iterator end() const
+		{
+			return mEnd;
+		}
+	};
+
+	using item_range = range< ObjectType::iterator >;
+	using const_item_range = range< ObjectType::const_iterator >;
+
+	/**
+	 * Contiguous view over the elements of an array type JsonValue.
+	 * The iterators are plain pointers, so they are random access and contiguous,
+	 * and can be handed to std::sort, std::lower_bound or the parallel algorithms.
+	 * The view is invalidated by any operation that resizes the array.
+	 */
+	template < typename ElementType >
+	class span
+	{
+	private:
+		ElementType* mData;
+		size_t mSize;
+
+	public:
+		using element_type = ElementType;
+		using value_type = typename std::remove_cv< ElementType >::type;
+		using pointer = ElementType*;
+		using reference = ElementType&;
+		using iterator = ElementType*;
+
+		/**
+		 * Construct a view over {@param size} elements starting at {@param data}.
+		 * @param data Pointer to the first element.
+		 * @param size Number of elements.
+		 */
+		span( ElementType* data, size_t size ) noexcept :
+			mData( data ),
+			mSize( size )
+		{
+		}
+
+		/**
+		 * Reference access to the last element. The span may not be empty.
+		 * @return Reference to the last element.
+		 */
+		reference back() const noexcept
+		{
+			return mData[ mSize - 1 ];
+		}
+
+		/**
+		 * Return an iterator to the first element.
+		 * @return Pointer to the first element.
+		 */
+		iterator begin() const noexcept
+		{
+			return mData;
+		}
+
+		/**
+		 * Pointer access to the underlying elements.
+		 * @return Pointer to the first element.
+		 */
+		pointer data() const noexcept
+		{
+			return mData;
+		}
+
+		/**
+		 * Check if the span has no elements.
+		 * @return True is returned if the span is empty.
+		 */
+		bool empty() const noexcept
+		{
+			return 0 == mSize;
+		}
+
+		/**
+		 * Return an iterator past the last element.
+		 * @return Pointer past the last element.
+		 */
+		iterator end() const noexcept
+		{
+			return mData + mSize;
+		}
+
+		/**
+		 * Reference access to the first element. The span may not be empty.
+		 * @return Reference to the first element.
+		 */
+		reference front() const noexcept
+		{
+			return mData[ 0 ];
+		}
+
+		/**
+		 * Unchecked element access.
+		 * @param index Index of the element, which must be less than size().
+		 * @return Reference to the element.
+		 */
+		reference operator[]( size_t index ) const noexcept
+		{
+			return mData[ index ];
+		}
+
+		/**
+		 * Number of elements in the span.
+		 * @return The number of elements.
+		 */
+		size_t size() const noexcept
+		{
+			return mSize;
+		}
+	};
+
+	using array_iterator = JsonValue*;
+	using const_array_iterator = const JsonValue*;
+
+	/**
+	 * Lazy range over the keys of an object type JsonValue.
+	 */
+	class key_range
+	{
+	public:
+		/**
+		 * Immutable iterator over the keys of an object, yielding each key by const reference.
+		 */
+		class const_iterator
+		{
+		private:
+			ObjectType::const_iterator mIterator;
+
+		public:
+			using iterator_category = std::bidirectional_iterator_tag;
+			using difference_type   = std::ptrdiff_t;
+			using value_type        = std::string;
+			using pointer           = const std::string*;
+			using reference         = const std::string&;
+
+			/**
+			 * Default constructor to an empty iterator.
+			 */
+			const_iterator() = default;
+
+			/**
+			 * Construct from an iterator over the members of an object.
+			 * @param iterator Iterator over the members of an object.
+			 */
+			explicit const_iterator( ObjectType::const_iterator iterator ) :
+				mIterator( iterator )
+			{
+			}
+
+			/**
+			 * Compare iterators for equality.
+			 * @param other Const reference to the iterator to compare against this iterator.
+			 * @return True is returned if this and {@param other} compare equal.
+			 */
+			bool operator==( const const_iterator& other ) const
+			{
+				return mIterator == other.mIterator;
+			}
+
+			/**
+			 * Compare iterators for inequality.
+			 * @param other Const reference to the iterator to compare against this iterator.
+			 * @return True is returned if this and {@param other} compare not equal.
+			 */
+			bool operator!=( const const_iterator& other ) const
+			{
+				return mIterator != other.mIterator;
+			}
+
+			/**
+			 * Const pointer access to the key.
+			 * @return Return const pointer to the key.
+			 */
+			pointer operator->() const
+			{
+				return &mIterator->first;
+			}
+
+			/**
+			 * Const reference access to the key.
+			 * @return Const reference to the key.
+			 */
+			reference operator*() const
+			{
+				return mIterator->first;
+			}
+
+			/**
+			 * Post-increment operator.
+			 * @return Return the const_iterator prior to incrementing.
+			 */
+			const_iterator operator++( int )
+			{
+				const_iterator previous( *this );
+				++mIterator;
+				return previous;
+			}
+
+			/**
+			 * Pre-increment operator.
+			 * @return Return the const_iterator post increment.
+			 */
+			const_iterator& operator++()
+			{
+				++mIterator;
+				return *this;
+			}
+
+			/**
+			 * Post-decrement operator.
+			 * @return Return the const_iterator prior to decrementing.
+			 */
+			const_iterator operator--( int )
+			{
+				const_iterator previous( *this );
+				--mIterator;
+				return previous;
+			}
+
+			/**
+			 * Pre-decrement operator.
+			 * @return Return the const_iterator post decrement.
+			 */
+			const_iterator& operator--()
+			{
+				--mIterator;
+				return *this;
+			}
+		};
+
+		using iterator = const_iterator;
+
+	private:
+		const ObjectType* mMembers;
+
+	public:
+		/**
+		 * Construct a range over the keys of the given members.
+		 * @param members Const reference to the members of an object.
+		 */
+		explicit key_range( const ObjectType& members ) :
+			mMembers( &members )
+		{
+		}
+
+		/**
+		 * Return a const_iterator to the first key.
+		 * @return The const_iterator to the first key.
+		 */
+		const_iterator begin() const
+		{
+			return const_iterator( mMembers->cbegin() );
+		}
+
+		/**
+		 * Check if there are no keys.
+		 * @return True is returned if there are no keys.
+		 */
+		bool empty() const
+		{
+			return mMembers->empty();
+		}
+
+		/**
+		 * Return a const_iterator past the last key.
+		 * @return The const_iterator past the last key.
+		 */
+		const_iterator end() const
+		{
+			return const_iterator( mMembers->cend() );
+		}
+
+		/**
+		 * Copy the keys into a vector.
+		 * @return Return a vector of keys.
+		 */
+		operator std::vector< std::string >() const
+		{
+			return std::vector< std::string >( begin(), end() );
+		}
+
+		/**
+		 * Number of keys in the range.
+		 * @return The number of keys.
+		 */
+		size_t size() const
+		{
+			return mMembers->size();
+		}
+	};
+
+	/**
+	 * Background reclaimer for releasing JsonValue trees off of the calling thread.
+	 * Trees handed to reclaim() are moved onto a queue and destroyed by a worker
+	 * thread, so dropping a large document does not stall the thread that dropped it.
+	 * Note(s):
+	 *    - reclaim() and flush() may be called from any number of threads.
+	 *    - The destructor releases every pending tree before returning.
+	 *    - An optional callback is run on the worker thread after each batch
+	 *      of trees is released, with the number of trees in the batch.
+	 */
+	class Reclaimer
+	{
+	public:
+		using Callback = std::function< void( size_t ) >;
+
+	private:
+		Callback mOnReleased;
+		std::mutex mMutex;
+		std::condition_variable mPendingCondition;
+		std::condition_variable mDrainedCondition;
+		ArrayType mPending;
+		bool mReleasing;
+		bool mStopping;
+		std::thread mWorker;
+
+		// Worker loop: take everything that is pending and release it unlocked.
+		void _run()
+		{
+			std::unique_lock< std::mutex > lock( mMutex );
+
+			while ( true )
+			{
+				mPendingCondition.wait( lock, [ this ]()
+				{
+					return mStopping or not mPending.empty();
+				} );
+
+				if ( mPending.empty() )
+				{
+					return;
+				}
+
+				ArrayType batch( std::move( mPending ) );
+				mPending.clear();
+				mReleasing = true;
+
+				lock.unlock();
+				const size_t released = batch.size();
+				batch.clear();
+				if ( mOnReleased )
+				{
+					mOnReleased( released );
+				}
+				lock.lock();
+
+				mReleasing = false;
+				mDrainedCondition.notify_all();
+			}
+		}
+
+	public:
+		/**
+		 * Default constructor. Starts the worker thread.
+		 */
+		Reclaimer() :
+			Reclaimer( Callback() )
+		{
+		}
+
+		/**
+		 * Constructor. Starts the worker thread.
+		 * @param onReleased Callback run on the worker thread after each batch is
+		 *                   released, with the number of trees in the batch.
+		 */
+		explicit Reclaimer( Callback onReleased ) :
+			mOnReleased( std::move( onReleased ) ),
+			mReleasing( false ),
+			mStopping( false ),
+			mWorker( &Reclaimer::_run, this )
+		{
+		}
+
+		// Copying and moving a reclaimer is not supported
+		Reclaimer( const Reclaimer& ) = delete;
+		Reclaimer& operator=( const Reclaimer& ) = delete;
+
+		/**
+		 * Destructor. Releases all pending trees and joins the worker thread.
+		 */
+		~Reclaimer()
+		{
+			{
+				std::lock_guard< std::mutex > lock( mMutex );
+				mStopping = true;
+			}
+
+			mPendingCondition.notify_one();
+			mWorker.join();
+		}
+
+		/**
+		 * Block until every tree handed to reclaim() prior to this call has been released.
+		 */
+		void flush()
+		{
+			std::unique_lock< std::mutex > lock( mMutex );
+			mDrainedCondition.wait( lock, [ this ]()
+			{
+				return mPending.empty() and not mReleasing;
+			} );
+		}
+
+		/**
+		 * Hand a JsonValue over to be released by the worker thread.
+		 * Values without elements or members are released immediately.
+		 * @param value R-Value of the JsonValue to release. The JsonValue
+		 *              shall be undefined after calling this method.
+		 */
+		void reclaim( JsonValue&& value )
+		{
+			if ( not value._hasChildren() )
+			{
+				value.clear();
+				return;
+			}
+
+			{
+				std::lock_guard< std::mutex > lock( mMutex );
+				mPending.push_back( std::move( value ) );
+			}
+
+			mPendingCondition.notify_one();
+		}
+	};
+
+	/**
+	 * Compiled JSON Pointer, as defined in RFC 6901.
+	 * Reference: https://www.rfc-editor.org/rfc/rfc6901
+	 * Note(s):
+	 *    - The pointer string is split and unescaped once, and array indices
+	 *      are parsed up front. Evaluating the pointer performs no allocation.
+	 *    - Evaluation never adds members or elements to the document.
+	 */
+	class Pointer
+	{
+	public:
+		/**
+		 * A single, unescaped, reference token of a JSON Pointer.
+		 */
+		struct Token
+		{
+			std::string key;    ///< The unescaped reference token.
+			size_t index;       ///< The parsed array index, valid if isIndex is set.
+			bool isIndex;       ///< The token is a valid array index.
+			bool isEndOfArray;  ///< The token is "-", the element after the last.
+
+			/**
+			 * Compare tokens for equality.
+			 * @param other Const reference to the Token to compare against.
+			 * @return True is returned if both tokens have the same key.
+			 */
+			bool operator==( const Token& other ) const noexcept
+			{
+				return key == other.key;
+			}
+
+			/**
+			 * Compare tokens for inequality.
+			 * @param other Const reference to the Token to compare against.
+			 * @return True is returned if the tokens have different keys.
+			 */
+			bool operator!=( const Token& other ) const noexcept
+			{
+				return key != other.key;
+			}
+		};
+
+		using const_iterator = std::vector< Token >::const_iterator;
+
+	private:
+		friend class JsonValue;
+
+		std::vector< Token > mTokens;
+
+		// Resolve the first {@param count} reference tokens against {@param document}.
+		const JsonValue* _get( const JsonValue& document, size_t count ) const noexcept
+		{
+			const JsonValue* value = &document;
+
+			for ( size_t position( 0 ); position < count; ++position )
+			{
+				const Token& token = mTokens[ position ];
+				if ( Type::object == value->mType )
+				{
+					auto member = value->mMembers.find( token.key );
+					if ( value->mMembers.end() == member )
+					{
+						return nullptr;
+					}
+
+					value = &member->second;
+				}
+				else if ( ( Type::array == value->mType )
+					and token.isIndex and ( token.index < value->mElements.size() ) )
+				{
+					value = &value->mElements[ token.index ];
+				}
+				else
+				{
+					return nullptr;
+				}
+			}
+
+			return value;
+		}
+
+		// Append {@param key} to {@param pointer} as an escaped reference token.
+		static void _appendToken( std::string& pointer, const std::string& key )
+		{
+			pointer.push_back( '/' );
+			for ( const char character : key )
+			{
+				if ( '~' == character )
+				{
+					pointer.append( "~0" );
+				}
+				else if ( '/' == character )
+				{
+					pointer.append( "~1" );
+				}
+				else
+				{
+					pointer.push_back( character );
+				}
+			}
+		}
+
+		// Build a token from an unescaped key, resolving whether it is an array index.
+		static Token _makeToken( std::string&& key )
+		{
+			Token token;
+			token.key = std::move( key );
+			token.index = 0;
+			token.isIndex = false;
+			token.isEndOfArray = ( "-" == token.key );
+
+			// RFC 6901: array-index = %x30 / ( %x31-39 *(%x30-39) )
+			if ( token.key.empty() or ( ( '0' == token.key[ 0 ] ) and ( 1 < token.key.length() ) ) )
+			{
+				return token;
+			}
+
+			size_t index = 0;
+			for ( const char character : token.key )
+			{
+				if ( not isdigit( static_cast< unsigned char >( character ) ) )
+				{
+					return token;
+				}
+
+				size_t digit = size_t( character - '0' );
+				if ( ( SIZE_MAX - digit ) / 10 < index )
+				{
+					// Too large to address an element, treat it as a member key only.
+					return token;
+				}
+
+				index = ( index * 10 ) + digit;
+			}
+
+			token.index = index;
+			token.isIndex = true;
+			return token;
+		}
+
+		// Split and unescape the pointer string into tokens.
+		void _compile( const char* pointer, size_t length )
+		{
+			if ( 0 == length )
+			{
+				return;
+			}
+
+			if ( '/' != pointer[ 0 ] )
+			{
+				throw std::invalid_argument( "JSON Pointer must be empty or begin with '/'" );
+			}
+
+			std::string key;
+			for ( size_t offset( 1 ); offset <= length; ++offset )
+			{
+				if ( ( length == offset ) or ( '/' == pointer[ offset ] ) )
+				{
+					mTokens.push_back( _makeToken( std::move( key ) ) );
+					key = std::string();
+					continue;
+				}
+
+				if ( '~' == pointer[ offset ] )
+				{
+					char escaped = ( ( offset + 1 ) < length ) ? pointer[ offset + 1 ] : '\0';
+
+					if ( '0' == escaped )
+					{
+						key.push_back( '~' );
+					}
+					else if ( '1' == escaped )
+					{
+						key.push_back( '/' );
+					}
+					else
+					{
+						throw std::invalid_argument( "JSON Pointer contains an invalid escape sequence" );
+					}
+
+					++offset;
+					continue;
+				}
+
+				key.push_back( pointer[ offset ] );
+			}
+		}
+
+	public:
+		/**
+		 * Default constructor. The pointer refers to the whole document.
+		 */
+		Pointer() = default;
+
+		/**
+		 * Compile a JSON Pointer from its string representation.
+		 * @param pointer Const reference to the pointer string, e.g. "/a/b/0/c".
+		 * @throw std::invalid_argument is thrown if the pointer is malformed.
+		 */
+		Pointer( const std::string& pointer )
+		{
+			_compile( pointer.data(), pointer.length() );
+		}
+
+		/**
+		 * Compile a JSON Pointer from its string representation.
+		 * @param pointer Pointer to a const char string, e.g. "/a/b/0/c".
+		 * @throw std::invalid_argument is thrown if the pointer is null or malformed.
+		 */
+		Pointer( const char* const pointer )
+		{
+			if ( nullptr == pointer )
+			{
+				throw std::invalid_argument( "JSON Pointer may not be a null pointer" );
+			}
+
+			_compile( pointer, strlen( pointer ) );
+		}
+
+		/**
+		 * Append a member key, or array index in string form, to this pointer.
+		 * @param key Const reference to the unescaped reference token.
+		 * @return Reference to this Pointer instance is returned.
+		 */
+		Pointer& append( const std::string& key )
+		{
+			mTokens.push_back( _makeToken( std::string( key ) ) );
+			return *this;
+		}
+
+		/**
+		 * Append an array index to this pointer.
+		 * @param index The index of the array element.
+		 * @return Reference to this Pointer instance is returned.
+		 */
+		Pointer& append( size_t index )
+		{
+			Token token;
+			token.key = std::to_string( index );
+			token.index = index;
+			token.isIndex = true;
+			token.isEndOfArray = false;
+			mTokens.push_back( std::move( token ) );
+			return *this;
+		}
+
+		/**
+		 * Return a const_iterator to the first reference token.
+		 * @return The const_iterator to the first reference token.
+		 */
+		const_iterator begin() const noexcept
+		{
+			return mTokens.cbegin();
+		}
+
+		/**
+		 * Return a const_iterator past the last reference token.
+		 * @return The const_iterator past the last reference token.
+		 */
+		const_iterator end() const noexcept
+		{
+			return mTokens.cend();
+		}
+
+		/**
+		 * Check if this pointer refers to the whole document.
+		 * @return True is returned if there are no reference tokens.
+		 */
+		bool empty() const noexcept
+		{
+			return mTokens.empty();
+		}
+
+		/**
+		 * Resolve this pointer against the given document.
+		 * @param document Reference to the JsonValue to evaluate against.
+		 * @return Pointer to the referenced JsonValue is returned, or a null
+		 *         pointer if any reference token cannot be resolved.
+		 */
+		JsonValue* get( JsonValue& document ) const noexcept
+		{
+			return const_cast< JsonValue* >( get( static_cast< const JsonValue& >( document ) ) );
+		}
+
+		/**
+		 * Resolve this pointer against the given document.
+		 * @param document Const reference to the JsonValue to evaluate against.
+		 * @return Const pointer to the referenced JsonValue is returned, or a null
+		 *         pointer if any reference token cannot be resolved.
+		 */
+		const JsonValue* get( const JsonValue& document ) const noexcept
+		{
+			return _get( document, mTokens.size() );
+		}
+
+		/**
+		 * Compare pointers for equality.
+		 * @param other Const reference to the Pointer to compare against.
+		 * @return True is returned if both pointers have the same reference tokens.
+		 */
+		bool operator==( const Pointer& other ) const noexcept
+		{
+			return mTokens == other.mTokens;
+		}
+
+		/**
+		 * Compare pointers for inequality.
+		 * @param other Const reference to the Pointer to compare against.
+		 * @return True is returned if the pointers have different reference tokens.
+		 */
+		bool operator!=( const Pointer& other ) const noexcept
+		{
+			return not this->operator==( other );
+		}
+
+		/**
+		 * Access a reference token by position.
+		 * @param position Position of the reference token.
+		 * @return Const reference to the Token.
+		 * @throw std::out_of_range is thrown if position exceeds the number of tokens.
+		 */
+		const Token& operator[]( size_t position ) const
+		{
+			return mTokens.at( position );
+		}
+
+		/**
+		 * Return a pointer to the parent of the value this pointer refers to.
+		 * @return The Pointer with the last reference token removed.
+		 * @throw std::out_of_range is thrown if this pointer refers to the whole document.
+		 */
+		Pointer parent() const
+		{
+			if ( mTokens.empty() )
+			{
+				throw std::out_of_range( "The whole document has no parent" );
+			}
+
+			Pointer parentPointer;
+			parentPointer.mTokens.assign( mTokens.begin(), std::prev( mTokens.end() ) );
+			return parentPointer;
+		}
+
+		/**
+		 * Number of reference tokens in this pointer.
+		 * @return The number of reference tokens.
+		 */
+		size_t size() const noexcept
+		{
+			return mTokens.size();
+		}
+
+		/**
+		 * Generate the escaped string representation of this pointer.
+		 * @return The string representation of this pointer is returned.
+		 */
+		std::string toString() const
+		{
+			std::string pointer;
+
+			for ( const auto& token : mTokens )
+			{
+				_appendToken( pointer, token.key );
+			}
+
+			return pointer;
+		}
+	};
+
+	/**
+	 * Compiled JSONPath query.
+	 * Reference: https://www.rfc-editor.org/rfc/rfc9535
+	 * Supported syntax:
+	 *    - Root '$', child segments '.name', '.*', "['name']" and '[*]'.
+	 *    - Descendant segments '..name', '..*' and '..[ selectors ]'.
+	 *    - Index '[-1]', slice '[start:end:step]' and union '[0,2,"name"]' selectors.
+	 *    - Filter selectors '[?(@.price < 10 && @.isbn)]' with the comparison
+	 *      operators == != < <= > >=, the logical operators && || ! and literals.
+	 * Note(s):
+	 *    - The query is compiled once into a plan of segments and selectors,
+	 *      which can be run against any number of documents.
+	 *    - The streaming overloads of select() run the plan directly over the
+	 *      source text. Only the matched values are built, and everything else
+	 *      is skipped. Values under a filter, negative index or negative slice
+	 *      are built first, as those selectors need the complete value.
+	 *      Streamed results are produced in document order without duplicates.
+	 */
+	class Path
+	{
+	public:
+		using Callback = std::function< void( JsonValue&& ) >;
+
+	private:
+		// A single selector within a segment
+		struct Selector
+		{
+			enum class Kind
+			{
+				NAME,      // Select a member by name
+				INDEX,     // Select an element by index
+				WILDCARD,  // Select all members or elements
+				SLICE,     // Select a range of elements
+				FILTER     // Select the members or elements passing a test
+			};
+
+			Kind kind;
+			std::string name;
+			intmax_t index;
+			intmax_t start;
+			intmax_t end;
+			intmax_t step;
+			bool hasStart;
+			bool hasEnd;
+			size_t filter;
+		};
+
+		// A segment applies its selectors to its input values, or
+		// to its input values and all of their descendants.
+		struct Segment
+		{
+			bool isDescendant;
+			std::vector< Selector > selectors;
+		};
+
+		// A node of a compiled filter expression
+		struct Expression
+		{
+			enum class Operation
+			{
+				OR,             // left || right
+				AND,            // left && right
+				NOT,            // !left
+				EQUAL,          // left == right
+				NOT_EQUAL,      // left != right
+				LESS,           // left < right
+				LESS_EQUAL,     // left <= right
+				GREATER,        // left > right
+				GREATER_EQUAL,  // left >= right
+				EXISTS,         // The query yields at least one value
+				QUERY,          // Operand: the value yielded by a singular query
+				LITERAL         // Operand: a literal value
+			};
+
+			Operation operation;
+			size_t left;
+			size_t right;
+			bool isRooted;
+			std::vector< Segment > segments;
+			size_t literal;
+		};
+
+		std::string mQuery;
+		std::vector< Segment > mSegments;
+		std::vector< Expression > mExpressions;
+		ArrayType mLiterals;
+		bool mUsesRoot;
+
+		// Cursor over the query string used during compilation
+		struct Compiler
+		{
+			const std::string& query;
+			size_t offset;
+
+			[[noreturn]] void fail( const char* const reason ) const
+			{
+				throw std::invalid_argument( std::string( "JSONPath: " ) + reason
+					+ " at offset " + std::to_string( offset ) + " of '" + query + "'" );
+			}
+
+			bool atEnd() const noexcept
+			{
+				return query.length() <= offset;
+			}
+
+			char peek( size_t lookAhead = 0 ) const noexcept
+			{
+				return ( offset + lookAhead < query.length() ) ? query[ offset + lookAhead ] : '\0';
+			}
+
+			void skipWhitespace() noexcept
+			{
+				while ( ( not atEnd() ) and ( nullptr != strchr( " \t\r\n", peek() ) ) )
+				{
+					++offset;
+				}
+			}
+
+			bool consume( const char* const token ) noexcept
+			{
+				size_t length = strlen( token );
+				if ( 0 == query.compare( offset, length, token ) )
+				{
+					offset += length;
+					return true;
+				}
+
+				return false;
+			}
+		};
+
+		// Check if the character may appear in a dot notation member name, which RFC 9535
+		// limits to letters, digits, '_' and non-ASCII characters, not starting with a digit.
+		// Other names, e.g. those holding a '-', must be written as ['name'].
+		static bool _isNameCharacter( char character, bool isFirst ) noexcept
+		{
+			unsigned char byte = static_cast< unsigned char >( character );
+			return ( 0x80 <= byte ) or isalpha( byte ) or ( '_' == character )
+				or ( ( not isFirst ) and isdigit( byte ) );
+		}
+
+		// Value of a hexadecimal digit
+		static uint32_t _hexValue( char digit ) noexcept
+		{
+			return uint32_t( isdigit( static_cast< unsigned char >( digit ) ) ? ( digit - '0' ) : ( ( tolower( digit ) - 'a' ) + 10 ) );
+		}
+
+		// Compile a single or double quoted string literal
+		static std::string _compileString( Compiler& compiler )
+		{
+			const char quote = compiler.peek();
+			std::string string;
+
+			++compiler.offset;
+			while ( quote != compiler.peek() )
+			{
+				if ( compiler.atEnd() )
+				{
+					compiler.fail( "unterminated string literal" );
+				}
+
+				char character = compiler.peek();
+				++compiler.offset;
+
+				if ( '\\' != character )
+				{
+					string.push_back( character );
+					continue;
+				}
+
+				character = compiler.peek();
+				++compiler.offset;
+
+				switch ( character )
+				{
+				case 'b': string.push_back( '\b' ); break;
+				case 'f': string.push_back( '\f' ); break;
+				case 'n': string.push_back( '\n' ); break;
+				case 'r': string.push_back( '\r' ); break;
+				case 't': string.push_back( '\t' ); break;
+				case '/':
+				case '\\':
+				case '\'':
+				case '"':
+					string.push_back( character );
+					break;
+
+				case 'u':
+				{
+					uint32_t codePoint = 0;
+					for ( size_t digit( 0 ); digit < 4; ++digit, ++compiler.offset )
+					{
+						if ( not isxdigit( static_cast< unsigned char >( compiler.peek() ) ) )
+						{
+							compiler.fail( "invalid unicode escape" );
+						}
+
+						codePoint = ( codePoint << 4 ) | _hexValue( compiler.peek() );
+					}
+
+					// Combine a surrogate pair into a single code point.
+					if ( ( 0xD800 <= codePoint ) and ( codePoint < 0xDC00 ) and compiler.consume( "\\u" ) )
+					{
+						uint32_t lowSurrogate = 0;
+						for ( size_t digit( 0 ); digit < 4; ++digit, ++compiler.offset )
+						{
+							if ( not isxdigit( static_cast< unsigned char >( compiler.peek() ) ) )
+							{
+								compiler.fail( "invalid unicode escape" );
+							}
+
+							lowSurrogate = ( lowSurrogate << 4 ) | _hexValue( compiler.peek() );
+						}
+
+						codePoint = 0x10000 + ( ( codePoint - 0xD800 ) << 10 ) + ( lowSurrogate - 0xDC00 );
+					}
+
+					char encoded[ 4 ];
+					string.append( encoded, _encodeUTF8( encoded, 0, codePoint ) );
+					break;
+				}
+
+				default:
+					compiler.fail( "invalid escape sequence" );
+				}
+			}
+
+			++compiler.offset;
+			return string;
+		}
+
+		// Compile an optionally signed integer
+		static bool _compileInteger( Compiler& compiler, intmax_t& integer )
+		{
+			size_t begin = compiler.offset;
+			if ( '-' == compiler.peek() )
+			{
+				++compiler.offset;
+			}
+
+			if ( not isdigit( static_cast< unsigned char >( compiler.peek() ) ) )
+			{
+				compiler.offset = begin;
+				return false;
+			}
+
+			while ( isdigit( static_cast< unsigned char >( compiler.peek() ) ) )
+			{
+				++compiler.offset;
+			}
+
+			try
+			{
+				integer = intmax_t( std::stoll( compiler.query.substr( begin, compiler.offset - begin ) ) );
+			}
+			catch ( const std::out_of_range& )
+			{
+				compiler.fail( "integer out of range" );
+			}
+
+			return true;
+		}
+
+		// Create a selector of the given kind
+		static Selector _makeSelector( Selector::Kind kind )
+		{
+			Selector selector;
+			selector.kind = kind;
+			selector.index = 0;
+			selector.start = 0;
+			selector.end = 0;
+			selector.step = 1;
+			selector.hasStart = false;
+			selector.hasEnd = false;
+			selector.filter = 0;
+			return selector;
+		}
+
+		// Compile a single selector within brackets
+		Selector _compileSelector( Compiler& compiler )
+		{
+			Selector selector = _makeSelector( Selector::Kind::INDEX );
+
+			compiler.skipWhitespace();
+			char next = compiler.peek();
+
+			if ( ( '\'' == next ) or ( '"' == next ) )
+			{
+				selector.kind = Selector::Kind::NAME;
+				selector.name = _compileString( compiler );
+			}
+			else if ( '*' == next )
+			{
+				selector.kind = Selector::Kind::WILDCARD;
+				++compiler.offset;
+			}
+			else if ( '?' == next )
+			{
+				selector.kind = Selector::Kind::FILTER;
+				++compiler.offset;
+				selector.filter = _compileOr( compiler );
+			}
+			else
+			{
+				intmax_t integer = 0;
+				bool hasInteger = _compileInteger( compiler, integer );
+				compiler.skipWhitespace();
+
+				if ( ':' != compiler.peek() )
+				{
+					if ( not hasInteger )
+					{
+						compiler.fail( "expected a selector" );
+					}
+
+					selector.index = integer;
+					return selector;
+				}
+
+				selector.kind = Selector::Kind::SLICE;
+				selector.hasStart = hasInteger;
+				selector.start = integer;
+
+				++compiler.offset;
+				compiler.skipWhitespace();
+				selector.hasEnd = _compileInteger( compiler, selector.end );
+				compiler.skipWhitespace();
+
+				if ( ':' == compiler.peek() )
+				{
+					++compiler.offset;
+					compiler.skipWhitespace();
+					if ( not _compileInteger( compiler, selector.step ) )
+					{
+						selector.step = 1;
+					}
+				}
+			}
+
+			return selector;
+		}
+
+		// Compile the segments of a query, stopping at the first character
+		// which cannot continue the query.
+		std::vector< Segment > _compileSegments( Compiler& compiler )
+		{
+			std::vector< Segment > segments;
+
+			while ( true )
+			{
+				compiler.skipWhitespace();
+
+				Segment segment;
+				segment.isDescendant = compiler.consume( ".." );
+
+				if ( segment.isDescendant or ( '.' == compiler.peek() ) )
+				{
+					if ( not segment.isDescendant )
+					{
+						++compiler.offset;
+					}
+
+					if ( '*' == compiler.peek() )
+					{
+						++compiler.offset;
+						segment.selectors.push_back( _makeSelector( Selector::Kind::WILDCARD ) );
+						segments.push_back( std::move( segment ) );
+						continue;
+					}
+
+					if ( not ( segment.isDescendant and ( '[' == compiler.peek() ) ) )
+					{
+						size_t begin = compiler.offset;
+						while ( _isNameCharacter( compiler.peek(), begin == compiler.offset ) and not compiler.atEnd() )
+						{
+							++compiler.offset;
+						}
+
+						if ( begin == compiler.offset )
+						{
+							compiler.fail( "expected a member name" );
+						}
+
+						Selector selector = _makeSelector( Selector::Kind::NAME );
+						selector.name = compiler.query.substr( begin, compiler.offset - begin );
+						segment.selectors.push_back( std::move( selector ) );
+						segments.push_back( std::move( segment ) );
+						continue;
+					}
+				}
+
+				if ( '[' != compiler.peek() )
+				{
+					if ( segment.isDescendant )
+					{
+						compiler.fail( "expected a selector after '..'" );
+					}
+
+					return segments;
+				}
+
+				++compiler.offset;
+				do
+				{
+					segment.selectors.push_back( _compileSelector( compiler ) );
+					compiler.skipWhitespace();
+				}
+				while ( compiler.consume( "," ) );
+
+				if ( not compiler.consume( "]" ) )
+				{
+					compiler.fail( "expected ']'" );
+				}
+
+				segments.push_back( std::move( segment ) );
+			}
+		}
+
+		// Add an expression node and return its position
+		size_t _addExpression( Expression&& expression )
+		{
+			mExpressions.push_back( std::move( expression ) );
+			return mExpressions.size() - 1;
+		}
+
+		// Create an expression node with the given operation and operands
+		static Expression _makeExpression( Expression::Operation operation, size_t left = 0, size_t right = 0 )
+		{
+			Expression expression;
+			expression.operation = operation;
+			expression.left = left;
+			expression.right = right;
+			expression.isRooted = false;
+			expression.literal = 0;
+			return expression;
+		}
+
+		// logical-or-expr = logical-and-expr *( "||" logical-and-expr )
+		size_t _compileOr( Compiler& compiler )
+		{
+			size_t left = _compileAnd( compiler );
+
+			compiler.skipWhitespace();
+			while ( compiler.consume( "||" ) )
+			{
+				size_t right = _compileAnd( compiler );
+				left = _addExpression( _makeExpression( Expression::Operation::OR, left, right ) );
+				compiler.skipWhitespace();
+			}
+
+			return left;
+		}
+
+		// logical-and-expr = basic-expr *( "&&" basic-expr )
+		size_t _compileAnd( Compiler& compiler )
+		{
+			size_t left = _compileBasic( compiler );
+
+			compiler.skipWhitespace();
+			while ( compiler.consume( "&&" ) )
+			{
+				size_t right = _compileBasic( compiler );
+				left = _addExpression( _makeExpression( Expression::Operation::AND, left, right ) );
+				compiler.skipWhitespace();
+			}
+
+			return left;
+		}
+
+		// basic-expr = "!" basic-expr / "(" logical-or-expr ")" / comparison / test
+		size_t _compileBasic( Compiler& compiler )
+		{
+			compiler.skipWhitespace();
+
+			if ( ( '!' == compiler.peek() ) and ( '=' != compiler.peek( 1 ) ) )
+			{
+				++compiler.offset;
+				size_t operand = _compileBasic( compiler );
+				return _addExpression( _makeExpression( Expression::Operation::NOT, operand ) );
+			}
+
+			if ( '(' == compiler.peek() )
+			{
+				++compiler.offset;
+				size_t inner = _compileOr( compiler );
+				compiler.skipWhitespace();
+				if ( not compiler.consume( ")" ) )
+				{
+					compiler.fail( "expected ')'" );
+				}
+
+				return inner;
+			}
+
+			size_t left = _compileOperand( compiler );
+			compiler.skipWhitespace();
+
+			static const std::pair< const char*, Expression::Operation > COMPARISONS[]
+			{
+				{ "==", Expression::Operation::EQUAL         },
+				{ "!=", Expression::Operation::NOT_EQUAL     },
+				{ "<=", Expression::Operation::LESS_EQUAL    },
+				{ ">=", Expression::Operation::GREATER_EQUAL },
+				{ "<",  Expression::Operation::LESS          },
+				{ ">",  Expression::Operation::GREATER       }
+			};
+
+			for ( const auto& comparison : COMPARISONS )
+			{
+				if ( compiler.consume( comparison.first ) )
+				{
+					size_t right = _compileOperand( compiler );
+					for ( size_t operand : { left, right } )
+					{
+						if ( ( Expression::Operation::QUERY == mExpressions[ operand ].operation )
+							and ( not _isSingular( mExpressions[ operand ].segments ) ) )
+						{
+							compiler.fail( "comparisons require a singular query" );
+						}
+					}
+
+					return _addExpression( _makeExpression( comparison.second, left, right ) );
+				}
+			}
+
+			if ( Expression::Operation::QUERY != mExpressions[ left ].operation )
+			{
+				compiler.fail( "a literal is not a test expression" );
+			}
+
+			mExpressions[ left ].operation = Expression::Operation::EXISTS;
+			return left;
+		}
+
+		// comparable = literal / "@" segments / "$" segments
+		size_t _compileOperand( Compiler& compiler )
+		{
+			compiler.skipWhitespace();
+			char next = compiler.peek();
+
+			if ( ( '@' == next ) or ( '$' == next ) )
+			{
+				++compiler.offset;
+				Expression query = _makeExpression( Expression::Operation::QUERY );
+				query.isRooted = ( '$' == next );
+				query.segments = _compileSegments( compiler );
+				mUsesRoot = mUsesRoot or query.isRooted;
+				return _addExpression( std::move( query ) );
+			}
+
+			Expression literal = _makeExpression( Expression::Operation::LITERAL );
+			literal.literal = mLiterals.size();
+
+			if ( ( '\'' == next ) or ( '"' == next ) )
+			{
+				mLiterals.emplace_back( _compileString( compiler ) );
+			}
+			else if ( compiler.consume( "true" ) )
+			{
+				mLiterals.emplace_back( true );
+			}
+			else if ( compiler.consume( "false" ) )
+			{
+				mLiterals.emplace_back( false );
+			}
+			else if ( compiler.consume( "null" ) )
+			{
+				mLiterals.emplace_back( nullptr );
+			}
+			else if ( ( '-' == next ) or isdigit( static_cast< unsigned char >( next ) ) )
+			{
+				size_t begin = compiler.offset;
+				while ( ( not compiler.atEnd() ) and ( nullptr != strchr( "+-0123456789.eE", compiler.peek() ) ) )
+				{
+					++compiler.offset;
+				}
+
+				std::string number = compiler.query.substr( begin, compiler.offset - begin );
+				size_t length = 0;
+				try
+				{
+					if ( std::string::npos == number.find_first_of( ".eE" ) )
+					{
+						mLiterals.emplace_back( intmax_t( std::stoll( number, &length ) ) );
+					}
+					else
+					{
+						mLiterals.emplace_back( std::stold( number, &length ) );
+					}
+				}
+				catch ( const std::logic_error& )
+				{
+					compiler.fail( "invalid number literal" );
+				}
+
+				if ( number.size() != length )
+				{
+					compiler.fail( "invalid number literal" );
+				}
+			}
+			else
+			{
+				compiler.fail( "expected a literal or a query" );
+			}
+
+			return _addExpression( std::move( literal ) );
+		}
+
+		// A singular query selects at most one value: only names and indices.
+		static bool _isSingular( const std::vector< Segment >& segments ) noexcept
+		{
+			for ( const auto& segment : segments )
+			{
+				if ( segment.isDescendant or ( 1 != segment.selectors.size() )
+					or ( ( Selector::Kind::NAME != segment.selectors[ 0 ].kind )
+						and ( Selector::Kind::INDEX != segment.selectors[ 0 ].kind ) ) )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		// Resolve a possibly negative index against {@param length}.
+		static bool _normalizeIndex( intmax_t index, size_t length, size_t& absoluteIndex ) noexcept
+		{
+			if ( index < 0 )
+			{
+				if ( size_t( -( index + 1 ) ) >= length )
+				{
+					return false;
+				}
+
+				absoluteIndex = length - size_t( -( index + 1 ) ) - 1;
+				return true;
+			}
+
+			absoluteIndex = size_t( index );
+			return absoluteIndex < length;
+		}
+
+		// Apply a single selector to the children of {@param value}.
+		void _applySelector( const Selector& selector, const JsonValue& value,
+			const JsonValue* root, std::vector< const JsonValue* >& output ) const
+		{
+			switch ( selector.kind )
+			{
+			case Selector::Kind::NAME:
+				if ( Type::object == value.mType )
+				{
+					auto member = value.mMembers.find( selector.name );
+					if ( value.mMembers.end() != member )
+					{
+						output.push_back( &member->second );
+					}
+				}
+				break;
+
+			case Selector::Kind::INDEX:
+				if ( Type::array == value.mType )
+				{
+					size_t index = 0;
+					if ( _normalizeIndex( selector.index, value.mElements.size(), index ) )
+					{
+						output.push_back( &value.mElements[ index ] );
+					}
+				}
+				break;
+
+			case Selector::Kind::WILDCARD:
+			case Selector::Kind::FILTER:
+				if ( Type::object == value.mType )
+				{
+					for ( const auto& member : value.mMembers )
+					{
+						if ( ( Selector::Kind::WILDCARD == selector.kind ) or _test( selector.filter, member.second, root ) )
+						{
+							output.push_back( &member.second );
+						}
+					}
+				}
+				else if ( Type::array == value.mType )
+				{
+					for ( const auto& element : value.mElements )
+					{
+						if ( ( Selector::Kind::WILDCARD == selector.kind ) or _test( selector.filter, element, root ) )
+						{
+							output.push_back( &element );
+						}
+					}
+				}
+				break;
+
+			case Selector::Kind::SLICE:
+				if ( ( Type::array == value.mType ) and ( 0 != selector.step ) )
+				{
+					const intmax_t length = intmax_t( value.mElements.size() );
+					const intmax_t step = selector.step;
+					auto normalize = [ length ]( intmax_t index )
+					{
+						return ( 0 <= index ) ? index : ( length + index );
+					};
+
+					if ( 0 < step )
+					{
+						intmax_t lower = selector.hasStart ? std::min( std::max( normalize( selector.start ), intmax_t( 0 ) ), length ) : 0;
+						intmax_t upper = selector.hasEnd ? std::min( std::max( normalize( selector.end ), intmax_t( 0 ) ), length ) : length;
+						for ( intmax_t index( lower ); index < upper; index += step )
+						{
+							output.push_back( &value.mElements[ size_t( index ) ] );
+						}
+					}
+					else
+					{
+						intmax_t upper = selector.hasStart ? std::min( std::max( normalize( selector.start ), intmax_t( -1 ) ), length - 1 ) : ( length - 1 );
+						intmax_t lower = selector.hasEnd ? std::min( std::max( normalize( selector.end ), intmax_t( -1 ) ), length - 1 ) : -1;
+						for ( intmax_t index( upper ); lower < index; index += step )
+						{
+							output.push_back( &value.mElements[ size_t( index ) ] );
+						}
+					}
+				}
+				break;
+			}
+		}
+
+		// Run {@param segments}, starting at {@param first}, over the values in {@param nodes}.
+		void _evaluate( const std::vector< Segment >& segments, size_t first,
+			std::vector< const JsonValue* >& nodes, const JsonValue* root ) const
+		{
+			std::vector< const JsonValue* > output;
+			std::vector< const JsonValue* > descendants;
+
+			for ( size_t position( first ); position < segments.size(); ++position )
+			{
+				const Segment& segment = segments[ position ];
+				output.clear();
+
+				for ( const JsonValue* node : nodes )
+				{
+					descendants.assign( 1, node );
+
+					while ( not descendants.empty() )
+					{
+						const JsonValue* value = descendants.back();
+						descendants.pop_back();
+
+						for ( const auto& selector : segment.selectors )
+						{
+							_applySelector( selector, *value, root, output );
+						}
+
+						if ( not segment.isDescendant )
+						{
+							continue;
+						}
+
+						// Push the children in reverse so they are visited in document order.
+						if ( Type::object == value->mType )
+						{
+							for ( auto member = value->mMembers.rbegin(); member != value->mMembers.rend(); ++member )
+							{
+								descendants.push_back( &member->second );
+							}
+						}
+						else if ( Type::array == value->mType )
+						{
+							for ( auto element = value->mElements.rbegin(); element != value->mElements.rend(); ++element )
+							{
+								descendants.push_back( &*element );
+							}
+						}
+					}
+				}
+
+				nodes.swap( output );
+			}
+		}
+
+		// Resolve an operand of a comparison, a null pointer represents no value.
+		const JsonValue* _operand( size_t expression, const JsonValue& current, const JsonValue* root ) const
+		{
+			const Expression& operand = mExpressions[ expression ];
+
+			if ( Expression::Operation::LITERAL == operand.operation )
+			{
+				return &mLiterals[ operand.literal ];
+			}
+
+			std::vector< const JsonValue* > nodes( 1, operand.isRooted ? root : &current );
+			_evaluate( operand.segments, 0, nodes, root );
+			return nodes.empty() ? nullptr : nodes.front();
+		}
+
+		// Compare two operands for equality, where a null pointer represents no value.
+		static bool _equal( const JsonValue* left, const JsonValue* right ) noexcept
+		{
+			if ( ( nullptr == left ) or ( nullptr == right ) )
+			{
+				return left == right;
+			}
+
+			if ( ( Type::number == left->mType ) and ( Type::number == right->mType ) )
+			{
+				return 0 == _compareNumbers( *left, *right );
+			}
+
+			return *left == *right;
+		}
+
+		// Order two operands, only numbers and strings are ordered.
+		static bool _less( const JsonValue* left, const JsonValue* right ) noexcept
+		{
+			if ( ( nullptr == left ) or ( nullptr == right ) or ( left->mType != right->mType ) )
+			{
+				return false;
+			}
+
+			if ( Type::number == left->mType )
+			{
+				return _compareNumbers( *left, *right ) < 0;
+			}
+
+			if ( Type::string == left->mType )
+			{
+				return left->mStringValue < right->mStringValue;
+			}
+
+			return false;
+		}
+
+		// Evaluate a filter expression with {@param current} as '@'.
+		bool _test( size_t expression, const JsonValue& current, const JsonValue* root ) const
+		{
+			const Expression& node = mExpressions[ expression ];
+
+			switch ( node.operation )
+			{
+			case Expression::Operation::OR:
+				return _test( node.left, current, root ) or _test( node.right, current, root );
+
+			case Expression::Operation::AND:
+				return _test( node.left, current, root ) and _test( node.right, current, root );
+
+			case Expression::Operation::NOT:
+				return not _test( node.left, current, root );
+
+			case Expression::Operation::EXISTS:
+			{
+				std::vector< const JsonValue* > nodes( 1, node.isRooted ? root : &current );
+				_evaluate( node.segments, 0, nodes, root );
+				return not nodes.empty();
+			}
+
+			case Expression::Operation::EQUAL:
+				return _equal( _operand( node.left, current, root ), _operand( node.right, current, root ) );
+
+			case Expression::Operation::NOT_EQUAL:
+				return not _equal( _operand( node.left, current, root ), _operand( node.right, current, root ) );
+
+			case Expression::Operation::LESS:
+				return _less( _operand( node.left, current, root ), _operand( node.right, current, root ) );
+
+			case Expression::Operation::LESS_EQUAL:
+			{
+				const JsonValue* left = _operand( node.left, current, root );
+				const JsonValue* right = _operand( node.right, current, root );
+				return _less( left, right ) or _equal( left, right );
+			}
+
+			case Expression::Operation::GREATER:
+				return _less( _operand( node.right, current, root ), _operand( node.left, current, root ) );
+
+			case Expression::Operation::GREATER_EQUAL:
+			{
+				const JsonValue* left = _operand( node.left, current, root );
+				const JsonValue* right = _operand( node.right, current, root );
+				return _less( right, left ) or _equal( left, right );
+			}
+
+			default:
+				return false;
+			}
+		}
+
+		// Check if a segment can be matched against children one at a time,
+		// without knowing the length of the array or the complete child.
+		static bool _isStreamable( const Segment& segment ) noexcept
+		{
+			for ( const auto& selector : segment.selectors )
+			{
+				if ( ( Selector::Kind::FILTER == selector.kind )
+					or ( ( Selector::Kind::INDEX == selector.kind ) and ( selector.index < 0 ) )
+					or ( ( Selector::Kind::SLICE == selector.kind )
+						and ( ( selector.step <= 0 ) or ( selector.hasStart and ( selector.start < 0 ) )
+							or ( selector.hasEnd and ( selector.end < 0 ) ) ) ) )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		// Check if a streamable segment selects the member {@param key}.
+		static bool _selectsMember( const Segment& segment, const std::string& key ) noexcept
+		{
+			for ( const auto& selector : segment.selectors )
+			{
+				if ( ( Selector::Kind::WILDCARD == selector.kind )
+					or ( ( Selector::Kind::NAME == selector.kind ) and ( key == selector.name ) ) )
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// Check if a streamable segment selects the element at {@param index}.
+		static bool _selectsElement( const Segment& segment, size_t index ) noexcept
+		{
+			for ( const auto& selector : segment.selectors )
+			{
+				switch ( selector.kind )
+				{
+				case Selector::Kind::WILDCARD:
+					return true;
+
+				case Selector::Kind::INDEX:
+					if ( size_t( selector.index ) == index )
+					{
+						return true;
+					}
+					break;
+
+				case Selector::Kind::SLICE:
+				{
+					size_t start = selector.hasStart ? size_t( selector.start ) : 0;
+					if ( ( start <= index ) and ( ( not selector.hasEnd ) or ( index < size_t( selector.end ) ) )
+						and ( 0 == ( ( index - start ) % size_t( selector.step ) ) ) )
+					{
+						return true;
+					}
+					break;
+				}
+
+				default:
+					break;
+				}
+			}
+
+			return false;
+		}
+
+		// Positions reached by a child, given the positions of its parent.
+		template < typename MatchFunction >
+		void _advance( const std::vector< size_t >& positions, std::vector< size_t >& childPositions, MatchFunction matches ) const
+		{
+			childPositions.clear();
+
+			for ( size_t position : positions )
+			{
+				const Segment& segment = mSegments[ position ];
+
+				if ( matches( segment ) )
+				{
+					childPositions.push_back( position + 1 );
+				}
+
+				if ( segment.isDescendant )
+				{
+					childPositions.push_back( position );
+				}
+			}
+
+			std::sort( childPositions.begin(), childPositions.end() );
+			childPositions.erase( std::unique( childPositions.begin(), childPositions.end() ), childPositions.end() );
+		}
+
+		// Run the plan over the value at the current read position of {@param source},
+		// which was reached at the given plan positions.
+		void _stream( ParseSource& source, const std::vector< size_t >& positions, const Callback& callback ) const
+		{
+			_parseWhitespace( source );
+
+			if ( positions.empty() )
+			{
+				_skipValue( source );
+				return;
+			}
+
+			bool isContainer = ( '{' == source.peek() ) or ( '[' == source.peek() );
+			bool mustBuild = not isContainer;
+			for ( size_t position : positions )
+			{
+				mustBuild = mustBuild or ( mSegments.size() == position ) or not _isStreamable( mSegments[ position ] );
+			}
+
+			if ( mustBuild )
+			{
+				JsonValue value;
+				value._parseValue( source );
+
+				if ( ( 1 == positions.size() ) and ( mSegments.size() == positions[ 0 ] ) )
+				{
+					callback( std::move( value ) );
+					return;
+				}
+
+				for ( size_t position : positions )
+				{
+					std::vector< const JsonValue* > nodes( 1, &value );
+					_evaluate( mSegments, position, nodes, nullptr );
+					for ( const JsonValue* node : nodes )
+					{
+						callback( JsonValue( *node ) );
+					}
+				}
+
+				return;
+			}
+
+			std::vector< size_t > childPositions;
+
+			if ( '{' == source.peek() )
+			{
+				source.update();
+				_parseWhitespace( source );
+
+				while ( ( not source.endOfSource() ) and ( '}' != source.peek() ) )
+				{
+					JsonValue key;
+					key._parseString( source );
+					_parseWhitespace( source );
+
+					if ( ':' != source.peek() )
+					{
+						throw ParseError( "selectPath", source );
+					}
+
+					source.update();
+					_advance( positions, childPositions, [ &key ]( const Segment& segment )
+					{
+						return _selectsMember( segment, key.mStringValue );
+					} );
+					_stream( source, childPositions, callback );
+					_parseWhitespace( source );
+
+					if ( ',' == source.peek() )
+					{
+						source.update();
+						_parseWhitespace( source );
+					}
+					else if ( '}' != source.peek() )
+					{
+						throw ParseError( "selectPath", source );
+					}
+				}
+
+				if ( '}' != source.peek() )
+				{
+					throw ParseError( "selectPath", source );
+				}
+			}
+			else
+			{
+				source.update();
+				_parseWhitespace( source );
+
+				for ( size_t index( 0 ); ( not source.endOfSource() ) and ( ']' != source.peek() ); ++index )
+				{
+					_advance( positions, childPositions, [ index ]( const Segment& segment )
+					{
+						return _selectsElement( segment, index );
+					} );
+					_stream( source, childPositions, callback );
+					_parseWhitespace( source );
+
+					if ( ',' == source.peek() )
+					{
+						source.update();
+						_parseWhitespace( source );
+					}
+					else if ( ']' != source.peek() )
+					{
+						throw ParseError( "selectPath", source );
+					}
+				}
+
+				if ( ']' != source.peek() )
+				{
+					throw ParseError( "selectPath", source );
+				}
+			}
+
+			source.update();
+			_parseWhitespace( source );
+		}
+
+		// Run the plan over a whole source
+		void _streamSource( ParseSource& source, const Callback& callback ) const
+		{
+			if ( mUsesRoot )
+			{
+				throw std::invalid_argument( "JSONPath filters referring to '$' cannot be streamed: " + mQuery );
+			}
+
+			std::vector< size_t > positions( 1, 0 );
+			_stream( source, positions, callback );
+			_parseEndOfSource( source );
+		}
+
+	public:
+		/**
+		 * Compile a JSONPath query into an execution plan.
+		 * @param query Const reference to the query string, e.g. "$.store.book[?(@.price < 10)].title".
+		 * @throw std::invalid_argument is thrown if the query is malformed.
+		 */
+		Path( const std::string& query ) :
+			mQuery( query ),
+			mUsesRoot( false )
+		{
+			Compiler compiler { mQuery, 0 };
+			compiler.skipWhitespace();
+
+			if ( not compiler.consume( "$" ) )
+			{
+				compiler.fail( "a query must begin with '$'" );
+			}
+
+			mSegments = _compileSegments( compiler );
+			compiler.skipWhitespace();
+
+			if ( not compiler.atEnd() )
+			{
+				compiler.fail( "unexpected character" );
+			}
+		}
+
+		/**
+		 * Select the values matched by this query from a document.
+		 * @param document Reference to the JsonValue to run the query against.
+		 * @return Pointers to the matched values, in the order defined by RFC 9535.
+		 */
+		std::vector< JsonValue* > select( JsonValue& document ) const
+		{
+			std::vector< const JsonValue* > nodes( 1, &document );
+			_evaluate( mSegments, 0, nodes, &document );
+
+			std::vector< JsonValue* > matches;
+			matches.reserve( nodes.size() );
+			for ( const JsonValue* node : nodes )
+			{
+				matches.push_back( const_cast< JsonValue* >( node ) );
+			}
+
+			return matches;
+		}
+
+		/**
+		 * Select the values matched by this query from a document.
+		 * @param document Const reference to the JsonValue to run the query against.
+		 * @return Const pointers to the matched values, in the order defined by RFC 9535.
+		 */
+		std::vector< const JsonValue* > select( const JsonValue& document ) const
+		{
+			std::vector< const JsonValue* > nodes( 1, &document );
+			_evaluate( mSegments, 0, nodes, &document );
+			return nodes;
+		}
+
+		/**
+		 * Select the values matched by this query directly from JSON text,
+		 * without building a JsonValue for the unmatched parts of the document.
+		 * @param jsonString A string object containing the JSON to be queried.
+		 * @param callback Function receiving each matched value.
+		 * @throw ParseError is thrown if there is a parsing error.
+		 * @throw std::invalid_argument is thrown if a filter refers to the root '$'.
+		 */
+		void select( const std::string& jsonString, const Callback& callback ) const
+		{
+			ParseSource source( jsonString );
+			_streamSource( source, callback );
+		}
+
+		/**
+		 * Select the values matched by this query directly from a FILE,
+		 * without building a JsonValue for the unmatched parts of the document.
+		 * @param jsonFile A pointer to a FILE object from whence to read the JSON.
+		 * @param callback Function receiving each matched value.
+		 * @throw ParseError is thrown if there is a parsing error.
+		 * @throw std::invalid_argument is thrown if a filter refers to the root '$'.
+		 */
+		void select( FILE* jsonFile, const Callback& callback ) const
+		{
+			ParseSource source( jsonFile );
+			_streamSource( source, callback );
+		}
+
+		/**
+		 * Select the values matched by this query directly from a std::ifstream,
+		 * without building a JsonValue for the unmatched parts of the document.
+		 * @param jsonIFStream A reference to the std::ifstream from whence to read the JSON.
+		 * @param callback Function receiving each matched value.
+		 * @throw ParseError is thrown if there is a parsing error.
+		 * @throw std::invalid_argument is thrown if a filter refers to the root '$'.
+		 */
+		void select( std::ifstream& jsonIFStream, const Callback& callback ) const
+		{
+			ParseSource source( jsonIFStream );
+			_streamSource( source, callback );
+		}
+
+		/**
+		 * Retrieve the query this plan was compiled from.
+		 * @return Const reference to the query string.
+		 */
+		const std::string& toString() const noexcept
+		{
+			return mQuery;
+		}
+	};
+
+	/**
+	 * Secondary hash index over an array of objects, keyed by the value a JSON
+	 * Pointer refers to within each element, e.g. the "/id" of each record.
+	 * Lookups hash the key once and compare only the elements in its bucket,
+	 * rather than scanning every element of the array.
+	 * Note(s):
+	 *    - The index follows the array when the array is moved, and is kept up to
+	 *      date by push_back(), insert(), erase() and pop_back() of the array, and by
+	 *      applyPatch() for the elements a patch adds, removes or replaces.
+	 *    - Changes made through references to elements, e.g. by operator[] or by
+	 *      sorting the elements, are not tracked. Call rebuild() afterwards.
+	 *    - The index is detached when the array is cleared, reassigned or
+	 *      destroyed, after which lookups find nothing.
+	 */
+	class Index
+	{
+	private:
+		friend class JsonValue;
+
+		JsonValue* mArray;
+		Pointer mField;
+		std::unordered_multimap< size_t, size_t > mPositions;
+		Index* mNext;
+
+		// Add the element at {@param position} to the index, if it holds the field.
+		void _insert( size_t position )
+		{
+			const JsonValue* key = mField.get( mArray->mElements[ position ] );
+			if ( nullptr != key )
+			{
+				mPositions.emplace( key->hash(), position );
+			}
+		}
+
+		// Shift every position at or after {@param position} by {@param offset},
+		// dropping the entry for {@param erased} if one is given.
+		void _shift( size_t position, ptrdiff_t offset, const size_t* erased ) noexcept
+		{
+			for ( auto entry = mPositions.begin(); mPositions.end() != entry; )
+			{
+				if ( ( nullptr != erased ) and ( *erased == entry->second ) )
+				{
+					entry = mPositions.erase( entry );
+					continue;
+				}
+
+				if ( position <= entry->second )
+				{
+					entry->second += offset;
+				}
+
+				++entry;
+			}
+		}
+
+		// Unlink this index from the array it is attached to.
+		void _detach() noexcept
+		{
+			if ( nullptr == mArray )
+			{
+				return;
+			}
+
+			Index** link = &mArray->mIndexes;
+			while ( this != *link )
+			{
+				link = &( *link )->mNext;
+			}
+
+			*link = mNext;
+			mArray = nullptr;
+			mNext = nullptr;
+			mPositions.clear();
+		}
+
+	public:
+		/**
+		 * Build an index over the elements of an array.
+		 * @param array Reference to the array type JsonValue to index.
+		 * @param field Pointer to the key within each element. Elements in
+		 *              which the pointer does not resolve are not indexed.
+		 * @throw std::runtime_error is thrown if the JsonValue is not an array.
+		 */
+		Index( JsonValue& array, const Pointer& field ) :
+			mArray( nullptr ),
+			mField( field ),
+			mNext( nullptr )
+		{
+			if ( Type::array != array.mType )
+			{
+				throw std::runtime_error( "Cannot build an index over non-array type: " + array._getTypeString() );
+			}
+
+			mArray = &array;
+			rebuild();
+			mNext = std::exchange( array.mIndexes, this );
+		}
+
+		/**
+		 * Move constructor, the index is taken over from other.
+		 * @param other R-Value of the Index to move.
+		 */
+		Index( Index&& other ) noexcept :
+			mArray( nullptr ),
+			mField( std::move( other.mField ) ),
+			mPositions( std::move( other.mPositions ) ),
+			mNext( nullptr )
+		{
+			if ( nullptr != other.mArray )
+			{
+				Index** link = &other.mArray->mIndexes;
+				while ( &other != *link )
+				{
+					link = &( *link )->mNext;
+				}
+
+				*link = this;
+				mArray = std::exchange( other.mArray, nullptr );
+				mNext = std::exchange( other.mNext, nullptr );
+			}
+		}
+
+		Index( const Index& ) = delete;
+		Index& operator=( const Index& ) = delete;
+		Index& operator=( Index&& ) = delete;
+
+		/**
+		 * Destructor, detaches the index from the array.
+		 */
+		~Index()
+		{
+			_detach();
+		}
+
+		/**
+		 * Check if the index is still attached to an array.
+		 * @return True is returned if the index is attached, else false.
+		 */
+		bool attached() const noexcept
+		{
+			return nullptr != mArray;
+		}
+
+		/**
+		 * Retrieve the pointer to the indexed field.
+		 * @return Const reference to the Pointer.
+		 */
+		const Pointer& field() const noexcept
+		{
+			return mField;
+		}
+
+		/**
+		 * Find the first element whose field equals the given key.
+		 * Numbers compare by value, regardless of their representation.
+		 * @param key Const reference to the key to look up.
+		 * @return Pointer to the element is returned, or a null pointer if there is none.
+		 */
+		JsonValue* find( const JsonValue& key ) noexcept
+		{
+			return const_cast< JsonValue* >( static_cast< const Index* >( this )->find( key ) );
+		}
+
+		/**
+		 * Find the first element whose field equals the given key.
+		 * Numbers compare by value, regardless of their representation.
+		 * @param key Const reference to the key to look up.
+		 * @return Const pointer to the element is returned, or a null pointer if there is none.
+		 */
+		const JsonValue* find( const JsonValue& key ) const noexcept
+		{
+			const JsonValue* first = nullptr;
+
+			if ( nullptr != mArray )
+			{
+				auto bucket = mPositions.equal_range( key.hash() );
+				for ( auto entry = bucket.first; bucket.second != entry; ++entry )
+				{
+					const JsonValue* element = _match( entry->second, key );
+					if ( ( nullptr != element ) and ( ( nullptr == first ) or ( element < first ) ) )
+					{
+						first = element;
+					}
+				}
+			}
+
+			return first;
+		}
+
+		/**
+		 * Find every element whose field equals the given key.
+		 * Numbers compare by value, regardless of their representation.
+		 * @param key Const reference to the key to look up.
+		 * @return Pointers to the elements, in array order.
+		 */
+		std::vector< JsonValue* > findAll( const JsonValue& key )
+		{
+			return _findAll< JsonValue >( key );
+		}
+
+		/**
+		 * Find every element whose field equals the given key.
+		 * Numbers compare by value, regardless of their representation.
+		 * @param key Const reference to the key to look up.
+		 * @return Const pointers to the elements, in array order.
+		 */
+		std::vector< const JsonValue* > findAll( const JsonValue& key ) const
+		{
+			return _findAll< const JsonValue >( key );
+		}
+
+		/**
+		 * Rebuild the index from the current elements of the array, after they
+		 * have been changed through references.
+		 */
+		void rebuild()
+		{
+			if ( nullptr == mArray )
+			{
+				return;
+			}
+
+			mPositions.clear();
+			mPositions.reserve( mArray->mElements.size() );
+
+			for ( size_t position( 0 ); position < mArray->mElements.size(); ++position )
+			{
+				_insert( position );
+			}
+		}
+
+		/**
+		 * Retrieve the number of indexed elements.
+		 * @return The number of elements holding the field.
+		 */
+		size_t size() const noexcept
+		{
+			return mPositions.size();
+		}
+
+	private:
+		// Shared implementation of the findAll() overloads
+		template < typename Element >
+		std::vector< Element* > _findAll( const JsonValue& key ) const
+		{
+			std::vector< Element* > elements;
+
+			if ( nullptr != mArray )
+			{
+				auto bucket = mPositions.equal_range( key.hash() );
+				for ( auto entry = bucket.first; bucket.second != entry; ++entry )
+				{
+					Element* element = _match( entry->second, key );
+					if ( nullptr != element )
+					{
+						elements.push_back( element );
+					}
+				}
+
+				std::sort( elements.begin(), elements.end() );
+			}
+
+			return elements;
+		}
+
+		// Resolve {@param position} to its element if the field still equals {@param key}.
+		JsonValue* _match( size_t position, const JsonValue& key ) const noexcept
+		{
+			if ( mArray->mElements.size() <= position )
+			{
+				return nullptr;
+			}
+
+			JsonValue* element = &mArray->mElements[ position ];
+			const JsonValue* field = mField.get( *element );
+			return ( ( nullptr != field ) and _equivalent( *field, key ) ) ? element : nullptr;
+		}
+	};
+
+	/**
+	 * Journal of the changes made to a document through it, published as JSON Patches.
+	 * Reference: https://www.rfc-editor.org/rfc/rfc6902
+	 * Changes are made through References, handed out by member key and element position,
+	 * and each is recorded as the patch operation that repeats it: assignment as add or
+	 * replace, push_back() and insert() as add, and erase() and pop_back() as remove.
+	 * drain() returns the operations recorded since it was last called as a patch, so a
+	 * copy of the document patched with each in turn keeps up with the document.
+	 * Note(s):
+	 *    - Only changes made through the journal are recorded. A change made to the document
+	 *      directly is missed, and leaves the patches to come out of step with it.
+	 *    - An entry holds its operation, the escaped pointer to where it applies and a copy
+	 *      of the value it adds. An assignment to where the entry before it applied updates
+	 *      the value of that entry rather than adding another.
+	 *    - A Reference is invalidated by whatever invalidates a reference to the value it
+	 *      refers to, e.g. adding an element to the array holding it.
+	 *    - Elements are reached only at positions that exist. Arrays grow by push_back() and
+	 *      insert(), rather than by indexing past their end.
+	 */
+	class Journal
+	{
+	private:
+		friend class JsonValue;
+
+		// An operation recorded in the journal
+		struct Entry
+		{
+			ePatchOperation operation;
+			std::string path;
+			size_t value;  // Position in mValues of the value the operation adds, if it adds one
+		};
+
+		JsonValue* mDocument;
+		std::vector< Entry > mEntries;
+		ArrayType mValues;
+
+		// Record {@param operation} at {@param path}, with a copy of the {@param value} it adds
+		void _record( ePatchOperation operation, const std::string& path, const JsonValue* value )
+		{
+			if ( ( ePatchOperation::REPLACE == operation ) and not mEntries.empty()
+				and ( ePatchOperation::REMOVE != mEntries.back().operation ) and ( mEntries.back().path == path ) )
+			{
+				mValues[ mEntries.back().value ] = *value;
+				return;
+			}
+
+			mEntries.push_back( Entry { operation, path, mValues.size() } );
+			if ( nullptr != value )
+			{
+				mValues.push_back( *value );
+			}
+		}
+
+	public:
+		/**
+		 * Reference to a value within a journaled document, through which changes to the
+		 * value are made and recorded.
+		 */
+		class Reference
+		{
+		private:
+			friend class Journal;
+
+			Journal* mJournal;
+			JsonValue* mValue;   // The value, or nullptr for a member that does not exist yet
+			JsonValue* mObject;  // The object holding the member, or nullptr for an element or the document
+			std::string mKey;    // Key of the member within mObject
+			std::string mPath;
+
+			Reference( Journal& journal, JsonValue* value, std::string&& path ) :
+				mJournal( &journal ),
+				mValue( value ),
+				mObject( nullptr ),
+				mKey(),
+				mPath( std::move( path ) )
+			{
+			}
+
+			Reference( Journal& journal, JsonValue& object, const std::string& key, std::string&& path ) :
+				mJournal( &journal ),
+				mValue( nullptr ),
+				mObject( &object ),
+				mKey( key ),
+				mPath( std::move( path ) )
+			{
+				auto member = object.mMembers.find( key );
+				if ( object.mMembers.end() != member )
+				{
+					mValue = &member->second;
+				}
+			}
+
+			// The value, for the operations other than assignment, which change it in place
+			JsonValue& _getExisting() const
+			{
+				if ( nullptr == mValue )
+				{
+					throw std::runtime_error( "The journaled member '" + mPath + "' does not exist; assign it before changing it in place" );
+				}
+
+				return *mValue;
+			}
+
+		public:
+			Reference( const Reference& ) = default;
+
+			/**
+			 * Assign the value other refers to, recording the assignment.
+			 * @param other Const reference to the Reference whose value to copy.
+			 * @return Reference to this Reference.
+			 */
+			Reference& operator=( const Reference& other )
+			{
+				return *this = JsonValue( other.value() );
+			}
+
+			/**
+			 * Assign a copy of a value, recording the assignment.
+			 * @param value Const reference to the JsonValue to copy.
+			 * @return Reference to this Reference.
+			 */
+			Reference& operator=( const JsonValue& value )
+			{
+				return *this = JsonValue( value );
+			}
+
+			/**
+			 * Assign a value, recording the assignment as an add if it creates the member
+			 * it refers to, else as a replace. An element is always replaced, as it was
+			 * added when it was inserted.
+			 * @param value R-Value of the JsonValue to move.
+			 * @return Reference to this Reference.
+			 */
+			Reference& operator=( JsonValue&& value )
+			{
+				ePatchOperation operation = ePatchOperation::REPLACE;
+				if ( nullptr == mValue )
+				{
+					// Another Reference may have created the member since this one looked.
+					auto member = mObject->mMembers.emplace( mKey, JsonValue() );
+					operation = member.second ? ePatchOperation::ADD : ePatchOperation::REPLACE;
+					mValue = &member.first->second;
+				}
+
+				*mValue = std::move( value );
+				mJournal->_record( operation, mPath, mValue );
+				return *this;
+			}
+
+			/**
+			 * Access a member by key. Unlike JsonValue::operator[], a member that does not
+			 * exist is not created by the access, only by assigning it, so reading through
+			 * a Reference, or failing to, changes neither the document nor the journal.
+			 * @param key Const reference to the key of the member.
+			 * @return Reference to the member.
+			 * @throw std::runtime_error is thrown if the value is not an object.
+			 */
+			Reference operator[]( const std::string& key )
+			{
+				if ( ( nullptr == mValue ) or ( Type::object != mValue->mType ) )
+				{
+					throw std::runtime_error( "Member access 'operator[]( const std::string& )' is not defined for non-object type" );
+				}
+
+				std::string path( mPath );
+				Pointer::_appendToken( path, key );
+				return Reference( *mJournal, *mValue, key, std::move( path ) );
+			}
+
+			/**
+			 * Access an element by position.
+			 * @param index Position of the element, which must exist.
+			 * @return Reference to the element.
+			 * @throw std::runtime_error is thrown if the value is not an array.
+			 * @throw std::out_of_range is thrown if index exceeds the last element of the array.
+			 */
+			template < typename IntegralType,
+				typename = typename std::enable_if< std::is_integral< IntegralType >::value >::type >
+			Reference operator[]( IntegralType index )
+			{
+				if ( ( nullptr == mValue ) or ( Type::array != mValue->mType ) )
+				{
+					throw std::runtime_error( "Integral index access 'operator[]( IntegralType )' is not defined for non-array type" );
+				}
+
+				// A negative index converts to a position past the end.
+				const size_t position = size_t( index );
+				if ( mValue->mElements.size() <= position )
+				{
+					throw std::out_of_range( "Journaled elements must exist; add them by push_back() or insert()." );
+				}
+
+				return Reference( *mJournal, &mValue->mElements[ position ], mPath + "/" + std::to_string( position ) );
+			}
+
+			/**
+			 * Remove the element at a position, recording the removal.
+			 * @param position Position of the element to remove.
+			 * @throw std::runtime_error is thrown if the value is not an array.
+			 * @throw std::out_of_range is thrown if position exceeds the last element of the array.
+			 */
+			void erase( size_t position )
+			{
+				_getExisting().erase( position );
+				mJournal->_record( ePatchOperation::REMOVE, mPath + "/" + std::to_string( position ), nullptr );
+			}
+
+			/**
+			 * Remove the member with a key, recording the removal if there was one.
+			 * @param key Const reference to the key of the member to remove.
+			 * @throw std::runtime_error is thrown if the value is not an object.
+			 */
+			void erase( const std::string& key )
+			{
+				if ( ( nullptr == mValue ) or ( Type::object != mValue->mType ) )
+				{
+					throw std::runtime_error( "Member removal 'erase( const std::string& )' is not defined for non-object type" );
+				}
+
+				if ( 0 != mValue->mMembers.erase( key ) )
+				{
+					std::string path( mPath );
+					Pointer::_appendToken( path, key );
+					mJournal->_record( ePatchOperation::REMOVE, path, nullptr );
+				}
+			}
+
+			/**
+			 * Insert a copy of a value before a position, recording the insertion.
+			 * @param position Position before which to insert, which may be the length of the array.
+			 * @param value Const reference to the JsonValue to insert.
+			 * @throw std::runtime_error is thrown if the value is not an array.
+			 * @throw std::out_of_range is thrown if position exceeds the length of the array.
+			 */
+			void insert( size_t position, const JsonValue& value )
+			{
+				insert( position, JsonValue( value ) );
+			}
+
+			/**
+			 * Insert a value before a position, recording the insertion.
+			 * @param position Position before which to insert, which may be the length of the array.
+			 * @param value R-Value of the JsonValue to insert.
+			 * @throw std::runtime_error is thrown if the value is not an array.
+			 * @throw std::out_of_range is thrown if position exceeds the length of the array.
+			 */
+			void insert( size_t position, JsonValue&& value )
+			{
+				_getExisting().insert( position, std::move( value ) );
+				mJournal->_record( ePatchOperation::ADD, mPath + "/" + std::to_string( position ), &mValue->mElements[ position ] );
+			}
+
+			/**
+			 * Remove the last element, recording the removal.
+			 * @throw std::runtime_error is thrown if the value is not an array.
+			 * @throw std::out_of_range is thrown if the array is empty.
+			 */
+			void pop_back()
+			{
+				_getExisting().pop_back();
+				mJournal->_record( ePatchOperation::REMOVE, mPath + "/" + std::to_string( mValue->mElements.size() ), nullptr );
+			}
+
+			/**
+			 * Append a copy of a value, recording the addition.
+			 * @param value Const reference to the JsonValue to append.
+			 * @throw std::runtime_error is thrown if the value is not an array.
+			 */
+			void push_back( const JsonValue& value )
+			{
+				push_back( JsonValue( value ) );
+			}
+
+			/**
+			 * Append a value, recording the addition.
+			 * @param value R-Value of the JsonValue to append.
+			 * @throw std::runtime_error is thrown if the value is not an array.
+			 */
+			void push_back( JsonValue&& value )
+			{
+				_getExisting().push_back( std::move( value ) );
+				mJournal->_record( ePatchOperation::ADD, mPath + "/" + std::to_string( mValue->mElements.size() - 1 ),
+					&mValue->mElements.back() );
+			}
+
+			/**
+			 * Retrieve the escaped JSON Pointer to the value within the document.
+			 * @return Const reference to the pointer text.
+			 */
+			const std::string& path() const noexcept
+			{
+				return mPath;
+			}
+
+			/**
+			 * Read the value, which is changed only through this Reference.
+			 * @return Const reference to the value, which is undefined for a member that does not exist.
+			 */
+			const JsonValue& value() const noexcept
+			{
+				static const JsonValue UNDEFINED;
+				return ( nullptr == mValue ) ? UNDEFINED : *mValue;
+			}
+		};
+
+		/**
+		 * Start a journal of the changes made to a document through it.
+		 * @param document Reference to the document, which must outlive the journal.
+		 */
+		explicit Journal( JsonValue& document ) :
+			mDocument( &document )
+		{
+		}
+
+		Journal( const Journal& ) = delete;
+		Journal& operator=( const Journal& ) = delete;
+
+		/**
+		 * Access a member of the document by key, see Reference::operator[].
+		 * @param key Const reference to the key of the member.
+		 * @return Reference to the member.
+		 * @throw std::runtime_error is thrown if the document is not an object.
+		 */
+		Reference operator[]( const std::string& key )
+		{
+			return root()[ key ];
+		}
+
+		/**
+		 * Access an element of the document by position, see Reference::operator[].
+		 * @param index Position of the element, which must exist.
+		 * @return Reference to the element.
+		 * @throw std::runtime_error is thrown if the document is not an array.
+		 * @throw std::out_of_range is thrown if index exceeds the last element of the array.
+		 */
+		template < typename IntegralType,
+			typename = typename std::enable_if< std::is_integral< IntegralType >::value >::type >
+		Reference operator[]( IntegralType index )
+		{
+			return root()[ index ];
+		}
+
+		/**
+		 * Take the operations recorded since the last drain, leaving the journal empty.
+		 * @return The JSON Patch of the operations, in the order they were made.
+		 */
+		JsonValue drain()
+		{
+			// Names of the operations, in the order of ePatchOperation.
+			const char* const NAMES[] = { "add", "remove", "replace", "move", "copy", "test" };
+
+			ArrayType operations;
+			operations.reserve( mEntries.size() );
+			for ( Entry& entry : mEntries )
+			{
+				ObjectType members { { "op", JsonValue( std::string( NAMES[ size_t( entry.operation ) ] ) ) },
+					{ "path", JsonValue( std::move( entry.path ) ) } };
+				if ( ePatchOperation::REMOVE != entry.operation )
+				{
+					members.emplace( "value", std::move( mValues[ entry.value ] ) );
+				}
+
+				operations.emplace_back( std::move( members ) );
+			}
+
+			mEntries.clear();
+			mValues.clear();
+			return JsonValue( std::move( operations ) );
+		}
+
+		/**
+		 * Check if no operation has been recorded since the last drain.
+		 * @return True is returned if the journal is empty, else false.
+		 */
+		bool empty() const noexcept
+		{
+			return mEntries.empty();
+		}
+
+		/**
+		 * Reference the whole document, e.g. to assign it.
+		 * @return Reference to the document.
+		 */
+		Reference root() noexcept
+		{
+			return Reference( *this, mDocument, std::string() );
+		}
+
+		/**
+		 * Retrieve the number of operations recorded since the last drain.
+		 * @return The number of operations.
+		 */
+		size_t size() const noexcept
+		{
+			return mEntries.size();
+		}
+	};
+
+	/**
+	 * Read-only view of a value within a tape, the flat binary form written by toTape().
+	 * A view holds only the address of the tape and the offset of its value, so it is
+	 * cheap to copy, and every query reads the tape in place without deserializing it.
+	 * Lookups that find nothing return an invalid view, which tests false and queries
+	 * as an undefined value.
+	 * Note(s):
+	 *    - Views are valid only for as long as the Tape they came from.
+	 *    - Every offset read from the tape is bounds checked, and must lead forward
+	 *      through it, so a corrupt tape yields invalid views rather than bad reads.
+	 */
+	class TapeView
+	{
+	private:
+		friend class JsonValue;
+
+		const char* mTape;
+		uint64_t mLength;
+		uint64_t mOffset;
+
+		// View the node at {@param offset}, or an invalid view if it lies outside the tape.
+		TapeView( const char* tape, uint64_t length, uint64_t offset ) noexcept :
+			mTape( tape ),
+			mLength( length ),
+			mOffset( ( ( length < TAPE_NODE_SIZE ) or ( ( length - TAPE_NODE_SIZE ) < offset ) ) ? 0 : offset )
+		{
+			mTape = ( 0 == mOffset ) ? nullptr : mTape;
+		}
+
+		// Read the word at {@param offset} of the tape, which must be in bounds.
+		uint64_t _load( uint64_t offset ) const noexcept
+		{
+			uint64_t word;
+			std::memcpy( &word, mTape + offset, sizeof( word ) );
+			return word;
+		}
+
+		// The kind of this node, undefined for an invalid view.
+		eTapeKind _kind() const noexcept
+		{
+			return ( nullptr == mTape ) ? eTapeKind::UNDEFINED : eTapeKind( uint32_t( _load( mOffset ) ) );
+		}
+
+		// The count of a container node, or 0 if its table would run past the end of the tape.
+		uint64_t _count( uint64_t entrySize ) const noexcept
+		{
+			const uint64_t count = _load( mOffset + 8 );
+			const uint64_t table = mOffset + TAPE_NODE_SIZE;
+			return ( count <= ( ( mLength - table ) / entrySize ) ) ? count : 0;
+		}
+
+		// View the child whose offset is stored at {@param slot}; children always follow their parents.
+		TapeView _child( uint64_t slot ) const noexcept
+		{
+			const uint64_t offset = _load( slot );
+			return TapeView( mTape, mLength, ( mOffset < offset ) ? offset : 0 );
+		}
+
+		// The length of a string node, or 0 if its bytes would run past the end of the tape.
+		uint64_t _stringLength() const noexcept
+		{
+			const uint64_t length = _load( mOffset + 8 );
+			return ( length < ( mLength - mOffset - TAPE_NODE_SIZE ) ) ? length : 0;
+		}
+
+	public:
+		/**
+		 * Default constructor to an invalid view.
+		 */
+		TapeView() noexcept :
+			mTape( nullptr ),
+			mLength( 0 ),
+			mOffset( 0 )
+		{
+		}
+
+		/**
+		 * Check if the view refers to a value.
+		 * @return True is returned if the view is valid, false if a lookup found nothing.
+		 */
+		explicit operator bool() const noexcept
+		{
+			return nullptr != mTape;
+		}
+
+		/**
+		 * View an element of an array, or the value of a member of an object by its
+		 * position in key order.
+		 * @param index The position of the element or member.
+		 * @return The view of the value is returned, or an invalid view if there is none.
+		 */
+		TapeView at( size_t index ) const noexcept
+		{
+			const eTapeKind kind = _kind();
+			if ( eTapeKind::ARRAY == kind )
+			{
+				return ( index < _count( 8 ) ) ? _child( mOffset + TAPE_NODE_SIZE + ( 8 * uint64_t( index ) ) ) : TapeView();
+			}
+
+			if ( eTapeKind::OBJECT == kind )
+			{
+				return ( index < _count( 16 ) ) ? _child( mOffset + TAPE_NODE_SIZE + ( 16 * uint64_t( index ) ) + 8 ) : TapeView();
+			}
+
+			return TapeView();
+		}
+
+		/**
+		 * Get the characters of a string, in place in the tape.
+		 * @return Pointer to the null terminated characters is returned, or a null pointer
+		 *         if this is not a string. The length is given by size(), as the string
+		 *         may itself hold null characters.
+		 */
+		const char* c_str() const noexcept
+		{
+			return ( ( eTapeKind::STRING == _kind() ) and ( _load( mOffset + 8 ) < ( mLength - mOffset - TAPE_NODE_SIZE ) ) )
+				? ( mTape + mOffset + TAPE_NODE_SIZE ) : nullptr;
+		}
+
+		/**
+		 * Look up the value of a member of an object, by binary search of its key table.
+		 * @param key Const reference to the key.
+		 * @return The view of the value is returned, or an invalid view if there is none.
+		 */
+		TapeView find( const std::string& key ) const noexcept
+		{
+			return find( key.data(), key.length() );
+		}
+
+		/**
+		 * Look up the value of a member of an object, by binary search of its key table.
+		 * @param key Pointer to the characters of the key.
+		 * @param length Number of characters in the key.
+		 * @return The view of the value is returned, or an invalid view if there is none.
+		 */
+		TapeView find( const char* key, size_t length ) const noexcept
+		{
+			if ( eTapeKind::OBJECT != _kind() )
+			{
+				return TapeView();
+			}
+
+			// Keys are stored in the byte order of std::string comparison.
+			uint64_t low = 0;
+			uint64_t high = _count( 16 );
+			while ( low < high )
+			{
+				const uint64_t middle = low + ( ( high - low ) / 2 );
+				const uint64_t slot = mOffset + TAPE_NODE_SIZE + ( 16 * middle );
+				const TapeView memberKey = _child( slot );
+				const char* memberCharacters = memberKey.c_str();
+
+				if ( nullptr == memberCharacters )
+				{
+					return TapeView();
+				}
+
+				const size_t memberLength = size_t( memberKey._stringLength() );
+
+				int comparison = std::memcmp( memberCharacters, key, std::min( memberLength, length ) );
+				comparison = ( 0 != comparison ) ? comparison : ( ( memberLength < length ) ? -1 : ( ( length < memberLength ) ? 1 : 0 ) );
+
+				if ( 0 == comparison )
+				{
+					return _child( slot + 8 );
+				}
+
+				low = ( comparison < 0 ) ? ( middle + 1 ) : low;
+				high = ( comparison < 0 ) ? high : middle;
+			}
+
+			return TapeView();
+		}
+
+		/**
+		 * Get a boolean value.
+		 * @param value Reference to receive the value.
+		 * @return True is returned if this is a boolean, else false and value is unchanged.
+		 */
+		bool get( bool& value ) const noexcept
+		{
+			const eTapeKind kind = _kind();
+			value = ( eTapeKind::TRUE_VALUE == kind ) or ( ( eTapeKind::FALSE_VALUE != kind ) and value );
+			return ( eTapeKind::TRUE_VALUE == kind ) or ( eTapeKind::FALSE_VALUE == kind );
+		}
+
+		/**
+		 * Get a number stored as a signed integral.
+		 * @param value Reference to receive the value.
+		 * @return True is returned if this is a signed integral, else false and value is unchanged.
+		 */
+		bool get( intmax_t& value ) const noexcept
+		{
+			if ( eTapeKind::SIGNED_INTEGRAL != _kind() )
+			{
+				return false;
+			}
+
+			value = intmax_t( _load( mOffset + 8 ) );
+			return true;
+		}
+
+		/**
+		 * Get a number stored as an unsigned integral.
+		 * @param value Reference to receive the value.
+		 * @return True is returned if this is an unsigned integral, else false and value is unchanged.
+		 */
+		bool get( uintmax_t& value ) const noexcept
+		{
+			if ( eTapeKind::UNSIGNED_INTEGRAL != _kind() )
+			{
+				return false;
+			}
+
+			value = uintmax_t( _load( mOffset + 8 ) );
+			return true;
+		}
+
+		/**
+		 * Get a number stored as floating.
+		 * @param value Reference to receive the value.
+		 * @return True is returned if this is a floating number, else false and value is unchanged.
+		 */
+		bool get( long double& value ) const noexcept
+		{
+			if ( ( eTapeKind::FLOATING != _kind() ) or ( mLength - mOffset < ( 2 * TAPE_NODE_SIZE ) ) )
+			{
+				return false;
+			}
+
+			std::memcpy( &value, mTape + mOffset + TAPE_NODE_SIZE, sizeof( value ) );
+			return true;
+		}
+
+		/**
+		 * Get a copy of a string.
+		 * @param value Reference to receive the value.
+		 * @return True is returned if this is a string, else false and value is unchanged.
+		 */
+		bool get( std::string& value ) const
+		{
+			if ( eTapeKind::STRING != _kind() )
+			{
+				return false;
+			}
+
+			value.assign( c_str(), size_t( _stringLength() ) );
+			return true;
+		}
+
+		/**
+		 * Check the type of the viewed value.
+		 * @param type The type to check against.
+		 * @return True is returned if the value is of the given type.
+		 */
+		bool is( Type type ) const noexcept
+		{
+			return type == this->type();
+		}
+
+		/**
+		 * View the key of a member of an object, by its position in key order.
+		 * @param index The position of the member.
+		 * @return The view of the key string is returned, or an invalid view if there is none.
+		 */
+		TapeView keyAt( size_t index ) const noexcept
+		{
+			return ( ( eTapeKind::OBJECT == _kind() ) and ( index < _count( 16 ) ) )
+				? _child( mOffset + TAPE_NODE_SIZE + ( 16 * uint64_t( index ) ) ) : TapeView();
+		}
+
+		/**
+		 * Length of the viewed value, assuming the type is: object, array, or string.
+		 * @return Length of the value.
+		 * @throw std::runtime_error is thrown if the value is not an object, array, or string.
+		 */
+		size_t size() const
+		{
+			switch ( _kind() )
+			{
+			case eTapeKind::ARRAY:
+				return size_t( _count( 8 ) );
+
+			case eTapeKind::OBJECT:
+				return size_t( _count( 16 ) );
+
+			case eTapeKind::STRING:
+				return size_t( _stringLength() );
+
+			default:
+				throw std::runtime_error( "Operation 'size()' is not defined for non-container type" );
+			}
+		}
+
+		/**
+		 * Copy the viewed value, and everything below it, into a JsonValue.
+		 * @return The JsonValue is returned, undefined for an invalid view.
+		 */
+		JsonValue toJsonValue() const
+		{
+			JsonValue value;
+
+			switch ( _kind() )
+			{
+			case eTapeKind::NULL_VALUE:
+				value.mType = Type::null;
+				break;
+
+			case eTapeKind::FALSE_VALUE:
+			case eTapeKind::TRUE_VALUE:
+				value.mType = Type::boolean;
+				value.mBoolean = eTapeKind::TRUE_VALUE == _kind();
+				break;
+
+			case eTapeKind::SIGNED_INTEGRAL:
+				value.mType = Type::number;
+				value.mNumericType = eNumberType::SIGNED_INTEGRAL;
+				get( value.mNumericValue.signedIntegral );
+				break;
+
+			case eTapeKind::UNSIGNED_INTEGRAL:
+				value.mType = Type::number;
+				value.mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+				get( value.mNumericValue.unsignedIntegral );
+				break;
+
+			case eTapeKind::FLOATING:
+				value.mType = Type::number;
+				value.mNumericType = eNumberType::FLOATING;
+				value.mNumericValue.floatValue = 0.0L;
+				get( value.mNumericValue.floatValue );
+				break;
+
+			case eTapeKind::STRING:
+				value.mType = Type::string;
+				get( value.mStringValue );
+				break;
+
+			case eTapeKind::ARRAY:
+				value.mType = Type::array;
+				value.mElements.resize( size() );
+				for ( size_t position( 0 ); position < value.mElements.size(); ++position )
+				{
+					value.mElements[ position ] = at( position ).toJsonValue();
+				}
+				break;
+
+			case eTapeKind::OBJECT:
+			{
+				value.mType = Type::object;
+				std::string key;
+				const size_t count = size();
+
+				// Keys are in order already, so each member is placed at the end of the map.
+				for ( size_t position( 0 ); position < count; ++position )
+				{
+					key.clear();
+					keyAt( position ).get( key );
+					value.mMembers.emplace_hint( value.mMembers.end(), std::move( key ), at( position ).toJsonValue() );
+				}
+				break;
+			}
+
+			default:
+				break;
+			}
+
+			return value;
+		}
+
+		/**
+		 * Retrieve the type of the viewed value.
+		 * @return The type, undefined for an invalid view.
+		 */
+		Type type() const noexcept
+		{
+			switch ( _kind() )
+			{
+			case eTapeKind::NULL_VALUE:
+				return Type::null;
+
+			case eTapeKind::FALSE_VALUE:
+			case eTapeKind::TRUE_VALUE:
+				return Type::boolean;
+
+			case eTapeKind::SIGNED_INTEGRAL:
+			case eTapeKind::UNSIGNED_INTEGRAL:
+			case eTapeKind::FLOATING:
+				return Type::number;
+
+			case eTapeKind::STRING:
+				return Type::string;
+
+			case eTapeKind::ARRAY:
+				return Type::array;
+
+			case eTapeKind::OBJECT:
+				return Type::object;
+
+			default:
+				return Type::undefined;
+			}
+		}
+	};
+
+	/**
+	 * A tape, the flat binary form of a document written by toTape(), loaded for
+	 * querying in place through TapeViews. Loading a tape from file maps it into
+	 * memory where the platform supports it, so no part of it is read or decoded
+	 * until it is queried.
+	 * Note(s):
+	 *    - Tapes are written in the byte order and long double format of the host,
+	 *      and can only be loaded by a host that shares them.
+	 *    - Only the header is checked when a tape is loaded; the rest of the tape is
+	 *      checked as it is queried, see TapeView.
+	 */
+	class Tape
+	{
+	private:
+		std::string mBuffer;
+		const char* mData;
+		size_t mLength;
+		bool mIsMapped;
+
+		// Empty tape, for load() to fill in.
+		Tape() noexcept :
+			mData( nullptr ),
+			mLength( 0 ),
+			mIsMapped( false )
+		{
+		}
+
+		// Check the header against the tape and the host.
+		void _validate() const
+		{
+			uint32_t words[ 2 ];
+			uint64_t length = 0;
+
+			if ( mLength < TAPE_HEADER_SIZE )
+			{
+				throw std::runtime_error( "Tape is truncated" );
+			}
+
+			std::memcpy( words, mData + 8, sizeof( words ) );
+			std::memcpy( &length, mData + 16, sizeof( length ) );
+
+			if ( 0 != std::memcmp( mData, "JSONTAPE", 8 ) )
+			{
+				throw std::runtime_error( "Not a tape" );
+			}
+
+			if ( ( TAPE_BYTE_ORDER != words[ 0 ] ) or ( sizeof( long double ) != words[ 1 ] ) )
+			{
+				throw std::runtime_error( "Tape was written by a host of a different byte order or long double format" );
+			}
+
+			if ( length != mLength )
+			{
+				throw std::runtime_error( "Tape is truncated" );
+			}
+		}
+
+		// Release the mapping, if there is one.
+		void _unmap() noexcept
+		{
+#if defined( __unix__ ) or defined( __APPLE__ )
+			if ( mIsMapped )
+			{
+				::munmap( const_cast< char* >( mData ), mLength );
+			}
+#endif
+
+			mIsMapped = false;
+		}
+
+	public:
+		/**
+		 * Take over a tape held in memory.
+		 * @param bytes R-Value of the string holding the tape, as written by toTape().
+		 * @throw std::runtime_error is thrown if the header is not that of a tape this host can read.
+		 */
+		explicit Tape( std::string&& bytes ) :
+			mBuffer( std::move( bytes ) ),
+			mData( mBuffer.data() ),
+			mLength( mBuffer.length() ),
+			mIsMapped( false )
+		{
+			_validate();
+		}
+
+		/**
+		 * Move constructor, the tape is taken over from other.
+		 * @param other R-Value of the Tape to move.
+		 */
+		Tape( Tape&& other ) noexcept :
+			mBuffer( std::move( other.mBuffer ) ),
+			mData( other.mIsMapped ? other.mData : mBuffer.data() ),
+			mLength( std::exchange( other.mLength, 0 ) ),
+			mIsMapped( std::exchange( other.mIsMapped, false ) )
+		{
+			other.mData = nullptr;
+		}
+
+		/**
+		 * Move assignment, the tape is taken over from other.
+		 * @param other R-Value of the Tape to move.
+		 * @return Reference to this Tape.
+		 */
+		Tape& operator=( Tape&& other ) noexcept
+		{
+			if ( this != &other )
+			{
+				_unmap();
+				mBuffer = std::move( other.mBuffer );
+				mData = other.mIsMapped ? other.mData : mBuffer.data();
+				mLength = std::exchange( other.mLength, 0 );
+				mIsMapped = std::exchange( other.mIsMapped, false );
+				other.mData = nullptr;
+			}
+
+			return *this;
+		}
+
+		Tape( const Tape& ) = delete;
+		Tape& operator=( const Tape& ) = delete;
+
+		/**
+		 * Destructor, releases the mapping of a loaded tape.
+		 */
+		~Tape()
+		{
+			_unmap();
+		}
+
+		/**
+		 * Load a tape from file. On POSIX platforms the file is mapped read-only into
+		 * memory, else it is read in whole.
+		 * @param path Path to the tape file.
+		 * @return The loaded Tape.
+		 * @throw std::runtime_error is thrown if the file cannot be opened or mapped, or its
+		 *        header is not that of a tape this host can read.
+		 */
+		static Tape load( const std::string& path )
+		{
+			Tape tape;
+
+#if defined( __unix__ ) or defined( __APPLE__ )
+			const int descriptor = ::open( path.c_str(), O_RDONLY );
+			struct stat status;
+			if ( ( descriptor < 0 ) or ( 0 != ::fstat( descriptor, &status ) ) )
+			{
+				if ( 0 <= descriptor )
+				{
+					::close( descriptor );
+				}
+
+				throw std::runtime_error( "Cannot open tape: " + path );
+			}
+
+			void* mapping = ( 0 < status.st_size ) ? ::mmap( nullptr, size_t( status.st_size ), PROT_READ, MAP_PRIVATE, descriptor, 0 ) : MAP_FAILED;
+			::close( descriptor );
+
+			if ( MAP_FAILED == mapping )
+			{
+				throw std::runtime_error( "Cannot map tape: " + path );
+			}
+
+			tape.mData = static_cast< const char* >( mapping );
+			tape.mLength = size_t( status.st_size );
+			tape.mIsMapped = true;
+#else
+			std::ifstream file( path, std::ios::binary );
+			if ( not file )
+			{
+				throw std::runtime_error( "Cannot open tape: " + path );
+			}
+
+			tape.mBuffer.assign( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >() );
+			tape.mData = tape.mBuffer.data();
+			tape.mLength = tape.mBuffer.length();
+#endif
+
+			tape._validate();
+			return tape;
+		}
+
+		/**
+		 * View the root value of the tape.
+		 * @return The view of the root value.
+		 */
+		TapeView root() const noexcept
+		{
+			return TapeView( mData, mLength, TAPE_HEADER_SIZE );
+		}
+
+		/**
+		 * Retrieve the size of the tape.
+		 * @return The number of bytes in the tape.
+		 */
+		size_t size() const noexcept
+		{
+			return mLength;
+		}
+	};
+
+	/**
+	 * Read-only view of a value within a Literal, the compile time form of a document
+	 * made by literal(). A view holds only the addresses of the tables of its literal and
+	 * the position of its value, and its queries are constexpr, so a lookup on a constexpr
+	 * literal is folded to its result by the compiler. Lookups that find nothing return
+	 * an invalid view, which tests false and queries as an undefined value.
+	 * Note(s):
+	 *    - Views are valid only for as long as the Literal they came from.
+	 */
+	class LiteralView
+	{
+	private:
+		friend class JsonValue;
+		template < size_t Nodes, size_t Length > friend class Literal;
+
+		const LiteralNode* mNodes;
+		const size_t* mTable;
+		const char* mText;
+		size_t mIndex;
+
+		// View the node at {@param index} of the tables of a literal.
+		constexpr LiteralView( const LiteralNode* nodes, const size_t* table, const char* text, size_t index ) noexcept :
+			mNodes( nodes ),
+			mTable( table ),
+			mText( text ),
+			mIndex( index )
+		{
+		}
+
+		// The kind of this node, undefined for an invalid view.
+		constexpr eTapeKind _kind() const noexcept
+		{
+			return ( nullptr == mNodes ) ? eTapeKind::UNDEFINED : mNodes[ mIndex ].kind;
+		}
+
+		// View the child whose position is stored at {@param slot} of the table.
+		constexpr LiteralView _child( size_t slot ) const noexcept
+		{
+			return LiteralView( mNodes, mTable, mText, mTable[ slot ] );
+		}
+
+		// Compare two strings in the byte order of std::string comparison.
+		static constexpr int _compareText( const char* left, size_t leftLength, const char* right, size_t rightLength ) noexcept
+		{
+			for ( size_t offset( 0 ); ( offset < leftLength ) and ( offset < rightLength ); ++offset )
+			{
+				if ( left[ offset ] != right[ offset ] )
+				{
+					return ( uint8_t( left[ offset ] ) < uint8_t( right[ offset ] ) ) ? -1 : 1;
+				}
+			}
+
+			return ( leftLength < rightLength ) ? -1 : ( ( rightLength < leftLength ) ? 1 : 0 );
+		}
+
+	public:
+		/**
+		 * Default constructor to an invalid view.
+		 */
+		constexpr LiteralView() noexcept :
+			mNodes( nullptr ),
+			mTable( nullptr ),
+			mText( nullptr ),
+			mIndex( 0 )
+		{
+		}
+
+		/**
+		 * Check if the view refers to a value.
+		 * @return True is returned if the view is valid, false if a lookup found nothing.
+		 */
+		constexpr explicit operator bool() const noexcept
+		{
+			return nullptr != mNodes;
+		}
+
+		/**
+		 * Look up the value of a member of an object, see find().
+		 * @param key Pointer to the null terminated key.
+		 * @return The view of the value is returned, or an invalid view if there is none.
+		 */
+		constexpr LiteralView operator[]( const char* const key ) const noexcept
+		{
+			return find( key );
+		}
+
+		/**
+		 * View an element of an array, see at().
+		 * @param index The position of the element.
+		 * @return The view of the element is returned, or an invalid view if there is none.
+		 */
+		template < typename IntegralType,
+			typename = typename std::enable_if< std::is_integral< IntegralType >::value >::type >
+		constexpr LiteralView operator[]( IntegralType index ) const noexcept
+		{
+			return ( index < 0 ) ? LiteralView() : at( size_t( index ) );
+		}
+
+		/**
+		 * View an element of an array, or the value of a member of an object by its
+		 * position in key order.
+		 * @param index The position of the element or member.
+		 * @return The view of the value is returned, or an invalid view if there is none.
+		 */
+		constexpr LiteralView at( size_t index ) const noexcept
+		{
+			const eTapeKind kind = _kind();
+			if ( ( eTapeKind::ARRAY == kind ) and ( index < mNodes[ mIndex ].count ) )
+			{
+				return _child( mNodes[ mIndex ].offset + index );
+			}
+
+			if ( ( eTapeKind::OBJECT == kind ) and ( index < mNodes[ mIndex ].count ) )
+			{
+				return _child( mNodes[ mIndex ].offset + ( 2 * index ) + 1 );
+			}
+
+			return LiteralView();
+		}
+
+		/**
+		 * Get the characters of a string, in place in the literal.
+		 * @return Pointer to the null terminated characters is returned, or a null pointer
+		 *         if this is not a string. The length is given by size(), as the string
+		 *         may itself hold null characters.
+		 */
+		constexpr const char* c_str() const noexcept
+		{
+			return ( eTapeKind::STRING == _kind() ) ? ( mText + mNodes[ mIndex ].offset ) : nullptr;
+		}
+
+		/**
+		 * Look up the value of a member of an object, by binary search of its key table.
+		 * @param key Pointer to the null terminated key.
+		 * @return The view of the value is returned, or an invalid view if there is none.
+		 */
+		constexpr LiteralView find( const char* const key ) const noexcept
+		{
+			size_t length = 0;
+			while ( '\0' != key[ length ] )
+			{
+				++length;
+			}
+
+			return find( key, length );
+		}
+
+		/**
+		 * Look up the value of a member of an object, by binary search of its key table.
+		 * @param key Pointer to the characters of the key.
+		 * @param length Number of characters in the key.
+		 * @return The view of the value is returned, or an invalid view if there is none.
+		 */
+		constexpr LiteralView find( const char* key, size_t length ) const noexcept
+		{
+			if ( eTapeKind::OBJECT != _kind() )
+			{
+				return LiteralView();
+			}
+
+			// Keys are stored in the byte order of std::string comparison.
+			const size_t table = mNodes[ mIndex ].offset;
+			size_t low = 0;
+			size_t high = mNodes[ mIndex ].count;
+			while ( low < high )
+			{
+				const size_t middle = low + ( ( high - low ) / 2 );
+				const LiteralNode& memberKey = mNodes[ mTable[ table + ( 2 * middle ) ] ];
+				const int comparison = _compareText( mText + memberKey.offset, memberKey.count, key, length );
+
+				if ( 0 == comparison )
+				{
+					return _child( table + ( 2 * middle ) + 1 );
+				}
+
+				low = ( comparison < 0 ) ? ( middle + 1 ) : low;
+				high = ( comparison < 0 ) ? high : middle;
+			}
+
+			return LiteralView();
+		}
+
+		/**
+		 * Look up the value of a member of an object, by binary search of its key table.
+		 * @param key Const reference to the key.
+		 * @return The view of the value is returned, or an invalid view if there is none.
+		 */
+		LiteralView find( const std::string& key ) const noexcept
+		{
+			return find( key.data(), key.length() );
+		}
+
+		/**
+		 * Get a boolean value.
+		 * @param value Reference to receive the value.
+		 * @return True is returned if this is a boolean, else false and value is unchanged.
+		 */
+		constexpr bool get( bool& value ) const noexcept
+		{
+			const eTapeKind kind = _kind();
+			value = ( eTapeKind::TRUE_VALUE == kind ) or ( ( eTapeKind::FALSE_VALUE != kind ) and value );
+			return ( eTapeKind::TRUE_VALUE == kind ) or ( eTapeKind::FALSE_VALUE == kind );
+		}
+
+		/**
+		 * Get a number stored as a signed integral.
+		 * @param value Reference to receive the value.
+		 * @return True is returned if this is a signed integral, else false and value is unchanged.
+		 */
+		constexpr bool get( intmax_t& value ) const noexcept
+		{
+			if ( eTapeKind::SIGNED_INTEGRAL != _kind() )
+			{
+				return false;
+			}
+
+			// The magnitude is kept negated in two's complement, so the most negative value fits.
+			const uintmax_t integral = mNodes[ mIndex ].integral;
+			value = ( integral <= uintmax_t( INTMAX_MAX ) ) ? intmax_t( integral ) : ( -intmax_t( ~integral ) - 1 );
+			return true;
+		}
+
+		/**
+		 * Get a number stored as an unsigned integral.
+		 * @param value Reference to receive the value.
+		 * @return True is returned if this is an unsigned integral, else false and value is unchanged.
+		 */
+		constexpr bool get( uintmax_t& value ) const noexcept
+		{
+			if ( eTapeKind::UNSIGNED_INTEGRAL != _kind() )
+			{
+				return false;
+			}
+
+			value = mNodes[ mIndex ].integral;
+			return true;
+		}
+
+		/**
+		 * Get a number stored as floating.
+		 * @param value Reference to receive the value.
+		 * @return True is returned if this is a floating number, else false and value is unchanged.
+		 */
+		constexpr bool get( long double& value ) const noexcept
+		{
+			if ( eTapeKind::FLOATING != _kind() )
+			{
+				return false;
+			}
+
+			value = mNodes[ mIndex ].floating;
+			return true;
+		}
+
+		/**
+		 * Get a copy of a string.
+		 * @param value Reference to receive the value.
+		 * @return True is returned if this is a string, else false and value is unchanged.
+		 */
+		bool get( std::string& value ) const
+		{
+			if ( eTapeKind::STRING != _kind() )
+			{
+				return false;
+			}
+
+			value.assign( c_str(), mNodes[ mIndex ].count );
+			return true;
+		}
+
+		/**
+		 * Check the type of the viewed value.
+		 * @param type The type to check against.
+		 * @return True is returned if the value is of the given type.
+		 */
+		constexpr bool is( Type type ) const noexcept
+		{
+			return type == this->type();
+		}
+
+		/**
+		 * View the key of a member of an object, by its position in key order.
+		 * @param index The position of the member.
+		 * @return The view of the key string is returned, or an invalid view if there is none.
+		 */
+		constexpr LiteralView keyAt( size_t index ) const noexcept
+		{
+			return ( ( eTapeKind::OBJECT == _kind() ) and ( index < mNodes[ mIndex ].count ) )
+				? _child( mNodes[ mIndex ].offset + ( 2 * index ) ) : LiteralView();
+		}
+
+		/**
+		 * Length of the viewed value, assuming the type is: object, array, or string.
+		 * @return Length of the value.
+		 * @throw std::runtime_error is thrown if the value is not an object, array, or string.
+		 */
+		constexpr size_t size() const
+		{
+			const eTapeKind kind = _kind();
+			if ( ( eTapeKind::ARRAY != kind ) and ( eTapeKind::OBJECT != kind ) and ( eTapeKind::STRING != kind ) )
+			{
+				throw std::runtime_error( "Operation 'size()' is not defined for non-container type" );
+			}
+
+			return mNodes[ mIndex ].count;
+		}
+
+		/**
+		 * Copy the viewed value, and everything below it, into a JsonValue.
+		 * @return The JsonValue is returned, undefined for an invalid view.
+		 */
+		JsonValue toJsonValue() const
+		{
+			JsonValue value;
+
+			switch ( _kind() )
+			{
+			case eTapeKind::NULL_VALUE:
+				value.mType = Type::null;
+				break;
+
+			case eTapeKind::FALSE_VALUE:
+			case eTapeKind::TRUE_VALUE:
+				value.mType = Type::boolean;
+				value.mBoolean = eTapeKind::TRUE_VALUE == _kind();
+				break;
+
+			case eTapeKind::SIGNED_INTEGRAL:
+				value.mType = Type::number;
+				value.mNumericType = eNumberType::SIGNED_INTEGRAL;
+				get( value.mNumericValue.signedIntegral );
+				break;
+
+			case eTapeKind::UNSIGNED_INTEGRAL:
+				value.mType = Type::number;
+				value.mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+				get( value.mNumericValue.unsignedIntegral );
+				break;
+
+			case eTapeKind::FLOATING:
+				value.mType = Type::number;
+				value.mNumericType = eNumberType::FLOATING;
+				get( value.mNumericValue.floatValue );
+				break;
+
+			case eTapeKind::STRING:
+				value.mType = Type::string;
+				get( value.mStringValue );
+				break;
+
+			case eTapeKind::ARRAY:
+				value.mType = Type::array;
+				value.mElements.resize( size() );
+				for ( size_t position( 0 ); position < value.mElements.size(); ++position )
+				{
+					value.mElements[ position ] = at( position ).toJsonValue();
+				}
+				break;
+
+			case eTapeKind::OBJECT:
+			{
+				value.mType = Type::object;
+				std::string key;
+				const size_t count = size();
+
+				// Keys are in order already, so each member is placed at the end of the map.
+				for ( size_t position( 0 ); position < count; ++position )
+				{
+					key.clear();
+					keyAt( position ).get( key );
+					value.mMembers.emplace_hint( value.mMembers.end(), std::move( key ), at( position ).toJsonValue() );
+				}
+				break;
+			}
+
+			default:
+				break;
+			}
+
+			return value;
+		}
+
+		/**
+		 * Retrieve the type of the viewed value.
+		 * @return The type, undefined for an invalid view.
+		 */
+		constexpr Type type() const noexcept
+		{
+			switch ( _kind() )
+			{
+			case eTapeKind::NULL_VALUE:
+				return Type::null;
+
+			case eTapeKind::FALSE_VALUE:
+			case eTapeKind::TRUE_VALUE:
+				return Type::boolean;
+
+			case eTapeKind::SIGNED_INTEGRAL:
+			case eTapeKind::UNSIGNED_INTEGRAL:
+			case eTapeKind::FLOATING:
+				return Type::number;
+
+			case eTapeKind::STRING:
+				return Type::string;
+
+			case eTapeKind::ARRAY:
+				return Type::array;
+
+			case eTapeKind::OBJECT:
+				return Type::object;
+
+			default:
+				return Type::undefined;
+			}
+		}
+	};
+
+	/**
+	 * A document parsed at compile time from JSON text, made by literal(). The values
+	 * are held in a fixed table of nodes and their strings in a fixed buffer, both
+	 * within the literal itself, so a constexpr literal is placed in read-only data
+	 * and costs neither parsing at startup nor heap memory. It is queried through
+	 * LiteralViews, starting from root().
+	 * Note(s):
+	 *    - Nodes is the capacity for values and Length the length of the text with its
+	 *      terminating null. A text holding more values than Nodes is rejected.
+	 *    - Members of an object are held in key order, and repeated keys are rejected.
+	 *    - Floating numbers are scaled from their first 19 significant digits by exact
+	 *      powers of ten where these fit a long double. Numbers with more digits, or with
+	 *      extreme exponents, may differ from strtold() in the last place.
+	 *    - Nesting is limited by the depth of constexpr evaluation of the compiler.
+	 */
+	template < size_t Nodes, size_t Length >
+	class Literal
+	{
+	private:
+		friend class JsonValue;
+
+		LiteralNode mNodes[ Nodes ];
+		size_t mTable[ Nodes ];  // Children of containers, each object member as its key then its value
+		char mText[ Length ];    // Unescaped, null terminated strings, never longer than their JSON text
+		size_t mNodeCount;
+		size_t mTableLength;
+		size_t mTextLength;
+
+		// Parse {@param text}, of Length characters including its terminating null.
+		constexpr Literal( const char* text ) :
+			mNodes(),
+			mTable(),
+			mText(),
+			mNodeCount( 0 ),
+			mTableLength( 0 ),
+			mTextLength( 0 )
+		{
+			// Children are gathered on the stack until their container closes, then moved to the table.
+			size_t stack[ Nodes ] = {};
+			size_t offset = _skipWhitespace( text, 0 );
+			_parseValue( text, offset, stack, 0 );
+
+			if ( Length != offset + 1 )
+			{
+				throw std::invalid_argument( "Unexpected characters after JSON literal" );
+			}
+		}
+
+		// Offset of the first character from {@param offset} that is not whitespace
+		static constexpr size_t _skipWhitespace( const char* text, size_t offset ) noexcept
+		{
+			while ( ( ' ' == text[ offset ] ) or ( '\t' == text[ offset ] ) or ( '\n' == text[ offset ] ) or ( '\r' == text[ offset ] ) )
+			{
+				++offset;
+			}
+
+			return offset;
+		}
+
+		// Value of the hexadecimal digit {@param digit}, or 16 if it is not one
+		static constexpr uint32_t _getHexValue( char digit ) noexcept
+		{
+			return ( ( '0' <= digit ) and ( digit <= '9' ) ) ? uint32_t( digit - '0' )
+				: ( ( 'a' <= digit ) and ( digit <= 'f' ) ) ? uint32_t( digit - 'a' + 10 )
+				: ( ( 'A' <= digit ) and ( digit <= 'F' ) ) ? uint32_t( digit - 'A' + 10 ) : 16;
+		}
+
+		// Value of the four hexadecimal digits at {@param offset}, or above 0xFFFF if they are not
+		static constexpr uint32_t _getHexQuad( const char* text, size_t offset ) noexcept
+		{
+			uint32_t value = 0;
+			for ( size_t position( 0 ); ( position < 4 ) and ( value <= 0xFFFF ); ++position )
+			{
+				const uint32_t digit = _getHexValue( text[ offset + position ] );
+				value = ( 16 == digit ) ? 0x10000 : ( ( value << 4 ) | digit );
+			}
+
+			return value;
+		}
+
+		// Ten to the power of {@param exponent}, exactly while it fits the digits of a long double
+		static constexpr long double _getPowerOfTen( uint32_t exponent ) noexcept
+		{
+			long double power = 1.0L;
+			long double square = 10.0L;
+			while ( 0 < exponent )
+			{
+				power = ( 0 != ( exponent & 1 ) ) ? ( power * square ) : power;
+				exponent >>= 1;
+				square = ( 0 < exponent ) ? ( square * square ) : square;
+			}
+
+			return power;
+		}
+
+		// Check that {@param word} is at {@param offset}, and skip past it
+		static constexpr bool _skipWord( const char* text, size_t& offset, const char* word ) noexcept
+		{
+			size_t length = 0;
+			while ( ( '\0' != word[ length ] ) and ( word[ length ] == text[ offset + length ] ) )
+			{
+				++length;
+			}
+
+			offset += ( '\0' == word[ length ] ) ? length : 0;
+			return '\0' == word[ length ];
+		}
+
+		// Parse the value at {@param offset} into a new node, and the whitespace after it.
+		// Children of containers are gathered on {@param stack} above {@param top}.
+		constexpr size_t _parseValue( const char* text, size_t& offset, size_t* stack, size_t top )
+		{
+			if ( Nodes == mNodeCount )
+			{
+				throw std::invalid_argument( "JSON literal holds more values than its node capacity" );
+			}
+
+			const size_t index = mNodeCount++;
+			LiteralNode& node = mNodes[ index ];
+
+			switch ( text[ offset ] )
+			{
+			case '{':
+			case '[':
+				_parseContainer( text, offset, node, stack, top );
+				break;
+
+			case '"':
+				_parseString( text, offset, node );
+				break;
+
+			default:
+				if ( _skipWord( text, offset, "null" ) )
+				{
+					node.kind = eTapeKind::NULL_VALUE;
+				}
+				else if ( _skipWord( text, offset, "true" ) )
+				{
+					node.kind = eTapeKind::TRUE_VALUE;
+				}
+				else if ( _skipWord( text, offset, "false" ) )
+				{
+					node.kind = eTapeKind::FALSE_VALUE;
+				}
+				else
+				{
+					_parseNumber( text, offset, node );
+				}
+				break;
+			}
+
+			offset = _skipWhitespace( text, offset );
+			return index;
+		}
+
+		// Parse the object or array at {@param offset} into {@param node}
+		constexpr void _parseContainer( const char* text, size_t& offset, LiteralNode& node, size_t* stack, size_t top )
+		{
+			const bool isObject = '{' == text[ offset ];
+			const char closer = isObject ? '}' : ']';
+			size_t count = 0;
+
+			offset = _skipWhitespace( text, offset + 1 );
+			while ( closer != text[ offset ] )
+			{
+				if ( ( 0 < count ) and ( ',' != text[ offset ] ) )
+				{
+					throw std::invalid_argument( "Expected ',' in JSON literal" );
+				}
+
+				offset = ( 0 < count ) ? _skipWhitespace( text, offset + 1 ) : offset;
+				if ( isObject )
+				{
+					if ( '"' != text[ offset ] )
+					{
+						throw std::invalid_argument( "Expected a key in JSON literal" );
+					}
+
+					const size_t key = _parseValue( text, offset, stack, top + ( 2 * count ) );
+					stack[ top + ( 2 * count ) ] = key;
+
+					if ( ':' != text[ offset ] )
+					{
+						throw std::invalid_argument( "Expected ':' in JSON literal" );
+					}
+
+					offset = _skipWhitespace( text, offset + 1 );
+				}
+
+				const size_t entry = isObject ? ( top + ( 2 * count ) + 1 ) : ( top + count );
+				const size_t child = _parseValue( text, offset, stack, entry );
+				stack[ entry ] = child;
+				++count;
+			}
+
+			++offset;
+			node.kind = isObject ? eTapeKind::OBJECT : eTapeKind::ARRAY;
+			node.count = count;
+			node.offset = mTableLength;
+
+			// Sort the members by key, so that find() can search them.
+			for ( size_t position( 1 ); isObject and ( position < count ); ++position )
+			{
+				const size_t key = stack[ top + ( 2 * position ) ];
+				const size_t value = stack[ top + ( 2 * position ) + 1 ];
+				size_t slot = position;
+				int comparison = -1;
+				while ( 0 < slot )
+				{
+					const LiteralNode& previous = mNodes[ stack[ top + ( 2 * slot ) - 2 ] ];
+					comparison = LiteralView::_compareText( mText + mNodes[ key ].offset, mNodes[ key ].count,
+						mText + previous.offset, previous.count );
+					if ( 0 <= comparison )
+					{
+						break;
+					}
+
+					stack[ top + ( 2 * slot ) ] = stack[ top + ( 2 * slot ) - 2 ];
+					stack[ top + ( 2 * slot ) + 1 ] = stack[ top + ( 2 * slot ) - 1 ];
+					--slot;
+				}
+
+				if ( 0 == comparison )
+				{
+					throw std::invalid_argument( "Repeated key in JSON literal" );
+				}
+
+				stack[ top + ( 2 * slot ) ] = key;
+				stack[ top + ( 2 * slot ) + 1 ] = value;
+			}
+
+			const size_t entries = isObject ? ( 2 * count ) : count;
+			for ( size_t position( 0 ); position < entries; ++position )
+			{
+				mTable[ mTableLength++ ] = stack[ top + position ];
+			}
+		}
+
+		// Parse the string at {@param offset} into {@param node}, unescaping it into the text
+		constexpr void _parseString( const char* text, size_t& offset, LiteralNode& node )
+		{
+			const char SHORT_ESCAPES[] = "\"\"\\\\//b\bf\fn\nr\rt\t";
+
+			node.kind = eTapeKind::STRING;
+			node.offset = mTextLength;
+			++offset;
+
+			while ( '"' != text[ offset ] )
+			{
+				const char character = text[ offset++ ];
+				if ( uint8_t( character ) < uint8_t( ' ' ) )
+				{
+					throw std::invalid_argument( "Unterminated string or control character in JSON literal" );
+				}
+
+				if ( '\\' != character )
+				{
+					mText[ mTextLength++ ] = character;
+					continue;
+				}
+
+				const char letter = text[ offset++ ];
+				if ( 'u' != letter )
+				{
+					size_t escape = 0;
+					while ( ( '\0' != SHORT_ESCAPES[ escape ] ) and ( letter != SHORT_ESCAPES[ escape ] ) )
+					{
+						escape += 2;
+					}
+
+					if ( ( '\0' == letter ) or ( '\0' == SHORT_ESCAPES[ escape ] ) )
+					{
+						throw std::invalid_argument( "Invalid escape in JSON literal" );
+					}
+
+					mText[ mTextLength++ ] = SHORT_ESCAPES[ escape + 1 ];
+					continue;
+				}
+
+				uint32_t codePoint = _getHexQuad( text, offset );
+				if ( 0xFFFF < codePoint )
+				{
+					throw std::invalid_argument( "Invalid escape in JSON literal" );
+				}
+
+				offset += 4;
+
+				// A surrogate pair becomes one code point, and a lone surrogate becomes U+FFFD.
+				const uint32_t lowSurrogate = ( ( '\\' == text[ offset ] ) and ( 'u' == text[ offset + 1 ] ) ) ? _getHexQuad( text, offset + 2 ) : 0;
+				if ( ( 0xD800 <= codePoint ) and ( codePoint < 0xDC00 ) and ( 0xDC00 <= lowSurrogate ) and ( lowSurrogate < 0xE000 ) )
+				{
+					codePoint = 0x10000 + ( ( codePoint - 0xD800 ) << 10 ) + ( lowSurrogate - 0xDC00 );
+					offset += 6;
+				}
+				else if ( ( 0xD800 <= codePoint ) and ( codePoint < 0xE000 ) )
+				{
+					codePoint = 0xFFFD;
+				}
+
+				mTextLength = _encodeUTF8( mText, mTextLength, codePoint );
+			}
+
+			++offset;
+			node.count = mTextLength - node.offset;
+			mText[ mTextLength++ ] = '\0';
+		}
+
+		// Parse the number at {@param offset} into {@param node}. Integers that fit are kept
+		// exactly, with a negative one held negated; others are floating.
+		constexpr void _parseNumber( const char* text, size_t& offset, LiteralNode& node )
+		{
+			const bool isNegative = '-' == text[ offset ];
+			uintmax_t mantissa = 0;
+			int32_t exponent = 0;
+			bool isIntegral = true;
+
+			offset += isNegative ? 1 : 0;
+			if ( ( text[ offset ] < '0' ) or ( '9' < text[ offset ] ) )
+			{
+				throw std::invalid_argument( "Invalid value in JSON literal" );
+			}
+
+			// A leading zero stands alone, and digits beyond those the mantissa holds only scale it.
+			bool isTruncated = false;
+			while ( ( '0' <= text[ offset ] ) and ( text[ offset ] <= '9' ) )
+			{
+				const uint32_t digit = uint32_t( text[ offset++ ] - '0' );
+				isTruncated = isTruncated or ( ( ( UINTMAX_MAX - digit ) / 10 ) < mantissa );
+				mantissa = isTruncated ? mantissa : ( ( mantissa * 10 ) + digit );
+				exponent += isTruncated ? 1 : 0;
+				if ( 0 == mantissa )
+				{
+					break;
+				}
+			}
+
+			if ( '.' == text[ offset ] )
+			{
+				isIntegral = false;
+				if ( ( text[ ++offset ] < '0' ) or ( '9' < text[ offset ] ) )
+				{
+					throw std::invalid_argument( "Invalid number in JSON literal" );
+				}
+
+				while ( ( '0' <= text[ offset ] ) and ( text[ offset ] <= '9' ) )
+				{
+					const uint32_t digit = uint32_t( text[ offset++ ] - '0' );
+					if ( mantissa <= ( ( UINTMAX_MAX - digit ) / 10 ) )
+					{
+						mantissa = ( mantissa * 10 ) + digit;
+						--exponent;
+					}
+				}
+			}
+
+			if ( ( 'e' == text[ offset ] ) or ( 'E' == text[ offset ] ) )
+			{
+				isIntegral = false;
+				const bool isNegativeExponent = '-' == text[ ++offset ];
+				offset += ( ( '-' == text[ offset ] ) or ( '+' == text[ offset ] ) ) ? 1 : 0;
+				if ( ( text[ offset ] < '0' ) or ( '9' < text[ offset ] ) )
+				{
+					throw std::invalid_argument( "Invalid number in JSON literal" );
+				}
+
+				int32_t written = 0;
+				while ( ( '0' <= text[ offset ] ) and ( text[ offset ] <= '9' ) )
+				{
+					written = std::min( ( written * 10 ) + ( text[ offset++ ] - '0' ), 100000 );
+				}
+
+				exponent += isNegativeExponent ? -written : written;
+			}
+
+			if ( isIntegral and ( not isTruncated ) and ( ( not isNegative ) or ( mantissa <= ( uintmax_t( INTMAX_MAX ) + 1 ) ) ) )
+			{
+				node.kind = isNegative ? eTapeKind::SIGNED_INTEGRAL : eTapeKind::UNSIGNED_INTEGRAL;
+				node.integral = isNegative ? ( 0 - mantissa ) : mantissa;
+				return;
+			}
+
+			// Scale down in steps that each fit a long double, stopping once nothing is left.
+			long double value = ( long double )( mantissa );
+			while ( ( exponent < -LDBL_MAX_10_EXP ) and ( 0.0L != value ) )
+			{
+				value /= _getPowerOfTen( LDBL_MAX_10_EXP );
+				exponent += LDBL_MAX_10_EXP;
+			}
+
+			if ( ( 0.0L != value ) and ( LDBL_MAX_10_EXP < exponent ) )
+			{
+				throw std::invalid_argument( "Number out of range in JSON literal" );
+			}
+
+			value = ( 0.0L == value ) ? value
+				: ( ( exponent < 0 ) ? ( value / _getPowerOfTen( uint32_t( -exponent ) ) ) : ( value * _getPowerOfTen( uint32_t( exponent ) ) ) );
+			node.kind = eTapeKind::FLOATING;
+			node.floating = isNegative ? -value : value;
+		}
+
+	public:
+		/**
+		 * View the root value of the literal.
+		 * @return The view of the root value.
+		 */
+		constexpr LiteralView root() const noexcept
+		{
+			return LiteralView( mNodes, mTable, mText, 0 );
+		}
+
+		/**
+		 * Retrieve the number of values in the literal.
+		 * @return The number of nodes in use, at most Nodes.
+		 */
+		constexpr size_t size() const noexcept
+		{
+			return mNodeCount;
+		}
+	};
+
+	/**
+	 * Compiled JSON Schema, as defined in draft 2020-12, for validating documents
+	 * after they are built or while they are parsed.
+	 * Reference: https://json-schema.org/draft/2020-12/json-schema-validation
+	 * Supported keywords:
+	 *    - type, enum, const, and the boolean schemas true and false.
+	 *    - multipleOf, maximum, exclusiveMaximum, minimum and exclusiveMinimum.
+	 *    - maxLength, minLength and pattern, which uses the ECMAScript grammar of std::regex.
+	 *    - prefixItems, items, contains, maxContains, minContains, maxItems, minItems and uniqueItems.
+	 *    - properties, patternProperties, additionalProperties, propertyNames, required,
+	 *      dependentRequired, dependentSchemas, maxProperties and minProperties.
+	 *    - allOf, anyOf, oneOf, not, if, then and else.
+	 *    - $ref to a JSON Pointer within the schema, e.g. "#/$defs/item", and $defs.
+	 * Note(s):
+	 *    - The schema is compiled once into a table of nodes, one per subschema, with
+	 *      each keyword resolved to the nodes it applies to members and elements. Each node
+	 *      also lists the nodes that hold alongside it through allOf and $ref.
+	 *    - JsonValue::parse() with a schema validates while it parses. The type of a value
+	 *      is checked before it is read, and members, elements and counts are checked as
+	 *      they are met, so an invalid document is rejected without reading the rest of it.
+	 *      Only enum, const, uniqueItems, contains, dependentSchemas, anyOf, oneOf, not and if
+	 *      need a complete value, and these are checked over that value alone once it is built.
+	 *    - $anchor, $dynamicAnchor, $dynamicRef, unevaluatedItems, unevaluatedProperties, the
+	 *      earlier drafts' $recursiveAnchor, $recursiveRef, additionalItems and dependencies, and
+	 *      references outside the schema are rejected when compiling, rather than ignored.
+	 *      Other unknown keywords, including format, are annotations and are ignored.
+	 */
+	class Schema
+	{
+		friend class JsonValue;
+
+	private:
+		// Bits of the types a node accepts
+		enum eTypeMask : uint8_t
+		{
+			NULL_TYPE = 0x01,
+			BOOLEAN_TYPE = 0x02,
+			OBJECT_TYPE = 0x04,
+			ARRAY_TYPE = 0x08,
+			NUMBER_TYPE = 0x10,
+			INTEGER_TYPE = 0x20,
+			STRING_TYPE = 0x40,
+			ALL_TYPES = 0x7F
+		};
+
+		// Marks an absent subschema or pattern
+		enum eNodeLayout : size_t
+		{
+			NO_NODE = SIZE_MAX
+		};
+
+		// A compiled subschema
+		struct Node
+		{
+			uint8_t types = ALL_TYPES;                  // The eTypeMask bits of the accepted types
+			bool isDeferred = false;                    // Has keywords checked against the complete value
+			long double minimum = -HUGE_VALL;
+			long double exclusiveMinimum = -HUGE_VALL;
+			long double maximum = HUGE_VALL;
+			long double exclusiveMaximum = HUGE_VALL;
+			long double multipleOf = 0.0L;              // Zero if there is no multipleOf
+			size_t minLength = 0;
+			size_t maxLength = SIZE_MAX;
+			size_t pattern = NO_NODE;                   // Position in mPatterns
+			std::vector< size_t > prefixItems;
+			size_t items = NO_NODE;
+			size_t contains = NO_NODE;
+			size_t minContains = 1;
+			size_t maxContains = SIZE_MAX;
+			size_t minItems = 0;
+			size_t maxItems = SIZE_MAX;
+			bool uniqueItems = false;
+			std::vector< std::pair< std::string, size_t > > properties;       // Sorted by name
+			std::vector< std::pair< size_t, size_t > > patternProperties;     // Position in mPatterns, and node
+			size_t additionalProperties = NO_NODE;
+			size_t propertyNames = NO_NODE;
+			std::vector< std::string > required;
+			std::vector< std::pair< std::string, std::vector< std::string > > > dependentRequired;
+			std::vector< std::pair< std::string, size_t > > dependentSchemas;
+			size_t minProperties = 0;
+			size_t maxProperties = SIZE_MAX;
+			bool hasEnumeration = false;
+			ArrayType enumeration;                      // The enum values, or the const value
+			std::vector< size_t > allOf;                // The allOf nodes and the $ref target
+			std::vector< size_t > anyOf;
+			std::vector< size_t > oneOf;
+			size_t negation = NO_NODE;
+			size_t condition = NO_NODE;
+			size_t consequence = NO_NODE;
+			size_t alternative = NO_NODE;
+			std::vector< size_t > conjunction;          // This node and every node reached through allOf
+		};
+
+		// The schema document and the nodes compiled from it so far
+		struct Compiler
+		{
+			const JsonValue& root;
+			std::map< const JsonValue*, size_t > nodes;
+		};
+
+		std::vector< Node > mNodes;
+		std::vector< std::regex > mPatterns;
+
+		[[noreturn]] static void _fail( const std::string& reason )
+		{
+			throw std::invalid_argument( "JSON Schema: " + reason );
+		}
+
+		// Read the non-negative integer value of the keyword {@param keyword}
+		static size_t _getCount( const JsonValue& value, const char* const keyword )
+		{
+			long double count = ( Type::number == value.mType ) ? value._toLongDouble() : -1.0L;
+			if ( ( count < 0 ) or ( std::floor( count ) != count ) )
+			{
+				_fail( std::string( "'" ) + keyword + "' must be a non-negative integer" );
+			}
+
+			return ( std::ldexp( 1.0L, 64 ) <= count ) ? SIZE_MAX : size_t( count );
+		}
+
+		// Read the numeric value of the keyword {@param keyword}
+		static long double _getNumber( const JsonValue& value, const char* const keyword )
+		{
+			if ( Type::number != value.mType )
+			{
+				_fail( std::string( "'" ) + keyword + "' must be a number" );
+			}
+
+			return value._toLongDouble();
+		}
+
+		// Read the array of strings of the keyword {@param keyword}
+		static std::vector< std::string > _getNames( const JsonValue& value, const char* const keyword )
+		{
+			if ( Type::array != value.mType )
+			{
+				_fail( std::string( "'" ) + keyword + "' must be an array of strings" );
+			}
+
+			std::vector< std::string > names;
+			for ( const JsonValue& name : value.mElements )
+			{
+				if ( Type::string != name.mType )
+				{
+					_fail( std::string( "'" ) + keyword + "' must be an array of strings" );
+				}
+
+				names.push_back( name.mStringValue );
+			}
+
+			return names;
+		}
+
+		// Compile the regular expression {@param pattern}, returning its position in mPatterns
+		size_t _compilePattern( const JsonValue& pattern )
+		{
+			if ( Type::string != pattern.mType )
+			{
+				_fail( "a pattern must be a string" );
+			}
+
+			try
+			{
+				mPatterns.emplace_back( pattern.mStringValue, std::regex::ECMAScript );
+			}
+			catch ( const std::regex_error& )
+			{
+				_fail( "invalid pattern '" + pattern.mStringValue + "'" );
+			}
+
+			return mPatterns.size() - 1;
+		}
+
+		// Compile each schema of the array of the keyword {@param keyword}
+		std::vector< size_t > _compileList( const JsonValue& schemas, Compiler& compiler, const char* const keyword )
+		{
+			if ( ( Type::array != schemas.mType ) or schemas.mElements.empty() )
+			{
+				_fail( std::string( "'" ) + keyword + "' must be a non-empty array of schemas" );
+			}
+
+			std::vector< size_t > nodes;
+			for ( const JsonValue& schema : schemas.mElements )
+			{
+				nodes.push_back( _compile( schema, compiler ) );
+			}
+
+			return nodes;
+		}
+
+		// Resolve the reference {@param reference} against the schema document
+		static const JsonValue& _resolve( const std::string& reference, const Compiler& compiler )
+		{
+			if ( ( reference.empty() ) or ( '#' != reference[ 0 ] ) )
+			{
+				_fail( "only references within the schema are supported, not '" + reference + "'" );
+			}
+
+			// The fragment is a URI fragment, so percent-decode it before reading it as a JSON Pointer.
+			std::string pointer;
+			for ( size_t offset( 1 ); offset < reference.length(); ++offset )
+			{
+				if ( ( '%' == reference[ offset ] ) and ( offset + 2 < reference.length() )
+					and isxdigit( static_cast< unsigned char >( reference[ offset + 1 ] ) )
+					and isxdigit( static_cast< unsigned char >( reference[ offset + 2 ] ) ) )
+				{
+					pointer.push_back( char( std::stoi( reference.substr( offset + 1, 2 ), nullptr, 16 ) ) );
+					offset += 2;
+				}
+				else
+				{
+					pointer.push_back( reference[ offset ] );
+				}
+			}
+
+			if ( ( not pointer.empty() ) and ( '/' != pointer[ 0 ] ) )
+			{
+				_fail( "anchors are not supported, in '" + reference + "'" );
+			}
+
+			const JsonValue* target = Pointer( pointer ).get( compiler.root );
+			if ( nullptr == target )
+			{
+				_fail( "unresolved reference '" + reference + "'" );
+			}
+
+			return *target;
+		}
+
+		// Compile {@param schema} into a node, or return its node if it has already been compiled.
+		size_t _compile( const JsonValue& schema, Compiler& compiler )
+		{
+			auto compiled = compiler.nodes.find( &schema );
+			if ( compiler.nodes.end() != compiled )
+			{
+				return compiled->second;
+			}
+
+			// Register the node before compiling its subschemas, so recursive references terminate.
+			const size_t index = mNodes.size();
+			mNodes.emplace_back();
+			compiler.nodes.emplace( &schema, index );
+
+			if ( Type::boolean == schema.mType )
+			{
+				mNodes[ index ].types = schema.mBoolean ? uint8_t( ALL_TYPES ) : uint8_t( 0 );
+				return index;
+			}
+
+			if ( Type::object != schema.mType )
+			{
+				_fail( "a schema must be an object or a boolean" );
+			}
+
+			// Subschemas are compiled before a node is touched, as compiling them grows mNodes.
+			for ( const auto& member : schema.mMembers )
+			{
+				const std::string& keyword = member.first;
+				const JsonValue& value = member.second;
+
+				if ( "type" == keyword )
+				{
+					static const std::map< std::string, uint8_t, std::less<> > TYPE_MASK_MAP
+					{
+						{ "null",    NULL_TYPE    },
+						{ "boolean", BOOLEAN_TYPE },
+						{ "object",  OBJECT_TYPE  },
+						{ "array",   ARRAY_TYPE   },
+						{ "number",  NUMBER_TYPE  },
+						{ "integer", INTEGER_TYPE },
+						{ "string",  STRING_TYPE  }
+					};
+
+					const std::vector< std::string > names = ( Type::string == value.mType )
+						? std::vector< std::string >( 1, value.mStringValue ) : _getNames( value, "type" );
+
+					uint8_t types = 0;
+					for ( const std::string& name : names )
+					{
+						auto mask = TYPE_MASK_MAP.find( name );
+						if ( TYPE_MASK_MAP.end() == mask )
+						{
+							_fail( "unknown type '" + name + "'" );
+						}
+
+						types |= mask->second;
+					}
+
+					mNodes[ index ].types &= types;
+				}
+				else if ( ( "enum" == keyword ) or ( "const" == keyword ) )
+				{
+					if ( ( "enum" == keyword ) and ( Type::array != value.mType ) )
+					{
+						_fail( "'enum' must be an array" );
+					}
+
+					mNodes[ index ].enumeration = ( "enum" == keyword ) ? value.mElements : ArrayType( 1, value );
+					mNodes[ index ].hasEnumeration = true;
+				}
+				else if ( "multipleOf" == keyword )
+				{
+					mNodes[ index ].multipleOf = _getNumber( value, "multipleOf" );
+					if ( not ( 0 < mNodes[ index ].multipleOf ) )
+					{
+						_fail( "'multipleOf' must be greater than 0" );
+					}
+				}
+				else if ( "minimum" == keyword )
+				{
+					mNodes[ index ].minimum = _getNumber( value, "minimum" );
+				}
+				else if ( "exclusiveMinimum" == keyword )
+				{
+					mNodes[ index ].exclusiveMinimum = _getNumber( value, "exclusiveMinimum" );
+				}
+				else if ( "maximum" == keyword )
+				{
+					mNodes[ index ].maximum = _getNumber( value, "maximum" );
+				}
+				else if ( "exclusiveMaximum" == keyword )
+				{
+					mNodes[ index ].exclusiveMaximum = _getNumber( value, "exclusiveMaximum" );
+				}
+				else if ( "minLength" == keyword )
+				{
+					mNodes[ index ].minLength = _getCount( value, "minLength" );
+				}
+				else if ( "maxLength" == keyword )
+				{
+					mNodes[ index ].maxLength = _getCount( value, "maxLength" );
+				}
+				else if ( "pattern" == keyword )
+				{
+					mNodes[ index ].pattern = _compilePattern( value );
+				}
+				else if ( "prefixItems" == keyword )
+				{
+					std::vector< size_t > nodes = _compileList( value, compiler, "prefixItems" );
+					mNodes[ index ].prefixItems = std::move( nodes );
+				}
+				else if ( "items" == keyword )
+				{
+					const size_t node = _compile( value, compiler );
+					mNodes[ index ].items = node;
+				}
+				else if ( "contains" == keyword )
+				{
+					const size_t node = _compile( value, compiler );
+					mNodes[ index ].contains = node;
+				}
+				else if ( "minContains" == keyword )
+				{
+					mNodes[ index ].minContains = _getCount( value, "minContains" );
+				}
+				else if ( "maxContains" == keyword )
+				{
+					mNodes[ index ].maxContains = _getCount( value, "maxContains" );
+				}
+				else if ( "minItems" == keyword )
+				{
+					mNodes[ index ].minItems = _getCount( value, "minItems" );
+				}
+				else if ( "maxItems" == keyword )
+				{
+					mNodes[ index ].maxItems = _getCount( value, "maxItems" );
+				}
+				else if ( "uniqueItems" == keyword )
+				{
+					mNodes[ index ].uniqueItems = ( Type::boolean == value.mType ) and value.mBoolean;
+				}
+				else if ( "properties" == keyword )
+				{
+					if ( Type::object != value.mType )
+					{
+						_fail( "'properties' must be an object" );
+					}
+
+					// The members are visited in name order, so the properties are sorted for lookup.
+					std::vector< std::pair< std::string, size_t > > properties;
+					for ( const auto& property : value.mMembers )
+					{
+						properties.emplace_back( property.first, _compile( property.second, compiler ) );
+					}
+
+					mNodes[ index ].properties = std::move( properties );
+				}
+				else if ( "patternProperties" == keyword )
+				{
+					if ( Type::object != value.mType )
+					{
+						_fail( "'patternProperties' must be an object" );
+					}
+
+					std::vector< std::pair< size_t, size_t > > patternProperties;
+					for ( const auto& property : value.mMembers )
+					{
+						const size_t pattern = _compilePattern( JsonValue( std::string( property.first ) ) );
+						patternProperties.emplace_back( pattern, _compile( property.second, compiler ) );
+					}
+
+					mNodes[ index ].patternProperties = std::move( patternProperties );
+				}
+				else if ( "additionalProperties" == keyword )
+				{
+					const size_t node = _compile( value, compiler );
+					mNodes[ index ].additionalProperties = node;
+				}
+				else if ( "propertyNames" == keyword )
+				{
+					const size_t node = _compile( value, compiler );
+					mNodes[ index ].propertyNames = node;
+				}
+				else if ( "required" == keyword )
+				{
+					mNodes[ index ].required = _getNames( value, "required" );
+				}
+				else if ( "dependentRequired" == keyword )
+				{
+					if ( Type::object != value.mType )
+					{
+						_fail( "'dependentRequired' must be an object" );
+					}
+
+					for ( const auto& dependency : value.mMembers )
+					{
+						mNodes[ index ].dependentRequired.emplace_back( dependency.first,
+							_getNames( dependency.second, "dependentRequired" ) );
+					}
+				}
+				else if ( "dependentSchemas" == keyword )
+				{
+					if ( Type::object != value.mType )
+					{
+						_fail( "'dependentSchemas' must be an object" );
+					}
+
+					std::vector< std::pair< std::string, size_t > > dependentSchemas;
+					for ( const auto& dependency : value.mMembers )
+					{
+						dependentSchemas.emplace_back( dependency.first, _compile( dependency.second, compiler ) );
+					}
+
+					mNodes[ index ].dependentSchemas = std::move( dependentSchemas );
+				}
+				else if ( "minProperties" == keyword )
+				{
+					mNodes[ index ].minProperties = _getCount( value, "minProperties" );
+				}
+				else if ( "maxProperties" == keyword )
+				{
+					mNodes[ index ].maxProperties = _getCount( value, "maxProperties" );
+				}
+				else if ( "allOf" == keyword )
+				{
+					std::vector< size_t > nodes = _compileList( value, compiler, "allOf" );
+					mNodes[ index ].allOf.insert( mNodes[ index ].allOf.end(), nodes.begin(), nodes.end() );
+				}
+				else if ( "anyOf" == keyword )
+				{
+					std::vector< size_t > nodes = _compileList( value, compiler, "anyOf" );
+					mNodes[ index ].anyOf = std::move( nodes );
+				}
+				else if ( "oneOf" == keyword )
+				{
+					std::vector< size_t > nodes = _compileList( value, compiler, "oneOf" );
+					mNodes[ index ].oneOf = std::move( nodes );
+				}
+				else if ( "not" == keyword )
+				{
+					const size_t node = _compile( value, compiler );
+					mNodes[ index ].negation = node;
+				}
+				else if ( "if" == keyword )
+				{
+					const size_t node = _compile( value, compiler );
+					mNodes[ index ].condition = node;
+				}
+				else if ( "then" == keyword )
+				{
+					const size_t node = _compile( value, compiler );
+					mNodes[ index ].consequence = node;
+				}
+				else if ( "else" == keyword )
+				{
+					const size_t node = _compile( value, compiler );
+					mNodes[ index ].alternative = node;
+				}
+				else if ( "$ref" == keyword )
+				{
+					if ( Type::string != value.mType )
+					{
+						_fail( "'$ref' must be a string" );
+					}
+
+					const size_t node = _compile( _resolve( value.mStringValue, compiler ), compiler );
+					mNodes[ index ].allOf.push_back( node );
+				}
+				else if ( ( "$anchor" == keyword ) or ( "$dynamicAnchor" == keyword ) or ( "$dynamicRef" == keyword )
+					or ( "$recursiveAnchor" == keyword ) or ( "$recursiveRef" == keyword ) or ( "additionalItems" == keyword )
+					or ( "dependencies" == keyword ) or ( "unevaluatedItems" == keyword ) or ( "unevaluatedProperties" == keyword ) )
+				{
+					_fail( "'" + keyword + "' is not supported" );
+				}
+			}
+
+			Node& node = mNodes[ index ];
+			node.isDeferred = node.hasEnumeration or node.uniqueItems or ( NO_NODE != node.contains )
+				or ( not node.dependentSchemas.empty() ) or ( not node.anyOf.empty() ) or ( not node.oneOf.empty() ) or ( NO_NODE != node.negation )
+				or ( NO_NODE != node.condition );
+			return index;
+		}
+
+		// Append the nodes of {@param index}'s conjunction that {@param states} does not hold yet
+		void _expand( size_t index, std::vector< size_t >& states ) const
+		{
+			for ( size_t node : mNodes[ index ].conjunction )
+			{
+				if ( states.end() == std::find( states.begin(), states.end(), node ) )
+				{
+					states.push_back( node );
+				}
+			}
+		}
+
+		// Count the code points of the UTF-8 string {@param string}
+		static size_t _countCodePoints( const std::string& string ) noexcept
+		{
+			size_t count = 0;
+			for ( char byte : string )
+			{
+				count += ( 0x80 != ( uint8_t( byte ) & 0xC0 ) ) ? 1 : 0;
+			}
+
+			return count;
+		}
+
+		// Check the type, number and string keywords of {@param node}
+		bool _acceptsScalar( const JsonValue& value, const Node& node ) const
+		{
+			switch ( value.mType )
+			{
+			case Type::null:
+				return 0 != ( node.types & NULL_TYPE );
+
+			case Type::boolean:
+				return 0 != ( node.types & BOOLEAN_TYPE );
+
+			case Type::object:
+				return 0 != ( node.types & OBJECT_TYPE );
+
+			case Type::array:
+				return 0 != ( node.types & ARRAY_TYPE );
+
+			case Type::string:
+				if ( 0 == ( node.types & STRING_TYPE ) )
+				{
+					return false;
+				}
+
+				if ( ( 0 < node.minLength ) or ( SIZE_MAX != node.maxLength ) )
+				{
+					const size_t length = _countCodePoints( value.mStringValue );
+					if ( ( length < node.minLength ) or ( node.maxLength < length ) )
+					{
+						return false;
+					}
+				}
+
+				return ( NO_NODE == node.pattern ) or std::regex_search( value.mStringValue, mPatterns[ node.pattern ] );
+
+			case Type::number:
+			{
+				const long double number = value._toLongDouble();
+				const bool isIntegral = ( eNumberType::SIGNED_INTEGRAL == value.mNumericType )
+					or ( eNumberType::UNSIGNED_INTEGRAL == value.mNumericType )
+					or ( eNumberType::MULTIPLE_PRECISION_INTEGRAL == value.mNumericType )
+					or ( std::isfinite( number ) and ( std::floor( number ) == number ) );
+
+				if ( 0 == ( node.types & ( isIntegral ? ( NUMBER_TYPE | INTEGER_TYPE ) : NUMBER_TYPE ) ) )
+				{
+					return false;
+				}
+
+				if ( ( number < node.minimum ) or ( number <= node.exclusiveMinimum )
+					or ( node.maximum < number ) or ( node.exclusiveMaximum <= number ) )
+				{
+					return false;
+				}
+
+				const long double quotient = ( 0 < node.multipleOf ) ? ( number / node.multipleOf ) : 0.0L;
+				return std::isfinite( quotient ) and ( std::floor( quotient ) == quotient );
+			}
+
+			default:
+				return false;
+			}
+		}
+
+		// Collect into {@param states} the nodes that the member {@param key} of an
+		// object must match under {@param node}. Returns false if the name is rejected.
+		bool _collectMember( const Node& node, const JsonValue& key, std::vector< size_t >& states ) const
+		{
+			if ( ( NO_NODE != node.propertyNames ) and not _accepts( key, node.propertyNames ) )
+			{
+				return false;
+			}
+
+			bool isAdditional = true;
+			auto property = std::lower_bound( node.properties.begin(), node.properties.end(), key.mStringValue,
+				[]( const std::pair< std::string, size_t >& entry, const std::string& name )
+				{
+					return entry.first < name;
+				} );
+
+			if ( ( node.properties.end() != property ) and ( key.mStringValue == property->first ) )
+			{
+				_expand( property->second, states );
+				isAdditional = false;
+			}
+
+			for ( const auto& patternProperty : node.patternProperties )
+			{
+				if ( std::regex_search( key.mStringValue, mPatterns[ patternProperty.first ] ) )
+				{
+					_expand( patternProperty.second, states );
+					isAdditional = false;
+				}
+			}
+
+			if ( isAdditional and ( NO_NODE != node.additionalProperties ) )
+			{
+				_expand( node.additionalProperties, states );
+			}
+
+			return true;
+		}
+
+		// Collect into {@param states} the nodes that the element at {@param position} of an array must match under {@param node}
+		void _collectElement( const Node& node, size_t position, std::vector< size_t >& states ) const
+		{
+			if ( position < node.prefixItems.size() )
+			{
+				_expand( node.prefixItems[ position ], states );
+			}
+			else if ( NO_NODE != node.items )
+			{
+				_expand( node.items, states );
+			}
+		}
+
+		// Check the keywords of {@param node} that hold over a complete object
+		static bool _acceptsObject( const JsonValue& value, const Node& node ) noexcept
+		{
+			if ( ( value.mMembers.size() < node.minProperties ) or ( node.maxProperties < value.mMembers.size() ) )
+			{
+				return false;
+			}
+
+			for ( const std::string& name : node.required )
+			{
+				if ( value.mMembers.end() == value.mMembers.find( name ) )
+				{
+					return false;
+				}
+			}
+
+			for ( const auto& dependency : node.dependentRequired )
+			{
+				if ( value.mMembers.end() != value.mMembers.find( dependency.first ) )
+				{
+					for ( const std::string& name : dependency.second )
+					{
+						if ( value.mMembers.end() == value.mMembers.find( name ) )
+						{
+							return false;
+						}
+					}
+				}
+			}
+
+			return true;
+		}
+
+		// Check the keywords of {@param node} that need the complete value
+		bool _acceptsDeferred( const JsonValue& value, const Node& node ) const
+		{
+			if ( not node.isDeferred )
+			{
+				return true;
+			}
+
+			if ( node.hasEnumeration and ( node.enumeration.end() == std::find_if( node.enumeration.begin(), node.enumeration.end(),
+				[ &value ]( const JsonValue& candidate )
+				{
+					return _equivalent( candidate, value );
+				} ) ) )
+			{
+				return false;
+			}
+
+			if ( Type::array == value.mType )
+			{
+				if ( node.uniqueItems )
+				{
+					std::unordered_multimap< size_t, const JsonValue* > seen;
+					for ( const JsonValue& element : value.mElements )
+					{
+						const size_t hash = element.hash();
+						auto candidates = seen.equal_range( hash );
+						for ( auto candidate = candidates.first; candidate != candidates.second; ++candidate )
+						{
+							if ( _equivalent( *candidate->second, element ) )
+							{
+								return false;
+							}
+						}
+
+						seen.emplace( hash, &element );
+					}
+				}
+
+				if ( NO_NODE != node.contains )
+				{
+					size_t count = 0;
+					for ( const JsonValue& element : value.mElements )
+					{
+						count += _accepts( element, node.contains ) ? 1 : 0;
+					}
+
+					if ( ( count < node.minContains ) or ( node.maxContains < count ) )
+					{
+						return false;
+					}
+				}
+			}
+
+			if ( Type::object == value.mType )
+			{
+				for ( const auto& dependency : node.dependentSchemas )
+				{
+					if ( ( value.mMembers.end() != value.mMembers.find( dependency.first ) ) and not _accepts( value, dependency.second ) )
+					{
+						return false;
+					}
+				}
+			}
+
+			if ( ( not node.anyOf.empty() ) and std::none_of( node.anyOf.begin(), node.anyOf.end(),
+				[ this, &value ]( size_t branch )
+				{
+					return _accepts( value, branch );
+				} ) )
+			{
+				return false;
+			}
+
+			if ( ( not node.oneOf.empty() ) and ( 1 != std::count_if( node.oneOf.begin(), node.oneOf.end(),
+				[ this, &value ]( size_t branch )
+				{
+					return _accepts( value, branch );
+				} ) ) )
+			{
+				return false;
+			}
+
+			if ( ( NO_NODE != node.negation ) and _accepts( value, node.negation ) )
+			{
+				return false;
+			}
+
+			if ( NO_NODE != node.condition )
+			{
+				const size_t branch = _accepts( value, node.condition ) ? node.consequence : node.alternative;
+				return ( NO_NODE == branch ) or _accepts( value, branch );
+			}
+
+			return true;
+		}
+
+		// Check {@param value} against a single node, leaving its conjunction to the caller
+		bool _acceptsNode( const JsonValue& value, size_t index ) const
+		{
+			const Node& node = mNodes[ index ];
+			if ( not _acceptsScalar( value, node ) )
+			{
+				return false;
+			}
+
+			std::vector< size_t > states;
+
+			if ( Type::object == value.mType )
+			{
+				if ( not _acceptsObject( value, node ) )
+				{
+					return false;
+				}
+
+				JsonValue key( Type::string );
+				for ( const auto& member : value.mMembers )
+				{
+					states.clear();
+					key.mStringValue = member.first;
+					if ( not _collectMember( node, key, states ) )
+					{
+						return false;
+					}
+
+					for ( size_t state : states )
+					{
+						if ( not _acceptsNode( member.second, state ) )
+						{
+							return false;
+						}
+					}
+				}
+			}
+			else if ( Type::array == value.mType )
+			{
+				if ( ( value.mElements.size() < node.minItems ) or ( node.maxItems < value.mElements.size() ) )
+				{
+					return false;
+				}
+
+				for ( size_t position( 0 ); position < value.mElements.size(); ++position )
+				{
+					states.clear();
+					_collectElement( node, position, states );
+					for ( size_t state : states )
+					{
+						if ( not _acceptsNode( value.mElements[ position ], state ) )
+						{
+							return false;
+						}
+					}
+				}
+			}
+
+			return _acceptsDeferred( value, node );
+		}
+
+		// Check {@param value} against the node {@param index} and its conjunction
+		bool _accepts( const JsonValue& value, size_t index ) const
+		{
+			for ( size_t node : mNodes[ index ].conjunction )
+			{
+				if ( not _acceptsNode( value, node ) )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		// The types that a value starting with {@param character} may have
+		static uint8_t _getCandidateTypes( char character ) noexcept
+		{
+			switch ( character )
+			{
+			case '{':
+				return OBJECT_TYPE;
+
+			case '[':
+				return ARRAY_TYPE;
+
+			case '"':
+				return STRING_TYPE;
+
+			case 't':
+			case 'f':
+				return BOOLEAN_TYPE;
+
+			case 'n':
+				return NULL_TYPE;
+
+			default:
+				// Anything else is left for the parser to report.
+				return ( ( '-' == character ) or isdigit( static_cast< unsigned char >( character ) ) )
+					? uint8_t( NUMBER_TYPE | INTEGER_TYPE ) : uint8_t( ALL_TYPES );
+			}
+		}
+
+		// Parse a value from {@param source} into {@param target}, checking it against
+		// every node of {@param states} as it is read.
+		void _parse( ParseSource& source, JsonValue& target, const std::vector< size_t >& states ) const
+		{
+			_parseWhitespace( source );
+
+			const uint8_t candidates = _getCandidateTypes( source.peek() );
+			for ( size_t state : states )
+			{
+				if ( 0 == ( mNodes[ state ].types & candidates ) )
+				{
+					throw ParseError( "validate", source );
+				}
+			}
+
+			if ( '{' == source.peek() )
+			{
+				_parseObject( source, target, states );
+			}
+			else if ( '[' == source.peek() )
+			{
+				_parseArray( source, target, states );
+			}
+			else
+			{
+				target._parseValue( source );
+
+				for ( size_t state : states )
+				{
+					if ( not _acceptsScalar( target, mNodes[ state ] ) )
+					{
+						throw ParseError( "validate", source );
+					}
+				}
+			}
+
+			for ( size_t state : states )
+			{
+				if ( not _acceptsDeferred( target, mNodes[ state ] ) )
+				{
+					throw ParseError( "validate", source );
+				}
+			}
+		}
+
+		// Parse an object, routing each member to the nodes it must match
+		void _parseObject( ParseSource& source, JsonValue& target, const std::vector< size_t >& states ) const
+		{
+			source.update();
+			_parseWhitespace( source );
+			target.mType = Type::object;
+
+			JsonValue key;
+			std::vector< size_t > memberStates;
+			while ( ( not source.endOfSource() ) and ( '}' != source.peek() ) )
+			{
+				key._parseString( source );
+				_parseWhitespace( source );
+
+				if ( ':' != source.peek() )
+				{
+					throw ParseError( "parseObject", source );
+				}
+
+				source.update();
+				memberStates.clear();
+				for ( size_t state : states )
+				{
+					if ( not _collectMember( mNodes[ state ], key, memberStates ) )
+					{
+						throw ParseError( "validate", source );
+					}
+				}
+
+				JsonValue& member = target.mMembers[ key.mStringValue ];
+				member.clear();
+
+				for ( size_t state : states )
+				{
+					if ( mNodes[ state ].maxProperties < target.mMembers.size() )
+					{
+						throw ParseError( "validate", source );
+					}
+				}
+
+				_parse( source, member, memberStates );
+				_parseWhitespace( source );
+
+				if ( ',' == source.peek() )
+				{
+					source.update();
+					_parseWhitespace( source );
+
+					if ( '"' != source.peek() )
+					{
+						throw ParseError( "parseObject", source );
+					}
+				}
+				else if ( '}' != source.peek() )
+				{
+					throw ParseError( "parseObject", source );
+				}
+			}
+
+			if ( '}' != source.peek() )
+			{
+				throw ParseError( "parseObject", source );
+			}
+
+			source.update();
+
+			for ( size_t state : states )
+			{
+				if ( not _acceptsObject( target, mNodes[ state ] ) )
+				{
+					throw ParseError( "validate", source );
+				}
+			}
+		}
+
+		// Parse an array, routing each element to the nodes it must match
+		void _parseArray( ParseSource& source, JsonValue& target, const std::vector< size_t >& states ) const
+		{
+			source.update();
+			_parseWhitespace( source );
+			target.mType = Type::array;
+
+			std::vector< size_t > elementStates;
+			while ( ( not source.endOfSource() ) and ( ']' != source.peek() ) )
+			{
+				const size_t position = target.mElements.size();
+				elementStates.clear();
+				for ( size_t state : states )
+				{
+					if ( mNodes[ state ].maxItems <= position )
+					{
+						throw ParseError( "validate", source );
+					}
+
+					_collectElement( mNodes[ state ], position, elementStates );
+				}
+
+				target.mElements.emplace_back();
+				_parse( source, target.mElements.back(), elementStates );
+				_parseWhitespace( source );
+
+				if ( ',' == source.peek() )
+				{
+					source.update();
+					_parseWhitespace( source );
+
+					if ( ']' == source.peek() )
+					{
+						throw ParseError( "parseArray", source );
+					}
+				}
+				else if ( ']' != source.peek() )
+				{
+					throw ParseError( "parseArray", source );
+				}
+			}
+
+			if ( ']' != source.peek() )
+			{
+				throw ParseError( "parseArray", source );
+			}
+
+			source.update();
+
+			for ( size_t state : states )
+			{
+				if ( target.mElements.size() < mNodes[ state ].minItems )
+				{
+					throw ParseError( "validate", source );
+				}
+			}
+		}
+
+		// Parse the document in {@param source} into {@param target}, validating it as it is read
+		void _parseSource( ParseSource& source, JsonValue& target ) const
+		{
+			std::vector< size_t > states;
+			_expand( 0, states );
+			_parse( source, target, states );
+			_parseWhitespace( source );
+		}
+
+	public:
+		/**
+		 * Compile a JSON Schema into a table of validation nodes.
+		 * @param schema Const reference to the schema document, an object or a boolean.
+		 * @throw std::invalid_argument is thrown if the schema is malformed, or uses an unsupported keyword.
+		 */
+		Schema( const JsonValue& schema )
+		{
+			Compiler compiler { schema, {} };
+			_compile( schema, compiler );
+
+			// Gather, once, the nodes that must hold together with each node.
+			for ( Node& node : mNodes )
+			{
+				std::vector< size_t > pending( 1, size_t( &node - mNodes.data() ) );
+				while ( not pending.empty() )
+				{
+					const size_t index = pending.back();
+					pending.pop_back();
+
+					if ( node.conjunction.end() == std::find( node.conjunction.begin(), node.conjunction.end(), index ) )
+					{
+						node.conjunction.push_back( index );
+						pending.insert( pending.end(), mNodes[ index ].allOf.begin(), mNodes[ index ].allOf.end() );
+					}
+				}
+			}
+		}
+
+		/**
+		 * Check a document against the schema.
+		 * @param document Const reference to the JsonValue to check.
+		 * @return True if the document is valid under the schema, false otherwise.
+		 */
+		bool validate( const JsonValue& document ) const
+		{
+			return _accepts( document, 0 );
+		}
+	};
+
+	/**
+	 * A field of a bound type: the name of a JSON member, and the member of the
+	 * C++ type it is read into. Created by bind(), and listed by the jsonFields()
+	 * function of the bound type, see parseInto().
+	 */
+	template < typename Owner, typename Member >
+	struct Field
+	{
+		const char* name;        ///< The name of the JSON member.
+		size_t length;           ///< The length of the name.
+		Member Owner::* member;  ///< The member the JSON member is read into.
+	};
+
+	/**
+	 * Default constructor.
+	 * @param type Type to initialize the JsonValue to. [default: undefined]
+	 */
+	JsonValue( Type type = Type::undefined ) noexcept
+	{
+		_initPrimitiveVariables( type );
+	}
+
+	/**
+	 * Copy constructor.
+	 * @param other Const reference to the JsonValue to copy.
+	 */
+	JsonValue( const JsonValue& other )
+	{
+		_copyAssign( other );
+	}
+
+	/**
+	 * Move constructor.
+	 * @param other R-Value of the JsonValue to move to this instance.
+	 */
+	JsonValue( JsonValue&& other ) noexcept
+	{
+		_moveAssign( std::move( other ) );
+	}
+
+	/**
+	 * Object copy initialization constructor.
+	 * @param object Const reference to an ObjectType to initialize the JsonValue to.
+	 */
+	JsonValue( const ObjectType& object )
+	{
+		_initPrimitiveVariables( Type::object );
+		mMembers = object;
+	}
+
+	/**
+	 * Object move initialization constructor.
+	 * @param object R-Value to an ObjectType to initialize the JsonValue to.
+	 */
+	JsonValue( ObjectType&& object )
+	{
+		_initPrimitiveVariables( Type::object );
+		mMembers = std::move( object );
+	}
+
+	/**
+	 * Array copy initialization constructor.
+	 * @param array Const reference to an ArrayType to initialize the JsonValue to.
+	 */
 	JsonValue( const ArrayType& array )
 	{
-		_initPrimitiveVariables( Type::array );
-		mElements = array;
+		_initPrimitiveVariables( Type::array );
+		mElements = array;
+	}
+
+	/**
+	 * Array move initialization constructor.
+	 * @param array R-Value to an ArrayType to initialize the JsonValue to.
+	 */
+	JsonValue( ArrayType&& array )
+	{
+		_initPrimitiveVariables( Type::array );
+		mElements = std::move( array );
+	}
+
+	/**
+	 * String copy initialization constructor.
+	 * @param string Const reference to a string to initialize the JsonValue to.
+	 */
+	JsonValue( const std::string& string )
+	{
+		_initPrimitiveVariables( Type::string );
+		mStringValue = string;
+	}
+
+	/**
+	 * String move initialization constructor.
+	 * @param string R-Value to a string to initialize the JsonValue to.
+	 */
+	JsonValue( std::string&& string )
+	{
+		_initPrimitiveVariables( Type::string );
+		mStringValue = std::move( string );
+	}
+
+	/**
+	 * Boolean initialization constructor.
+	 * @param boolean Boolean value to initialize the JsonValue to.
+	 */
+	JsonValue( bool boolean )
+	{
+		_initPrimitiveVariables( Type::boolean );
+		mBoolean = boolean;
+	}
+
+	/**
+	 * Arithmetic number initialization constructor.
+	 * @param arithmeticValue An arithmetic number to initialize the JsonValue with.
+	 */
+	template < typename ArithmeticType,
+		typename = typename std::enable_if< std::is_arithmetic< ArithmeticType >::value >::type >
+	JsonValue( ArithmeticType arithmeticValue )
+	{
+		_initPrimitiveVariables( Type::number );
+
+		if ( std::is_floating_point< ArithmeticType >::value )
+		{
+			mNumericType = eNumberType::FLOATING;
+			mNumericValue.floatValue = arithmeticValue;
+		}
+		else if ( std::is_unsigned< ArithmeticType >::value )
+		{
+			mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+			mNumericValue.unsignedIntegral = arithmeticValue;
+		}
+		else
+		{
+			mNumericType = eNumberType::SIGNED_INTEGRAL;
+			mNumericValue.signedIntegral = arithmeticValue;
+		}
+	}
+
+#ifdef INCLUDE_GMP
+	/**
+	 * Multiple precision integral copy initialization constructor.
+	 * @param array Const reference to an ArrayType to initialize the JsonValue to.
+	 */
+	JsonValue( mpz_t multiplePrecisionIntegral )
+	{
+		_initPrimitiveVariables( Type::number );
+		mNumericType = eNumberType::MULTIPLE_PRECISION_INTEGRAL;
+		mpz_init_set( mNumericValue.MPIntegralValue, multiplePrecisionIntegral );
+	}
+
+	/**
+	 * Multiple precision floating copy initialization constructor.
+	 * @param array Const reference to an ArrayType to initialize the JsonValue to.
+	 */
+	JsonValue( mpf_t multiplePrecisionFloat )
+	{
+		_initPrimitiveVariables( Type::number );
+		mNumericType = eNumberType::MULTIPLE_PRECISION_FLOAT;
+		mpf_init_set( mNumericValue.MPFloatValue, multiplePrecisionFloat );
+	}
+#endif
+
+	/**
+	 * Null initialization constructor.
+	 */
+	JsonValue( std::nullptr_t )
+	{
+		_initPrimitiveVariables( Type::null );
+	}
+
+	/**
+	 * Destructor.
+	 */
+	~JsonValue()
+	{
+		this->clear();
+	}
+
+	/**
+	 * Apply a JSON Patch to this instance in place.
+	 * Reference: https://www.rfc-editor.org/rfc/rfc6902
+	 * All six operations are supported: add, remove, replace, move, copy and test.
+	 * Note(s):
+	 *    - The patch is compiled before it is applied, so a malformed patch changes nothing.
+	 *      Each path is compiled to a Pointer once, and resolved without being parsed again.
+	 *    - Values are moved rather than copied where the patch allows: move takes the value
+	 *      out of its place and into its new one, and replaced or removed values are moved
+	 *      into the undo log rather than copied. Only the values the patch itself holds, and
+	 *      those copy duplicates, are copied.
+	 *    - An atomic patch logs how to reverse each change as it is made. Should an operation
+	 *      fail, the changes made so far are reversed from the log, last first, so the document
+	 *      is as it was without having been copied beforehand. A patch that is not atomic keeps
+	 *      the operations before the one that failed, which itself changes nothing.
+	 * @param patch Const reference to the patch, an array of operation objects.
+	 * @param isAtomic Reverse the changes made if an operation fails. [default: true]
+	 * @throw std::invalid_argument is thrown if the patch is malformed, or holds a malformed pointer.
+	 * @throw std::runtime_error is thrown if an operation fails: a path does not exist, a test
+	 *        fails, or a value is moved into itself.
+	 */
+	void applyPatch( const JsonValue& patch, bool isAtomic = true )
+	{
+		const std::vector< PatchOperation > operations = _compilePatch( patch );
+		PatchLog log;
+
+		try
+		{
+			for ( const PatchOperation& operation : operations )
+			{
+				_applyPatchOperation( operation, isAtomic ? &log : nullptr );
+			}
+		}
+		catch ( ... )
+		{
+			_undoPatch( log );
+			throw;
+		}
+	}
+
+	/**
+	 * Non-throwing element access for array type JsonValue instances.
+	 * Negative indices count back from the end of the array. The array is never resized.
+	 * @param index Index into the array.
+	 * @return Pointer to the element JsonValue is returned, or a null pointer if the
+	 *         JsonValue is not an array or the index is out of range.
+	 */
+	template < typename IntegralType,
+		typename = typename std::enable_if< std::is_integral< IntegralType >::value >::type >
+	JsonValue* at( IntegralType index ) noexcept
+	{
+		return const_cast< JsonValue* >( static_cast< const JsonValue* >( this )->at( index ) );
+	}
+
+	/**
+	 * Non-throwing element access for array type JsonValue instances.
+	 * Negative indices count back from the end of the array.
+	 * @param index Index into the array.
+	 * @return Const pointer to the element JsonValue is returned, or a null pointer if
+	 *         the JsonValue is not an array or the index is out of range.
+	 */
+	template < typename IntegralType,
+		typename = typename std::enable_if< std::is_integral< IntegralType >::value >::type >
+	const JsonValue* at( IntegralType index ) const noexcept
+	{
+		if ( Type::array != mType )
+		{
+			return nullptr;
+		}
+
+		size_t absoluteIndex = size_t( index );
+		if ( std::is_signed< IntegralType >::value and ( index < IntegralType( 0 ) ) )
+		{
+			// Negate as ( -( index + 1 ) + 1 ) to stay clear of overflow for the minimum value.
+			size_t distanceFromEnd = size_t( -( index + 1 ) ) + 1;
+			if ( mElements.size() < distanceFromEnd )
+			{
+				return nullptr;
+			}
+
+			absoluteIndex = mElements.size() - distanceFromEnd;
+		}
+
+		return ( absoluteIndex < mElements.size() ) ? &mElements[ absoluteIndex ] : nullptr;
+	}
+
+	/**
+	 * Return an iterator to the beginning of either an object or array JsonValue instance.
+	 * @return The iterator to the beginning of either an object or array JsonValue instance.
+	 * @throw std::runtime_error is thrown if the JsonValue type is non-iterable.
+	 */
+	iterator begin()
+	{
+		if ( JsonValue::Type::object == mType )
+		{
+			return iterator( mMembers.begin() );
+		}
+
+		if ( JsonValue::Type::array == mType )
+		{
+			return iterator( mElements.begin() );
+		}
+
+		throw std::runtime_error( "Cannot create iterator for non-iterable type: " + _getTypeString() );
+	}
+
+	/**
+	 * Return a const_iterator to the beginning of either an object or array JsonValue instance.
+	 * @return The const_iterator to the beginning of either an object or array JsonValue instance.
+	 * @throw std::runtime_error is thrown if the JsonValue type is non-iterable.
+	 */
+	const_iterator begin() const
+	{
+		if ( JsonValue::Type::object == mType )
+		{
+			return const_iterator( mMembers.cbegin() );
+		}
+
+		if ( JsonValue::Type::array == mType )
+		{
+			return const_iterator( mElements.cbegin() );
+		}
+
+		throw std::runtime_error( "Cannot create iterator for non-iterable type: " + _getTypeString() );
+	}
+
+	/**
+	 * Bind the JSON member {@param name} to a member of a C++ type, for listing in the
+	 * jsonFields() function of the type, see parseInto().
+	 * @param name The name of the JSON member, a string literal.
+	 * @param member Pointer to the member the JSON member is read into.
+	 * @return The Field binding the two.
+	 */
+	template < typename Owner, typename Member, size_t Length >
+	static constexpr Field< Owner, Member > bind( const char ( &name )[ Length ], Member Owner::* member ) noexcept
+	{
+		return Field< Owner, Member > { name, Length - 1, member };
+	}
+
+	/**
+	 * Build a secondary hash index over the elements of this array, keyed by the
+	 * value the given pointer refers to within each element.
+	 * @param field Pointer to the key within each element, e.g. "/id".
+	 * @return The Index, which is kept up to date by push_back(), insert(),
+	 *         erase() and pop_back() of this array.
+	 * @throw std::runtime_error is thrown if the JsonValue is not an array.
+	 */
+	Index buildIndex( const Pointer& field )
+	{
+		return Index( *this, field );
+	}
+
+	/**
+	 * Return a const_iterator to the beginning of either an object or array JsonValue instance.
+	 * @return The const_iterator to the beginning of either an object or array JsonValue instance.
+	 * @throw std::runtime_error is thrown if the JsonValue type is non-iterable.
+	 */
+	const_iterator cbegin() const
+	{
+		if ( JsonValue::Type::object == mType )
+		{
+			return const_iterator( mMembers.cbegin() );
+		}
+
+		if ( JsonValue::Type::array == mType )
+		{
+			return const_iterator( mElements.cbegin() );
+		}
+
+		throw std::runtime_error( "Cannot create iterator for non-iterable type: " + _getTypeString() );
+	}
+
+	/**
+	 * Return a const_iterator to the end of either an object or array JsonValue instance.
+	 * @return The const_iterator to the end of either an object or array JsonValue instance.
+	 * @throw std::runtime_error is thrown if the JsonValue type is non-iterable.
+	 */
+	const_iterator cend() const
+	{
+		if ( JsonValue::Type::object == mType )
+		{
+			return const_iterator( mMembers.cend() );
+		}
+
+		if ( JsonValue::Type::array == mType )
+		{
+			return const_iterator( mElements.cend() );
+		}
+
+		throw std::runtime_error( "Cannot create iterator for non-iterable type: " + _getTypeString() );
+	}
+
+	/**
+	 * Clear the contents of this JsonValue instance.
+	 * The type of this JsonValue instance shall be undefined after calling this method.
+	 * Elements and members are released iteratively, so the stack depth does not
+	 * grow with the nesting depth of the document.
+	 */
+	void clear() noexcept
+	{
+#ifdef INCLUDE_GMP
+		switch ( mNumericType )
+		{
+		case eNumberType::MULTIPLE_PRECISION_FLOAT:
+			mpf_clear( mMPFloatValue );
+			break;
+		case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
+			mpz_clear( mMPIntegralValue );
+			break;
+		}
+#endif
+
+		while ( nullptr != mIndexes )
+		{
+			mIndexes->_detach();
+		}
+
+		mType = Type::undefined;
+		mStringValue.clear();
+		_releaseChildren();
+		mBoolean = false;
+		mNumericType = eNumberType::NONE;
+		std::memset( &mNumericValue, 0, sizeof( mNumericValue ) );
+	}
+
+	/**
+	 * Compute a JSON Patch that turns one value into another.
+	 * Reference: https://www.rfc-editor.org/rfc/rfc6902
+	 * Applying the patch to source with applyPatch() yields a value equal to target. Objects
+	 * are compared member by member and arrays element by element, so a change deep within a
+	 * document is patched where it is rather than by replacing what holds it.
+	 * Note(s):
+	 *    - Every subtree of both values is hashed once, bottom up, into a flat table in the
+	 *      order the diff walks them. A subtree whose hash differs from that of its counterpart
+	 *      is known to differ without being compared. One whose hash matches is taken as equal,
+	 *      and not walked further, once a shallow check agrees: the types match, as do the
+	 *      lengths of objects and arrays, and any other values are equal. Two containers that
+	 *      differ only where their hashes collide are thus left unpatched, which hashes of 64
+	 *      bits make unlikely for any but crafted input.
+	 *    - Arrays are aligned on the longest common subsequence of the hashes of their elements,
+	 *      once their common prefix and suffix are trimmed. The elements left out of it are
+	 *      diffed in place, pairwise, and whichever side has elements over is removed or added.
+	 *      Where what remains is too long to align in bounded memory, it is aligned on the
+	 *      elements that occur once on each side instead, as patience diff does.
+	 *    - Numbers are compared by value, so 1 and 1.0 are not told apart.
+	 * @param source Const reference to the value the patch applies to.
+	 * @param target Const reference to the value the patch produces.
+	 * @return The patch, an array of add, remove and replace operations.
+	 */
+	static JsonValue diff( const JsonValue& source, const JsonValue& target )
+	{
+		return diff( source, target, Pointer() );
+	}
+
+	/**
+	 * Compute a JSON Patch that turns one value into another, matching the elements of arrays
+	 * by the value of an identifying member, e.g. the "/id" of each record.
+	 * Reference: https://www.rfc-editor.org/rfc/rfc6902
+	 * Diffs as diff( source, target ) does, except that an array whose elements, on both sides,
+	 * all hold a value at key is aligned on those values rather than on whole elements. A record
+	 * that keeps its key is then diffed where it is, however much of the rest of it changed.
+	 * @param source Const reference to the value the patch applies to.
+	 * @param target Const reference to the value the patch produces.
+	 * @param key Const reference to the Pointer, within each element, to the identifying value.
+	 * @return The patch, an array of add, remove and replace operations.
+	 */
+	static JsonValue diff( const JsonValue& source, const JsonValue& target, const Pointer& key )
+	{
+		DiffContext context { std::vector< DiffHash >(), std::vector< DiffHash >(), key, ArrayType() };
+		_hashTree( source, context.sourceHashes );
+		_hashTree( target, context.targetHashes );
+
+		std::string path;
+		_diff( source, 0, target, 0, path, context );
+		return JsonValue( std::move( context.operations ) );
+	}
+
+	/**
+	 * Write the string representation of this JsonValue out to file.
+	 * By default, the dense representation is generated. If a beautified,
+	 * or human readable, version is desired, then the indent can be set to
+	 * use tabs or spaces. The indentLevel is by default set to 4 for spaces.
+	 * @param jsonFile Pointer to the FILE handle to write to.
+	 * @param indent The character to use for indentation. [default: Indent:NONE]
+	 * @param indentationLevel This parameter is only used if {@param indent} is set
+	 *                         to Indent::SPACE, in which case it is the number of space
+	 *                         characters used for each level of indentation. [default: 4]
+	 */
+	void dump( FILE* jsonFile, Indent indent = Indent::NONE, size_t indentLevel = 4 ) const
+	{
+		JsonSink sink( jsonFile, indent, indentLevel );
+		_writeJSON( *this, sink );
+	}
+
+	/**
+	 * Write the compressed string representation of this JsonValue out to file.
+	 * The text is compressed a block at a time as it is generated, so it is never
+	 * held in whole. The indentation is as for the uncompressed dump.
+	 * @param jsonFile Pointer to the FILE handle to write to.
+	 * @param compression The compression to apply.
+	 * @param indent The character to use for indentation. [default: Indent:NONE]
+	 * @param indentationLevel This parameter is only used if {@param indent} is set
+	 *                         to Indent::SPACE, in which case it is the number of space
+	 *                         characters used for each level of indentation. [default: 4]
+	 * @throw std::runtime_error is thrown if the compression is not available or fails.
+	 */
+	void dump( FILE* jsonFile, Compression compression, Indent indent = Indent::NONE, size_t indentLevel = 4 ) const
+	{
+		JsonSink output( jsonFile, indent, indentLevel );
+		Compressor compressor( output, compression );
+		JsonSink sink( compressor, indent, indentLevel );
+		_writeJSON( *this, sink );
+		compressor.finish();
+	}
+
+	/**
+	 * Write the string representation of this JsonValue out to file.
+	 * By default, the dense representation is generated. If a beautified,
+	 * or human readable, version is desired, then the indent can be set to
+	 * use tabs or spaces. The indentLevel is by default set to 4 for spaces.
+	 * @param jsonOFStream Reference to the std::ofstream to write to.
+	 * @param indent The character to use for indentation. [default: Indent:NONE]
+	 * @param indentationLevel This parameter is only used if {@param indent} is set
+	 *                         to Indent::SPACE, in which case it is the number of space
+	 *                         characters used for each level of indentation. [default: 4]
+	 */
+	void dump( std::ofstream& jsonOFStream, Indent indent = Indent::NONE, size_t indentLevel = 4 ) const
+	{
+		JsonSink sink( jsonOFStream, indent, indentLevel );
+		_writeJSON( *this, sink );
+	}
+
+	/**
+	 * Write the compressed string representation of this JsonValue out to file.
+	 * The text is compressed a block at a time as it is generated, so it is never
+	 * held in whole. The indentation is as for the uncompressed dump.
+	 * @param jsonOFStream Reference to the std::ofstream to write to.
+	 * @param compression The compression to apply.
+	 * @param indent The character to use for indentation. [default: Indent:NONE]
+	 * @param indentationLevel This parameter is only used if {@param indent} is set
+	 *                         to Indent::SPACE, in which case it is the number of space
+	 *                         characters used for each level of indentation. [default: 4]
+	 * @throw std::runtime_error is thrown if the compression is not available or fails.
+	 */
+	void dump( std::ofstream& jsonOFStream, Compression compression, Indent indent = Indent::NONE, size_t indentLevel = 4 ) const
+	{
+		JsonSink output( jsonOFStream, indent, indentLevel );
+		Compressor compressor( output, compression );
+		JsonSink sink( compressor, indent, indentLevel );
+		_writeJSON( *this, sink );
+		compressor.finish();
+	}
+
+	/**
+	 * Write the string representation of this JsonValue out to file.
+	 * By default, the dense representation is generated. If a beautified,
+	 * or human readable, version is desired, then the indent can be set to
+	 * use tabs or spaces. The indentLevel is by default set to 4 for spaces.
+	 * @param jsonString Reference to the std::string to write to.
+	 * @param indent The character to use for indentation. [default: Indent:NONE]
+	 * @param indentationLevel This parameter is only used if {@param indent} is set
+	 *                         to Indent::SPACE, in which case it is the number of space
+	 *                         characters used for each level of indentation. [default: 4]
+	 */
+	void dumps( std::string& jsonString, Indent indent = Indent::NONE, size_t indentLevel = 4 ) const
+	{
+		JsonSink sink( jsonString, indent, indentLevel );
+		_writeJSON( *this, sink );
+	}
+
+	/**
+	 * Write the compressed string representation of this JsonValue out to a string.
+	 * The text is compressed a block at a time as it is generated, so it is never
+	 * held in whole. The indentation is as for the uncompressed dump.
+	 * @param jsonString Reference to the std::string to write to.
+	 * @param compression The compression to apply.
+	 * @param indent The character to use for indentation. [default: Indent:NONE]
+	 * @param indentationLevel This parameter is only used if {@param indent} is set
+	 *                         to Indent::SPACE, in which case it is the number of space
+	 *                         characters used for each level of indentation. [default: 4]
+	 * @throw std::runtime_error is thrown if the compression is not available or fails.
+	 */
+	void dumps( std::string& jsonString, Compression compression, Indent indent = Indent::NONE, size_t indentLevel = 4 ) const
+	{
+		JsonSink output( jsonString, indent, indentLevel );
+		Compressor compressor( output, compression );
+		JsonSink sink( compressor, indent, indentLevel );
+		_writeJSON( *this, sink );
+		compressor.finish();
+	}
+
+	/**
+	 * Return a contiguous view over the elements under the constraint that the JsonValue is an array.
+	 * @return Return a span of the elements.
+	 * @throw An exception is thrown if the JsonValue is not an array.
+	 */
+	span< JsonValue > elements()
+	{
+		if ( Type::array == mType )
+		{
+			return span< JsonValue >( mElements.data(), mElements.size() );
+		}
+
+		throw std::runtime_error( "Operation 'elements()' is not defined for non-array type" );
+	}
+
+	/**
+	 * Return a contiguous view over the elements under the constraint that the JsonValue is an array.
+	 * @return Return a span of the const elements.
+	 * @throw An exception is thrown if the JsonValue is not an array.
+	 */
+	span< const JsonValue > elements() const
+	{
+		if ( Type::array == mType )
+		{
+			return span< const JsonValue >( mElements.data(), mElements.size() );
+		}
+
+		throw std::runtime_error( "Operation 'elements()' is not defined for non-array type" );
+	}
+
+	/**
+	 * Return an iterator to the end of either an object or array JsonValue instance.
+	 * @return The iterator to the end of either an object or array JsonValue instance.
+	 * @throw std::runtime_error is thrown if the JsonValue type is non-iterable.
+	 */
+	iterator end()
+	{
+		if ( JsonValue::Type::object == mType )
+		{
+			return iterator( mMembers.end() );
+		}
+
+		if ( JsonValue::Type::array == mType )
+		{
+			return iterator( mElements.end() );
+		}
+
+		throw std::runtime_error( "Cannot create iterator for non-iterable type: " + _getTypeString() );
+	}
+
+	/**
+	 * Return a const_iterator to the end of either an object or array JsonValue instance.
+	 * @return The const_iterator to the end of either an object or array JsonValue instance.
+	 * @throw std::runtime_error is thrown if the JsonValue type is non-iterable.
+	 */
+	const_iterator end() const
+	{
+		if ( JsonValue::Type::object == mType )
+		{
+			return const_iterator( mMembers.cend() );
+		}
+
+		if ( JsonValue::Type::array == mType )
+		{
+			return const_iterator( mElements.cend() );
+		}
+
+		throw std::runtime_error( "Cannot create iterator for non-iterable type: " + _getTypeString() );
+	}
+
+	/**
+	 * Remove an element from an array type JsonValue instance.
+	 * Indexes built over the array are updated.
+	 * @param position Position of the element to remove.
+	 * @throw std::runtime_error is thrown if the JsonValue is not an array.
+	 * @throw std::out_of_range is thrown if the position exceeds the array.
+	 */
+	void erase( size_t position )
+	{
+		if ( Type::array != mType )
+		{
+			throw std::runtime_error( "Element removal 'erase( size_t )' is not defined for non-array type" );
+		}
+
+		if ( mElements.size() <= position )
+		{
+			throw std::out_of_range( "Position exceeds the length of the array." );
+		}
+
+		mElements.erase( mElements.begin() + position );
+
+		for ( Index* index = mIndexes; nullptr != index; index = index->mNext )
+		{
+			index->_shift( position + 1, -1, &position );
+		}
+	}
+
+private:
+	// Result types of extract() and extractFrom(), one per requested key
+	template < typename KeyType >
+	using _PointerFor = const JsonValue*;
+
+	template < typename KeyType >
+	using _ValueFor = JsonValue;
+
+public:
+	/**
+	 * Look up several members of an object type JsonValue in a single forward pass.
+	 * The keys are ordered once, then the members are walked in key order, so the
+	 * lookups share their traversal instead of each descending the tree separately.
+	 * @param keys The member keys, each either a std::string or a const char*.
+	 * @return A tuple with one const pointer per key, in the order the keys were given.
+	 *         A null pointer is returned for keys that are not present, and for every
+	 *         key if the JsonValue is not an object.
+	 */
+	template < typename... KeyTypes >
+	std::tuple< _PointerFor< KeyTypes >... > extract( const KeyTypes&... keys ) const
+	{
+		constexpr size_t KEY_COUNT = sizeof...( KeyTypes );
+		std::array< KeyView, KEY_COUNT > views {{ KeyView( keys )... }};
+		std::array< size_t, KEY_COUNT > order;
+		std::array< const JsonValue*, KEY_COUNT > found;
+		found.fill( nullptr );
+
+		if ( Type::object == mType )
+		{
+			_extractMembers( views.data(), order.data(), found.data(), KEY_COUNT );
+		}
+
+		return _toTuple( found, std::make_index_sequence< KEY_COUNT >() );
+	}
+
+	/**
+	 * Extract several members of the top level object directly from JSON text, without
+	 * building the rest of the document. Unrequested members are skipped, and reading
+	 * stops as soon as every requested member has been found. If a key is repeated,
+	 * the first occurrence is extracted.
+	 * @param jsonString A string object containing the JSON object.
+	 * @param keys The member keys, each either a std::string or a const char*.
+	 * @return A tuple with one JsonValue per key, in the order the keys were given.
+	 *         Keys that are not present are returned as undefined.
+	 * @throw ParseError is thrown if there is a parsing error or the value is not an object.
+	 */
+	template < typename... KeyTypes >
+	static std::tuple< _ValueFor< KeyTypes >... > extractFrom( const std::string& jsonString, const KeyTypes&... keys )
+	{
+		ParseSource source( jsonString );
+		return _extractFrom( source, keys... );
+	}
+
+	/**
+	 * Extract several members of the top level object directly from a FILE, without
+	 * building the rest of the document. Unrequested members are skipped, and reading
+	 * stops as soon as every requested member has been found. If a key is repeated,
+	 * the first occurrence is extracted.
+	 * @param jsonFile Pointer to the FILE handle from whence to read the JSON object.
+	 * @param keys The member keys, each either a std::string or a const char*.
+	 * @return A tuple with one JsonValue per key, in the order the keys were given.
+	 *         Keys that are not present are returned as undefined.
+	 * @throw ParseError is thrown if there is a parsing error or the value is not an object.
+	 */
+	template < typename... KeyTypes >
+	static std::tuple< _ValueFor< KeyTypes >... > extractFrom( FILE* jsonFile, const KeyTypes&... keys )
+	{
+		ParseSource source( jsonFile );
+		return _extractFrom( source, keys... );
+	}
+
+	/**
+	 * Extract several members of the top level object directly from a std::ifstream,
+	 * without building the rest of the document. Unrequested members are skipped, and
+	 * reading stops as soon as every requested member has been found. If a key is
+	 * repeated, the first occurrence is extracted.
+	 * @param jsonIFStream Reference to a std::ifstream from whence to read the JSON object.
+	 * @param keys The member keys, each either a std::string or a const char*.
+	 * @return A tuple with one JsonValue per key, in the order the keys were given.
+	 *         Keys that are not present are returned as undefined.
+	 * @throw ParseError is thrown if there is a parsing error or the value is not an object.
+	 */
+	template < typename... KeyTypes >
+	static std::tuple< _ValueFor< KeyTypes >... > extractFrom( std::ifstream& jsonIFStream, const KeyTypes&... keys )
+	{
+		ParseSource source( jsonIFStream );
+		return _extractFrom( source, keys... );
+	}
+
+	/**
+	 * Non-throwing member lookup for object type JsonValue instances.
+	 * The member is never added if the key is not present.
+	 * @param key Const reference to the member key.
+	 * @return Pointer to the member JsonValue is returned, or a null pointer if
+	 *         the JsonValue is not an object or the key is not present.
+	 */
+	JsonValue* find( const std::string& key ) noexcept
+	{
+		return const_cast< JsonValue* >( static_cast< const JsonValue* >( this )->find( key ) );
+	}
+
+	/**
+	 * Non-throwing member lookup for object type JsonValue instances.
+	 * @param key Const reference to the member key.
+	 * @return Const pointer to the member JsonValue is returned, or a null pointer
+	 *         if the JsonValue is not an object or the key is not present.
+	 */
+	const JsonValue* find( const std::string& key ) const noexcept
+	{
+		if ( Type::object != mType )
+		{
+			return nullptr;
+		}
+
+		auto member = mMembers.find( key );
+		return ( mMembers.end() != member ) ? &member->second : nullptr;
+	}
+
+	/**
+	 * Non-throwing member lookup for object type JsonValue instances.
+	 * The key is compared in place, no temporary std::string is constructed.
+	 * @param key Pointer to a const char.
+	 * @return Pointer to the member JsonValue is returned, or a null pointer if the
+	 *         JsonValue is not an object, the key is null or the key is not present.
+	 */
+	JsonValue* find( const char* const key ) noexcept
+	{
+		return const_cast< JsonValue* >( static_cast< const JsonValue* >( this )->find( key ) );
+	}
+
+	/**
+	 * Non-throwing member lookup for object type JsonValue instances.
+	 * The key is compared in place, no temporary std::string is constructed.
+	 * @param key Pointer to a const char.
+	 * @return Const pointer to the member JsonValue is returned, or a null pointer if
+	 *         the JsonValue is not an object, the key is null or the key is not present.
+	 */
+	const JsonValue* find( const char* const key ) const noexcept
+	{
+		if ( ( Type::object != mType ) or ( nullptr == key ) )
+		{
+			return nullptr;
+		}
+
+		auto member = mMembers.find( key );
+		return ( mMembers.end() != member ) ? &member->second : nullptr;
+	}
+
+	/**
+	 * Non-throwing lookup of the value referred to by a JSON Pointer.
+	 * @param pointer Const reference to a compiled JSON Pointer.
+	 * @return Pointer to the referenced JsonValue is returned, or a null pointer
+	 *         if the pointer cannot be resolved against this JsonValue.
+	 */
+	JsonValue* find( const Pointer& pointer ) noexcept
+	{
+		return pointer.get( *this );
+	}
+
+	/**
+	 * Non-throwing lookup of the value referred to by a JSON Pointer.
+	 * @param pointer Const reference to a compiled JSON Pointer.
+	 * @return Const pointer to the referenced JsonValue is returned, or a null
+	 *         pointer if the pointer cannot be resolved against this JsonValue.
+	 */
+	const JsonValue* find( const Pointer& pointer ) const noexcept
+	{
+		return pointer.get( *this );
+	}
+
+	/**
+	 * Decode a single BJData value from the given string and assign to this instance.
+	 * BJData is the little endian derivative of UBJSON that adds unsigned integers, half
+	 * precision floats and N-dimensional arrays, which decode to nested arrays, row major.
+	 * Strongly typed, counted arrays are copied out of the source in one piece into elements
+	 * allocated up front. Only fixed width types may be declared for a container.
+	 * @param bjDataString A string object holding the BJData encoded bytes.
+	 * @throw ParseError is thrown if the value is malformed or truncated.
+	 */
+	void fromBJData( const std::string& bjDataString )
+	{
+		this->clear();
+		ParseSource source( bjDataString );
+		_readUBJSON( source, true, 0 );
+	}
+
+	/**
+	 * Decode a single BJData value from the given FILE and assign to this instance.
+	 * A seekable FILE is left positioned right after the value, so a sequence of
+	 * values can be read by repeated calls.
+	 * @param bjDataFile Pointer to a FILE handle from whence to read the BJData value.
+	 * @throw ParseError is thrown if the value is malformed or truncated.
+	 */
+	void fromBJData( FILE* bjDataFile )
+	{
+		this->clear();
+		ParseSource source( bjDataFile );
+		_readUBJSON( source, true, 0 );
+	}
+
+	/**
+	 * Decode a single BJData value from the given std::ifstream and assign to this instance.
+	 * The stream is left positioned right after the value, so a sequence of values can
+	 * be read by repeated calls.
+	 * @param bjDataIFStream Reference to a std::ifstream from whence to read the BJData value.
+	 * @throw ParseError is thrown if the value is malformed or truncated.
+	 */
+	void fromBJData( std::ifstream& bjDataIFStream )
+	{
+		this->clear();
+		ParseSource source( bjDataIFStream );
+		_readUBJSON( source, true, 0 );
+	}
+
+	/**
+	 * Decode a BSON document from the given string and assign to this instance.
+	 * Types JSON has no counterpart for decode to their MongoDB Extended JSON v2 canonical
+	 * forms, such as { "$oid": "<hex>" } for an ObjectId, and binary data to standard base64.
+	 * @param bsonString A string object holding the BSON encoded document.
+	 * @param projection Pointers to the only parts of the document to decode. Elements off
+	 *                   their paths are skipped by their length prefixes without being parsed,
+	 *                   and projected array elements keep their positions. [default: all]
+	 * @throw ParseError is thrown if the document is malformed, truncated, or its lengths disagree.
+	 */
+	void fromBSON( const std::string& bsonString, const std::vector< Pointer >& projection = std::vector< Pointer >() )
+	{
+		this->clear();
+		ParseSource source( bsonString );
+		_readBSON( source, projection );
+	}
+
+	/**
+	 * Decode a BSON document from the given FILE and assign to this instance.
+	 * A seekable FILE is left positioned right after the document, so a sequence of
+	 * documents, as written by mongodump, can be read by repeated calls.
+	 * @param bsonFile Pointer to a FILE handle from whence to read the BSON document.
+	 * @param projection Pointers to the only parts of the document to decode. [default: all]
+	 * @throw ParseError is thrown if the document is malformed, truncated, or its lengths disagree.
+	 */
+	void fromBSON( FILE* bsonFile, const std::vector< Pointer >& projection = std::vector< Pointer >() )
+	{
+		this->clear();
+		ParseSource source( bsonFile );
+		_readBSON( source, projection );
+	}
+
+	/**
+	 * Decode a BSON document from the given std::ifstream and assign to this instance.
+	 * The stream is left positioned right after the document, so a sequence of
+	 * documents can be read by repeated calls.
+	 * @param bsonIFStream Reference to a std::ifstream from whence to read the BSON document.
+	 * @param projection Pointers to the only parts of the document to decode. [default: all]
+	 * @throw ParseError is thrown if the document is malformed, truncated, or its lengths disagree.
+	 */
+	void fromBSON( std::ifstream& bsonIFStream, const std::vector< Pointer >& projection = std::vector< Pointer >() )
+	{
+		this->clear();
+		ParseSource source( bsonIFStream );
+		_readBSON( source, projection );
+	}
+
+	/**
+	 * Decode a single CBOR (RFC 8949) data item from the given string and assign to this instance.
+	 * Integers decode to the native integral types, floats of any precision to long double, and
+	 * RFC 8746 typed arrays to arrays of numbers. Bignums and decimal fractions decode to the
+	 * multiple precision types when GMP is included. Byte strings decode to base64url text.
+	 * @param cborString A string object holding the CBOR encoded bytes.
+	 * @throw ParseError is thrown if the data item is malformed or truncated.
+	 */
+	void fromCBOR( const std::string& cborString )
+	{
+		this->clear();
+		ParseSource source( cborString );
+		_readCBOR( source, 0 );
+	}
+
+	/**
+	 * Decode a single CBOR (RFC 8949) data item from the given FILE and assign to this instance.
+	 * The item is decoded as it is read, and a seekable FILE is left positioned right after
+	 * it, so a sequence of items can be read by repeated calls.
+	 * @param cborFile Pointer to a FILE handle from whence to read the CBOR data item.
+	 * @throw ParseError is thrown if the data item is malformed or truncated.
+	 */
+	void fromCBOR( FILE* cborFile )
+	{
+		this->clear();
+		ParseSource source( cborFile );
+		_readCBOR( source, 0 );
+	}
+
+	/**
+	 * Decode a single CBOR (RFC 8949) data item from the given std::ifstream and assign to this
+	 * instance. The item is decoded as it is read, and the stream is left positioned right
+	 * after it, so a sequence of items can be read by repeated calls.
+	 * @param cborIFStream Reference to a std::ifstream from whence to read the CBOR data item.
+	 * @throw ParseError is thrown if the data item is malformed or truncated.
+	 */
+	void fromCBOR( std::ifstream& cborIFStream )
+	{
+		this->clear();
+		ParseSource source( cborIFStream );
+		_readCBOR( source, 0 );
+	}
+
+	/**
+	 * Decode a single MessagePack object from the given string and assign to this instance.
+	 * Integers decode to the native integral types and floats to long double. Binary objects
+	 * decode to base64url text, and timestamps to a number of seconds.
+	 * @param messagePackString A string object holding the MessagePack encoded bytes.
+	 * @throw ParseError is thrown if the object is malformed, truncated, or an unknown extension.
+	 */
+	void fromMessagePack( const std::string& messagePackString )
+	{
+		this->clear();
+		ParseSource source( messagePackString );
+		_readMessagePack( source, 0 );
+	}
+
+	/**
+	 * Decode a single MessagePack object from the given FILE and assign to this instance.
+	 * The object is decoded as it is read, and a seekable FILE is left positioned right
+	 * after it, so a sequence of objects can be read by repeated calls.
+	 * @param messagePackFile Pointer to a FILE handle from whence to read the MessagePack object.
+	 * @throw ParseError is thrown if the object is malformed, truncated, or an unknown extension.
+	 */
+	void fromMessagePack( FILE* messagePackFile )
+	{
+		this->clear();
+		ParseSource source( messagePackFile );
+		_readMessagePack( source, 0 );
+	}
+
+	/**
+	 * Decode a single MessagePack object from the given std::ifstream and assign to this instance.
+	 * The object is decoded as it is read, and the stream is left positioned right after
+	 * it, so a sequence of objects can be read by repeated calls.
+	 * @param messagePackIFStream Reference to a std::ifstream from whence to read the MessagePack object.
+	 * @throw ParseError is thrown if the object is malformed, truncated, or an unknown extension.
+	 */
+	void fromMessagePack( std::ifstream& messagePackIFStream )
+	{
+		this->clear();
+		ParseSource source( messagePackIFStream );
+		_readMessagePack( source, 0 );
+	}
+
+	/**
+	 * Decode a single UBJSON value from the given string and assign to this instance.
+	 * Strongly typed, counted arrays of fixed width numbers are copied out of the source in
+	 * one piece into elements allocated up front. Integers decode to the native integral
+	 * types, floats to long double, and high precision numbers to the widest type that holds them.
+	 * Typed containers of null or boolean values carry no payload and expand to that value
+	 * repeated, up to 65536 elements. Typed arrays of no-ops are empty.
+	 * @param ubjsonString A string object holding the UBJSON encoded bytes.
+	 * @throw ParseError is thrown if the value is malformed or truncated.
+	 */
+	void fromUBJSON( const std::string& ubjsonString )
+	{
+		this->clear();
+		ParseSource source( ubjsonString );
+		_readUBJSON( source, false, 0 );
+	}
+
+	/**
+	 * Decode a single UBJSON value from the given FILE and assign to this instance.
+	 * A seekable FILE is left positioned right after the value, so a sequence of
+	 * values can be read by repeated calls.
+	 * @param ubjsonFile Pointer to a FILE handle from whence to read the UBJSON value.
+	 * @throw ParseError is thrown if the value is malformed or truncated.
+	 */
+	void fromUBJSON( FILE* ubjsonFile )
+	{
+		this->clear();
+		ParseSource source( ubjsonFile );
+		_readUBJSON( source, false, 0 );
+	}
+
+	/**
+	 * Decode a single UBJSON value from the given std::ifstream and assign to this instance.
+	 * The stream is left positioned right after the value, so a sequence of values can
+	 * be read by repeated calls.
+	 * @param ubjsonIFStream Reference to a std::ifstream from whence to read the UBJSON value.
+	 * @throw ParseError is thrown if the value is malformed or truncated.
+	 */
+	void fromUBJSON( std::ifstream& ubjsonIFStream )
+	{
+		this->clear();
+		ParseSource source( ubjsonIFStream );
+		_readUBJSON( source, false, 0 );
+	}
+
+	/**
+	 * Access the stored value if this JsonValue holds a {@param ValueType}.
+	 * Supported types are bool, std::string, ObjectType, ArrayType, and the
+	 * storage types of numbers: long double, intmax_t and uintmax_t.
+	 * Numbers are only returned through the type they were stored as.
+	 * @return Pointer to the stored value is returned, or a null pointer
+	 *         if this JsonValue does not hold a {@param ValueType}.
+	 */
+	template < typename ValueType >
+	ValueType* get_if() noexcept
+	{
+		return _getIf( static_cast< ValueType* >( nullptr ) );
+	}
+
+	/**
+	 * Access the stored value if this JsonValue holds a {@param ValueType}.
+	 * Supported types are bool, std::string, ObjectType, ArrayType, and the
+	 * storage types of numbers: long double, intmax_t and uintmax_t.
+	 * Numbers are only returned through the type they were stored as.
+	 * @return Const pointer to the stored value is returned, or a null
+	 *         pointer if this JsonValue does not hold a {@param ValueType}.
+	 */
+	template < typename ValueType >
+	const ValueType* get_if() const noexcept
+	{
+		return const_cast< JsonValue* >( this )->_getIf( static_cast< ValueType* >( nullptr ) );
+	}
+
+	/**
+	 * Compute a hash of this JsonValue. Values that are equal hash equally, and
+	 * numbers hash by value regardless of their representation, so 1 and 1.0
+	 * produce the same hash.
+	 * @return The hash of the type and content of this JsonValue.
+	 */
+	size_t hash() const noexcept
+	{
+		size_t seed = size_t( mType );
+
+		switch ( mType )
+		{
+		case Type::object:
+			for ( const auto& member : mMembers )
+			{
+				seed = _combineHash( seed, std::hash< std::string >()( member.first ) );
+				seed = _combineHash( seed, member.second.hash() );
+			}
+			break;
+
+		case Type::array:
+			for ( const auto& element : mElements )
+			{
+				seed = _combineHash( seed, element.hash() );
+			}
+			break;
+
+		case Type::string:
+			seed = _combineHash( seed, std::hash< std::string >()( mStringValue ) );
+			break;
+
+		case Type::number:
+			seed = _combineHash( seed, _hashNumber() );
+			break;
+
+		case Type::boolean:
+			seed = _combineHash( seed, mBoolean ? 1 : 0 );
+			break;
+
+		default:
+			break;
+		}
+
+		return seed;
+	}
+
+	/**
+	 * Check if the given key is present under the constraint that the JsonValue is an object.
+	 * @param key Member key to check existance for.
+	 * @return True is returned if the key is present. False is returned if either the member
+	 *         key is not present or if the JsonValue is not an object.
+	 */
+	bool hasMember( const std::string& key ) const noexcept
+	{
+		if ( Type::object == mType )
+		{
+			return mMembers.end() != mMembers.find( key );
+		}
+
+		return false;
+	}
+
+	/**
+	 * Insert an element into an array type JsonValue instance.
+	 * Indexes built over the array are updated.
+	 * @param position Position before which to insert, which may be the length of the array.
+	 * @param value Const reference to the JsonValue to insert.
+	 * @throw std::runtime_error is thrown if the JsonValue is not an array.
+	 * @throw std::out_of_range is thrown if the position exceeds the array.
+	 */
+	void insert( size_t position, const JsonValue& value )
+	{
+		insert( position, JsonValue( value ) );
+	}
+
+	/**
+	 * Insert an element into an array type JsonValue instance.
+	 * Indexes built over the array are updated.
+	 * @param position Position before which to insert, which may be the length of the array.
+	 * @param value R-Value of the JsonValue to insert.
+	 * @throw std::runtime_error is thrown if the JsonValue is not an array.
+	 * @throw std::out_of_range is thrown if the position exceeds the array.
+	 */
+	void insert( size_t position, JsonValue&& value )
+	{
+		if ( Type::array != mType )
+		{
+			throw std::runtime_error( "Element insertion 'insert( size_t, JsonValue )' is not defined for non-array type" );
+		}
+
+		if ( mElements.size() < position )
+		{
+			throw std::out_of_range( "Position exceeds the length of the array." );
+		}
+
+		mElements.insert( mElements.begin() + position, std::move( value ) );
+
+		for ( Index* index = mIndexes; nullptr != index; index = index->mNext )
+		{
+			index->_shift( position, 1, nullptr );
+			index->_insert( position );
+		}
+	}
+
+	/**
+	 * Check if this JsonValue is the same type as the requested.
+	 * @param type JsonValue::Type to check the present type against.
+	 * @return True is retured if the given and the present JsonValue::Type are the same.
+	 */
+	bool is( Type type ) const noexcept
+	{
+		return type == mType;
+	}
+
+	/**
+	 * Return a range over the members under the constraint that the JsonValue is an object.
+	 * Each item is a reference to the stored key and value pair, where first is the key
+	 * and second is the mutable JsonValue. Nothing is copied while iterating.
+	 * @return Return a range of key and value pairs.
+	 * @throw An exception is thrown if the JsonValue is not an object.
+	 */
+	item_range items()
+	{
+		if ( Type::object == mType )
+		{
+			return item_range( mMembers.begin(), mMembers.end() );
+		}
+
+		throw std::runtime_error( "Operation 'items()' is not defined for non-object type" );
+	}
+
+	/**
+	 * Return a range over the members under the constraint that the JsonValue is an object.
+	 * Each item is a const reference to the stored key and value pair, where first is the
+	 * key and second is the JsonValue. Nothing is copied while iterating.
+	 * @return Return a range of key and value pairs.
+	 * @throw An exception is thrown if the JsonValue is not an object.
+	 */
+	const_item_range items() const
+	{
+		if ( Type::object == mType )
+		{
+			return const_item_range( mMembers.cbegin(), mMembers.cend() );
+		}
+
+		throw std::runtime_error( "Operation 'items()' is not defined for non-object type" );
+	}
+
+	/**
+	 * Return a lazy range over the keys under the constraint that the JsonValue is an object.
+	 * The keys are visited in order by const reference, nothing is copied. The range
+	 * converts to a std::vector< std::string > for callers needing an owned copy.
+	 * @return Return a range of keys.
+	 * @throw An exception is thrown if the JsonValue is not an object.
+	 */
+	key_range keys() const
+	{
+		if ( Type::object == mType )
+		{
+			return key_range( mMembers );
+		}
+
+		throw std::runtime_error( "Operation 'keys()' is not defined for non-object type" );
+	}
+
+	/**
+	 * Parse JSON text at compile time into a Literal, a read-only document queried through
+	 * LiteralViews. Declared constexpr, the literal is built by the compiler and lookups on
+	 * it fold to their results, e.g.
+	 *     static constexpr auto CONFIG = JsonValue::literal( R"({ "port": 8080 })" );
+	 *     static_assert( CONFIG.root()[ "port" ].is( JsonValue::Type::number ), "" );
+	 * @param text The JSON text, as a string literal or a constexpr character array.
+	 * @return The Literal is returned. Its capacity for values, Nodes, is by default the
+	 *         most a text of this length can hold; pass literalNodeCount() of the text
+	 *         as Nodes for a literal with no room to spare.
+	 * @throw std::invalid_argument is thrown if the text is not valid JSON, or holds more
+	 *        than Nodes values. In a constant expression this is a compile error instead.
+	 */
+	template < size_t Nodes = 0, size_t Length >
+	static constexpr Literal< ( 0 < Nodes ) ? Nodes : ( ( Length / 2 ) + 1 ), Length > literal( const char ( &text )[ Length ] )
+	{
+		return Literal< ( 0 < Nodes ) ? Nodes : ( ( Length / 2 ) + 1 ), Length >( text );
+	}
+
+	/**
+	 * Count the values in JSON text, the capacity of a Literal made of it by literal().
+	 * The text is only scanned, not checked, so the count is exact only for valid JSON.
+	 * @param text The JSON text, as a string literal or a constexpr character array.
+	 * @return The number of values, counting each key, element and container.
+	 */
+	template < size_t Length >
+	static constexpr size_t literalNodeCount( const char ( &text )[ Length ] ) noexcept
+	{
+		size_t count = 0;
+		bool isInString = false;
+		bool isInWord = false;
+		for ( size_t offset( 0 ); ( offset + 1 ) < Length; ++offset )
+		{
+			const char character = text[ offset ];
+			const bool isWordCharacter = ( not isInString ) and ( ( ( 'a' <= character ) and ( character <= 'z' ) )
+				or ( ( '0' <= character ) and ( character <= '9' ) ) or ( '-' == character ) or ( '+' == character )
+				or ( '.' == character ) or ( 'E' == character ) );
+
+			count += ( ( not isInString ) and ( ( '{' == character ) or ( '[' == character ) or ( '"' == character ) ) ) ? 1 : 0;
+			count += ( isWordCharacter and ( not isInWord ) ) ? 1 : 0;
+			isInWord = isWordCharacter;
+			offset += ( isInString and ( '\\' == character ) ) ? 1 : 0;
+			isInString = ( '"' == character ) ? ( not isInString ) : isInString;
+		}
+
+		return count;
+	}
+
+	/**
+	 * Parse a JsonValue from the given FILE and assign to this instance.
+	 * @param jsonFile Pointer to a FILE handle from whence to read the JSON from.
+	 * @throw ParseError is thrown if there is a parsing error.
+	 */
+	void load( FILE* jsonFile )
+	{
+		this->parse( jsonFile );
+	}
+
+	/**
+	 * Parse a JsonValue from the given compressed FILE and assign to this instance.
+	 * @param jsonFile Pointer to a FILE handle from whence to read the JSON from.
+	 * @param compression The compression the JSON was written with.
+	 * @throw ParseError is thrown if there is a parsing error.
+	 * @throw std::runtime_error is thrown if the compression is not available, or the data is corrupt or truncated.
+	 */
+	void load( FILE* jsonFile, Compression compression )
+	{
+		this->parse( jsonFile, compression );
+	}
+
+	/**
+	 * Parse a JsonValue from the the given std::ifstream and assign to this instance.
+	 * @param jsonIFStream Reference to a std::ifstream from whence to read the JSON from.
+	 * @throw ParseError is thrown if there is a parsing error.
+	 */
+	void load( std::ifstream& jsonIFStream )
+	{
+		this->parse( jsonIFStream );
+	}
+
+	/**
+	 * Parse a JsonValue from the given compressed std::ifstream and assign to this instance.
+	 * @param jsonIFStream Reference to a std::ifstream from whence to read the JSON from.
+	 * @param compression The compression the JSON was written with.
+	 * @throw ParseError is thrown if there is a parsing error.
+	 * @throw std::runtime_error is thrown if the compression is not available, or the data is corrupt or truncated.
+	 */
+	void load( std::ifstream& jsonIFStream, Compression compression )
+	{
+		this->parse( jsonIFStream, compression );
+	}
+
+	/**
+	 * Parse a JsonValue from the given string and assign to this instance.
+	 * @param jsonString A string object containing the JSON to be parsed.
+	 * @throw ParseError is thrown if there is a parsing error.
+	 */
+	void loads( const std::string& jsonString )
+	{
+		this->parse( jsonString );
+	}
+
+	/**
+	 * Parse a JsonValue from the given compressed string and assign to this instance.
+	 * @param jsonString A string object containing the compressed JSON to be parsed.
+	 * @param compression The compression the JSON was written with.
+	 * @throw ParseError is thrown if there is a parsing error.
+	 * @throw std::runtime_error is thrown if the compression is not available, or the data is corrupt or truncated.
+	 */
+	void loads( const std::string& jsonString, Compression compression )
+	{
+		this->parse( jsonString, compression );
+	}
+
+	/**
+	 * Apply a JSON Merge Patch to this instance in place.
+	 * Reference: https://www.rfc-editor.org/rfc/rfc7396
+	 * The members of an object patch are merged into this instance, which becomes an object
+	 * if it is not one: a null member removes the member of the same key, an object member is
+	 * merged into the member of the same key, and any other member replaces it. A patch that
+	 * is not an object replaces this instance.
+	 * Note(s):
+	 *    - The members of the patch and of this instance are both in key order, so they are
+	 *      walked together: each change is found by stepping on from the one before, or by a
+	 *      lookup where many members lie between them, and a new member is inserted at the
+	 *      position found rather than looked up again through operator[].
+	 *    - The values the patch adds are copied; to move them instead, move the patch in.
+	 *    - The patch may be this instance, but no other value held within it.
+	 * @param patch Const reference to the patch.
+	 */
+	void mergePatch( const JsonValue& patch )
+	{
+		if ( this == &patch )
+		{
+			const JsonValue copy( patch );
+			_mergePatch( copy );
+			return;
+		}
+
+		_mergePatch( patch );
+	}
+
+	/**
+	 * Apply a JSON Merge Patch to this instance in place, moving the values it adds.
+	 * Reference: https://www.rfc-editor.org/rfc/rfc7396
+	 * Merges as mergePatch( const JsonValue& ) does, but every value the patch adds or replaces
+	 * is moved out of the patch rather than copied, so layering documents copies nothing.
+	 * @param patch R-Value of the patch, which is left in a valid but unspecified state.
+	 */
+	void mergePatch( JsonValue&& patch )
+	{
+		// Detach first, as the patch may be a descendant of this instance.
+		JsonValue moved( std::move( patch ) );
+		_mergePatch( std::move( moved ) );
+	}
+
+	/**
+	 * Copy assignment operator.
+	 * @param other Const reference to the JsonValue to copy.
+	 * @return Reference to this JsonValue instance.
+	 */
+	JsonValue& operator=( const JsonValue& other )
+	{
+		if ( this != &other )
+		{
+			// Copy first, as other may be a descendant of this instance.
+			JsonValue copy( other );
+			this->clear();
+			_moveAssign( std::move( copy ) );
+		}
+
+		return *this;
+	}
+
+	/**
+	 * Move assignment operator.
+	 * @param other R-Value to the JsonValue to move.
+	 * @return Reference to this JsonValue instance.
+	 */
+	JsonValue& operator=( JsonValue&& other ) noexcept
+	{
+		if ( this != &other )
+		{
+			// Detach first, as other may be a descendant of this instance.
+			JsonValue moved( std::move( other ) );
+			this->clear();
+			_moveAssign( std::move( moved ) );
+		}
+
+		return *this;
+	}
+
+	/**
+	 * Object copy assignment operator.
+	 * @param object Const reference to an object to assign to this JsonValue.
+	 * @return Reference to this JsonValue instance is returned.
+	 */
+	JsonValue& operator=( const ObjectType& object )
+	{
+		this->clear();
+		mType = Type::object;
+		mMembers = object;
+
+		return *this;
+	}
+
+	/**
+	 * Object move assignment operator.
+	 * @param object R-Value to an object to assign to this JsonValue.
+	 * @return Reference to this JsonValue instance is returned.
+	 */
+	JsonValue& operator=( ObjectType&& object )
+	{
+		this->clear();
+		mType = Type::object;
+		mMembers = std::move( object );
+
+		return *this;
+	}
+
+	/**
+	 * Array copy assignment operator.
+	 * @param array R-Value to an array to assign to this JsonValue.
+	 * @return Reference to this JsonValue instance is returned.
+	 */
+	JsonValue& operator=( const ArrayType& array )
+	{
+		this->clear();
+		mType = Type::array;
+		mElements = array;
+
+		return *this;
+	}
+
+	/**
+	 * Array copy assignment operator.
+	 * @param array R-Value to an array to assign to this JsonValue.
+	 * @return Reference to this JsonValue instance is returned.
+	 */
+	JsonValue& operator=( ArrayType&& array )
+	{
+		this->clear();
+		mType = Type::array;
+		mElements = std::move( array );
+
+		return *this;
+	}
+
+	/**
+	 * String copy assignment operator.
+	 * @param string Const reference to a string to assign to this JsonValue.
+	 * @return Reference to this JsonValue instance is returned.
+	 */
+	JsonValue& operator=( const std::string& string )
+	{
+		this->clear();
+		mType = Type::string;
+		mStringValue = string;
+
+		return *this;
+	}
+
+	/**
+	 * String move assignment operator.
+	 * @param string R-Value to a string to assign to this JsonValue.
+	 * @return Reference to this JsonValue instance is returned.
+	 */
+	JsonValue& operator=( std::string&& string )
+	{
+		this->clear();
+		mType = Type::string;
+		mStringValue = std::move( string );
+
+		return *this;
+	}
+
+	/**
+	 * Numeric assignment operator.
+	 * @param arithmeticValue Arithmetic number to assign to this JsonValue.
+	 * @return Reference to this JsonValue instance is returned.
+	 */
+	template < typename ArithmeticType,
+		typename = typename std::enable_if< std::is_arithmetic< ArithmeticType >::value >::type >
+	JsonValue& operator=( ArithmeticType arithmeticValue )
+	{
+		this->clear();
+		mType = Type::number;
+		if ( std::is_floating_point< ArithmeticType >::value )
+		{
+			mNumericType = eNumberType::FLOATING;
+			mNumericValue.floatValue = arithmeticValue;
+		}
+		else if ( std::is_unsigned< ArithmeticType >::value )
+		{
+			mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+			mNumericValue.unsignedIntegral = arithmeticValue;
+		}
+		else
+		{
+			mNumericType = eNumberType::SIGNED_INTEGRAL;
+			mNumericValue.signedIntegral = arithmeticValue;
+		}
+
+		return *this;
+	}
+
+#ifdef INCLUDE_GMP
+	/**
+	 * Multiple precision integral numeric assignment operator.
+	 * @param multiplePrecisionIntegral mpz_t object.
+	 * @return Return reference to this JsonValue instance.
+	 */
+	JsonValue& operator=( mpz_t multiplePrecisionIntegral )
+	{
+		this->clear();
+		mType = Type::number;
+		mNumericType = eNumberType::MULTIPLE_PRECISION_INTEGRAL;
+		mpz_init_set( mNumericValue.MPIntegralValue, multiplePrecisionIntegral );
+
+		return *this;
+	}
+
+	/**
+	 * Multiple precision float numeric assignment operator.
+	 * @param multiplePrecisionFloat mpf_t object.
+	 * @return Return reference to this JsonValue instance.
+	 */
+	JsonValue& operator=( mpf_t multiplePrecitionFloat )
+	{
+		this->clear();
+		mType = Type::number;
+		mNumericType = eNumberType::MULTIPLE_PRECISION_FLOAT;
+		mpf_init_set( mNumericValue.MPFloatValue, multiplePrecisionFloat );
+
+		return *this;
+	}
+#endif
+
+	/**
+	 * Boolean assignment operator.
+	 * @param boolean Boolean value to assign to this JsonValue.
+	 * @return Return reference to this JsonValue instance.
+	 */
+	JsonValue& operator=( bool boolean )
+	{
+		this->clear();
+		mType = Type::boolean;
+		mBoolean = boolean;
+
+		return *this;
+	}
+
+	/**
+	 * Null assignment operator.
+	 * @return Return reference to this JsonValue instance.
+	 */
+	JsonValue& operator=( std::nullptr_t )
+	{
+		this->clear();
+		mType = Type::null;
+
+		return *this;
+	}
+
+	/**
+	 * Compare equals operator.
+	 * @param other Const reference to the JsonValue object to compare against.
+	 * @return True is returned if this and other are equal, else false.
+	 */
+	bool operator==( const JsonValue& other ) const noexcept
+	{
+		if ( mType != other.mType )
+		{
+			return false;
+		}
+
+		switch ( mType )
+		{
+		case Type::object:
+			return mMembers == other.mMembers;
+
+		case Type::array:
+			return mElements == other.mElements;
+
+		case Type::string:
+			return mStringValue == other.mStringValue;
+
+		case Type::number:
+			switch ( mNumericType )
+			{
+			case eNumberType::FLOATING:
+				return mNumericValue.floatValue == other.mNumericValue.floatValue;
+
+			case eNumberType::SIGNED_INTEGRAL:
+				return mNumericValue.signedIntegral == other.mNumericValue.signedIntegral;
+
+			case eNumberType::UNSIGNED_INTEGRAL:
+				return mNumericValue.unsignedIntegral == other.mNumericValue.unsignedIntegral;
+#ifdef INCLUDE_GMP
+			case eNumberType::MULTIPLE_PRECISION_FLOAT:
+				return mpf_cmp( mNumericValue.MPFloatValue, other.mNumericValue.MPFloatValue );
+
+			case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
+				return mpz_cmp( mNumericValue.MPIntegralValue, other.mNumericValue.MPIntegralValue );
+#endif
+			default:
+				break;
+			}
+
+			return false;
+
+		case Type::boolean:
+			return mBoolean == other.mBoolean;
+
+		case Type::null:
+		case Type::undefined:
+			return true;
+		}
+
+		return false;
+	}
+
+	/**
+	 * Compare not equal operator.
+	 * @param other Const reference to the JsonValue object to compare against.
+	 * @return True is returned if this and other are not equal, else false.
+	 */
+	bool operator!=( const JsonValue& other ) const noexcept
+	{
+		return not this->operator==( other );
+	}
+
+	/**
+	 * Member access for object type JsonValue instances.
+	 * @param key Pointer to a const char
+	 * @return Reference to the member JsonValue.
+	 */
+	JsonValue& operator[]( const char* const key )
+	{
+		if ( Type::object != mType )
+		{
+			throw std::runtime_error( "Member access 'operator[]( const char* const )' is not defined for non-object type" );
+		}
+
+		if ( nullptr == key )
+		{
+			throw std::invalid_argument( "Key may not be a null pointer" );
+		}
+
+		return this->operator[]( std::string( key ) );
+	}
+
+	/**
+	 * Mutable member access for object type JsonValue instances.
+	 * If the key is not present, then the member is added.
+	 * @param key Const reference to a std::string.
+	 * @return Reference to the member JsonValue.
+	 */
+	JsonValue& operator[]( const std::string& key )
+	{
+		if ( Type::object != mType )
+		{
+			throw std::runtime_error( "Member access 'operator[]( const std::string& )' is not defined for non-object type" );
+		}
+
+		return mMembers[ key ];
+	}
+
+	/**
+	 * Mutable element access for array JSON values.
+	 * If the index is positive and exceeds the size, then the array is filled
+	 * with undefined elements up to the new index. Negative indices may not
+	 * exceed the size of the array.
+	 * @param index Index into the array.
+	 * @return Reference to the element JsonValue.
+	 * @throw std::out_of_range is thrown if the index is negative and exceeds the range.
+	 */
+	template < typename IntegralType,
+		typename = typename std::enable_if< std::is_integral< IntegralType >::value >::type >
+	JsonValue& operator[]( IntegralType index )
+	{
+		size_t absoluteIndex;
+
+		if ( Type::array != mType )
+		{
+			throw std::runtime_error( "Integral index access 'operator[]( IntegralType )' is not defined for non-array type" );
+		}
+
+		// Convert the given index into an absolute offset
+		// from the beginning of the elements array.
+		if ( std::is_signed< IntegralType >::value )
+		{
+			if ( index < IntegralType( 0 ) )
+			{
+				absoluteIndex = size_t( -index );
+				if ( mElements.size() < absoluteIndex )
+				{
+					throw std::out_of_range( "Negative indices may not exceed the length of the array." );
+				}
+
+				absoluteIndex = mElements.size() - absoluteIndex;
+			}
+			else
+			{
+				absoluteIndex = size_t( index );
+			}
+		}
+		else
+		{
+			absoluteIndex = size_t( index );
+		}
+
+		// Fill in the difference with undefined JSON values.
+		if ( mElements.size() <= absoluteIndex )
+		{
+			mElements.resize( absoluteIndex + 1 );
+		}
+
+		return mElements[ absoluteIndex ];
+	}
+
+	/**
+	 * Immutable member access for object type JsonValue instances.
+	 * If the key is not present, then std::out_of_range is thrown. The key is
+	 * looked up as it is, without being copied into a std::string.
+	 * @param key Pointer to a const char
+	 * @return Const reference to the member JsonValue.
+	 */
+	const JsonValue& operator[]( const char* const key ) const
+	{
+		if ( Type::object != mType )
+		{
+			throw std::runtime_error( "Member access 'operator[]( const char* const ) const' is not defined for non-object type" );
+		}
+
+		if ( nullptr == key )
+		{
+			throw std::invalid_argument( "Key may not be null" );
+		}
+
+		auto member = mMembers.find( key );
+		if ( mMembers.end() == member )
+		{
+			throw std::out_of_range( std::string( "Member does not exist: " ) + key );
+		}
+
+		return member->second;
+	}
+
+	/**
+	 * Immutable member access for object type JsonValue instances.
+	 * If the key is not present, then std::out_of_range is thrown.
+	 * @param key Const reference to a std::string.
+	 * @return Const reference to the member JsonValue.
+	 */
+	const JsonValue& operator[]( const std::string& key ) const
+	{
+		if ( Type::object != mType )
+		{
+			throw std::runtime_error( "Member access 'operator[]( const std::string& ) const' is not defined for non-object type" );
+		}
+
+		return mMembers.at( key );
+	}
+
+	/**
+	 * Immutable element access for array JSON values.
+	 * Negative indices count back from the end of the array. If the index
+	 * exceeds the bounds of the array, then std::out_of_range is thrown.
+	 * @param index Index into the array.
+	 * @return Const reference to the element JsonValue.
+	 */
+	template < typename IntegralType,
+		typename = typename std::enable_if< std::is_integral< IntegralType >::value >::type >
+	const JsonValue& operator[]( IntegralType index ) const
+	{
+		size_t absoluteIndex;
+
+		if ( Type::array != mType )
+		{
+			throw std::runtime_error( "Integral index access 'operator[]( IntegralType ) const' is not defined for non-array type" );
+		}
+
+		if ( std::is_signed< IntegralType >::value )
+		{
+			if ( index < IntegralType( 0 ) )
+			{
+				absoluteIndex = size_t( -index );
+				if ( mElements.size() < absoluteIndex )
+				{
+					throw std::out_of_range( "Negative indices may not exceed the length of the array." );
+				}
+
+				absoluteIndex = mElements.size() - absoluteIndex;
+			}
+			else
+			{
+				absoluteIndex = size_t( index );
+			}
+		}
+		else
+		{
+			absoluteIndex = size_t( index );
+		}
+
+		return mElements.at( absoluteIndex );
+	}
+
+	/**
+	 * Cast the value held by the JsonValue object to either true or false.
+	 * If the type is object or array, then true is returned. For string type,
+	 * true shall be returned if the string is non-zero in length. For number
+	 * type, if the value is non-zero, then true is returned else false.
+	 * For all other types, false is returned.
+	 */
+	operator bool() const
+	{
+		switch ( mType )
+		{
+			case Type::array:
+			case Type::object:
+				return true;
+
+			case Type::string:
+				return not mStringValue.empty();
+
+			case Type::number:
+				switch ( mNumericType )
+				{
+					case eNumberType::FLOATING:
+						return 0.0 != mNumericValue.floatValue;
+
+					case eNumberType::SIGNED_INTEGRAL:
+						return 0 != mNumericValue.signedIntegral;
+
+					case eNumberType::UNSIGNED_INTEGRAL:
+						return 0 != mNumericValue.unsignedIntegral;
+
+#ifdef INCLUDE_GMP
+					case eNumberType::MULTIPLE_PRECISION_FLOAT:
+						return 0 != mpf_sgn( mNumericValue.MPFloatValue );
+
+					case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
+						return 0 != mpz_sgn( mNumericValue.MPIntegralValue );
+#endif
+
+					default:
+						return false;
+				}
+
+				// If we get to here, then the JsonValue
+				// is clearly in an invalid state.
+				return false;
+
+			case Type::boolean:
+				return mBoolean;
+
+			default:
+				return false;
+		}
+
+		return false;
+	}
+
+	/**
+	 * Cast the JsonValue to a string.
+	 */
+	operator std::string() const
+	{
+#ifdef INCLUDE_GMP
+		mp_exp_t exponent;
+		char* cstring = nullptr;
+		void ( *freeFunction )( void*, size_t );
+#endif
+		std::string returnString;
+
+		switch ( mType )
+		{
+		case Type::object:
+			returnString = std::string( "[object Object]" );
+			break;
+
+		case Type::array:
+			if ( 0 < mElements.size() )
+			{
+				returnString = std::string( mElements[ 0 ] );
+				for ( size_t index( 0 ); ++index < mElements.size(); )
+				{
+					returnString.append( "," ).append( std::string( mElements[ index ] ) );
+				}
+			}
+			break;
+
+		case Type::string:
+			returnString = mStringValue;
+			break;
+
+		case Type::number:
+			switch ( mNumericType )
+			{
+			case eNumberType::FLOATING:
+				returnString = std::to_string( mNumericValue.floatValue );
+				break;
+
+			case eNumberType::SIGNED_INTEGRAL:
+				returnString = std::to_string( mNumericValue.signedIntegral );
+				break;
+
+			case eNumberType::UNSIGNED_INTEGRAL:
+				returnString = std::to_string( mNumericValue.unsignedIntegral );
+				break;
+
+#ifdef INCLUDE_GMP
+			case eNumberType::MULTIPLE_PRECISION_FLOAT:
+				mp_get_memory_functions( nullptr, nullptr, &freeFunction );
+				cstring = mpz_get_str( nullptr, 10, mNumericValue.MPFloatValue );
+				returnString = std::string( cstring );
+				freeFunction( cstring, strlen( cstring ) + 1 );
+				cstring = nullptr;
+				break;
+
+			case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
+				mp_get_memory_functions( nullptr, nullptr, &freeFunction );
+				cstring = mpf_get_str( nullptr, &exponent, 10, 0, mNumericValue.MPIntegralValue );
+				if ( 0 == strlen( cstring ) )
+				{
+					returnString = std::string( "0.0" );
+				}
+				else
+				{
+					// This is going to be fairly complicated.
+				}
+				freeFunction( cstring, strlen( cstring ) + 1 );
+				cstring = nullptr;
+				break;
+#endif
+			default:
+				break;
+			}
+			break;
+
+		case Type::boolean:
+			returnString = std::string( ( mBoolean ) ? "true" : "false" );
+			break;
+
+		case Type::null:
+			returnString = std::string( "null" );
+			break;
+
+		case Type::undefined:
+			break;
+		}
+
+		return returnString;
+	}
+
+	/**
+	 * Cast the JsonValue to an ArithmeticType value.
+	 */
+	template < typename ArithmeticType,
+		typename = typename std::enable_if< std::is_arithmetic< ArithmeticType >::value >::type >
+	operator ArithmeticType() const
+	{
+		switch ( mType )
+		{
+		case Type::number:
+			switch ( mNumericType )
+			{
+			case eNumberType::FLOATING:
+				return ArithmeticType( mNumericValue.floatValue );
+
+			case eNumberType::SIGNED_INTEGRAL:
+				return ArithmeticType( mNumericValue.signedIntegral );
+
+			case eNumberType::UNSIGNED_INTEGRAL:
+				return ArithmeticType( mNumericValue.unsignedIntegral );
+
+			default:
+				break;
+			}
+			break;
+
+		case Type::boolean:
+			return ArithmeticType( mBoolean );
+
+		case Type::null:
+		case Type::undefined:
+			return ArithmeticType( 0 );
+
+		default:
+			break;
+		}
+
+		throw std::runtime_error( "Cast to an arithmetic type is not defined for type: " + _getTypeString() );
+	}
+
+	/**
+	 * Cast the JsonValue to an ObjectType.
+	 * @throw std::runtime_error is thrown if the JsonValue is not an object.
+	 */
+	operator ObjectType() const
+	{
+		if ( Type::object != mType )
+		{
+			throw std::runtime_error( "Cast to an object is not defined for type: " + _getTypeString() );
+		}
+
+		return mMembers;
+	}
+
+	/**
+	 * Cast the JsonValue to an ArrayType.
+	 * @throw std::runtime_error is thrown if the JsonValue is not an array.
+	 */
+	operator ArrayType() const
+	{
+		if ( Type::array != mType )
+		{
+			throw std::runtime_error( "Cast to an array is not defined for type: " + _getTypeString() );
+		}
+
+		return mElements;
+	}
+
+	/**
+	 * Parse a JsonValue from the given FILE object to this instance.
+	 * @param jsonFile A pointer to a FILE object from whence to parse the JSON from.
+	 * @throw ParseError is thrown if there is a parsing error.
+	 */
+	void parse( FILE* jsonFile )
+	{
+		this->clear();
+		ParseSource source( jsonFile );
+		_parseValue( source );
+		_parseEndOfSource( source );
+	}
+
+	/**
+	 * Parse a JsonValue from the given compressed FILE object to this instance.
+	 * The source is decompressed a block at a time as it is parsed.
+	 * @param jsonFile A pointer to a FILE object from whence to parse the JSON from.
+	 * @param compression The compression the JSON was written with.
+	 * @throw ParseError is thrown if there is a parsing error.
+	 * @throw std::runtime_error is thrown if the compression is not available, or the data is corrupt or truncated.
+	 */
+	void parse( FILE* jsonFile, Compression compression )
+	{
+		this->clear();
+		ParseSource source( jsonFile, compression );
+		_parseValue( source );
+		_parseEndOfSource( source );
+	}
+
+	/**
+	 * Parse a JsonValue from the given FILE object to this instance, validating it against
+	 * a schema as it is parsed. Parsing stops at the first value the schema rejects.
+	 * @param jsonFile A pointer to a FILE object from whence to parse the JSON from.
+	 * @param schema Const reference to the compiled schema to validate against.
+	 * @throw ParseError is thrown if there is a parsing error, or the document is not valid under the schema.
+	 */
+	void parse( FILE* jsonFile, const Schema& schema )
+	{
+		this->clear();
+		ParseSource source( jsonFile );
+		schema._parseSource( source, *this );
+		_parseEndOfSource( source );
+	}
+
+	/**
+	 * Parse a JsonValue from the given std::ifstream to this instance.
+	 * @param jsonIFStream A reference to the std::ifstream to parse the JSON from.
+	 * @throw ParseError is thrown if there is a parsing error.
+	 */
+	void parse( std::ifstream& jsonIFStream )
+	{
+		this->clear();
+		ParseSource source( jsonIFStream );
+		_parseValue( source );
+		_parseEndOfSource( source );
+	}
+
+	/**
+	 * Parse a JsonValue from the given compressed std::ifstream to this instance.
+	 * The source is decompressed a block at a time as it is parsed.
+	 * @param jsonIFStream A reference to the std::ifstream to parse the JSON from.
+	 * @param compression The compression the JSON was written with.
+	 * @throw ParseError is thrown if there is a parsing error.
+	 * @throw std::runtime_error is thrown if the compression is not available, or the data is corrupt or truncated.
+	 */
+	void parse( std::ifstream& jsonIFStream, Compression compression )
+	{
+		this->clear();
+		ParseSource source( jsonIFStream, compression );
+		_parseValue( source );
+		_parseEndOfSource( source );
+	}
+
+	/**
+	 * Parse a JsonValue from the given std::ifstream to this instance, validating it against
+	 * a schema as it is parsed. Parsing stops at the first value the schema rejects.
+	 * @param jsonIFStream A reference to the std::ifstream to parse the JSON from.
+	 * @param schema Const reference to the compiled schema to validate against.
+	 * @throw ParseError is thrown if there is a parsing error, or the document is not valid under the schema.
+	 */
+	void parse( std::ifstream& jsonIFStream, const Schema& schema )
+	{
+		this->clear();
+		ParseSource source( jsonIFStream );
+		schema._parseSource( source, *this );
+		_parseEndOfSource( source );
+	}
+
+	/**
+	 * Parse a JsonValue from the given string an assign to this instance.
+	 * @param jsonString A string object containing the JSON to be parsed.
+	 * @throw ParseError is thrown if there is a parsing error.
+	 */
+	void parse( const std::string& jsonString )
+	{
+		this->clear();
+		ParseSource source( jsonString );
+		_parseValue( source );
+		_parseEndOfSource( source );
+	}
+
+	/**
+	 * Parse a JsonValue from the given compressed string to this instance.
+	 * The source is decompressed a block at a time as it is parsed.
+	 * @param jsonString A string object containing the compressed JSON to be parsed.
+	 * @param compression The compression the JSON was written with.
+	 * @throw ParseError is thrown if there is a parsing error.
+	 * @throw std::runtime_error is thrown if the compression is not available, or the data is corrupt or truncated.
+	 */
+	void parse( const std::string& jsonString, Compression compression )
+	{
+		this->clear();
+		ParseSource source( jsonString, compression );
+		_parseValue( source );
+		_parseEndOfSource( source );
+	}
+
+	/**
+	 * Parse a JsonValue from the given string to this instance, validating it against
+	 * a schema as it is parsed. Parsing stops at the first value the schema rejects.
+	 * @param jsonString A string object containing the JSON to be parsed.
+	 * @param schema Const reference to the compiled schema to validate against.
+	 * @throw ParseError is thrown if there is a parsing error, or the document is not valid under the schema.
+	 */
+	void parse( const std::string& jsonString, const Schema& schema )
+	{
+		this->clear();
+		ParseSource source( jsonString );
+		schema._parseSource( source, *this );
+		_parseEndOfSource( source );
+	}
+
+	/**
+	 * Parse JSON text straight into an object of a bound C++ type, without building a
+	 * JsonValue. A type is bound by declaring, in its namespace, a constexpr function
+	 * jsonFields() that lists its fields, e.g.
+	 *     constexpr auto jsonFields( const Message* )
+	 *     {
+	 *         return std::make_tuple( JsonValue::bind( "id", &Message::id ), JsonValue::bind( "tags", &Message::tags ) );
+	 *     }
+	 * Members are first expected in the order jsonFields() lists them: each key is matched
+	 * whole against the field expected next, and its value read straight into the field.
+	 * From the first member out of that order, the rest are matched through a perfect hash
+	 * table of the field names, built at compile time, with one hash and one comparison.
+	 * Fields may be bool, arithmetic types, std::string, std::vector, std::map keyed by
+	 * std::string, JsonValue or other bound types, and from C++17 std::optional, which
+	 * null empties. Fields missing from the text keep their value, and members without
+	 * a field are skipped.
+	 * @param jsonString A string object containing the JSON to be parsed.
+	 * @param target Reference to the object to read into.
+	 * @throw ParseError is thrown if there is a parsing error, or a value does not fit its field.
+	 */
+	template < typename Bound >
+	static void parseInto( const std::string& jsonString, Bound& target )
+	{
+		ParseSource source( jsonString );
+		_parseInto( source, target );
+	}
+
+	/**
+	 * Parse JSON text straight into an object of a bound C++ type, without building a
+	 * JsonValue. A type is bound by declaring, in its namespace, a constexpr function
+	 * jsonFields() that lists its fields, e.g.
+	 *     constexpr auto jsonFields( const Message* )
+	 *     {
+	 *         return std::make_tuple( JsonValue::bind( "id", &Message::id ), JsonValue::bind( "tags", &Message::tags ) );
+	 *     }
+	 * Members are first expected in the order jsonFields() lists them: each key is matched
+	 * whole against the field expected next, and its value read straight into the field.
+	 * From the first member out of that order, the rest are matched through a perfect hash
+	 * table of the field names, built at compile time, with one hash and one comparison.
+	 * Fields may be bool, arithmetic types, std::string, std::vector, std::map keyed by
+	 * std::string, JsonValue or other bound types, and from C++17 std::optional, which
+	 * null empties. Fields missing from the text keep their value, and members without
+	 * a field are skipped.
+	 * @param jsonFile A pointer to a FILE object from whence to parse the JSON from.
+	 * @param target Reference to the object to read into.
+	 * @throw ParseError is thrown if there is a parsing error, or a value does not fit its field.
+	 */
+	template < typename Bound >
+	static void parseInto( FILE* jsonFile, Bound& target )
+	{
+		ParseSource source( jsonFile );
+		_parseInto( source, target );
+	}
+
+	/**
+	 * Parse JSON text straight into an object of a bound C++ type, without building a
+	 * JsonValue. A type is bound by declaring, in its namespace, a constexpr function
+	 * jsonFields() that lists its fields, e.g.
+	 *     constexpr auto jsonFields( const Message* )
+	 *     {
+	 *         return std::make_tuple( JsonValue::bind( "id", &Message::id ), JsonValue::bind( "tags", &Message::tags ) );
+	 *     }
+	 * Members are first expected in the order jsonFields() lists them: each key is matched
+	 * whole against the field expected next, and its value read straight into the field.
+	 * From the first member out of that order, the rest are matched through a perfect hash
+	 * table of the field names, built at compile time, with one hash and one comparison.
+	 * Fields may be bool, arithmetic types, std::string, std::vector, std::map keyed by
+	 * std::string, JsonValue or other bound types, and from C++17 std::optional, which
+	 * null empties. Fields missing from the text keep their value, and members without
+	 * a field are skipped.
+	 * @param jsonIFStream A reference to the std::ifstream to parse the JSON from.
+	 * @param target Reference to the object to read into.
+	 * @throw ParseError is thrown if there is a parsing error, or a value does not fit its field.
+	 */
+	template < typename Bound >
+	static void parseInto( std::ifstream& jsonIFStream, Bound& target )
+	{
+		ParseSource source( jsonIFStream );
+		_parseInto( source, target );
+	}
+
+	/**
+	 * Remove the last element of an array type JsonValue instance.
+	 * Indexes built over the array are updated.
+	 * @throw std::runtime_error is thrown if the JsonValue is not an array.
+	 * @throw std::out_of_range is thrown if the array is empty.
+	 */
+	void pop_back()
+	{
+		if ( Type::array != mType )
+		{
+			throw std::runtime_error( "Element removal 'pop_back()' is not defined for non-array type" );
+		}
+
+		if ( mElements.empty() )
+		{
+			throw std::out_of_range( "Cannot remove an element from an empty array." );
+		}
+
+		erase( mElements.size() - 1 );
+	}
+
+	/**
+	 * Append an element to an array type JsonValue instance.
+	 * Indexes built over the array are updated.
+	 * @param value Const reference to the JsonValue to append.
+	 * @throw std::runtime_error is thrown if the JsonValue is not an array.
+	 */
+	void push_back( const JsonValue& value )
+	{
+		push_back( JsonValue( value ) );
+	}
+
+	/**
+	 * Append an element to an array type JsonValue instance.
+	 * Indexes built over the array are updated.
+	 * @param value R-Value of the JsonValue to append.
+	 * @throw std::runtime_error is thrown if the JsonValue is not an array.
+	 */
+	void push_back( JsonValue&& value )
+	{
+		if ( Type::array != mType )
+		{
+			throw std::runtime_error( "Element insertion 'push_back( JsonValue )' is not defined for non-array type" );
+		}
+
+		mElements.push_back( std::move( value ) );
+
+		for ( Index* index = mIndexes; nullptr != index; index = index->mNext )
+		{
+			index->_insert( mElements.size() - 1 );
+		}
+	}
+
+	/**
+	 * Serialize a C++ value straight to JSON text, without building a JsonValue.
+	 * Bound types, see parseInto(), are written as objects whose field names were
+	 * quoted and escaped at compile time. Members and elements may be bool, arithmetic
+	 * types, std::string, std::vector, std::map keyed by std::string, JsonValue or other
+	 * bound types, and from C++17 std::optional and std::variant, where an empty optional
+	 * and std::monostate are written as null. Numbers, strings and indentation are
+	 * written as dump() writes them.
+	 * @param value Const reference to the value to serialize.
+	 * @param jsonString Reference to the std::string to write to.
+	 * @param indent The character to use for indentation. [default: Indent:NONE]
+	 * @param indentationLevel This parameter is only used if {@param indent} is set
+	 *                         to Indent::SPACE, in which case it is the number of space
+	 *                         characters used for each level of indentation. [default: 4]
+	 */
+	template < typename Value >
+	static void serialize( const Value& value, std::string& jsonString, Indent indent = Indent::NONE, size_t indentLevel = 4 )
+	{
+		JsonSink sink( jsonString, indent, indentLevel );
+		_serializeValue( sink, value, 0 );
+	}
+
+	/**
+	 * Serialize a C++ value straight to JSON text, without building a JsonValue.
+	 * Bound types, see parseInto(), are written as objects whose field names were
+	 * quoted and escaped at compile time. Members and elements may be bool, arithmetic
+	 * types, std::string, std::vector, std::map keyed by std::string, JsonValue or other
+	 * bound types, and from C++17 std::optional and std::variant, where an empty optional
+	 * and std::monostate are written as null. Numbers, strings and indentation are
+	 * written as dump() writes them.
+	 * @param value Const reference to the value to serialize.
+	 * @param jsonFile Pointer to the FILE handle to write to.
+	 * @param indent The character to use for indentation. [default: Indent:NONE]
+	 * @param indentationLevel This parameter is only used if {@param indent} is set
+	 *                         to Indent::SPACE, in which case it is the number of space
+	 *                         characters used for each level of indentation. [default: 4]
+	 */
+	template < typename Value >
+	static void serialize( const Value& value, FILE* jsonFile, Indent indent = Indent::NONE, size_t indentLevel = 4 )
+	{
+		JsonSink sink( jsonFile, indent, indentLevel );
+		_serializeValue( sink, value, 0 );
+	}
+
+	/**
+	 * Serialize a C++ value straight to JSON text, without building a JsonValue.
+	 * Bound types, see parseInto(), are written as objects whose field names were
+	 * quoted and escaped at compile time. Members and elements may be bool, arithmetic
+	 * types, std::string, std::vector, std::map keyed by std::string, JsonValue or other
+	 * bound types, and from C++17 std::optional and std::variant, where an empty optional
+	 * and std::monostate are written as null. Numbers, strings and indentation are
+	 * written as dump() writes them.
+	 * @param value Const reference to the value to serialize.
+	 * @param jsonOFStream Reference to the std::ofstream to write to.
+	 * @param indent The character to use for indentation. [default: Indent:NONE]
+	 * @param indentationLevel This parameter is only used if {@param indent} is set
+	 *                         to Indent::SPACE, in which case it is the number of space
+	 *                         characters used for each level of indentation. [default: 4]
+	 */
+	template < typename Value >
+	static void serialize( const Value& value, std::ofstream& jsonOFStream, Indent indent = Indent::NONE, size_t indentLevel = 4 )
+	{
+		JsonSink sink( jsonOFStream, indent, indentLevel );
+		_serializeValue( sink, value, 0 );
+	}
+
+	/**
+	 * Length of the JsonValue, assuming the type is: object, array, or string.
+	 * @return Length of the JsonValue.
+	 * @throw An exception is thrown if the JsonValue is not an object, array, or string.
+	 */
+	size_t size() const
+	{
+		switch ( mType )
+		{
+		case Type::object:
+			return mMembers.size();
+
+		case Type::array:
+			return mElements.size();
+
+		case Type::string:
+			return mStringValue.size();
+
+		default:
+			break;
+		}
+
+		throw std::runtime_error( "Operation 'size()' is not defined for type: " + _getTypeString() );
+	}
+
+	/**
+	 * Generate the string representation of this JsonValue.
+	 * By default, the dense representation is generated. If a beautified,
+	 * or human readable, version is desired, then the indent can be set to
+	 * use tabs or spaces. The indentLevel is by default set to 4 for spaces.
+	 * @param indent The character to use for indentation. [default: Indent:NONE]
+	 * @param indentationLevel This parameter is only used if {@param indent} is set
+	 *                         to Indent::SPACE, in which case it is the number of space
+	 *                         characters used for each level of indentation. [default: 4]
+	 * @return The string representation of this JsonValue is returned.
+	 */
+	std::string stringify( Indent indent = Indent::NONE, size_t indentLevel = 4 ) const
+	{
+		std::string jsonString;
+		JsonSink sink( jsonString, indent, indentLevel );
+		_writeJSON( *this, sink );
+		return jsonString;
+	}
+
+	/**
+	 * Swap the contents of this JsonValue with another, without copying.
+	 * @param other Reference to the JsonValue with which to swap contents.
+	 */
+	void swap( JsonValue& other ) noexcept
+	{
+		JsonValue swapped( std::move( other ) );
+		other._moveAssign( std::move( *this ) );
+		_moveAssign( std::move( swapped ) );
+	}
+
+	/**
+	 * Swap the contents of two JsonValues, found through argument dependent lookup
+	 * by std::swap callers such as std::sort.
+	 * @param left Reference to the first JsonValue.
+	 * @param right Reference to the second JsonValue.
+	 */
+	friend void swap( JsonValue& left, JsonValue& right ) noexcept
+	{
+		left.swap( right );
+	}
+
+	/**
+	 * Encode this JsonValue as BJData and append it to the given string.
+	 * Containers are written with counts, and arrays of only integral or only floating numbers
+	 * as strongly typed arrays of the narrowest type, unsigned types included, so a decoder can
+	 * allocate up front and copy the packed elements in bulk. Undefined values are encoded as null.
+	 * @param bjDataString Reference to the std::string to append the encoding to.
+	 * @throw std::runtime_error is thrown if a number has not been resolved.
+	 */
+	void toBJData( std::string& bjDataString ) const
+	{
+		JsonSink sink( bjDataString, Indent::NONE, 0 );
+		_writeUBJSON( sink, true );
+	}
+
+	/**
+	 * Encode this JsonValue as BJData and write it out to file.
+	 * @param bjDataFile Pointer to the FILE handle to write to.
+	 * @throw std::runtime_error is thrown if a number has not been resolved.
+	 */
+	void toBJData( FILE* bjDataFile ) const
+	{
+		JsonSink sink( bjDataFile, Indent::NONE, 0 );
+		_writeUBJSON( sink, true );
+	}
+
+	/**
+	 * Encode this JsonValue as BJData and write it out to the given stream.
+	 * @param bjDataOFStream Reference to the std::ofstream to write to.
+	 * @throw std::runtime_error is thrown if a number has not been resolved.
+	 */
+	void toBJData( std::ofstream& bjDataOFStream ) const
+	{
+		JsonSink sink( bjDataOFStream, Indent::NONE, 0 );
+		_writeUBJSON( sink, true );
+	}
+
+	/**
+	 * Encode this object as a BSON document and append it to the given string.
+	 * The document is written in a single pass, each length prefix being reserved and
+	 * backpatched once its document is complete. Integers are encoded as int32 where they
+	 * fit, else int64, and floating numbers as double. Objects in the MongoDB Extended JSON
+	 * v2 canonical form, as produced by fromBSON(), are encoded as the types they describe.
+	 * @param bsonString Reference to the std::string to append the encoding to.
+	 * @throw std::runtime_error is thrown if this is not an object, or a number does not fit in an int64 or double.
+	 * @throw std::invalid_argument is thrown if a key holds a null character.
+	 * @throw std::length_error is thrown if a string or document exceeds 2^31 - 1 bytes.
+	 */
+	void toBSON( std::string& bsonString ) const
+	{
+		_writeBSON( bsonString );
+	}
+
+	/**
+	 * Encode this object as a BSON document and write it out to file.
+	 * @param bsonFile Pointer to the FILE handle to write to.
+	 * @throw std::runtime_error is thrown if this is not an object, or a number does not fit in an int64 or double.
+	 * @throw std::invalid_argument is thrown if a key holds a null character.
+	 * @throw std::length_error is thrown if a string or document exceeds 2^31 - 1 bytes.
+	 */
+	void toBSON( FILE* bsonFile ) const
+	{
+		std::string buffer;
+		_writeBSON( buffer );
+		JsonSink sink( bsonFile, Indent::NONE, 0 );
+		sink.append( buffer.data(), buffer.length() );
+	}
+
+	/**
+	 * Encode this object as a BSON document and write it out to the given stream.
+	 * @param bsonOFStream Reference to the std::ofstream to write to.
+	 * @throw std::runtime_error is thrown if this is not an object, or a number does not fit in an int64 or double.
+	 * @throw std::invalid_argument is thrown if a key holds a null character.
+	 * @throw std::length_error is thrown if a string or document exceeds 2^31 - 1 bytes.
+	 */
+	void toBSON( std::ofstream& bsonOFStream ) const
+	{
+		std::string buffer;
+		_writeBSON( buffer );
+		JsonSink sink( bsonOFStream, Indent::NONE, 0 );
+		sink.append( buffer.data(), buffer.length() );
+	}
+
+	/**
+	 * Encode this JsonValue as CBOR (RFC 8949) and append it to the given string.
+	 * Integers use the shortest head, floating numbers the shortest of single and double
+	 * precision that is exact, and GMP numbers the bignum and decimal fraction tags.
+	 * @param cborString Reference to the std::string to append the encoding to.
+	 * @param typedArrays If set, arrays of only integral or only floating numbers are
+	 *                    encoded as RFC 8746 typed arrays of the narrowest element type. [default: false]
+	 * @throw std::runtime_error is thrown if a number has not been resolved.
+	 */
+	void toCBOR( std::string& cborString, bool typedArrays = false ) const
+	{
+		JsonSink sink( cborString, Indent::NONE, 0 );
+		_writeCBOR( sink, typedArrays );
+	}
+
+	/**
+	 * Encode this JsonValue as CBOR (RFC 8949) and write it out to file.
+	 * @param cborFile Pointer to the FILE handle to write to.
+	 * @param typedArrays If set, arrays of only integral or only floating numbers are
+	 *                    encoded as RFC 8746 typed arrays of the narrowest element type. [default: false]
+	 * @throw std::runtime_error is thrown if a number has not been resolved.
+	 */
+	void toCBOR( FILE* cborFile, bool typedArrays = false ) const
+	{
+		JsonSink sink( cborFile, Indent::NONE, 0 );
+		_writeCBOR( sink, typedArrays );
+	}
+
+	/**
+	 * Encode this JsonValue as CBOR (RFC 8949) and write it out to the given stream.
+	 * @param cborOFStream Reference to the std::ofstream to write to.
+	 * @param typedArrays If set, arrays of only integral or only floating numbers are
+	 *                    encoded as RFC 8746 typed arrays of the narrowest element type. [default: false]
+	 * @throw std::runtime_error is thrown if a number has not been resolved.
+	 */
+	void toCBOR( std::ofstream& cborOFStream, bool typedArrays = false ) const
+	{
+		JsonSink sink( cborOFStream, Indent::NONE, 0 );
+		_writeCBOR( sink, typedArrays );
+	}
+
+	/**
+	 * Encode this JsonValue as MessagePack and append it to the given string.
+	 * Integers use the narrowest form that holds them exactly, and floating numbers a
+	 * float 32 if that is exact, else a float 64. Undefined values are encoded as nil.
+	 * @param messagePackString Reference to the std::string to append the encoding to.
+	 * @throw std::runtime_error is thrown if a number has not been resolved or does not fit in 64 bits.
+	 * @throw std::length_error is thrown if a string, array or object exceeds 2^32 - 1 entries.
+	 */
+	void toMessagePack( std::string& messagePackString ) const
+	{
+		JsonSink sink( messagePackString, Indent::NONE, 0 );
+		_writeMessagePack( sink );
+	}
+
+	/**
+	 * Encode this JsonValue as MessagePack and write it out to file.
+	 * @param messagePackFile Pointer to the FILE handle to write to.
+	 * @throw std::runtime_error is thrown if a number has not been resolved or does not fit in 64 bits.
+	 * @throw std::length_error is thrown if a string, array or object exceeds 2^32 - 1 entries.
+	 */
+	void toMessagePack( FILE* messagePackFile ) const
+	{
+		JsonSink sink( messagePackFile, Indent::NONE, 0 );
+		_writeMessagePack( sink );
+	}
+
+	/**
+	 * Encode this JsonValue as MessagePack and write it out to the given stream.
+	 * @param messagePackOFStream Reference to the std::ofstream to write to.
+	 * @throw std::runtime_error is thrown if a number has not been resolved or does not fit in 64 bits.
+	 * @throw std::length_error is thrown if a string, array or object exceeds 2^32 - 1 entries.
+	 */
+	void toMessagePack( std::ofstream& messagePackOFStream ) const
+	{
+		JsonSink sink( messagePackOFStream, Indent::NONE, 0 );
+		_writeMessagePack( sink );
+	}
+
+	/**
+	 * Write this JsonValue as a tape: a flat, offset based binary form that a Tape can
+	 * load, or map into memory, and query in place through TapeViews with no parsing.
+	 * Strings and numbers are held inline, and each object has a table of its keys in
+	 * order, so members are found by binary search.
+	 * @param tapeString Reference to the std::string to replace with the tape.
+	 * @throw std::runtime_error is thrown if a number has not been resolved or is of multiple precision.
+	 */
+	void toTape( std::string& tapeString ) const
+	{
+		_writeTapeDocument( tapeString );
+	}
+
+	/**
+	 * Write this JsonValue as a tape out to file.
+	 * @param tapeFile Pointer to the FILE handle to write to.
+	 * @throw std::runtime_error is thrown if a number has not been resolved or is of multiple precision.
+	 */
+	void toTape( FILE* tapeFile ) const
+	{
+		std::string tape;
+		_writeTapeDocument( tape );
+		JsonSink sink( tapeFile, Indent::NONE, 0 );
+		sink.append( tape.data(), tape.length() );
+	}
+
+	/**
+	 * Write this JsonValue as a tape out to the given stream.
+	 * @param tapeOFStream Reference to the std::ofstream to write to.
+	 * @throw std::runtime_error is thrown if a number has not been resolved or is of multiple precision.
+	 */
+	void toTape( std::ofstream& tapeOFStream ) const
+	{
+		std::string tape;
+		_writeTapeDocument( tape );
+		JsonSink sink( tapeOFStream, Indent::NONE, 0 );
+		sink.append( tape.data(), tape.length() );
+	}
+
+	/**
+	 * Encode this JsonValue as UBJSON and append it to the given string.
+	 * Containers are written with counts, and arrays of only integral or only floating numbers
+	 * as strongly typed arrays of the narrowest type, so a decoder can allocate up front and
+	 * copy the packed elements in bulk. Unsigned integers beyond int64 and GMP integrals are
+	 * written as high precision numbers. Undefined values are encoded as null.
+	 * @param ubjsonString Reference to the std::string to append the encoding to.
+	 * @throw std::runtime_error is thrown if a number has not been resolved.
+	 */
+	void toUBJSON( std::string& ubjsonString ) const
+	{
+		JsonSink sink( ubjsonString, Indent::NONE, 0 );
+		_writeUBJSON( sink, false );
+	}
+
+	/**
+	 * Encode this JsonValue as UBJSON and write it out to file.
+	 * @param ubjsonFile Pointer to the FILE handle to write to.
+	 * @throw std::runtime_error is thrown if a number has not been resolved.
+	 */
+	void toUBJSON( FILE* ubjsonFile ) const
+	{
+		JsonSink sink( ubjsonFile, Indent::NONE, 0 );
+		_writeUBJSON( sink, false );
+	}
+
+	/**
+	 * Encode this JsonValue as UBJSON and write it out to the given stream.
+	 * @param ubjsonOFStream Reference to the std::ofstream to write to.
+	 * @throw std::runtime_error is thrown if a number has not been resolved.
+	 */
+	void toUBJSON( std::ofstream& ubjsonOFStream ) const
+	{
+		JsonSink sink( ubjsonOFStream, Indent::NONE, 0 );
+		_writeUBJSON( sink, false );
+	}
+
+	/**
+	 * Retrieve the type of the JsonValue.
+	 * @return Return the type of the JsonValue.
+	 */
+	Type type() const noexcept
+	{
+		return mType;
+	}
+
+	/**
+	 * Get a string representation of the type.
+	 * @return Return a string representation of the JsonValue type.
+	 */
+	const std::string& typeString() const
+	{
+		return _getTypeString();
+	}
+
+private:
+
+	// Initialize our variables
+	void _initPrimitiveVariables( Type type )
+	{
+		mType = type;
+		mBoolean = false;
+		mNumericType = eNumberType::NONE;
+		std::memset( &mNumericValue, 0, sizeof( mNumericValue ) );
+	}
+
+	// Copy from other into this instance
+	void _copyAssign( const JsonValue& other )
+	{
+		mType = other.mType;
+		mStringValue = other.mStringValue;
+		mElements = other.mElements;
+		mMembers = other.mMembers;
+		mBoolean = other.mBoolean;
+		mNumericType = other.mNumericType;
+
+		switch ( mNumericType )
+		{
+		case eNumberType::FLOATING:
+		case eNumberType::SIGNED_INTEGRAL:
+		case eNumberType::UNSIGNED_INTEGRAL:
+			std::memcpy( &mNumericValue, &other.mNumericValue, sizeof( mNumericValue ) );
+			break;
+#ifdef INCLUDE_GMP
+		case eNumberType::MULTIPLE_PRECISION_FLOAT:
+			mpf_init_set( mMPFloatValue, other.mMPFloatValue );
+			break;
+		case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
+			mpz_init_set( mMPIntegralValue, other.mMPIntegralValue );
+			break;
+#endif
+		default:
+			std::memset( &mNumericValue, 0, sizeof( mNumericValue ) );
+			break;
+		}
+	}
+
+	// Move other instance into this instance
+	void _moveAssign( JsonValue&& other ) noexcept
+	{
+		mType = std::exchange( other.mType, Type::undefined );
+		mStringValue = std::move( other.mStringValue );
+		mElements = std::move( other.mElements );
+		mMembers = std::move( other.mMembers );
+		mBoolean = std::exchange( other.mBoolean, false );
+		mNumericType = std::exchange( other.mNumericType, eNumberType::NONE );
+		mIndexes = std::exchange( other.mIndexes, nullptr );
+
+		// Indexes built over other follow its elements into this instance.
+		for ( Index* index = mIndexes; nullptr != index; index = index->mNext )
+		{
+			index->mArray = this;
+		}
+
+		// We don't need to worry about the numeric type because, regardless
+		// of the type, if we copy the complete byte representation and
+		// then zero the bytes for mNumericValue in other, then we can be sure
+		// that there is only one set of the bytes between the 2 objects.
+		// If there are any pointers in the GMP objects, then they will be
+		// released by this object and not by other.
+		std::memcpy( &mNumericValue, &other.mNumericValue, sizeof( mNumericValue ) );
+		std::memset( &other.mNumericValue, 0, sizeof( mNumericValue ) );
+	}
+
+	// get_if() overloads, selected by the type of the unused parameter
+	bool* _getIf( bool* ) noexcept
+	{
+		return ( Type::boolean == mType ) ? &mBoolean : nullptr;
+	}
+
+	std::string* _getIf( std::string* ) noexcept
+	{
+		return ( Type::string == mType ) ? &mStringValue : nullptr;
+	}
+
+	ObjectType* _getIf( ObjectType* ) noexcept
+	{
+		return ( Type::object == mType ) ? &mMembers : nullptr;
+	}
+
+	ArrayType* _getIf( ArrayType* ) noexcept
+	{
+		return ( Type::array == mType ) ? &mElements : nullptr;
+	}
+
+	long double* _getIf( long double* ) noexcept
+	{
+		return ( eNumberType::FLOATING == mNumericType ) ? &mNumericValue.floatValue : nullptr;
+	}
+
+	intmax_t* _getIf( intmax_t* ) noexcept
+	{
+		return ( eNumberType::SIGNED_INTEGRAL == mNumericType ) ? &mNumericValue.signedIntegral : nullptr;
+	}
+
+	uintmax_t* _getIf( uintmax_t* ) noexcept
+	{
+		return ( eNumberType::UNSIGNED_INTEGRAL == mNumericType ) ? &mNumericValue.unsignedIntegral : nullptr;
+	}
+
+#ifdef INCLUDE_GMP
+	mpz_t* _getIf( mpz_t* ) noexcept
+	{
+		return ( eNumberType::MULTIPLE_PRECISION_INTEGRAL == mNumericType ) ? &mNumericValue.MPIntegralValue : nullptr;
+	}
+
+	mpf_t* _getIf( mpf_t* ) noexcept
+	{
+		return ( eNumberType::MULTIPLE_PRECISION_FLOAT == mNumericType ) ? &mNumericValue.MPFloatValue : nullptr;
+	}
+#endif
+
+	// Non-owning view of a member key, ordered against the std::string keys of ObjectType.
+	struct KeyView
+	{
+		const char* data;
+		size_t length;
+
+		KeyView( const std::string& key ) noexcept :
+			data( key.data() ),
+			length( key.length() )
+		{
+		}
+
+		KeyView( const char* const key ) noexcept :
+			data( ( nullptr == key ) ? "" : key ),
+			length( ( nullptr == key ) ? 0 : strlen( key ) )
+		{
+		}
+
+		bool operator==( const std::string& key ) const noexcept
+		{
+			return ( key.length() == length ) and ( 0 == key.compare( 0, key.length(), data, length ) );
+		}
+
+		bool operator<( const KeyView& other ) const noexcept
+		{
+			int order = memcmp( data, other.data, std::min( length, other.length ) );
+			return ( order < 0 ) or ( ( 0 == order ) and ( length < other.length ) );
+		}
+
+		friend bool operator<( const std::string& key, const KeyView& view ) noexcept
+		{
+			return key.compare( 0, key.length(), view.data, view.length ) < 0;
+		}
+
+		friend bool operator<( const KeyView& view, const std::string& key ) noexcept
+		{
+			return 0 < key.compare( 0, key.length(), view.data, view.length );
+		}
+	};
+
+	// Move the contents of a std::array into a std::tuple
+	template < size_t Index, typename ElementType >
+	using _ElementAt = ElementType;
+
+	template < typename ElementType, size_t Count, size_t... Indices >
+	static std::tuple< _ElementAt< Indices, ElementType >... > _toTuple( std::array< ElementType, Count >& elements, std::index_sequence< Indices... > )
+	{
+		return std::tuple< _ElementAt< Indices, ElementType >... >( std::move( elements[ Indices ] )... );
+	}
+
+	// Find the members named by {@param views} in a single forward pass over mMembers.
+	// {@param order} is scratch space for {@param count} positions.
+	void _extractMembers( const KeyView* views, size_t* order, const JsonValue** found, size_t count ) const
+	{
+		// Members that are this close are reached faster by stepping than by searching.
+		const size_t LINEAR_STEP_LIMIT = 8;
+
+		for ( size_t position( 0 ); position < count; ++position )
+		{
+			size_t insertAt = position;
+			while ( ( 0 < insertAt ) and ( views[ position ] < views[ order[ insertAt - 1 ] ] ) )
+			{
+				order[ insertAt ] = order[ insertAt - 1 ];
+				--insertAt;
+			}
+
+			order[ insertAt ] = position;
+		}
+
+		auto member = mMembers.begin();
+		for ( size_t position( 0 ); position < count; ++position )
+		{
+			const KeyView& key = views[ order[ position ] ];
+
+			for ( size_t steps( 0 ); ( mMembers.end() != member ) and ( member->first < key ) and ( steps < LINEAR_STEP_LIMIT ); ++steps )
+			{
+				++member;
+			}
+
+			if ( ( mMembers.end() != member ) and ( member->first < key ) )
+			{
+				member = mMembers.lower_bound( key );
+			}
+
+			if ( ( mMembers.end() != member ) and not ( key < member->first ) )
+			{
+				found[ order[ position ] ] = &member->second;
+			}
+		}
+	}
+
+	// Read the top level object from {@param source}, building only the
+	// members named by {@param views} into the matching {@param values}.
+	static void _extractSource( ParseSource& source, const KeyView* views, JsonValue* values, size_t count )
+	{
+		_parseWhitespace( source );
+
+		if ( '{' != source.peek() )
+		{
+			throw ParseError( "extract", source );
+		}
+
+		source.update();
+		_parseWhitespace( source );
+
+		if ( '}' == source.peek() )
+		{
+			source.update();
+			return;
+		}
+
+		// Once every key is found the rest of the object is left unread.
+		JsonValue key;
+		size_t remaining = count;
+		while ( 0 < remaining )
+		{
+			if ( source.endOfSource() )
+			{
+				throw ParseError( "extract", source );
+			}
+
+			key._parseString( source );
+			_parseWhitespace( source );
+
+			if ( ':' != source.peek() )
+			{
+				throw ParseError( "extract", source );
+			}
+
+			source.update();
+
+			JsonValue* slot = nullptr;
+			for ( size_t position( 0 ); ( nullptr == slot ) and ( position < count ); ++position )
+			{
+				if ( ( Type::undefined == values[ position ].mType ) and ( views[ position ] == key.mStringValue ) )
+				{
+					slot = &values[ position ];
+				}
+			}
+
+			if ( nullptr == slot )
+			{
+				_skipValue( source );
+			}
+			else
+			{
+				slot->_parseValue( source );
+				--remaining;
+			}
+
+			if ( '}' == source.peek() )
+			{
+				source.update();
+				return;
+			}
+
+			if ( ',' != source.peek() )
+			{
+				throw ParseError( "extract", source );
+			}
+
+			source.update();
+			_parseWhitespace( source );
+		}
+	}
+
+	// Shared implementation of the extractFrom() overloads
+	template < typename... KeyTypes >
+	static std::tuple< _ValueFor< KeyTypes >... > _extractFrom( ParseSource& source, const KeyTypes&... keys )
+	{
+		constexpr size_t KEY_COUNT = sizeof...( KeyTypes );
+		std::array< KeyView, KEY_COUNT > views {{ KeyView( keys )... }};
+		std::array< JsonValue, KEY_COUNT > values;
+
+		_extractSource( source, views.data(), values.data(), KEY_COUNT );
+		return _toTuple( values, std::make_index_sequence< KEY_COUNT >() );
+	}
+
+	// Hash a field name with {@param seed}, using FNV-1a with the seed folded into its offset basis
+	static constexpr uint64_t _hashFieldName( uint64_t seed, const char* name, size_t length ) noexcept
+	{
+		uint64_t hash = 0xcbf29ce484222325ULL ^ ( seed * 0x9e3779b97f4a7c15ULL );
+		for ( size_t offset( 0 ); offset < length; ++offset )
+		{
+			hash = ( hash ^ uint8_t( name[ offset ] ) ) * 0x100000001b3ULL;
+		}
+
+		return hash ^ ( hash >> 32 );
+	}
+
+	// Check if the field names {@param first} and {@param second} are the same
+	static constexpr bool _isSameFieldName( const char* first, size_t firstLength, const char* second, size_t secondLength ) noexcept
+	{
+		if ( firstLength != secondLength )
+		{
+			return false;
+		}
+
+		for ( size_t offset( 0 ); offset < firstLength; ++offset )
+		{
+			if ( first[ offset ] != second[ offset ] )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Number of slots in the field table of a type with {@param count} fields:
+	// the power of two at least twice the count, so a perfect seed is quickly found.
+	static constexpr size_t _getFieldSlotCount( size_t count ) noexcept
+	{
+		size_t slotCount = 2;
+		while ( slotCount < 2 * count )
+		{
+			slotCount *= 2;
+		}
+
+		return slotCount;
+	}
+
+	// Perfect hash table of the field names of a bound type, built at compile time.
+	// The seed is searched for until every name hashes to a slot of its own, so a
+	// lookup hashes the key once and compares it against a single name.
+	template < size_t Count >
+	struct FieldTable
+	{
+		enum : size_t
+		{
+			SLOT_COUNT = _getFieldSlotCount( Count ),
+			NAME_COUNT = ( 0 < Count ) ? Count : 1
+		};
+
+		uint64_t seed;
+		const char* names[ NAME_COUNT ];
+		size_t lengths[ NAME_COUNT ];
+		size_t slots[ SLOT_COUNT ];  // The field position plus one, or 0 for an empty slot
+		bool hasUniqueNames;
+		bool isPerfect;
+
+		constexpr FieldTable( const char* const* fieldNames, const size_t* fieldLengths ) :
+			seed( 0 ),
+			names(),
+			lengths(),
+			slots(),
+			hasUniqueNames( true ),
+			isPerfect( 0 == Count )
+		{
+			for ( size_t position( 0 ); position < Count; ++position )
+			{
+				names[ position ] = fieldNames[ position ];
+				lengths[ position ] = fieldLengths[ position ];
+
+				for ( size_t earlier( 0 ); hasUniqueNames and ( earlier < position ); ++earlier )
+				{
+					hasUniqueNames = not _isSameFieldName( names[ earlier ], lengths[ earlier ], names[ position ], lengths[ position ] );
+				}
+			}
+
+			// Repeated names never hash apart, so only distinct names are searched for a seed.
+			for ( uint64_t candidate( 0 ); hasUniqueNames and ( not isPerfect ) and ( candidate < 4096 ); ++candidate )
+			{
+				for ( size_t slot( 0 ); slot < SLOT_COUNT; ++slot )
+				{
+					slots[ slot ] = 0;
+				}
+
+				seed = candidate;
+				isPerfect = true;
+				for ( size_t position( 0 ); isPerfect and ( position < Count ); ++position )
+				{
+					const size_t slot = size_t( _hashFieldName( candidate, names[ position ], lengths[ position ] ) & ( SLOT_COUNT - 1 ) );
+					isPerfect = 0 == slots[ slot ];
+					slots[ slot ] = position + 1;
+				}
+			}
+		}
+
+		// Position of the field named {@param key}, or Count if there is none
+		size_t find( const std::string& key ) const noexcept
+		{
+			const size_t slot = slots[ _hashFieldName( seed, key.data(), key.length() ) & ( SLOT_COUNT - 1 ) ];
+			return ( ( 0 != slot ) and ( lengths[ slot - 1 ] == key.length() )
+				and ( 0 == std::memcmp( names[ slot - 1 ], key.data(), key.length() ) ) ) ? slot - 1 : Count;
+		}
+	};
+
+	// Build the field table of the fields {@param fields} of a bound type
+	template < typename Fields, size_t... Positions >
+	static constexpr FieldTable< sizeof...( Positions ) > _makeFieldTable( const Fields& fields, std::index_sequence< Positions... > ) noexcept
+	{
+		const char* const names[] = { std::get< Positions >( fields ).name..., nullptr };
+		const size_t lengths[] = { std::get< Positions >( fields ).length..., 0 };
+		return FieldTable< sizeof...( Positions ) >( names, lengths );
+	}
+
+	// The length of the number at the current read position, checked against the JSON number grammar
+	static uint32_t _scanNumber( ParseSource& source )
+	{
+		uint32_t length = ( '-' == source.peek() ) ? 1 : 0;
+		auto readDigits = [ &source, &length ]()
+		{
+			const uint32_t start = length;
+			while ( isdigit( static_cast< unsigned char >( source.peek( length ) ) ) )
+			{
+				++length;
+			}
+
+			return start < length;
+		};
+
+		if ( '0' == source.peek( length ) )
+		{
+			++length;
+		}
+		else if ( not readDigits() )
+		{
+			throw ParseError( "parseNumber", source, length );
+		}
+
+		if ( '.' == source.peek( length ) )
+		{
+			++length;
+			if ( not readDigits() )
+			{
+				throw ParseError( "parseNumber", source, length );
+			}
+		}
+
+		if ( ( 'e' == source.peek( length ) ) or ( 'E' == source.peek( length ) ) )
+		{
+			++length;
+			length += ( ( '+' == source.peek( length ) ) or ( '-' == source.peek( length ) ) ) ? 1 : 0;
+			if ( not readDigits() )
+			{
+				throw ParseError( "parseNumber", source, length );
+			}
+		}
+
+		return length;
+	}
+
+	// Read the number at the current read position into {@param text},
+	// checking it against the JSON number grammar.
+	static void _readNumberText( ParseSource& source, std::string& text )
+	{
+		const uint32_t length = _scanNumber( source );
+		source.copy( text, length );
+		source.update( length );
+	}
+
+	// Read a boolean into {@param target}
+	static void _bindValue( ParseSource& source, bool& target )
+	{
+		const char STRING_TRUE[] = "true";
+		const char STRING_FALSE[] = "false";
+
+		if ( source.strncmp( STRING_TRUE, strlen( STRING_TRUE ) ) )
+		{
+			target = true;
+			source.update( strlen( STRING_TRUE ) );
+		}
+		else if ( source.strncmp( STRING_FALSE, strlen( STRING_FALSE ) ) )
+		{
+			target = false;
+			source.update( strlen( STRING_FALSE ) );
+		}
+		else
+		{
+			throw ParseError( "parseInto", source );
+		}
+	}
+
+	// Read a string into {@param target}
+	static void _bindValue( ParseSource& source, std::string& target )
+	{
+		_readString( source, target );
+	}
+
+	// Read any value into {@param target}, for members left dynamic
+	static void _bindValue( ParseSource& source, JsonValue& target )
+	{
+		target.clear();
+		target._parseValue( source );
+	}
+
+	// Read a number into {@param target}, which must hold it exactly if it is integral
+	template < typename Number >
+	static typename std::enable_if< std::is_arithmetic< Number >::value >::type _bindValue( ParseSource& source, Number& target )
+	{
+		std::string text;
+		_readNumberText( source, text );
+		errno = 0;
+
+		if ( std::is_floating_point< Number >::value )
+		{
+			// Overflow reads as infinity, which no finite field of any width should take silently.
+			const long double value = strtold( text.c_str(), nullptr );
+			if ( ( value < (long double)( std::numeric_limits< Number >::lowest() ) )
+				or ( (long double)( std::numeric_limits< Number >::max() ) < value ) )
+			{
+				throw ParseError( "parseInto", source );
+			}
+
+			target = Number( value );
+		}
+		else if ( std::string::npos != text.find_first_of( ".eE" ) )
+		{
+			throw ParseError( "parseInto", source );
+		}
+		else if ( std::is_signed< Number >::value )
+		{
+			const long long value = strtoll( text.c_str(), nullptr, 10 );
+			if ( ( ERANGE == errno ) or ( value < (long long)( std::numeric_limits< Number >::min() ) )
+				or ( (long long)( std::numeric_limits< Number >::max() ) < value ) )
+			{
+				throw ParseError( "parseInto", source );
+			}
+
+			target = Number( value );
+		}
+		else
+		{
+			const unsigned long long value = strtoull( text.c_str(), nullptr, 10 );
+			if ( ( '-' == text[ 0 ] ) or ( ERANGE == errno )
+				or ( (unsigned long long)( std::numeric_limits< Number >::max() ) < value ) )
+			{
+				throw ParseError( "parseInto", source );
+			}
+
+			target = Number( value );
+		}
+	}
+
+	// Read an array into {@param target}, replacing its elements
+	template < typename Element >
+	static void _bindValue( ParseSource& source, std::vector< Element >& target )
+	{
+		if ( '[' != source.peek() )
+		{
+			throw ParseError( "parseInto", source );
+		}
+
+		source.update();
+		_parseWhitespace( source );
+		target.clear();
+
+		while ( ( not source.endOfSource() ) and ( ']' != source.peek() ) )
+		{
+			// Read into a local, as std::vector< bool > has no element to bind to.
+			Element element {};
+			_bindValue( source, element );
+			target.push_back( std::move( element ) );
+			_parseWhitespace( source );
+
+			if ( ',' == source.peek() )
+			{
+				source.update();
+				_parseWhitespace( source );
+
+				if ( ']' == source.peek() )
+				{
+					throw ParseError( "parseInto", source );
+				}
+			}
+			else if ( ']' != source.peek() )
+			{
+				throw ParseError( "parseInto", source );
+			}
+		}
+
+		if ( ']' != source.peek() )
+		{
+			throw ParseError( "parseInto", source );
+		}
+
+		source.update();
+	}
+
+	// Read an object into {@param target}, replacing its members
+	template < typename Mapped, typename Compare, typename Allocator >
+	static void _bindValue( ParseSource& source, std::map< std::string, Mapped, Compare, Allocator >& target )
+	{
+		if ( '{' != source.peek() )
+		{
+			throw ParseError( "parseInto", source );
+		}
+
+		source.update();
+		_parseWhitespace( source );
+		target.clear();
+
+		std::string key;
+		while ( ( not source.endOfSource() ) and ( '}' != source.peek() ) )
+		{
+			_readString( source, key );
+			_parseWhitespace( source );
+
+			if ( ':' != source.peek() )
+			{
+				throw ParseError( "parseInto", source );
+			}
+
+			source.update();
+			_parseWhitespace( source );
+			_bindValue( source, target[ key ] );
+			_parseWhitespace( source );
+
+			if ( ',' == source.peek() )
+			{
+				source.update();
+				_parseWhitespace( source );
+
+				if ( '"' != source.peek() )
+				{
+					throw ParseError( "parseInto", source );
+				}
+			}
+			else if ( '}' != source.peek() )
+			{
+				throw ParseError( "parseInto", source );
+			}
+		}
+
+		if ( '}' != source.peek() )
+		{
+			throw ParseError( "parseInto", source );
+		}
+
+		source.update();
+	}
+
+#if __cplusplus >= 201703L
+	// Read a value into {@param target}, or empty it if the value is null
+	template < typename Value >
+	static void _bindValue( ParseSource& source, std::optional< Value >& target )
+	{
+		const char STRING_NULL[] = "null";
+
+		if ( source.strncmp( STRING_NULL, strlen( STRING_NULL ) ) )
+		{
+			target.reset();
+			source.update( strlen( STRING_NULL ) );
+		}
+		else
+		{
+			_bindValue( source, target.emplace() );
+		}
+	}
+#endif
+
+	// Read the value of the field at {@param Position} of a bound type
+	template < typename Bound, size_t Position >
+	static void _bindField( ParseSource& source, Bound& target )
+	{
+		constexpr auto field = std::get< Position >( jsonFields( static_cast< const Bound* >( nullptr ) ) );
+		_bindValue( source, target.*( field.member ) );
+	}
+
+	// Read the value of the field at {@param position} of a bound type, through a jump table of the fields
+	template < typename Bound, size_t... Positions >
+	static void _bindField( ParseSource& source, Bound& target, size_t position, std::index_sequence< Positions... > )
+	{
+		using Binder = void (*)( ParseSource&, Bound& );
+		static const Binder BINDERS[] = { &_bindField< Bound, Positions >..., nullptr };
+		BINDERS[ position ]( source, target );
+	}
+
+	// Every field of a bound type has been read in order; the rest of the object is left to the generic loop
+	template < typename Bound, typename Names, size_t Count >
+	static void _bindInOrder( ParseSource&, Bound&, const Names&, std::integral_constant< size_t, Count >, std::integral_constant< size_t, Count > )
+	{
+	}
+
+	// Read the fields of a bound type from {@param Position} on, for as long as the object lists them in
+	// the order of jsonFields(). Each key is matched whole against its quoted name and colon, and each
+	// value is read straight into its member, so no key is copied, hashed or looked up. The read
+	// position is left at the next key, or the end of the object.
+	template < typename Bound, typename Names, size_t Position, size_t Count >
+	static void _bindInOrder( ParseSource& source, Bound& target, const Names& names,
+		std::integral_constant< size_t, Position >, std::integral_constant< size_t, Count > )
+	{
+		constexpr auto field = std::get< Position >( jsonFields( static_cast< const Bound* >( nullptr ) ) );
+		const size_t nameLength = names.offsets[ Position + 1 ] - names.offsets[ Position ];
+
+		if ( not source.strncmp( names.text + names.offsets[ Position ], nameLength ) )
+		{
+			return;
+		}
+
+		source.update( uint32_t( nameLength ) );
+		_parseWhitespace( source );
+		_bindValue( source, target.*( field.member ) );
+		_parseWhitespace( source );
+
+		if ( ',' != source.peek() )
+		{
+			if ( '}' != source.peek() )
+			{
+				throw ParseError( "parseInto", source );
+			}
+
+			return;
+		}
+
+		source.update();
+		_parseWhitespace( source );
+
+		if ( '"' != source.peek() )
+		{
+			throw ParseError( "parseInto", source );
+		}
+
+		_bindInOrder( source, target, names, std::integral_constant< size_t, Position + 1 >(), std::integral_constant< size_t, Count >() );
+	}
+
+	// Read an object into the bound type {@param target}, whose fields are listed by its jsonFields()
+	template < typename Bound >
+	static auto _bindValue( ParseSource& source, Bound& target ) -> decltype( jsonFields( static_cast< const Bound* >( nullptr ) ), void() )
+	{
+		constexpr size_t FIELD_COUNT = std::tuple_size< decltype( jsonFields( static_cast< const Bound* >( nullptr ) ) ) >::value;
+		static constexpr FieldTable< FIELD_COUNT > FIELD_TABLE = _makeFieldTable( jsonFields( static_cast< const Bound* >( nullptr ) ),
+			std::make_index_sequence< FIELD_COUNT >() );
+		static_assert( FIELD_TABLE.hasUniqueNames, "The field names of a bound type must be unique" );
+		static_assert( ( not FIELD_TABLE.hasUniqueNames ) or FIELD_TABLE.isPerfect,
+			"No seed below 4096 hashes the field names of a bound type to distinct slots" );
+
+		if ( '{' != source.peek() )
+		{
+			throw ParseError( "parseInto", source );
+		}
+
+		source.update();
+		_parseWhitespace( source );
+
+		// Messages of a fixed layout are read entirely by the expected order; the
+		// first key out of order, or unknown, falls back to reading the rest by name.
+		_bindInOrder( source, target, _getFieldNames< Bound >(), std::integral_constant< size_t, 0 >(),
+			std::integral_constant< size_t, FIELD_COUNT >() );
+
+		std::string key;
+		while ( ( not source.endOfSource() ) and ( '}' != source.peek() ) )
+		{
+			_readString( source, key );
+			_parseWhitespace( source );
+
+			if ( ':' != source.peek() )
+			{
+				throw ParseError( "parseInto", source );
+			}
+
+			source.update();
+			_parseWhitespace( source );
+
+			const size_t position = FIELD_TABLE.find( key );
+			if ( FIELD_COUNT == position )
+			{
+				_skipValue( source );
+			}
+			else
+			{
+				_bindField( source, target, position, std::make_index_sequence< FIELD_COUNT >() );
+			}
+
+			_parseWhitespace( source );
+
+			if ( ',' == source.peek() )
+			{
+				source.update();
+				_parseWhitespace( source );
+
+				if ( '"' != source.peek() )
+				{
+					throw ParseError( "parseInto", source );
+				}
+			}
+			else if ( '}' != source.peek() )
+			{
+				throw ParseError( "parseInto", source );
+			}
+		}
+
+		if ( '}' != source.peek() )
+		{
+			throw ParseError( "parseInto", source );
+		}
+
+		source.update();
+	}
+
+	// Shared implementation of the parseInto() overloads
+	template < typename Bound >
+	static void _parseInto( ParseSource& source, Bound& target )
+	{
+		_parseWhitespace( source );
+		_bindValue( source, target );
+		_parseEndOfSource( source );
+	}
+
+	// The names of the fields of a bound type, each quoted, escaped and followed by a
+	// colon at compile time, so writing a field name is a single append.
+	template < size_t Count, size_t Capacity >
+	struct FieldNames
+	{
+		char text[ Capacity ];
+		size_t offsets[ Count + 1 ];  // Where each name starts in text, then the end of the last
+
+		constexpr FieldNames( const char* const* names, const size_t* lengths ) :
+			text(),
+			offsets()
+		{
+			size_t length = 0;
+			for ( size_t position( 0 ); position < Count; ++position )
+			{
+				offsets[ position ] = length;
+				text[ length++ ] = '"';
+				for ( size_t offset( 0 ); offset < lengths[ position ]; ++offset )
+				{
+					length = _escapeCharacter( text, length, names[ position ][ offset ] );
+				}
+
+				text[ length++ ] = '"';
+				text[ length++ ] = ':';
+			}
+
+			offsets[ Count ] = length;
+		}
+	};
+
+	// Length of the names of the fields {@param fields} once quoted, escaped and followed by a colon
+	template < typename Fields, size_t... Positions >
+	static constexpr size_t _getFieldNamesLength( const Fields& fields, std::index_sequence< Positions... > ) noexcept
+	{
+		const char* const names[] = { std::get< Positions >( fields ).name..., nullptr };
+		const size_t lengths[] = { std::get< Positions >( fields ).length..., 0 };
+
+		size_t length = 1;
+		for ( size_t position( 0 ); position < sizeof...( Positions ); ++position )
+		{
+			length += 3;
+			for ( size_t offset( 0 ); offset < lengths[ position ]; ++offset )
+			{
+				length += _getEscapedLength( names[ position ][ offset ] );
+			}
+		}
+
+		return length;
+	}
+
+	// Build the escaped names of the fields {@param fields} of a bound type
+	template < size_t Capacity, typename Fields, size_t... Positions >
+	static constexpr FieldNames< sizeof...( Positions ), Capacity > _makeFieldNames( const Fields& fields, std::index_sequence< Positions... > ) noexcept
+	{
+		const char* const names[] = { std::get< Positions >( fields ).name..., nullptr };
+		const size_t lengths[] = { std::get< Positions >( fields ).length..., 0 };
+		return FieldNames< sizeof...( Positions ), Capacity >( names, lengths );
+	}
+
+	// The escaped names of the fields of the bound type {@param Bound}, built once at compile time
+	template < typename Bound >
+	static const auto& _getFieldNames() noexcept
+	{
+		constexpr size_t FIELD_COUNT = std::tuple_size< decltype( jsonFields( static_cast< const Bound* >( nullptr ) ) ) >::value;
+		constexpr size_t NAMES_LENGTH = _getFieldNamesLength( jsonFields( static_cast< const Bound* >( nullptr ) ),
+			std::make_index_sequence< FIELD_COUNT >() );
+		static constexpr FieldNames< FIELD_COUNT, NAMES_LENGTH > FIELD_NAMES = _makeFieldNames< NAMES_LENGTH >(
+			jsonFields( static_cast< const Bound* >( nullptr ) ), std::make_index_sequence< FIELD_COUNT >() );
+
+		return FIELD_NAMES;
+	}
+
+	// Write a boolean
+	static void _serializeValue( JsonSink& sink, bool value, size_t )
+	{
+		sink.append( value ? "true" : "false", value ? 4 : 5 );
+	}
+
+	// Write a string
+	static void _serializeValue( JsonSink& sink, const std::string& value, size_t )
+	{
+		_writeString( sink, value.data(), value.length() );
+	}
+
+	// Write a JsonValue, for members left dynamic
+	static void _serializeValue( JsonSink& sink, const JsonValue& value, size_t level )
+	{
+		_writeJSON( value, sink, level );
+	}
+
+	// Write a number, through the _writeNumber() overload of its kind
+	template < typename Number >
+	static typename std::enable_if< std::is_arithmetic< Number >::value >::type _serializeValue( JsonSink& sink, Number value, size_t )
+	{
+		using WrittenType = typename std::conditional< std::is_floating_point< Number >::value, long double,
+			typename std::conditional< std::is_signed< Number >::value, intmax_t, uintmax_t >::type >::type;
+		_writeNumber( sink, WrittenType( value ) );
+	}
+
+	// Write a std::vector as an array
+	template < typename Element, typename Allocator >
+	static void _serializeValue( JsonSink& sink, const std::vector< Element, Allocator >& elements, size_t level )
+	{
+		sink.append( "[", 1 );
+
+		for ( size_t position( 0 ); position < elements.size(); ++position )
+		{
+			if ( 0 < position )
+			{
+				sink.append( ",", 1 );
+			}
+
+			_writeIndentation( sink, level + 1 );
+			_serializeValue( sink, elements[ position ], level + 1 );
+		}
+
+		if ( not elements.empty() )
+		{
+			_writeIndentation( sink, level );
+		}
+
+		sink.append( "]", 1 );
+	}
+
+	// Write a std::map keyed by strings as an object
+	template < typename Mapped, typename Compare, typename Allocator >
+	static void _serializeValue( JsonSink& sink, const std::map< std::string, Mapped, Compare, Allocator >& members, size_t level )
+	{
+		sink.append( "{", 1 );
+
+		for ( auto member = members.begin(); member != members.end(); ++member )
+		{
+			if ( members.begin() != member )
+			{
+				sink.append( ",", 1 );
+			}
+
+			_writeIndentation( sink, level + 1 );
+			_writeString( sink, member->first.data(), member->first.length() );
+			sink.append( ( JsonValue::Indent::NONE == sink.indentation ) ? ":" : ": ", ( JsonValue::Indent::NONE == sink.indentation ) ? 1 : 2 );
+			_serializeValue( sink, member->second, level + 1 );
+		}
+
+		if ( not members.empty() )
+		{
+			_writeIndentation( sink, level );
+		}
+
+		sink.append( "}", 1 );
+	}
+
+#if __cplusplus >= 201703L
+	// Write a std::optional, or null if it is empty
+	template < typename Value >
+	static void _serializeValue( JsonSink& sink, const std::optional< Value >& value, size_t level )
+	{
+		if ( value )
+		{
+			_serializeValue( sink, *value, level );
+		}
+		else
+		{
+			sink.append( "null", 4 );
+		}
+	}
+
+	// Write the alternative a std::variant holds
+	template < typename... Alternatives >
+	static void _serializeValue( JsonSink& sink, const std::variant< Alternatives... >& value, size_t level )
+	{
+		std::visit( [ &sink, level ]( const auto& alternative )
+		{
+			_serializeValue( sink, alternative, level );
+		}, value );
+	}
+
+	// Write the empty alternative of a std::variant as null
+	static void _serializeValue( JsonSink& sink, std::monostate, size_t )
+	{
+		sink.append( "null", 4 );
+	}
+#endif
+
+	// Write the field at {@param Position} of a bound type, with its escaped name
+	template < typename Bound, size_t Position, typename Names >
+	static void _serializeField( JsonSink& sink, const Bound& value, size_t level, const Names& names )
+	{
+		constexpr auto field = std::get< Position >( jsonFields( static_cast< const Bound* >( nullptr ) ) );
+
+		if ( 0 < Position )
+		{
+			sink.append( ",", 1 );
+		}
+
+		_writeIndentation( sink, level + 1 );
+		sink.append( names.text + names.offsets[ Position ], names.offsets[ Position + 1 ] - names.offsets[ Position ] );
+
+		if ( JsonValue::Indent::NONE != sink.indentation )
+		{
+			sink.append( " ", 1 );
+		}
+
+		_serializeValue( sink, value.*( field.member ), level + 1 );
+	}
+
+	// Write every field of a bound type, in the order jsonFields() lists them
+	template < typename Bound, typename Names, size_t... Positions >
+	static void _serializeFields( JsonSink& sink, const Bound& value, size_t level, const Names& names, std::index_sequence< Positions... > )
+	{
+		const int expansion[] = { 0, ( _serializeField< Bound, Positions >( sink, value, level, names ), 0 )... };
+		static_cast< void >( expansion );
+	}
+
+	// Write a bound type as an object, whose fields are listed by its jsonFields()
+	template < typename Bound >
+	static auto _serializeValue( JsonSink& sink, const Bound& value, size_t level ) -> decltype( jsonFields( static_cast< const Bound* >( nullptr ) ), void() )
+	{
+		constexpr size_t FIELD_COUNT = std::tuple_size< decltype( jsonFields( static_cast< const Bound* >( nullptr ) ) ) >::value;
+
+		sink.append( "{", 1 );
+		_serializeFields( sink, value, level, _getFieldNames< Bound >(), std::make_index_sequence< FIELD_COUNT >() );
+
+		if ( 0 < FIELD_COUNT )
+		{
+			_writeIndentation( sink, level );
+		}
+
+		sink.append( "}", 1 );
+	}
+
+	// Check if this instance holds any elements or members
+	bool _hasChildren() const noexcept
+	{
+		return not ( mElements.empty() and mMembers.empty() );
+	}
+
+	// Move the elements and members that themselves hold children onto
+	// {@param pending}, then release what is left. Leaves are destroyed in
+	// place, as releasing them cannot recurse.
+	void _detachChildren( ArrayType& pending )
+	{
+		size_t containerCount = 0;
+
+		for ( const auto& element : mElements )
+		{
+			containerCount += element._hasChildren() ? 1 : 0;
+		}
+
+		for ( const auto& member : mMembers )
+		{
+			containerCount += member.second._hasChildren() ? 1 : 0;
+		}
+
+		// Reserve up front so that a failed allocation leaves this instance untouched.
+		pending.reserve( pending.size() + containerCount );
+
+		for ( auto& element : mElements )
+		{
+			if ( element._hasChildren() )
+			{
+				pending.push_back( std::move( element ) );
+			}
+		}
+
+		for ( auto& member : mMembers )
+		{
+			if ( member.second._hasChildren() )
+			{
+				pending.push_back( std::move( member.second ) );
+			}
+		}
+
+		mElements.clear();
+		mMembers.clear();
+	}
+
+	// Release the elements and members of this instance iteratively.
+	// Destroying mElements and mMembers directly recurses once per level
+	// of nesting, which overflows the stack for deeply nested documents.
+	void _releaseChildren() noexcept
+	{
+		if ( not _hasChildren() )
+		{
+			return;
+		}
+
+		try
+		{
+			ArrayType pending;
+			_detachChildren( pending );
+
+			while ( not pending.empty() )
+			{
+				JsonValue released( std::move( pending.back() ) );
+				pending.pop_back();
+				released._detachChildren( pending );
+			}
+		}
+		catch ( ... )
+		{
+			// The worklist could not be grown, fall back to the recursive release.
+			mElements.clear();
+			mMembers.clear();
+		}
+	}
+
+	// Widen a number type JsonValue to a long double
+	long double _toLongDouble() const noexcept
+	{
+		switch ( mNumericType )
+		{
+		case eNumberType::FLOATING:
+			return mNumericValue.floatValue;
+
+		case eNumberType::SIGNED_INTEGRAL:
+			return static_cast< long double >( mNumericValue.signedIntegral );
+
+		case eNumberType::UNSIGNED_INTEGRAL:
+			return static_cast< long double >( mNumericValue.unsignedIntegral );
+
+#ifdef INCLUDE_GMP
+		case eNumberType::MULTIPLE_PRECISION_FLOAT:
+			return static_cast< long double >( mpf_get_d( mNumericValue.MPFloatValue ) );
+
+		case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
+			return static_cast< long double >( mpz_get_d( mNumericValue.MPIntegralValue ) );
+#endif
+
+		default:
+			return 0.0L;
+		}
+	}
+
+	// Compare two number type JsonValues by value, regardless of their numeric type.
+	// A negative value, zero, or a positive value is returned if {@param left}
+	// is less than, equal to, or greater than {@param right}.
+	static int _compareNumbers( const JsonValue& left, const JsonValue& right ) noexcept
+	{
+		const bool leftIsIntegral = ( eNumberType::SIGNED_INTEGRAL == left.mNumericType )
+			or ( eNumberType::UNSIGNED_INTEGRAL == left.mNumericType );
+		const bool rightIsIntegral = ( eNumberType::SIGNED_INTEGRAL == right.mNumericType )
+			or ( eNumberType::UNSIGNED_INTEGRAL == right.mNumericType );
+
+		// Compare integrals exactly, rather than through a long double.
+		if ( leftIsIntegral and rightIsIntegral )
+		{
+			const bool leftIsNegative = ( eNumberType::SIGNED_INTEGRAL == left.mNumericType )
+				and ( left.mNumericValue.signedIntegral < 0 );
+			const bool rightIsNegative = ( eNumberType::SIGNED_INTEGRAL == right.mNumericType )
+				and ( right.mNumericValue.signedIntegral < 0 );
+
+			if ( leftIsNegative != rightIsNegative )
+			{
+				return leftIsNegative ? -1 : 1;
+			}
+
+			if ( leftIsNegative )
+			{
+				intmax_t leftValue = left.mNumericValue.signedIntegral;
+				intmax_t rightValue = right.mNumericValue.signedIntegral;
+				return ( leftValue < rightValue ) ? -1 : ( ( rightValue < leftValue ) ? 1 : 0 );
+			}
+
+			uintmax_t leftValue = ( eNumberType::SIGNED_INTEGRAL == left.mNumericType )
+				? uintmax_t( left.mNumericValue.signedIntegral ) : left.mNumericValue.unsignedIntegral;
+			uintmax_t rightValue = ( eNumberType::SIGNED_INTEGRAL == right.mNumericType )
+				? uintmax_t( right.mNumericValue.signedIntegral ) : right.mNumericValue.unsignedIntegral;
+			return ( leftValue < rightValue ) ? -1 : ( ( rightValue < leftValue ) ? 1 : 0 );
+		}
+
+		long double leftValue = left._toLongDouble();
+		long double rightValue = right._toLongDouble();
+		return ( leftValue < rightValue ) ? -1 : ( ( rightValue < leftValue ) ? 1 : 0 );
+	}
+
+	// Compare two JsonValues by value, with numbers compared regardless of their
+	// numeric type. This is the equality that hash() is consistent with.
+	static bool _equivalent( const JsonValue& left, const JsonValue& right ) noexcept
+	{
+		if ( ( Type::number == left.mType ) and ( Type::number == right.mType ) )
+		{
+			return 0 == _compareNumbers( left, right );
+		}
+
+		if ( left.mType != right.mType )
+		{
+			return false;
+		}
+
+		if ( Type::array == left.mType )
+		{
+			return std::equal( left.mElements.begin(), left.mElements.end(),
+				right.mElements.begin(), right.mElements.end(), _equivalent );
+		}
+
+		if ( Type::object == left.mType )
+		{
+			return std::equal( left.mMembers.begin(), left.mMembers.end(),
+				right.mMembers.begin(), right.mMembers.end(),
+				[]( const ObjectType::value_type& leftMember, const ObjectType::value_type& rightMember )
+				{
+					return ( leftMember.first == rightMember.first ) and _equivalent( leftMember.second, rightMember.second );
+				} );
+		}
+
+		return left == right;
+	}
+
+	// An operation of a JSON Patch, compiled before any operation is applied
+	struct PatchOperation
+	{
+		ePatchOperation operation;
+		Pointer path;
+		Pointer from;
+		const JsonValue* value;  // The "value" member of the operation, if it has one
+	};
+
+	// A step of the undo log of an atomic JSON Patch. The value displaced by each step is
+	// carried to the step before it, which is how a moved value finds its way back.
+	struct PatchUndo
+	{
+		ePatchUndo action;
+		const Pointer* path;
+		size_t value;    // Position of the value to put back in the values of the log
+		bool isCarried;  // Insert the value carried from the step after, rather than value
+	};
+
+	// The undo log of an atomic JSON Patch: its steps, and the values they put back
+	struct PatchLog
+	{
+		std::vector< PatchUndo > steps;
+		ArrayType values;
+
+		// Log {@param action} at {@param path}, keeping {@param value} to put back
+		void push( ePatchUndo action, const Pointer& path, JsonValue&& value, bool isCarried = false )
+		{
+			values.push_back( std::move( value ) );
+			steps.push_back( PatchUndo { action, &path, values.size() - 1, isCarried } );
+		}
+	};
+
+	// Compile the operations of the JSON Patch {@param patch}, checking their form
+	static std::vector< PatchOperation > _compilePatch( const JsonValue& patch )
+	{
+		const std::pair< const char*, ePatchOperation > OPERATIONS[] = { { "add", ePatchOperation::ADD },
+			{ "remove", ePatchOperation::REMOVE }, { "replace", ePatchOperation::REPLACE }, { "move", ePatchOperation::MOVE },
+			{ "copy", ePatchOperation::COPY }, { "test", ePatchOperation::TEST } };
+
+		if ( Type::array != patch.mType )
+		{
+			throw std::invalid_argument( "JSON Patch must be an array of operations" );
+		}
+
+		std::vector< PatchOperation > operations;
+		operations.reserve( patch.mElements.size() );
+		for ( const JsonValue& element : patch.mElements )
+		{
+			const JsonValue* name = element.find( "op" );
+			const JsonValue* path = element.find( "path" );
+			if ( ( Type::object != element.mType ) or ( nullptr == name ) or ( Type::string != name->mType )
+				or ( nullptr == path ) or ( Type::string != path->mType ) )
+			{
+				throw std::invalid_argument( "JSON Patch operation must be an object with string members 'op' and 'path'" );
+			}
+
+			const auto* known = std::find_if( std::begin( OPERATIONS ), std::end( OPERATIONS ),
+				[ name ]( const std::pair< const char*, ePatchOperation >& candidate ) { return name->mStringValue == candidate.first; } );
+			if ( std::end( OPERATIONS ) == known )
+			{
+				throw std::invalid_argument( "JSON Patch operation is unknown: " + name->mStringValue );
+			}
+
+			PatchOperation operation { known->second, Pointer( path->mStringValue ), Pointer(), element.find( "value" ) };
+			const bool needsFrom = ( ePatchOperation::MOVE == operation.operation ) or ( ePatchOperation::COPY == operation.operation );
+			const bool needsValue = ( ePatchOperation::ADD == operation.operation ) or ( ePatchOperation::REPLACE == operation.operation )
+				or ( ePatchOperation::TEST == operation.operation );
+
+			if ( needsFrom )
+			{
+				const JsonValue* from = element.find( "from" );
+				if ( ( nullptr == from ) or ( Type::string != from->mType ) )
+				{
+					throw std::invalid_argument( "JSON Patch operation '" + name->mStringValue + "' needs a string member 'from'" );
+				}
+
+				operation.from = Pointer( from->mStringValue );
+			}
+
+			if ( needsValue and ( nullptr == operation.value ) )
+			{
+				throw std::invalid_argument( "JSON Patch operation '" + name->mStringValue + "' needs a member 'value'" );
+			}
+
+			operations.push_back( std::move( operation ) );
+		}
+
+		return operations;
+	}
+
+	// Resolve the container that holds the value at {@param path}, which must not be the whole document
+	JsonValue& _resolvePatchParent( const Pointer& path )
+	{
+		JsonValue* parent = const_cast< JsonValue* >( path._get( *this, path.size() - 1 ) );
+		if ( ( nullptr == parent ) or ( ( Type::object != parent->mType ) and ( Type::array != parent->mType ) ) )
+		{
+			throw std::runtime_error( "JSON Patch path does not exist: " + path.toString() );
+		}
+
+		return *parent;
+	}
+
+	// Position in {@param parent}, an array, of the element {@param token} refers to, checked
+	// against the elements there are, plus one where the element after the last is allowed
+	static size_t _getPatchIndex( const JsonValue& parent, const Pointer& path, bool isAppending )
+	{
+		const Pointer::Token& token = path[ path.size() - 1 ];
+		const size_t count = parent.mElements.size() + ( isAppending ? 1 : 0 );
+
+		if ( isAppending and token.isEndOfArray )
+		{
+			return parent.mElements.size();
+		}
+
+		if ( ( not token.isIndex ) or ( count <= token.index ) )
+		{
+			throw std::runtime_error( "JSON Patch path does not exist: " + path.toString() );
+		}
+
+		return token.index;
+	}
+
+	// Add {@param value} at {@param path}, replacing a member of the same key, and log how to take it out
+	void _patchAdd( const Pointer& path, JsonValue&& value, PatchLog* log )
+	{
+		if ( path.empty() )
+		{
+			std::swap( *this, value );
+			if ( nullptr != log )
+			{
+				log->push( ePatchUndo::RESTORE, path, std::move( value ) );
+			}
+
+			return;
+		}
+
+		JsonValue& parent = _resolvePatchParent( path );
+		if ( Type::object == parent.mType )
+		{
+			auto member = parent.mMembers.lower_bound( path[ path.size() - 1 ].key );
+			if ( ( parent.mMembers.end() != member ) and ( member->first == path[ path.size() - 1 ].key ) )
+			{
+				std::swap( member->second, value );
+				if ( nullptr != log )
+				{
+					log->push( ePatchUndo::RESTORE, path, std::move( value ) );
+				}
+
+				return;
+			}
+
+			parent.mMembers.emplace_hint( member, path[ path.size() - 1 ].key, std::move( value ) );
+		}
+		else
+		{
+			parent.insert( _getPatchIndex( parent, path, true ), std::move( value ) );
+		}
+
+		if ( nullptr != log )
+		{
+			log->push( ePatchUndo::ERASE, path, JsonValue() );
+		}
+	}
+
+	// Take out the value at {@param path}, and log how to put it back. Where the value is to be
+	// moved elsewhere, {@param isCarried} is set and the log takes it back from there instead.
+	JsonValue _patchRemove( const Pointer& path, PatchLog* log, bool isCarried )
+	{
+		if ( path.empty() )
+		{
+			throw std::runtime_error( "JSON Patch cannot remove the whole document" );
+		}
+
+		JsonValue removed;
+		JsonValue& parent = _resolvePatchParent( path );
+		if ( Type::object == parent.mType )
+		{
+			auto member = parent.mMembers.find( path[ path.size() - 1 ].key );
+			if ( parent.mMembers.end() == member )
+			{
+				throw std::runtime_error( "JSON Patch path does not exist: " + path.toString() );
+			}
+
+			removed = std::move( member->second );
+			parent.mMembers.erase( member );
+		}
+		else
+		{
+			const size_t index = _getPatchIndex( parent, path, false );
+			removed = std::move( parent.mElements[ index ] );
+			parent.erase( index );
+		}
+
+		if ( nullptr != log )
+		{
+			log->push( ePatchUndo::INSERT, path, isCarried ? JsonValue() : JsonValue( std::move( removed ) ), isCarried );
+		}
+
+		return removed;
+	}
+
+	// Replace the value at {@param path} with {@param value}, and log how to swap it back
+	void _patchReplace( const Pointer& path, JsonValue&& value, PatchLog* log )
+	{
+		JsonValue* target = path.get( *this );
+		if ( nullptr == target )
+		{
+			throw std::runtime_error( "JSON Patch path does not exist: " + path.toString() );
+		}
+
+		JsonValue* parent = path.empty() ? nullptr : &_resolvePatchParent( path );
+		if ( ( nullptr != parent ) and ( Type::array == parent->mType ) )
+		{
+			parent->_swapElement( size_t( target - parent->mElements.data() ), value );
+		}
+		else
+		{
+			std::swap( *target, value );
+		}
+
+		if ( nullptr != log )
+		{
+			log->push( ePatchUndo::RESTORE, path, std::move( value ) );
+		}
+	}
+
+	// Apply {@param operation}, logging its steps to {@param log} if it is not null
+	void _applyPatchOperation( const PatchOperation& operation, PatchLog* log )
+	{
+		switch ( operation.operation )
+		{
+		case ePatchOperation::ADD:
+			_patchAdd( operation.path, JsonValue( *operation.value ), log );
+			break;
+
+		case ePatchOperation::REMOVE:
+			_patchRemove( operation.path, log, false );
+			break;
+
+		case ePatchOperation::REPLACE:
+			_patchReplace( operation.path, JsonValue( *operation.value ), log );
+			break;
+
+		case ePatchOperation::MOVE:
+		{
+			// A value cannot be moved into itself; moving it onto itself changes nothing.
+			const bool isSame = operation.from == operation.path;
+			const bool isWithin = ( operation.from.size() < operation.path.size() )
+				and std::equal( operation.from.begin(), operation.from.end(), operation.path.begin() );
+			if ( isWithin )
+			{
+				throw std::runtime_error( "JSON Patch cannot move a value into itself: " + operation.from.toString() );
+			}
+
+			if ( isSame )
+			{
+				if ( nullptr == operation.from.get( *this ) )
+				{
+					throw std::runtime_error( "JSON Patch path does not exist: " + operation.from.toString() );
+				}
+
+				break;
+			}
+
+			// Should the value not fit in its new place, it is put back, even when not atomic.
+			PatchLog steps;
+			PatchLog& moveLog = ( nullptr != log ) ? *log : steps;
+			JsonValue moved = _patchRemove( operation.from, &moveLog, true );
+
+			try
+			{
+				_patchAdd( operation.path, std::move( moved ), &moveLog );
+			}
+			catch ( ... )
+			{
+				moveLog.values.back() = std::move( moved );
+				moveLog.steps.back().isCarried = false;
+				if ( nullptr == log )
+				{
+					_undoPatch( steps );
+				}
+
+				throw;
+			}
+
+			break;
+		}
+
+		case ePatchOperation::COPY:
+		{
+			const JsonValue* source = operation.from.get( *this );
+			if ( nullptr == source )
+			{
+				throw std::runtime_error( "JSON Patch path does not exist: " + operation.from.toString() );
+			}
+
+			_patchAdd( operation.path, JsonValue( *source ), log );
+			break;
+		}
+
+		case ePatchOperation::TEST:
+		{
+			const JsonValue* value = operation.path.get( *this );
+			if ( ( nullptr == value ) or ( not _equivalent( *value, *operation.value ) ) )
+			{
+				throw std::runtime_error( "JSON Patch test failed: " + operation.path.toString() );
+			}
+
+			break;
+		}
+		}
+	}
+
+	// Swap {@param value} with the element at {@param position}, keeping the indexes over the array up to date
+	void _swapElement( size_t position, JsonValue& value )
+	{
+		std::swap( mElements[ position ], value );
+
+		for ( Index* index = mIndexes; nullptr != index; index = index->mNext )
+		{
+			index->_shift( position, 0, &position );
+			index->_insert( position );
+		}
+	}
+
+	// Reverse the steps of {@param log}, last first, restoring the document to how it was before
+	void _undoPatch( PatchLog& log )
+	{
+		JsonValue carried;
+
+		for ( auto step = log.steps.rbegin(); log.steps.rend() != step; ++step )
+		{
+			const Pointer& path = *step->path;
+			JsonValue& value = step->isCarried ? carried : log.values[ step->value ];
+			if ( path.empty() )
+			{
+				std::swap( *this, value );
+				carried = std::move( value );
+				continue;
+			}
+
+			JsonValue& parent = *const_cast< JsonValue* >( path._get( *this, path.size() - 1 ) );
+			const Pointer::Token& token = path[ path.size() - 1 ];
+
+			if ( Type::object == parent.mType )
+			{
+				switch ( step->action )
+				{
+				case ePatchUndo::ERASE:
+				{
+					auto member = parent.mMembers.find( token.key );
+					carried = std::move( member->second );
+					parent.mMembers.erase( member );
+					break;
+				}
+
+				case ePatchUndo::INSERT:
+					parent.mMembers.emplace( token.key, std::move( value ) );
+					break;
+
+				case ePatchUndo::RESTORE:
+					carried = std::move( parent.mMembers.find( token.key )->second );
+					parent.mMembers.find( token.key )->second = std::move( value );
+					break;
+				}
+
+				continue;
+			}
+
+			const size_t index = token.isEndOfArray ? ( parent.mElements.size() - 1 ) : token.index;
+			switch ( step->action )
+			{
+			case ePatchUndo::ERASE:
+				carried = std::move( parent.mElements[ index ] );
+				parent.erase( index );
+				break;
+
+			case ePatchUndo::INSERT:
+				parent.insert( index, std::move( value ) );
+				break;
+
+			case ePatchUndo::RESTORE:
+				parent._swapElement( index, value );
+				carried = std::move( value );
+				break;
+			}
+		}
+	}
+
+	// Merge {@param patch} into this instance as RFC 7396 describes. The values it adds are copied
+	// from a patch passed as an l-value, and moved from one passed as an r-value.
+	template < typename Patch >
+	void _mergePatch( Patch&& patch )
+	{
+		// Members are forwarded as the patch holding them was.
+		using Member = typename std::conditional< std::is_lvalue_reference< Patch >::value, const JsonValue&, JsonValue >::type;
+
+		// Members between consecutive changes are stepped over while few, else skipped by a lookup.
+		const size_t MERGE_WALK_STEPS = 8;
+
+		if ( Type::object != patch.mType )
+		{
+			*this = std::forward< Patch >( patch );
+			return;
+		}
+
+		if ( Type::object != mType )
+		{
+			*this = ObjectType();
+		}
+
+		// Both members are in key order, so each change is found from where the last one was.
+		auto member = mMembers.begin();
+		for ( auto& change : patch.mMembers )
+		{
+			size_t steps = 0;
+			while ( ( mMembers.end() != member ) and ( member->first < change.first ) and ( steps++ < MERGE_WALK_STEPS ) )
+			{
+				++member;
+			}
+
+			if ( MERGE_WALK_STEPS < steps )
+			{
+				member = mMembers.lower_bound( change.first );
+			}
+
+			if ( ( mMembers.end() != member ) and ( member->first == change.first ) )
+			{
+				if ( Type::null == change.second.mType )
+				{
+					member = mMembers.erase( member );
+				}
+				else
+				{
+					member->second._mergePatch( std::forward< Member >( change.second ) );
+					++member;
+				}
+			}
+			else if ( Type::object == change.second.mType )
+			{
+				// Nulls within a new object are dropped, so merge it into an empty one.
+				mMembers.emplace_hint( member, change.first, JsonValue( Type::object ) )->second._mergePatch( std::forward< Member >( change.second ) );
+			}
+			else if ( Type::null != change.second.mType )
+			{
+				mMembers.emplace_hint( member, change.first, std::forward< Member >( change.second ) );
+			}
+		}
+	}
+
+	// Hash of a subtree of a diffed value. The table of a value holds an entry for it followed
+	// by the tables of its members or elements, in order, {@param span} entries in all.
+	struct DiffHash
+	{
+		size_t hash;
+		size_t span;
+	};
+
+	// State shared by the steps of a diff: the hash tables of both values, the pointer to
+	// the identifying value of array elements, and the operations so far.
+	struct DiffContext
+	{
+		std::vector< DiffHash > sourceHashes;
+		std::vector< DiffHash > targetHashes;
+		const Pointer& key;
+		ArrayType operations;
+
+		// Append an operation, holding a copy of {@param value} if one is given
+		void push( const char* operation, const std::string& path, const JsonValue* value )
+		{
+			ObjectType members { { "op", JsonValue( std::string( operation ) ) }, { "path", JsonValue( path ) } };
+			if ( nullptr != value )
+			{
+				members.emplace( "value", *value );
+			}
+
+			operations.emplace_back( std::move( members ) );
+		}
+	};
+
+	// Hash {@param value} as hash() does, appending the table of it and of every value within
+	// it to {@param hashes}, each hash computed once from those of its children.
+	static size_t _hashTree( const JsonValue& value, std::vector< DiffHash >& hashes )
+	{
+		const size_t entry = hashes.size();
+		hashes.push_back( DiffHash { 0, 1 } );
+		size_t seed = size_t( value.mType );
+
+		switch ( value.mType )
+		{
+		case Type::object:
+			for ( const auto& member : value.mMembers )
+			{
+				seed = _combineHash( seed, std::hash< std::string >()( member.first ) );
+				seed = _combineHash( seed, _hashTree( member.second, hashes ) );
+			}
+			break;
+
+		case Type::array:
+			for ( const auto& element : value.mElements )
+			{
+				seed = _combineHash( seed, _hashTree( element, hashes ) );
+			}
+			break;
+
+		default:
+			seed = value.hash();
+			break;
+		}
+
+		hashes[ entry ] = DiffHash { seed, hashes.size() - entry };
+		return seed;
+	}
+
+	// Check what a matching hash leaves unconfirmed of {@param source} and {@param target}
+	// without walking them: their types, the lengths of containers, and any other values.
+	static bool _isShallowMatch( const JsonValue& source, const JsonValue& target ) noexcept
+	{
+		if ( source.mType != target.mType )
+		{
+			return false;
+		}
+
+		switch ( source.mType )
+		{
+		case Type::object:
+			return source.mMembers.size() == target.mMembers.size();
+
+		case Type::array:
+			return source.mElements.size() == target.mElements.size();
+
+		default:
+			return _equivalent( source, target );
+		}
+	}
+
+	// Append the operations that turn {@param source}, whose hash table starts at {@param sourceEntry},
+	// into {@param target}, whose table starts at {@param targetEntry}, found at {@param path}.
+	static void _diff( const JsonValue& source, size_t sourceEntry, const JsonValue& target, size_t targetEntry,
+		std::string& path, DiffContext& context )
+	{
+		// Differing hashes rule out equality without a comparison; matching ones are only checked shallowly.
+		if ( ( context.sourceHashes[ sourceEntry ].hash == context.targetHashes[ targetEntry ].hash )
+			and _isShallowMatch( source, target ) )
+		{
+			return;
+		}
+
+		if ( ( Type::object == source.mType ) and ( Type::object == target.mType ) )
+		{
+			_diffMembers( source, sourceEntry, target, targetEntry, path, context );
+		}
+		else if ( ( Type::array == source.mType ) and ( Type::array == target.mType ) )
+		{
+			_diffElements( source, sourceEntry, target, targetEntry, path, context );
+		}
+		else
+		{
+			context.push( "replace", path, &target );
+		}
+	}
+
+	// Append the operations that turn the members of {@param source} into those of {@param target},
+	// walking both, and their hash tables from {@param sourceEntry} and {@param targetEntry}, in key order at once.
+	static void _diffMembers( const JsonValue& source, size_t sourceEntry, const JsonValue& target, size_t targetEntry,
+		std::string& path, DiffContext& context )
+	{
+		const size_t length = path.length();
+		auto sourceMember = source.mMembers.begin();
+		auto targetMember = target.mMembers.begin();
+		size_t sourceChild = sourceEntry + 1;
+		size_t targetChild = targetEntry + 1;
+
+		while ( ( source.mMembers.end() != sourceMember ) or ( target.mMembers.end() != targetMember ) )
+		{
+			if ( ( target.mMembers.end() == targetMember )
+				or ( ( source.mMembers.end() != sourceMember ) and ( sourceMember->first < targetMember->first ) ) )
+			{
+				Pointer::_appendToken( path, sourceMember->first );
+				context.push( "remove", path, nullptr );
+				++sourceMember;
+				sourceChild += context.sourceHashes[ sourceChild ].span;
+			}
+			else if ( ( source.mMembers.end() == sourceMember ) or ( targetMember->first < sourceMember->first ) )
+			{
+				Pointer::_appendToken( path, targetMember->first );
+				context.push( "add", path, &targetMember->second );
+				++targetMember;
+				targetChild += context.targetHashes[ targetChild ].span;
+			}
+			else
+			{
+				Pointer::_appendToken( path, sourceMember->first );
+				_diff( sourceMember->second, sourceChild, targetMember->second, targetChild, path, context );
+				++sourceMember;
+				++targetMember;
+				sourceChild += context.sourceHashes[ sourceChild ].span;
+				targetChild += context.targetHashes[ targetChild ].span;
+			}
+
+			path.resize( length );
+		}
+	}
+
+	// Hash of what identifies {@param element} of an array, whose entry in {@param hashes} is
+	// {@param entry}: its value at the key of the diff, if {@param isKeyed}, or else the whole element.
+	static size_t _getDiffIdentity( const JsonValue& element, const std::vector< DiffHash >& hashes, size_t entry,
+		bool isKeyed, const DiffContext& context )
+	{
+		return isKeyed ? context.key.get( element )->hash() : hashes[ entry ].hash;
+	}
+
+	// Pair elements of the middles of two arrays, from {@param prefix} to {@param suffix} before
+	// their ends, along the longest common subsequence of their identities. That is found from a
+	// table of the length of the subsequence of every pair of suffixes, unless the table would
+	// exceed DIFF_ALIGNMENT_CELLS. Longer middles are aligned on the identities that occur once
+	// on each side instead, keeping the longest run of those in the same order on both sides.
+	static void _alignElements( const std::vector< size_t >& sourceIdentities, const std::vector< size_t >& targetIdentities,
+		size_t prefix, size_t suffix, std::vector< std::pair< size_t, size_t > >& pairs )
+	{
+		const size_t sourceLength = sourceIdentities.size() - prefix - suffix;
+		const size_t targetLength = targetIdentities.size() - prefix - suffix;
+		if ( ( 0 == sourceLength ) or ( 0 == targetLength ) )
+		{
+			return;
+		}
+
+		if ( ( sourceLength + 1 ) <= ( DIFF_ALIGNMENT_CELLS / ( targetLength + 1 ) ) )
+		{
+			const size_t width = targetLength + 1;
+			std::vector< uint32_t > lengths( ( sourceLength + 1 ) * width, 0 );
+			for ( size_t row( sourceLength ); 0 < row--; )
+			{
+				for ( size_t column( targetLength ); 0 < column--; )
+				{
+					lengths[ row * width + column ] = ( sourceIdentities[ prefix + row ] == targetIdentities[ prefix + column ] )
+						? lengths[ ( row + 1 ) * width + column + 1 ] + 1
+						: std::max( lengths[ ( row + 1 ) * width + column ], lengths[ row * width + column + 1 ] );
+				}
+			}
+
+			size_t row = 0;
+			size_t column = 0;
+			while ( ( row < sourceLength ) and ( column < targetLength ) )
+			{
+				if ( sourceIdentities[ prefix + row ] == targetIdentities[ prefix + column ] )
+				{
+					pairs.emplace_back( prefix + row++, prefix + column++ );
+				}
+				else if ( lengths[ ( row + 1 ) * width + column ] >= lengths[ row * width + column + 1 ] )
+				{
+					++row;
+				}
+				else
+				{
+					++column;
+				}
+			}
+
+			return;
+		}
+
+		// Count each identity on both sides, remembering where it last occurs.
+		struct Occurrences
+		{
+			size_t sourceCount;
+			size_t sourcePosition;
+			size_t targetCount;
+		};
+
+		std::unordered_map< size_t, Occurrences > occurrences;
+		for ( size_t position( prefix ); position < prefix + sourceLength; ++position )
+		{
+			Occurrences& occurrence = occurrences[ sourceIdentities[ position ] ];
+			++occurrence.sourceCount;
+			occurrence.sourcePosition = position;
+		}
+
+		for ( size_t position( prefix ); position < prefix + targetLength; ++position )
+		{
+			auto occurrence = occurrences.find( targetIdentities[ position ] );
+			if ( occurrences.end() != occurrence )
+			{
+				++occurrence->second.targetCount;
+			}
+		}
+
+		// The unique pairs in target order, of which the longest run increasing in source order
+		// is kept, found by patience sorting: the last pair of the best run of each length so far.
+		std::vector< std::pair< size_t, size_t > > candidates;
+		for ( size_t position( prefix ); position < prefix + targetLength; ++position )
+		{
+			auto occurrence = occurrences.find( targetIdentities[ position ] );
+			if ( ( occurrences.end() != occurrence ) and ( 1 == occurrence->second.sourceCount )
+				and ( 1 == occurrence->second.targetCount ) )
+			{
+				candidates.emplace_back( occurrence->second.sourcePosition, position );
+			}
+		}
+
+		std::vector< size_t > tails;
+		std::vector< size_t > previous( candidates.size(), candidates.size() );
+		for ( size_t candidate( 0 ); candidate < candidates.size(); ++candidate )
+		{
+			auto tail = std::lower_bound( tails.begin(), tails.end(), candidate,
+				[ &candidates ]( size_t left, size_t right )
+				{
+					return candidates[ left ].first < candidates[ right ].first;
+				} );
+
+			if ( tails.begin() != tail )
+			{
+				previous[ candidate ] = *std::prev( tail );
+			}
+
+			if ( tails.end() == tail )
+			{
+				tails.push_back( candidate );
+			}
+			else
+			{
+				*tail = candidate;
+			}
+		}
+
+		const size_t first = pairs.size();
+		for ( size_t candidate( tails.empty() ? candidates.size() : tails.back() ); candidates.size() != candidate;
+			candidate = previous[ candidate ] )
+		{
+			pairs.push_back( candidates[ candidate ] );
+		}
+
+		std::reverse( pairs.begin() + std::ptrdiff_t( first ), pairs.end() );
+	}
+
+	// Append the operations that turn the elements of {@param source} into those of {@param target}.
+	// Elements are paired by their identities, and each pair is diffed. Between pairs, elements
+	// are diffed in place until one side runs out, and the rest of the other side is removed or added.
+	static void _diffElements( const JsonValue& source, size_t sourceEntry, const JsonValue& target, size_t targetEntry,
+		std::string& path, DiffContext& context )
+	{
+		const ArrayType& sourceElements = source.mElements;
+		const ArrayType& targetElements = target.mElements;
+
+		// Elements are keyed only if every one of them, on both sides, holds the key.
+		const auto holdsKey = [ &context ]( const JsonValue& element )
+		{
+			return nullptr != context.key.get( element );
+		};
+		const bool isKeyed = not context.key.empty()
+			and std::all_of( sourceElements.begin(), sourceElements.end(), holdsKey )
+			and std::all_of( targetElements.begin(), targetElements.end(), holdsKey );
+
+		// The hash table entry of each element, found by skipping over those of the ones before it.
+		std::vector< size_t > sourceEntries;
+		std::vector< size_t > targetEntries;
+		std::vector< size_t > sourceIdentities;
+		std::vector< size_t > targetIdentities;
+		sourceEntries.reserve( sourceElements.size() );
+		targetEntries.reserve( targetElements.size() );
+		sourceIdentities.reserve( sourceElements.size() );
+		targetIdentities.reserve( targetElements.size() );
+		for ( size_t entry( sourceEntry + 1 ); sourceEntries.size() < sourceElements.size(); entry += context.sourceHashes[ entry ].span )
+		{
+			sourceIdentities.push_back( _getDiffIdentity( sourceElements[ sourceEntries.size() ], context.sourceHashes, entry, isKeyed, context ) );
+			sourceEntries.push_back( entry );
+		}
+
+		for ( size_t entry( targetEntry + 1 ); targetEntries.size() < targetElements.size(); entry += context.targetHashes[ entry ].span )
+		{
+			targetIdentities.push_back( _getDiffIdentity( targetElements[ targetEntries.size() ], context.targetHashes, entry, isKeyed, context ) );
+			targetEntries.push_back( entry );
+		}
+
+		// Trim the common prefix and suffix, which pair up without being aligned.
+		size_t prefix = 0;
+		while ( ( prefix < sourceIdentities.size() ) and ( prefix < targetIdentities.size() )
+			and ( sourceIdentities[ prefix ] == targetIdentities[ prefix ] ) )
+		{
+			++prefix;
+		}
+
+		size_t suffix = 0;
+		while ( ( prefix + suffix < sourceIdentities.size() ) and ( prefix + suffix < targetIdentities.size() )
+			and ( sourceIdentities[ sourceIdentities.size() - suffix - 1 ] == targetIdentities[ targetIdentities.size() - suffix - 1 ] ) )
+		{
+			++suffix;
+		}
+
+		std::vector< std::pair< size_t, size_t > > pairs;
+		for ( size_t position( 0 ); position < prefix; ++position )
+		{
+			pairs.emplace_back( position, position );
+		}
+
+		_alignElements( sourceIdentities, targetIdentities, prefix, suffix, pairs );
+		for ( size_t position( suffix ); 0 < position; --position )
+		{
+			pairs.emplace_back( sourceIdentities.size() - position, targetIdentities.size() - position );
+		}
+
+		pairs.emplace_back( sourceIdentities.size(), targetIdentities.size() );
+
+		// Walk the pairs, tracking where each element is in the array as it is being patched.
+		const size_t length = path.length();
+		const auto pathAt = [ &path, length ]( size_t position ) -> std::string&
+		{
+			path.resize( length );
+			return path.append( "/" ).append( std::to_string( position ) );
+		};
+
+		size_t sourcePosition = 0;
+		size_t targetPosition = 0;
+		size_t position = 0;
+		for ( const auto& pair : pairs )
+		{
+			for ( ; ( sourcePosition < pair.first ) and ( targetPosition < pair.second ); ++position )
+			{
+				_diff( sourceElements[ sourcePosition ], sourceEntries[ sourcePosition ], targetElements[ targetPosition ],
+					targetEntries[ targetPosition ], pathAt( position ), context );
+				++sourcePosition;
+				++targetPosition;
+			}
+
+			for ( ; sourcePosition < pair.first; ++sourcePosition )
+			{
+				context.push( "remove", pathAt( position ), nullptr );
+			}
+
+			for ( ; targetPosition < pair.second; ++position )
+			{
+				context.push( "add", pathAt( position ), &targetElements[ targetPosition++ ] );
+			}
+
+			// The last pair only marks the ends of the arrays.
+			if ( sourceElements.size() == pair.first )
+			{
+				break;
+			}
+
+			_diff( sourceElements[ sourcePosition ], sourceEntries[ sourcePosition ], targetElements[ targetPosition ],
+				targetEntries[ targetPosition ], pathAt( position++ ), context );
+			++sourcePosition;
+			++targetPosition;
+		}
+
+		path.resize( length );
+	}
+
+	// Mix {@param value} into the running hash {@param seed}
+	static size_t _combineHash( size_t seed, size_t value ) noexcept
+	{
+		return seed ^ ( value + size_t( 0x9e3779b97f4a7c15ULL ) + ( seed << 6 ) + ( seed >> 2 ) );
+	}
+
+	// Hash a number type JsonValue by value. Floating values that hold an
+	// integer hash as that integer, so they match the integral representation.
+	size_t _hashNumber() const noexcept
+	{
+		switch ( mNumericType )
+		{
+		case eNumberType::SIGNED_INTEGRAL:
+			return std::hash< uintmax_t >()( uintmax_t( mNumericValue.signedIntegral ) );
+
+		case eNumberType::UNSIGNED_INTEGRAL:
+			return std::hash< uintmax_t >()( mNumericValue.unsignedIntegral );
+
+		default:
+			break;
+		}
+
+		long double value = _toLongDouble();
+		if ( ( std::floor( value ) == value )
+			and ( -std::ldexp( 1.0L, 63 ) <= value ) and ( value < std::ldexp( 1.0L, 64 ) ) )
+		{
+			return std::hash< uintmax_t >()( ( value < 0 ) ? uintmax_t( intmax_t( value ) ) : uintmax_t( value ) );
+		}
+
+		return std::hash< long double >()( value );
+	}
+
+	// Get the type as a string
+	const std::string& _getTypeString() const
+	{
+		static const std::map< JsonValue::Type, std::string > TYPE_STRING_MAP
+		{
+			{ Type::object,    "object"    },
+			{ Type::array,     "array"     },
+			{ Type::string,    "string"    },
+			{ Type::number,    "number"    },
+			{ Type::boolean,   "boolean"   },
+			{ Type::null,      "null"      },
+			{ Type::undefined, "undefined" }
+		};
+
+		return TYPE_STRING_MAP.at( mType );
+	}
+
+	union
+	{
+		long double floatValue;      // The parsed number is floating.
+		intmax_t signedIntegral;     // The parsed number is signed.
+		uintmax_t unsignedIntegral;  // The parsed number is unsigned.
+#ifdef INCLUDE_GMP
+		mpz_t MPIntegralValue;      // Store the number as a multi-precision integral.
+		mpf_t MPFloatValue;         // Store the number as a multi-precision floating.
+#endif
+	}
+	mNumericValue;             // Anonymous union for holding numeric values.
+	Type mType;                // Type of this JsonValue.
+	eNumberType mNumericType;  // The best representation of mValue.
+	std::string mStringValue;  // Variable for holding string, non-mp numbers.
+	ArrayType mElements;       // Array of JsonValues.
+	ObjectType mMembers;       // Mapping of JsonValues.
+	bool mBoolean;             // Store the boolean value here.
+	Index* mIndexes = nullptr; // Indexes built over mElements.
+
+	// Just skip over any whitespace
+	static void _parseWhitespace( ParseSource& source )
+	{
+		const char STRING_WHITESPACE[] = " \r\n\t";
+		while ( ( not source.endOfSource() )
+			and ( nullptr != strchr( STRING_WHITESPACE, source.peek() ) ) )
+		{
+			source.update();
+		}
+	}
+
+	// Parse a string
+	void _parseString( ParseSource& source )
+	{
+		_readString( source, mStringValue );
+		mType = Type::string;
+	}
+
+	// Number of characters at {@param block}, of STRING_BLOCK_SIZE, before the first that ends a run
+	// of plain string characters: a quote, a backslash, a control character or a non-ASCII byte.
+	static size_t _getPlainLength( const char* block ) noexcept
+	{
+#if defined( __SSE2__ ) or defined( _M_X64 )
+		// Non-ASCII bytes are negative as signed bytes, so they compare below a space with the control characters.
+		const __m128i characters = _mm_loadu_si128( reinterpret_cast< const __m128i* >( block ) );
+		const __m128i special = _mm_or_si128( _mm_cmplt_epi8( characters, _mm_set1_epi8( ' ' ) ),
+			_mm_or_si128( _mm_cmpeq_epi8( characters, _mm_set1_epi8( '"' ) ), _mm_cmpeq_epi8( characters, _mm_set1_epi8( '\\' ) ) ) );
+		uint32_t mask = uint32_t( _mm_movemask_epi8( special ) ) | ( 1u << STRING_BLOCK_SIZE );
+
+		size_t length = 0;
+		while ( 0 == ( mask & 1 ) )
+		{
+			mask >>= 1;
+			++length;
+		}
+
+		return length;
+#else
+		size_t length = 0;
+		while ( ( length < STRING_BLOCK_SIZE ) and ( ' ' <= uint8_t( block[ length ] ) ) and ( uint8_t( block[ length ] ) < 0x80 )
+			and ( '"' != block[ length ] ) and ( '\\' != block[ length ] ) )
+		{
+			++length;
+		}
+
+		return length;
+#endif
+	}
+
+	// Length of the UTF-8 sequence at {@param offset} past the read position, or 0 if it is not
+	// well formed: an overlong form, a surrogate or past U+10FFFF (Unicode, Table 3-7).
+	static uint32_t _getUTF8Length( ParseSource& source, uint32_t offset )
+	{
+		const uint8_t lead = uint8_t( source.peek( offset ) );
+		const uint8_t second = uint8_t( source.peek( offset + 1 ) );
+		auto isContinuation = [ &source, offset ]( uint32_t position )
+		{
+			return 0x80 == ( uint8_t( source.peek( offset + position ) ) & 0xC0 );
+		};
+
+		if ( ( 0xC2 <= lead ) and ( lead <= 0xDF ) )
+		{
+			return isContinuation( 1 ) ? 2 : 0;
+		}
+
+		if ( ( 0xE0 <= lead ) and ( lead <= 0xEF ) )
+		{
+			const uint8_t low = ( 0xE0 == lead ) ? 0xA0 : 0x80;
+			const uint8_t high = ( 0xED == lead ) ? 0x9F : 0xBF;
+			return ( ( low <= second ) and ( second <= high ) and isContinuation( 2 ) ) ? 3 : 0;
+		}
+
+		if ( ( 0xF0 <= lead ) and ( lead <= 0xF4 ) )
+		{
+			const uint8_t low = ( 0xF0 == lead ) ? 0x90 : 0x80;
+			const uint8_t high = ( 0xF4 == lead ) ? 0x8F : 0xBF;
+			return ( ( low <= second ) and ( second <= high ) and isContinuation( 2 ) and isContinuation( 3 ) ) ? 4 : 0;
+		}
+
+		return 0;
+	}
+
+	// Scan the string from {@param offset} past the read position, just after its opening quote, and
+	// return the offset of its closing quote. Escapes, control characters and UTF-8 are checked as
+	// the string is scanned, and runs of plain ASCII are passed over a block at a time, so invalid
+	// text is rejected without a pass of its own. {@param hasEscape} is set if the string has escapes.
+	static uint32_t _scanString( ParseSource& source, uint32_t offset, bool& hasEscape )
+	{
+		const char STRING_ESCAPE_CHARACTER[] = "\"\\/bfnrtu";
+
+		for ( ;; )
+		{
+			const char* block = source.window( offset, STRING_BLOCK_SIZE );
+			const size_t plainLength = ( nullptr != block ) ? _getPlainLength( block ) : 0;
+			if ( 0 < plainLength )
+			{
+				offset += uint32_t( plainLength );
+				continue;
+			}
+
+			const uint8_t character = uint8_t( source.peek( offset ) );
+			if ( '"' == character )
+			{
+				return offset;
+			}
+
+			if ( '\\' == character )
+			{
+				++offset;
+				hasEscape = true;
+
+				if ( ( '\0' == source.peek( offset ) ) or ( nullptr == strchr( STRING_ESCAPE_CHARACTER, source.peek( offset ) ) ) )
+				{
+					throw ParseError( "parseString", source, offset );
+				}
+
+				if ( 'u' == source.peek( offset ) )
+				{
+					if ( isxdigit( source.peek( offset + 1 ) ) and isxdigit( source.peek( offset + 2 ) )
+						and isxdigit( source.peek( offset + 3 ) ) and isxdigit( source.peek( offset + 4 ) ) )
+					{
+						offset += 5;
+					}
+					else
+					{
+						throw ParseError( "parseString", source, offset );
+					}
+				}
+				else
+				{
+					++offset;
+				}
+			}
+			else if ( character < 0x20 )
+			{
+				// Also the end of the source, which peek() reads as a null character.
+				throw ParseError( "parseString", source, offset );
+			}
+			else if ( character < 0x80 )
+			{
+				++offset;
+			}
+			else
+			{
+				const uint32_t sequenceLength = _getUTF8Length( source, offset );
+				if ( 0 == sequenceLength )
+				{
+					throw ParseError( "parseString", source, offset );
+				}
+
+				offset += sequenceLength;
+			}
+		}
+	}
+
+	// Read the string at the current read position into {@param string}
+	static void _readString( ParseSource& source, std::string& string )
+	{
+		if ( '"' != source.peek() )
+		{
+			throw ParseError( "parseString", source );
+		}
+
+		source.update();
+		bool hasEscape = false;
+		const uint32_t stringLength = _scanString( source, 0, hasEscape );
+
+		source.copy( string, stringLength );
+		source.update( stringLength + 1 );
+
+		if ( hasEscape )
+		{
+			_unescapeString( string );
+		}
+	}
+
+	// Write the code point {@param codePoint} as UTF-8 at {@param offset} of {@param text},
+	// and return the offset after it
+	static constexpr size_t _encodeUTF8( char* text, size_t offset, uint32_t codePoint ) noexcept
+	{
+		if ( codePoint < 0x80 )
+		{
+			text[ offset++ ] = char( codePoint );
+		}
+		else if ( codePoint < 0x800 )
+		{
+			text[ offset++ ] = char( 0xC0 | ( codePoint >> 6 ) );
+			text[ offset++ ] = char( 0x80 | ( codePoint & 0x3F ) );
+		}
+		else if ( codePoint < 0x10000 )
+		{
+			text[ offset++ ] = char( 0xE0 | ( codePoint >> 12 ) );
+			text[ offset++ ] = char( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+			text[ offset++ ] = char( 0x80 | ( codePoint & 0x3F ) );
+		}
+		else
+		{
+			text[ offset++ ] = char( 0xF0 | ( codePoint >> 18 ) );
+			text[ offset++ ] = char( 0x80 | ( ( codePoint >> 12 ) & 0x3F ) );
+			text[ offset++ ] = char( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+			text[ offset++ ] = char( 0x80 | ( codePoint & 0x3F ) );
+		}
+
+		return offset;
+	}
+
+	// Replace the escape sequences of the string {@param string}, already checked by
+	// _readString(), with the characters they stand for. A surrogate pair becomes one
+	// code point, and a lone surrogate becomes U+FFFD. The result is never longer than
+	// the escaped text, so the string is rewritten in place.
+	static void _unescapeString( std::string& string )
+	{
+		const char SHORT_ESCAPES[] = "\"\"\\\\//b\bf\fn\nr\rt\t";
+		auto readHex = [ &string ]( size_t offset )
+		{
+			return uint32_t( std::stoul( string.substr( offset, 4 ), nullptr, 16 ) );
+		};
+
+		size_t write = 0;
+		for ( size_t read( 0 ); read < string.length(); ++read )
+		{
+			if ( '\\' != string[ read ] )
+			{
+				string[ write++ ] = string[ read ];
+				continue;
+			}
+
+			const char letter = string[ ++read ];
+			if ( 'u' != letter )
+			{
+				string[ write++ ] = strchr( SHORT_ESCAPES, letter )[ 1 ];
+				continue;
+			}
+
+			uint32_t codePoint = readHex( read + 1 );
+			read += 4;
+
+			if ( ( 0xD800 <= codePoint ) and ( codePoint < 0xDC00 ) and ( read + 6 < string.length() )
+				and ( '\\' == string[ read + 1 ] ) and ( 'u' == string[ read + 2 ] )
+				and ( 0xDC00 <= readHex( read + 3 ) ) and ( readHex( read + 3 ) < 0xE000 ) )
+			{
+				codePoint = 0x10000 + ( ( codePoint - 0xD800 ) << 10 ) + ( readHex( read + 3 ) - 0xDC00 );
+				read += 6;
+			}
+			else if ( ( 0xD800 <= codePoint ) and ( codePoint < 0xE000 ) )
+			{
+				codePoint = 0xFFFD;
+			}
+
+			write = _encodeUTF8( &string[ 0 ], write, codePoint );
+		}
+
+		string.resize( write );
+	}
+
+	// Parse a number into the narrowest numeric type that holds it: an integer as unsigned,
+	// or as signed if it is negative, and a fraction or exponent as a long double. Integers
+	// out of the range of the native integrals are kept exactly with GMP, else as a long double.
+	void _parseNumber( ParseSource& source )
+	{
+		std::string text;
+		_readNumberText( source, text );
+		mType = Type::number;
+
+		if ( std::string::npos == text.find_first_of( ".eE" ) )
+		{
+			errno = 0;
+			if ( '-' == text[ 0 ] )
+			{
+				mNumericType = eNumberType::SIGNED_INTEGRAL;
+				mNumericValue.signedIntegral = intmax_t( strtoll( text.c_str(), nullptr, 10 ) );
+			}
+			else
+			{
+				mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+				mNumericValue.unsignedIntegral = uintmax_t( strtoull( text.c_str(), nullptr, 10 ) );
+			}
+
+			if ( ERANGE != errno )
+			{
+				return;
+			}
+
+#ifdef INCLUDE_GMP
+			mNumericType = eNumberType::MULTIPLE_PRECISION_INTEGRAL;
+			mpz_init_set_str( mNumericValue.MPIntegralValue, text.c_str(), 10 );
+			return;
+#endif
+		}
+
+		mNumericType = eNumberType::FLOATING;
+		mNumericValue.floatValue = strtold( text.c_str(), nullptr );
+	}
+
+	// Parse an array
+	void _parseArray( ParseSource& source )
+	{
+		if ( '[' != source.peek() )
+		{
+			throw ParseError( "parseArray", source );
+		}
+
+		source.update();
+		_parseWhitespace( source );
+		while ( ( not source.endOfSource() ) and ( ']' != source.peek() ) )
+		{
+			// Parse each element in place rather than moving a parsed temporary into the array.
+			mElements.emplace_back();
+			mElements.back()._parseValue( source );
+
+			if ( ',' == source.peek() )
+			{
+				source.update();
+			}
+			else if ( ']' != source.peek() )
+			{
+				throw ParseError( "parseArray", source );
+			}
+		}
+
+		if ( ']' != source.peek() )
+		{
+			source.update();
+			throw ParseError( "parseArray", source );
+		}
+		else
+		{
+			source.update();
+		}
+
+		mType = Type::array;
+	}
+
+	// Parse an object
+	void _parseObject( ParseSource& source )
+	{
+		if ( '{' != source.peek() )
+		{
+			throw ParseError( "parseObject", source );
+		}
+
+		source.update();
+		_parseWhitespace( source );
+		while ( ( not source.endOfSource() ) and ( '}' != source.peek() ) )
+		{
+			std::string key;
+			_parseWhitespace( source );
+			_readString( source, key );
+			_parseWhitespace( source );
+
+			if ( ':' != source.peek() )
+			{
+				throw ParseError( "parseObject", source );
+			}
+
+			source.update();
+			JsonValue value;
+			value._parseValue( source );
+			mMembers[ std::move( key ) ] = std::move( value );
+
+			if ( ',' == source.peek() )
+			{
+				source.update();
+			}
+			else if ( '}' != source.peek() )
+			{
+				throw ParseError( "parseObject", source );
+			}
+		}
+
+		if ( '}' != source.peek() )
+		{
+			source.update();
+			throw ParseError( "parseObject", source );
+		}
+		else
+		{
+			source.update();
+		}
+
+		mType = Type::object;
+	}
+
+	// Check that nothing but whitespace follows the root value read from {@param source}
+	static void _parseEndOfSource( ParseSource& source )
+	{
+		_parseWhitespace( source );
+		if ( not source.endOfSource() )
+		{
+			throw ParseError( "parseEndOfSource", source );
+		}
+	}
+
+	// Root of the parser
+	void _parseValue( ParseSource& source )
+	{
+		const char STRING_TRUE[] = "true";
+		const char STRING_FALSE[] = "false";
+		const char STRING_NULL[] = "null";
+
+		_parseWhitespace( source );
+
+		if ( '"' == source.peek() )
+		{
+			_parseString( source );
+		}
+		else if ( ( '-' == source.peek() ) or isdigit( source.peek() ) )
+		{
+			_parseNumber( source );
+		}
+		else if ( '{' == source.peek() )
+		{
+			_parseObject( source );
+		}
+		else if ( '[' == source.peek() )
+		{
+			_parseArray( source );
+		}
+		else if ( source.strncmp( STRING_TRUE, strlen( STRING_TRUE ) ) )
+		{
+			// Parse a boolean
+			mType = Type::boolean;
+			mBoolean = true;
+			source.update( strlen( STRING_TRUE ) );
+		}
+		else if ( source.strncmp( STRING_FALSE, strlen( STRING_FALSE ) ) )
+		{
+			// Parse a boolean
+			mType = Type::boolean;
+			mBoolean = false;
+			source.update( strlen( STRING_FALSE ) );
+		}
+		else if ( source.strncmp( STRING_NULL, strlen( STRING_NULL ) ) )
+		{
+			// Parse a null
+			mType = Type::null;
+			source.update( strlen( STRING_NULL ) );
+		}
+		else
+		{
+			throw ParseError( "parseValue", source );
+		}
+
+		_parseWhitespace( source );
+	}
+
+	// Skip over the string at the current read position without copying it.
+	static void _skipString( ParseSource& source )
+	{
+		if ( '"' != source.peek() )
+		{
+			throw ParseError( "skipString", source );
+		}
+
+		// Skipped strings are checked as read ones are, so no invalid text passes unseen.
+		bool hasEscape = false;
+		source.update( _scanString( source, 1, hasEscape ) + 1 );
+	}
+
+	// Skip over the member key and its colon at the current read position.
+	static void _skipMemberKey( ParseSource& source )
+	{
+		_parseWhitespace( source );
+		_skipString( source );
+		_parseWhitespace( source );
+
+		if ( ':' != source.peek() )
+		{
+			throw ParseError( "skipValue", source );
+		}
+
+		source.update();
+	}
+
+	// Skip over the value at the current read position without building it, checking it
+	// against the JSON grammar as the parser would. Open containers are tracked on a stack
+	// of their opening brackets, so skipping does not recurse.
+	static void _skipValue( ParseSource& source )
+	{
+		const char STRING_TRUE[] = "true";
+		const char STRING_FALSE[] = "false";
+		const char STRING_NULL[] = "null";
+		std::string scopes;
+
+		do
+		{
+			_parseWhitespace( source );
+
+			if ( source.endOfSource() )
+			{
+				throw ParseError( "skipValue", source );
+			}
+
+			switch ( source.peek() )
+			{
+			case '{':
+			case '[':
+				scopes.push_back( source.peek() );
+				source.update();
+				_parseWhitespace( source );
+
+				if ( ( ( '{' == scopes.back() ) ? '}' : ']' ) == source.peek() )
+				{
+					scopes.pop_back();
+					source.update();
+					break;
+				}
+
+				if ( '{' == scopes.back() )
+				{
+					_skipMemberKey( source );
+				}
+
+				continue;
+
+			case '"':
+				_skipString( source );
+				break;
+
+			default:
+				if ( source.strncmp( STRING_TRUE, strlen( STRING_TRUE ) ) )
+				{
+					source.update( strlen( STRING_TRUE ) );
+				}
+				else if ( source.strncmp( STRING_FALSE, strlen( STRING_FALSE ) ) )
+				{
+					source.update( strlen( STRING_FALSE ) );
+				}
+				else if ( source.strncmp( STRING_NULL, strlen( STRING_NULL ) ) )
+				{
+					source.update( strlen( STRING_NULL ) );
+				}
+				else
+				{
+					source.update( _scanNumber( source ) );
+				}
+				break;
+			}
+
+			// A value has ended: close the containers it ends, or move on to the next element
+			_parseWhitespace( source );
+			while ( not scopes.empty() )
+			{
+				if ( ',' == source.peek() )
+				{
+					source.update();
+					if ( '{' == scopes.back() )
+					{
+						_skipMemberKey( source );
+					}
+
+					break;
+				}
+
+				if ( ( ( '{' == scopes.back() ) ? '}' : ']' ) != source.peek() )
+				{
+					throw ParseError( "skipValue", source );
+				}
+
+				scopes.pop_back();
+				source.update();
+				_parseWhitespace( source );
+			}
+		}
+		while ( not scopes.empty() );
+	}
+
+	// The letter of the two character escape of {@param character}, or '\0' if it has none
+	static constexpr char _getShortEscape( char character ) noexcept
+	{
+		const char SHORT_ESCAPES[] = "\"\"\\\\b\bf\fn\nr\rt\t";
+		for ( size_t position( 0 ); position + 1 < sizeof( SHORT_ESCAPES ); position += 2 )
+		{
+			if ( SHORT_ESCAPES[ position + 1 ] == character )
+			{
+				return SHORT_ESCAPES[ position ];
+			}
+		}
+
+		return '\0';
+	}
+
+	// Number of characters {@param character} takes once escaped in a JSON string
+	static constexpr size_t _getEscapedLength( char character ) noexcept
+	{
+		return ( ( uint8_t( character ) < 0x20 ) or ( '"' == character ) or ( '\\' == character ) )
+			? ( ( '\0' != _getShortEscape( character ) ) ? 2 : 6 ) : 1;
+	}
+
+	// Write {@param character}, escaped for a JSON string, to {@param text} at {@param offset}.
+	// Returns the offset after the written characters.
+	static constexpr size_t _escapeCharacter( char* text, size_t offset, char character ) noexcept
+	{
+		const char HEX_DIGITS[] = "0123456789abcdef";
+
+		switch ( _getEscapedLength( character ) )
+		{
+		case 2:
+			text[ offset++ ] = '\\';
+			text[ offset++ ] = _getShortEscape( character );
+			break;
+
+		case 6:
+			text[ offset++ ] = '\\';
+			text[ offset++ ] = 'u';
+			text[ offset++ ] = '0';
+			text[ offset++ ] = '0';
+			text[ offset++ ] = HEX_DIGITS[ uint8_t( character ) >> 4 ];
+			text[ offset++ ] = HEX_DIGITS[ uint8_t( character ) & 0x0F ];
+			break;
+
+		default:
+			text[ offset++ ] = character;
+			break;
+		}
+
+		return offset;
+	}
+
+	// Write a new line and {@param level} levels of indentation, if the sink is indented
+	static void _writeIndentation( JsonSink& sink, size_t level )
+	{
+		static const std::string TABS( 64, '\t' );
+		static const std::string SPACES( 64, ' ' );
+
+		if ( JsonValue::Indent::NONE == sink.indentation )
+		{
+			return;
+		}
+
+		const std::string& fill = ( JsonValue::Indent::TAB == sink.indentation ) ? TABS : SPACES;
+		size_t count = ( JsonValue::Indent::TAB == sink.indentation ) ? level : level * sink.indentSpaces;
+
+		sink.append( "\n", 1 );
+		while ( 0 < count )
+		{
+			const size_t chunk = std::min( count, fill.length() );
+			sink.append( fill.data(), chunk );
+			count -= chunk;
+		}
+	}
+
+	// Write {@param length} bytes of {@param string} as a quoted JSON string.
+	// Runs of characters that need no escape are appended whole.
+	static void _writeString( JsonSink& sink, const char* string, size_t length )
+	{
+		sink.append( "\"", 1 );
+
+		size_t runStart = 0;
+		for ( size_t offset( 0 ); offset < length; ++offset )
+		{
+			if ( 1 < _getEscapedLength( string[ offset ] ) )
+			{
+				char escape[ 6 ] = {};
+				sink.append( string + runStart, offset - runStart );
+				sink.append( escape, _escapeCharacter( escape, 0, string[ offset ] ) );
+				runStart = offset + 1;
+			}
+		}
+
+		sink.append( string + runStart, length - runStart );
+		sink.append( "\"", 1 );
+	}
+
+	// Write a floating number
+	static void _writeNumber( JsonSink& sink, long double number )
+	{
+		char buffer[ 128 ];
+		const int length = snprintf( buffer, sizeof( buffer ), "%.*Le", LDBL_DIG + 3, number );
+		sink.append( buffer, size_t( std::max( length, 0 ) ) );
+	}
+
+	// Write a signed integral number
+	static void _writeNumber( JsonSink& sink, intmax_t number )
+	{
+		char buffer[ 32 ];
+		const int length = snprintf( buffer, sizeof( buffer ), "%lld", static_cast< long long >( number ) );
+		sink.append( buffer, size_t( std::max( length, 0 ) ) );
+	}
+
+	// Write an unsigned integral number
+	static void _writeNumber( JsonSink& sink, uintmax_t number )
+	{
+		char buffer[ 32 ];
+		const int length = snprintf( buffer, sizeof( buffer ), "%llu", static_cast< unsigned long long >( number ) );
+		sink.append( buffer, size_t( std::max( length, 0 ) ) );
+	}
+
+	// Write the given JsonValue out to the given sink.
+	static void _writeJSON( const JsonValue& value, JsonSink& sink, size_t level = 0 )
+	{
+		switch ( value.mType )
+		{
+		case JsonValue::Type::object:
+			sink.append( "{", 1 );
+
+			for ( auto iter = value.mMembers.begin(); iter != value.mMembers.end(); ++iter )
+			{
+				if ( value.mMembers.begin() != iter )
+				{
+					sink.append( ",", 1 );
+				}
+
+				_writeIndentation( sink, level + 1 );
+				_writeString( sink, iter->first.data(), iter->first.length() );
+				sink.append( ":", 1 );
+
+				if ( JsonValue::Indent::NONE != sink.indentation )
+				{
+					sink.append( " ", 1 );
+				}
+
+				_writeJSON( iter->second, sink, level + 1 );
+			}
+
+			if ( 0 < value.mMembers.size() )
+			{
+				_writeIndentation( sink, level );
+			}
+
+			sink.append( "}", 1 );
+			break;
+
+		case JsonValue::Type::array:
+			sink.append( "[", 1 );
+
+			for ( size_t index( 0 ); index < value.mElements.size(); ++index )
+			{
+				if ( 0 < index )
+				{
+					sink.append( ",", 1 );
+				}
+
+				_writeIndentation( sink, level + 1 );
+				_writeJSON( value.mElements[ index ], sink, level + 1 );
+			}
+
+			if ( 0 < value.mElements.size() )
+			{
+				_writeIndentation( sink, level );
+			}
+
+			sink.append( "]", 1 );
+			break;
+
+		case JsonValue::Type::string:
+			_writeString( sink, value.mStringValue.data(), value.mStringValue.length() );
+			break;
+
+		case JsonValue::Type::number:
+			switch ( value.mNumericType )
+			{
+			case eNumberType::FLOATING:
+				_writeNumber( sink, value.mNumericValue.floatValue );
+				break;
+
+			case eNumberType::SIGNED_INTEGRAL:
+				_writeNumber( sink, value.mNumericValue.signedIntegral );
+				break;
+
+			case eNumberType::UNSIGNED_INTEGRAL:
+				_writeNumber( sink, value.mNumericValue.unsignedIntegral );
+				break;
+
+#ifdef INCLUDE_GMP
+			case eNumberType::MULTIPLE_PRECISION_FLOAT:
+				char* mpfString = mpf_get_str( nullptr, 10, value.mNumericValue. );
+				sink.append( std::string( mpfString ) );
+
+				// Now we need to free the buffer from gmp
+				void ( *freeFunction )( void*, size_t );
+				mp_get_memory_functions( nullptr, nullptr, &freeFunction );
+				freeFunction( mpzString, strlen( mpzString ) + 1 );
+				break;
+
+			case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
+				char* mpzString = mpz_get_str( nullptr, 10, value.mNumericValue );
+				sink.append( std::string( mpzString ) );
+
+				// Now we need to free the buffer from gmp
+				void ( *freeFunction )( void*, size_t );
+				mp_get_memory_functions( nullptr, nullptr, &freeFunction );
+				freeFunction( mpzString, strlen( mpzString ) + 1 );
+				break;
+#endif
+			default:
+				break;
+			}
+
+			break;
+			
+		case JsonValue::Type::boolean:
+			sink.append( value.mBoolean ? "true" : "false" );
+			break;
+
+		// JSON has no undefined, so it is written as null, as the MessagePack and UBJSON writers do.
+		case JsonValue::Type::null:
+		case JsonValue::Type::undefined:
+			sink.append( "null" );
+			break;
+		}
+	}
+
+	// Write the CBOR head of a data item, the major type and its argument,
+	// using the shortest encoding of the argument.
+	static void _writeCBORHead( JsonSink& sink, eCBORMajorType majorType, uint64_t argument )
+	{
+		char head[ 9 ];
+		size_t headLength = 9;
+		uint8_t additional = 27;
+
+		if ( argument < 24 )
+		{
+			headLength = 1;
+			additional = uint8_t( argument );
+		}
+		else if ( argument <= 0xFF )
+		{
+			headLength = 2;
+			additional = 24;
+		}
+		else if ( argument <= 0xFFFF )
+		{
+			headLength = 3;
+			additional = 25;
+		}
+		else if ( argument <= 0xFFFFFFFF )
+		{
+			headLength = 5;
+			additional = 26;
+		}
+
+		head[ 0 ] = char( ( uint8_t( majorType ) << 5 ) | additional );
+		for ( size_t position( 1 ); position < headLength; ++position )
+		{
+			head[ position ] = char( argument >> ( 8 * ( headLength - 1 - position ) ) );
+		}
+
+		sink.append( head, headLength );
+	}
+
+	// Write a floating point number in the shortest of single and double
+	// precision that holds it exactly, falling back to double precision.
+	static void _writeCBORFloat( JsonSink& sink, long double value )
+	{
+		char buffer[ 9 ];
+
+		if ( std::isnan( value ) )
+		{
+			const char CANONICAL_NAN[] = { char( 0xF9 ), char( 0x7E ), char( 0x00 ) };
+			sink.append( CANONICAL_NAN, sizeof( CANONICAL_NAN ) );
+			return;
+		}
+
+		const float singlePrecision = float( value );
+		if ( value == static_cast< long double >( singlePrecision ) )
+		{
+			uint32_t bits;
+			std::memcpy( &bits, &singlePrecision, sizeof( bits ) );
+			buffer[ 0 ] = char( 0xFA );
+			for ( size_t position( 0 ); position < 4; ++position )
+			{
+				buffer[ 1 + position ] = char( bits >> ( 8 * ( 3 - position ) ) );
+			}
+
+			sink.append( buffer, 5 );
+			return;
+		}
+
+		const double doublePrecision = double( value );
+		uint64_t bits;
+		std::memcpy( &bits, &doublePrecision, sizeof( bits ) );
+		buffer[ 0 ] = char( 0xFB );
+		for ( size_t position( 0 ); position < 8; ++position )
+		{
+			buffer[ 1 + position ] = char( bits >> ( 8 * ( 7 - position ) ) );
+		}
+
+		sink.append( buffer, 9 );
+	}
+
+#ifdef INCLUDE_GMP
+	// Write a multiple precision integral as a bignum, tag 2 or 3.
+	static void _writeCBORBignum( JsonSink& sink, const mpz_t integralValue )
+	{
+		mpz_t magnitude;
+		mpz_init( magnitude );
+
+		// Negative bignums encode -1 - n, as negative integers do.
+		const bool isNegative = mpz_sgn( integralValue ) < 0;
+		if ( isNegative )
+		{
+			mpz_com( magnitude, integralValue );
+		}
+		else
+		{
+			mpz_set( magnitude, integralValue );
+		}
+
+		std::string bytes( ( mpz_sizeinbase( magnitude, 2 ) + 7 ) / 8, '\0' );
+		size_t byteCount = 0;
+		mpz_export( &bytes[ 0 ], &byteCount, 1, 1, 1, 0, magnitude );
+		bytes.resize( byteCount );
+		mpz_clear( magnitude );
+
+		_writeCBORHead( sink, eCBORMajorType::TAG, isNegative ? 3 : 2 );
+		_writeCBORHead( sink, eCBORMajorType::BYTE_STRING, bytes.length() );
+		sink.append( bytes.data(), bytes.length() );
+	}
+
+	// Write a multiple precision float as a decimal fraction, tag 4,
+	// holding the decimal exponent and the mantissa as a bignum.
+	static void _writeCBORDecimalFraction( JsonSink& sink, const mpf_t floatValue )
+	{
+		mp_exp_t exponent = 0;
+		char* digits = mpf_get_str( nullptr, &exponent, 10, 0, floatValue );
+		std::string mantissaString( digits );
+
+		void ( *freeFunction )( void*, size_t );
+		mp_get_memory_functions( nullptr, nullptr, &freeFunction );
+		freeFunction( digits, strlen( digits ) + 1 );
+
+		// mpf_get_str() returns the digits of 0.d1d2...dn x 10^exponent.
+		const size_t digitCount = mantissaString.length() - ( ( '-' == mantissaString[ 0 ] ) ? 1 : 0 );
+		const intmax_t decimalExponent = mantissaString.empty() ? 0 : intmax_t( exponent ) - intmax_t( digitCount );
+
+		mpz_t mantissa;
+		mpz_init_set_str( mantissa, mantissaString.empty() ? "0" : mantissaString.c_str(), 10 );
+
+		_writeCBORHead( sink, eCBORMajorType::TAG, 4 );
+		_writeCBORHead( sink, eCBORMajorType::ARRAY, 2 );
+		if ( decimalExponent < 0 )
+		{
+			_writeCBORHead( sink, eCBORMajorType::NEGATIVE_INTEGER, uint64_t( -( decimalExponent + 1 ) ) );
+		}
+		else
+		{
+			_writeCBORHead( sink, eCBORMajorType::UNSIGNED_INTEGER, uint64_t( decimalExponent ) );
+		}
+
+		_writeCBORBignum( sink, mantissa );
+		mpz_clear( mantissa );
+	}
+#endif
+
+	// Write an array of numbers as an RFC 8746 typed array, little endian and of the
+	// narrowest element type that holds every element. Returns false if the elements
+	// are not all integral or all floating, in which case nothing is written.
+	bool _writeCBORTypedArray( JsonSink& sink ) const
+	{
+		bool isIntegral = true;
+		bool isFloating = true;
+		bool isSinglePrecision = true;
+		uintmax_t maximum = 0;
+		intmax_t minimum = 0;
+
+		for ( const auto& element : mElements )
+		{
+			if ( Type::number != element.mType )
+			{
+				return false;
+			}
+
+			switch ( element.mNumericType )
+			{
+			case eNumberType::SIGNED_INTEGRAL:
+				isFloating = false;
+				minimum = std::min( minimum, element.mNumericValue.signedIntegral );
+				maximum = std::max( maximum, uintmax_t( std::max< intmax_t >( 0, element.mNumericValue.signedIntegral ) ) );
+				break;
+
+			case eNumberType::UNSIGNED_INTEGRAL:
+				isFloating = false;
+				maximum = std::max( maximum, element.mNumericValue.unsignedIntegral );
+				break;
+
+			case eNumberType::FLOATING:
+				isIntegral = false;
+				isSinglePrecision = isSinglePrecision
+					and ( element.mNumericValue.floatValue == static_cast< long double >( float( element.mNumericValue.floatValue ) ) );
+				break;
+
+			default:
+				return false;
+			}
+		}
+
+		const bool isSigned = minimum < 0;
+		if ( mElements.empty() or not ( isIntegral or isFloating )
+			or ( isSigned and ( uintmax_t( INT64_MAX ) < maximum ) ) )
+		{
+			return false;
+		}
+
+		// RFC 8746 tags: 64 + float (16) + signed (8) + little endian (4) + log2 of the width,
+		// where the width of a float counts from half precision and that of an integer from a byte.
+		size_t width = 8;
+		uint64_t tag = 64 + 4;
+
+		if ( isFloating )
+		{
+			width = isSinglePrecision ? 4 : 8;
+			tag += 16 + ( isSinglePrecision ? 1 : 2 );
+		}
+		else
+		{
+			if ( isSigned )
+			{
+				tag += 8;
+				width = ( ( -128 <= minimum ) and ( maximum <= 127 ) ) ? 1
+					: ( ( ( -32768 <= minimum ) and ( maximum <= 32767 ) ) ? 2
+					: ( ( ( INT32_MIN <= minimum ) and ( maximum <= INT32_MAX ) ) ? 4 : 8 ) );
+			}
+			else
+			{
+				width = ( maximum <= 0xFF ) ? 1 : ( ( maximum <= 0xFFFF ) ? 2 : ( ( maximum <= 0xFFFFFFFF ) ? 4 : 8 ) );
+			}
+
+			if ( 1 == width )
+			{
+				// Single byte elements have no byte order: uint8 is tag 64, sint8 is tag 72.
+				tag = isSigned ? 72 : 64;
+			}
+			else
+			{
+				tag += ( 2 == width ) ? 1 : ( ( 4 == width ) ? 2 : 3 );
+			}
+		}
+
+		std::string bytes( mElements.size() * width, '\0' );
+		char* byte = &bytes[ 0 ];
+		for ( const auto& element : mElements )
+		{
+			uint64_t bits = 0;
+
+			if ( isFloating and ( 4 == width ) )
+			{
+				const float singlePrecision = float( element.mNumericValue.floatValue );
+				uint32_t singleBits;
+				std::memcpy( &singleBits, &singlePrecision, sizeof( singleBits ) );
+				bits = singleBits;
+			}
+			else if ( isFloating )
+			{
+				const double doublePrecision = double( element.mNumericValue.floatValue );
+				std::memcpy( &bits, &doublePrecision, sizeof( bits ) );
+			}
+			else if ( eNumberType::SIGNED_INTEGRAL == element.mNumericType )
+			{
+				bits = uint64_t( element.mNumericValue.signedIntegral );
+			}
+			else
+			{
+				bits = uint64_t( element.mNumericValue.unsignedIntegral );
+			}
+
+			for ( size_t position( 0 ); position < width; ++position )
+			{
+				*byte++ = char( bits >> ( 8 * position ) );
+			}
+		}
+
+		_writeCBORHead( sink, eCBORMajorType::TAG, tag );
+		_writeCBORHead( sink, eCBORMajorType::BYTE_STRING, bytes.length() );
+		sink.append( bytes.data(), bytes.length() );
+		return true;
+	}
+
+	// Write this JsonValue out to the given sink as CBOR.
+	void _writeCBOR( JsonSink& sink, bool typedArrays ) const
+	{
+		switch ( mType )
+		{
+		case Type::object:
+			_writeCBORHead( sink, eCBORMajorType::MAP, mMembers.size() );
+			for ( const auto& member : mMembers )
+			{
+				_writeCBORHead( sink, eCBORMajorType::TEXT_STRING, member.first.length() );
+				sink.append( member.first.data(), member.first.length() );
+				member.second._writeCBOR( sink, typedArrays );
+			}
+			break;
+
+		case Type::array:
+			if ( typedArrays and _writeCBORTypedArray( sink ) )
+			{
+				break;
+			}
+
+			_writeCBORHead( sink, eCBORMajorType::ARRAY, mElements.size() );
+			for ( const auto& element : mElements )
+			{
+				element._writeCBOR( sink, typedArrays );
+			}
+			break;
+
+		case Type::string:
+			_writeCBORHead( sink, eCBORMajorType::TEXT_STRING, mStringValue.length() );
+			sink.append( mStringValue.data(), mStringValue.length() );
+			break;
+
+		case Type::number:
+			switch ( mNumericType )
+			{
+			case eNumberType::SIGNED_INTEGRAL:
+				if ( mNumericValue.signedIntegral < 0 )
+				{
+					// Negative integers encode -1 - n.
+					_writeCBORHead( sink, eCBORMajorType::NEGATIVE_INTEGER, ~uint64_t( mNumericValue.signedIntegral ) );
+				}
+				else
+				{
+					_writeCBORHead( sink, eCBORMajorType::UNSIGNED_INTEGER, uint64_t( mNumericValue.signedIntegral ) );
+				}
+				break;
+
+			case eNumberType::UNSIGNED_INTEGRAL:
+				_writeCBORHead( sink, eCBORMajorType::UNSIGNED_INTEGER, uint64_t( mNumericValue.unsignedIntegral ) );
+				break;
+
+			case eNumberType::FLOATING:
+				_writeCBORFloat( sink, mNumericValue.floatValue );
+				break;
+
+#ifdef INCLUDE_GMP
+			case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
+				_writeCBORBignum( sink, mNumericValue.MPIntegralValue );
+				break;
+
+			case eNumberType::MULTIPLE_PRECISION_FLOAT:
+				_writeCBORDecimalFraction( sink, mNumericValue.MPFloatValue );
+				break;
+#endif
+
+			default:
+				throw std::runtime_error( "Cannot encode an unresolved number as CBOR" );
+			}
+			break;
+
+		case Type::boolean:
+			sink.append( mBoolean ? "\xF5" : "\xF4", 1 );
+			break;
+
+		case Type::null:
+			sink.append( "\xF6", 1 );
+			break;
+
+		case Type::undefined:
+			sink.append( "\xF7", 1 );
+			break;
+		}
+	}
+
+	// Read a single byte of CBOR
+	static uint8_t _readCBORByte( ParseSource& source )
+	{
+		if ( not source.available( 1 ) )
+		{
+			throw ParseError( "fromCBOR", source );
+		}
+
+		const uint8_t byte = uint8_t( source.peek() );
+		source.update();
+		return byte;
+	}
+
+	// Read the argument that follows the initial byte of a data item. Indefinite
+	// lengths, additional information 31, are left for the caller to handle.
+	static uint64_t _readCBORArgument( ParseSource& source, uint8_t additional )
+	{
+		if ( additional < 24 )
+		{
+			return additional;
+		}
+
+		if ( 27 < additional )
+		{
+			throw ParseError( "fromCBOR", source );
+		}
+
+		const size_t argumentLength = size_t( 1 ) << ( additional - 24 );
+		if ( not source.available( argumentLength ) )
+		{
+			throw ParseError( "fromCBOR", source );
+		}
+
+		uint64_t argument = 0;
+		for ( size_t position( 0 ); position < argumentLength; ++position )
+		{
+			argument = ( argument << 8 ) | uint8_t( source.peek( uint32_t( position ) ) );
+		}
+
+		source.update( uint32_t( argumentLength ) );
+		return argument;
+	}
+
+	// Append the payload of a byte or text string to {@param destination}.
+	static void _readCBORString( ParseSource& source, eCBORMajorType majorType, uint8_t additional, std::string& destination )
+	{
+		if ( 31 == additional )
+		{
+			// Indefinite length strings are a series of definite length chunks of the same major type.
+			for ( uint8_t initialByte = _readCBORByte( source ); 0xFF != initialByte; initialByte = _readCBORByte( source ) )
+			{
+				if ( ( majorType != eCBORMajorType( initialByte >> 5 ) ) or ( 31 == ( initialByte & 0x1F ) ) )
+				{
+					throw ParseError( "fromCBOR", source );
+				}
+
+				_readCBORString( source, majorType, initialByte & 0x1F, destination );
+			}
+
+			return;
+		}
+
+		if ( not source.append( destination, size_t( _readCBORArgument( source, additional ) ) ) )
+		{
+			throw ParseError( "fromCBOR", source );
+		}
+	}
+
+	// Read the byte string content of a tag, such as a bignum or a typed array.
+	static void _readCBORTagBytes( ParseSource& source, std::string& bytes )
+	{
+		const uint8_t initialByte = _readCBORByte( source );
+		if ( eCBORMajorType::BYTE_STRING != eCBORMajorType( initialByte >> 5 ) )
+		{
+			throw ParseError( "fromCBOR", source );
+		}
+
+		_readCBORString( source, eCBORMajorType::BYTE_STRING, initialByte & 0x1F, bytes );
+	}
+
+	// Read a map key, which must be a text string or an integer.
+	static void _readCBORKey( ParseSource& source, std::string& key )
+	{
+		const uint8_t initialByte = _readCBORByte( source );
+		const eCBORMajorType majorType = eCBORMajorType( initialByte >> 5 );
+
+		if ( eCBORMajorType::TEXT_STRING == majorType )
+		{
+			_readCBORString( source, majorType, initialByte & 0x1F, key );
+		}
+		else if ( eCBORMajorType::UNSIGNED_INTEGER == majorType )
+		{
+			key = std::to_string( _readCBORArgument( source, initialByte & 0x1F ) );
+		}
+		else if ( eCBORMajorType::NEGATIVE_INTEGER == majorType )
+		{
+			const uint64_t argument = _readCBORArgument( source, initialByte & 0x1F );
+			if ( uint64_t( INTMAX_MAX ) < argument )
+			{
+				throw ParseError( "fromCBOR", source );
+			}
+
+			key = std::to_string( -1 - intmax_t( argument ) );
+		}
+		else
+		{
+			throw ParseError( "fromCBOR", source );
+		}
+	}
+
+	// Convert the half precision float {@param bits} to a long double
+	static long double _halfToLongDouble( uint16_t bits ) noexcept
+	{
+		const int exponent = ( bits >> 10 ) & 0x1F;
+		const int mantissa = bits & 0x3FF;
+		long double value;
+
+		if ( 0 == exponent )
+		{
+			value = std::ldexp( static_cast< long double >( mantissa ), -24 );
+		}
+		else if ( 31 == exponent )
+		{
+			value = ( 0 == mantissa ) ? HUGE_VALL : NAN;
+		}
+		else
+		{
+			value = std::ldexp( static_cast< long double >( mantissa + 1024 ), exponent - 25 );
+		}
+
+		return ( bits & 0x8000 ) ? -value : value;
+	}
+
+	// Convert the quadruple precision float held in {@param high} and {@param low}
+	// to a long double, rounding the mantissa if long double is narrower.
+	static long double _quadToLongDouble( uint64_t high, uint64_t low ) noexcept
+	{
+		const int exponent = int( ( high >> 48 ) & 0x7FFF );
+		const uint64_t mantissaHigh = high & 0xFFFFFFFFFFFFULL;
+		long double value;
+
+		if ( 0x7FFF == exponent )
+		{
+			value = ( ( 0 == mantissaHigh ) and ( 0 == low ) ) ? HUGE_VALL : NAN;
+		}
+		else
+		{
+			// Subnormals have no implicit leading bit, and the exponent of the smallest normal.
+			const uint64_t leading = ( 0 == exponent ) ? 0 : ( uint64_t( 1 ) << 48 );
+			const int unbiasedExponent = ( ( 0 == exponent ) ? 1 : exponent ) - 16383;
+			value = std::ldexp( static_cast< long double >( leading | mantissaHigh ), unbiasedExponent - 48 )
+				+ std::ldexp( static_cast< long double >( low ), unbiasedExponent - 112 );
+		}
+
+		return ( high >> 63 ) ? -value : value;
+	}
+
+	// Read the elements of an RFC 8746 typed array, tags 64 through 87.
+	void _readCBORTypedArray( ParseSource& source, uint64_t tag )
+	{
+		const bool isFloating = 0 != ( tag & 0x10 );
+		const bool isSigned = ( not isFloating ) and ( 0 != ( tag & 0x08 ) );
+		const bool isLittleEndian = 0 != ( tag & 0x04 );
+		const size_t width = ( isFloating ? 2 : 1 ) << ( tag & 0x03 );
+
+		std::string bytes;
+		_readCBORTagBytes( source, bytes );
+
+		// Tag 76, a little endian sint8, is reserved.
+		if ( ( 76 == tag ) or ( 0 != ( bytes.length() % width ) ) )
+		{
+			throw ParseError( "fromCBOR", source );
+		}
+
+		mType = Type::array;
+		mElements.resize( bytes.length() / width );
+
+		for ( size_t position( 0 ); position < mElements.size(); ++position )
+		{
+			const uint8_t* element = reinterpret_cast< const uint8_t* >( bytes.data() ) + ( position * width );
+			uint64_t bits[ 2 ] = { 0, 0 };
+
+			// Gather the bytes most significant first; quadruple precision spans both words.
+			for ( size_t byte( 0 ); byte < width; ++byte )
+			{
+				const uint8_t value = element[ isLittleEndian ? ( width - 1 - byte ) : byte ];
+				uint64_t& word = bits[ ( 16 == width ) and ( 8 <= byte ) ? 1 : 0 ];
+				word = ( word << 8 ) | value;
+			}
+
+			JsonValue& number = mElements[ position ];
+			number.mType = Type::number;
+
+			if ( isFloating )
+			{
+				number.mNumericType = eNumberType::FLOATING;
+
+				if ( 2 == width )
+				{
+					number.mNumericValue.floatValue = _halfToLongDouble( uint16_t( bits[ 0 ] ) );
+				}
+				else if ( 4 == width )
+				{
+					const uint32_t singleBits = uint32_t( bits[ 0 ] );
+					float singlePrecision;
+					std::memcpy( &singlePrecision, &singleBits, sizeof( singlePrecision ) );
+					number.mNumericValue.floatValue = singlePrecision;
+				}
+				else if ( 8 == width )
+				{
+					double doublePrecision;
+					std::memcpy( &doublePrecision, &bits[ 0 ], sizeof( doublePrecision ) );
+					number.mNumericValue.floatValue = doublePrecision;
+				}
+				else
+				{
+					number.mNumericValue.floatValue = _quadToLongDouble( bits[ 0 ], bits[ 1 ] );
+				}
+			}
+			else if ( isSigned )
+			{
+				// Sign extend from the element width.
+				const unsigned shift = unsigned( 64 - ( 8 * width ) );
+				number.mNumericType = eNumberType::SIGNED_INTEGRAL;
+				number.mNumericValue.signedIntegral = intmax_t( int64_t( bits[ 0 ] << shift ) >> shift );
+			}
+			else
+			{
+				number.mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+				number.mNumericValue.unsignedIntegral = uintmax_t( bits[ 0 ] );
+			}
+		}
+	}
+
+	// Read a bignum, tag 2 or 3, into this instance.
+	void _readCBORBignum( ParseSource& source, bool isNegative )
+	{
+		std::string bytes;
+		_readCBORTagBytes( source, bytes );
+		mType = Type::number;
+
+#ifdef INCLUDE_GMP
+		mNumericType = eNumberType::MULTIPLE_PRECISION_INTEGRAL;
+		mpz_init( mNumericValue.MPIntegralValue );
+		mpz_import( mNumericValue.MPIntegralValue, bytes.length(), 1, 1, 1, 0, bytes.data() );
+
+		if ( isNegative )
+		{
+			mpz_com( mNumericValue.MPIntegralValue, mNumericValue.MPIntegralValue );
+		}
+#else
+		// Without GMP, bignums that fit are narrowed to the native integrals.
+		const size_t significant = bytes.find_first_not_of( '\0' );
+		uint64_t magnitude = 0;
+
+		if ( ( std::string::npos == significant ) or ( ( bytes.length() - significant ) <= 8 ) )
+		{
+			for ( size_t position( ( std::string::npos == significant ) ? bytes.length() : significant ); position < bytes.length(); ++position )
+			{
+				magnitude = ( magnitude << 8 ) | uint8_t( bytes[ position ] );
+			}
+
+			if ( not isNegative )
+			{
+				mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+				mNumericValue.unsignedIntegral = magnitude;
+				return;
+			}
+
+			if ( magnitude <= uint64_t( INTMAX_MAX ) )
+			{
+				mNumericType = eNumberType::SIGNED_INTEGRAL;
+				mNumericValue.signedIntegral = -1 - intmax_t( magnitude );
+				return;
+			}
+		}
+
+		long double value = 0.0L;
+		for ( char byte : bytes )
+		{
+			value = ( value * 256.0L ) + uint8_t( byte );
+		}
+
+		mNumericType = eNumberType::FLOATING;
+		mNumericValue.floatValue = isNegative ? ( -1.0L - value ) : value;
+#endif
+	}
+
+	// Read a decimal fraction, tag 4, or a bigfloat, tag 5, into this instance.
+	void _readCBORFraction( ParseSource& source, bool isDecimal, size_t depth )
+	{
+		JsonValue fraction;
+		fraction._readCBOR( source, depth + 1 );
+
+		if ( ( Type::array != fraction.mType ) or ( 2 != fraction.mElements.size() )
+			or ( Type::number != fraction.mElements[ 0 ].mType ) or ( Type::number != fraction.mElements[ 1 ].mType )
+			or ( eNumberType::FLOATING == fraction.mElements[ 0 ].mNumericType )
+			or ( eNumberType::FLOATING == fraction.mElements[ 1 ].mNumericType ) )
+		{
+			throw ParseError( "fromCBOR", source );
+		}
+
+		const JsonValue& exponentValue = fraction.mElements[ 0 ];
+		const JsonValue& mantissa = fraction.mElements[ 1 ];
+		const long double exponent = exponentValue._toLongDouble();
+		mType = Type::number;
+
+#ifdef INCLUDE_GMP
+		mpz_t integralMantissa;
+		mpz_init( integralMantissa );
+
+		switch ( mantissa.mNumericType )
+		{
+		case eNumberType::SIGNED_INTEGRAL:
+			mpz_set_str( integralMantissa, std::to_string( mantissa.mNumericValue.signedIntegral ).c_str(), 10 );
+			break;
+
+		case eNumberType::UNSIGNED_INTEGRAL:
+			mpz_set_str( integralMantissa, std::to_string( mantissa.mNumericValue.unsignedIntegral ).c_str(), 10 );
+			break;
+
+		default:
+			mpz_set( integralMantissa, mantissa.mNumericValue.MPIntegralValue );
+			break;
+		}
+
+		mNumericType = eNumberType::MULTIPLE_PRECISION_FLOAT;
+		mpf_init( mNumericValue.MPFloatValue );
+
+		if ( isDecimal )
+		{
+			char* digits = mpz_get_str( nullptr, 10, integralMantissa );
+			std::string decimal = std::string( digits ) + "e" + std::to_string( intmax_t( exponent ) );
+			mpf_set_str( mNumericValue.MPFloatValue, decimal.c_str(), 10 );
+
+			void ( *freeFunction )( void*, size_t );
+			mp_get_memory_functions( nullptr, nullptr, &freeFunction );
+			freeFunction( digits, strlen( digits ) + 1 );
+		}
+		else
+		{
+			mpf_set_z( mNumericValue.MPFloatValue, integralMantissa );
+			if ( exponent < 0 )
+			{
+				mpf_div_2exp( mNumericValue.MPFloatValue, mNumericValue.MPFloatValue, mp_bitcnt_t( -exponent ) );
+			}
+			else
+			{
+				mpf_mul_2exp( mNumericValue.MPFloatValue, mNumericValue.MPFloatValue, mp_bitcnt_t( exponent ) );
+			}
+		}
+
+		mpz_clear( integralMantissa );
+#else
+		mNumericType = eNumberType::FLOATING;
+		mNumericValue.floatValue = isDecimal
+			? ( mantissa._toLongDouble() * std::pow( 10.0L, exponent ) )
+			: std::ldexp( mantissa._toLongDouble(), int( exponent ) );
+#endif
+	}
+
+	// Encode raw bytes as base64. The URL safe alphabet is unpadded, as is the
+	// conversion of byte strings to JSON recommended by RFC 8949.
+	static void _base64Encode( const std::string& bytes, std::string& text, bool isUrlSafe )
+	{
+		const char* const ALPHABET = isUrlSafe
+			? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+			: "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+		text.clear();
+		text.reserve( ( ( bytes.length() + 2 ) / 3 ) * 4 );
+
+		for ( size_t position( 0 ); position < bytes.length(); position += 3 )
+		{
+			const size_t remaining = std::min< size_t >( 3, bytes.length() - position );
+			uint32_t group = uint32_t( uint8_t( bytes[ position ] ) ) << 16;
+			group |= ( 1 < remaining ) ? ( uint32_t( uint8_t( bytes[ position + 1 ] ) ) << 8 ) : 0;
+			group |= ( 2 < remaining ) ? uint32_t( uint8_t( bytes[ position + 2 ] ) ) : 0;
+
+			for ( size_t sextet( 0 ); sextet <= remaining; ++sextet )
+			{
+				text.push_back( ALPHABET[ ( group >> ( 18 - ( 6 * sextet ) ) ) & 0x3F ] );
+			}
+
+			if ( not isUrlSafe )
+			{
+				text.append( 3 - remaining, '=' );
+			}
+		}
+	}
+
+	// Decode base64 in either alphabet, with or without padding.
+	// Returns false if {@param text} is not valid base64.
+	static bool _base64Decode( const std::string& text, std::string& bytes )
+	{
+		uint32_t group = 0;
+		size_t sextets = 0;
+
+		bytes.clear();
+		bytes.reserve( ( text.length() / 4 ) * 3 + 2 );
+
+		for ( size_t position( 0 ); position < text.length(); ++position )
+		{
+			const char character = text[ position ];
+			uint32_t sextet;
+
+			if ( ( 'A' <= character ) and ( character <= 'Z' ) )
+			{
+				sextet = uint32_t( character - 'A' );
+			}
+			else if ( ( 'a' <= character ) and ( character <= 'z' ) )
+			{
+				sextet = uint32_t( character - 'a' ) + 26;
+			}
+			else if ( ( '0' <= character ) and ( character <= '9' ) )
+			{
+				sextet = uint32_t( character - '0' ) + 52;
+			}
+			else if ( ( '+' == character ) or ( '-' == character ) )
+			{
+				sextet = 62;
+			}
+			else if ( ( '/' == character ) or ( '_' == character ) )
+			{
+				sextet = 63;
+			}
+			else if ( '=' == character )
+			{
+				// Padding may only complete the final group.
+				if ( ( sextets < 2 ) or ( 0 != ( text.length() % 4 ) )
+					or ( std::string::npos != text.find_first_not_of( '=', position ) ) )
+				{
+					return false;
+				}
+
+				break;
+			}
+			else
+			{
+				return false;
+			}
+
+			group = ( group << 6 ) | sextet;
+			if ( 4 == ++sextets )
+			{
+				bytes.push_back( char( group >> 16 ) );
+				bytes.push_back( char( group >> 8 ) );
+				bytes.push_back( char( group ) );
+				group = 0;
+				sextets = 0;
+			}
+		}
+
+		// A trailing group of 2 or 3 sextets holds 1 or 2 bytes.
+		if ( 1 == sextets )
+		{
+			return false;
+		}
+
+		if ( 1 < sextets )
+		{
+			group <<= 6 * ( 4 - sextets );
+			bytes.push_back( char( group >> 16 ) );
+			if ( 3 == sextets )
+			{
+				bytes.push_back( char( group >> 8 ) );
+			}
+		}
+
+		return true;
+	}
+
+	// Read a single CBOR data item from the source into this instance.
+	void _readCBOR( ParseSource& source, size_t depth )
+	{
+		if ( DECODER_NESTING_DEPTH < depth )
+		{
+			throw ParseError( "fromCBOR", source );
+		}
+
+		const uint8_t initialByte = _readCBORByte( source );
+		const eCBORMajorType majorType = eCBORMajorType( initialByte >> 5 );
+		const uint8_t additional = initialByte & 0x1F;
+		const bool isIndefinite = 31 == additional;
+
+		// Only strings, arrays and maps may have an indefinite length.
+		if ( isIndefinite and ( eCBORMajorType::BYTE_STRING != majorType ) and ( eCBORMajorType::TEXT_STRING != majorType )
+			and ( eCBORMajorType::ARRAY != majorType ) and ( eCBORMajorType::MAP != majorType ) )
+		{
+			throw ParseError( "fromCBOR", source );
+		}
+
+		switch ( majorType )
+		{
+		case eCBORMajorType::UNSIGNED_INTEGER:
+			mType = Type::number;
+			mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+			mNumericValue.unsignedIntegral = _readCBORArgument( source, additional );
+			break;
+
+		case eCBORMajorType::NEGATIVE_INTEGER:
+		{
+			const uint64_t argument = _readCBORArgument( source, additional );
+			mType = Type::number;
+
+			if ( argument <= uint64_t( INTMAX_MAX ) )
+			{
+				mNumericType = eNumberType::SIGNED_INTEGRAL;
+				mNumericValue.signedIntegral = -1 - intmax_t( argument );
+			}
+			else
+			{
+#ifdef INCLUDE_GMP
+				mNumericType = eNumberType::MULTIPLE_PRECISION_INTEGRAL;
+				mpz_init( mNumericValue.MPIntegralValue );
+				mpz_set_str( mNumericValue.MPIntegralValue, std::to_string( argument ).c_str(), 10 );
+				mpz_com( mNumericValue.MPIntegralValue, mNumericValue.MPIntegralValue );
+#else
+				mNumericType = eNumberType::FLOATING;
+				mNumericValue.floatValue = -1.0L - static_cast< long double >( argument );
+#endif
+			}
+			break;
+		}
+
+		case eCBORMajorType::BYTE_STRING:
+		{
+			std::string bytes;
+			_readCBORString( source, majorType, additional, bytes );
+			mType = Type::string;
+			_base64Encode( bytes, mStringValue, true );
+			break;
+		}
+
+		case eCBORMajorType::TEXT_STRING:
+			mType = Type::string;
+			_readCBORString( source, majorType, additional, mStringValue );
+			break;
+
+		case eCBORMajorType::ARRAY:
+			mType = Type::array;
+
+			if ( isIndefinite )
+			{
+				while ( 0xFF != uint8_t( source.peek() ) )
+				{
+					mElements.emplace_back();
+					mElements.back()._readCBOR( source, depth + 1 );
+				}
+
+				source.update();
+			}
+			else
+			{
+				// Grow as elements arrive, so a corrupt count cannot force a huge allocation.
+				const uint64_t count = _readCBORArgument( source, additional );
+				mElements.reserve( size_t( std::min< uint64_t >( count, 4096 ) ) );
+
+				for ( uint64_t position( 0 ); position < count; ++position )
+				{
+					mElements.emplace_back();
+					mElements.back()._readCBOR( source, depth + 1 );
+				}
+			}
+			break;
+
+		case eCBORMajorType::MAP:
+		{
+			mType = Type::object;
+			const uint64_t count = isIndefinite ? 0 : _readCBORArgument( source, additional );
+			std::string key;
+
+			for ( uint64_t position( 0 ); isIndefinite ? ( 0xFF != uint8_t( source.peek() ) ) : ( position < count ); ++position )
+			{
+				key.clear();
+				_readCBORKey( source, key );
+
+				// Like the text parser, the last of any duplicate keys wins.
+				JsonValue& member = mMembers[ key ];
+				member.clear();
+				member._readCBOR( source, depth + 1 );
+			}
+
+			if ( isIndefinite )
+			{
+				source.update();
+			}
+			break;
+		}
+
+		case eCBORMajorType::TAG:
+		{
+			const uint64_t tag = _readCBORArgument( source, additional );
+
+			if ( ( 2 == tag ) or ( 3 == tag ) )
+			{
+				_readCBORBignum( source, 3 == tag );
+			}
+			else if ( ( 4 == tag ) or ( 5 == tag ) )
+			{
+				_readCBORFraction( source, 4 == tag, depth );
+			}
+			else if ( ( 64 <= tag ) and ( tag <= 87 ) )
+			{
+				_readCBORTypedArray( source, tag );
+			}
+			else
+			{
+				// Other tags only add semantics to the enclosed item, which is read as is.
+				_readCBOR( source, depth + 1 );
+			}
+			break;
+		}
+
+		case eCBORMajorType::SIMPLE:
+			switch ( additional )
+			{
+			case 20:
+			case 21:
+				mType = Type::boolean;
+				mBoolean = 21 == additional;
+				break;
+
+			case 22:
+				mType = Type::null;
+				break;
+
+			case 23:
+				mType = Type::undefined;
+				break;
+
+			case 25:
+				mType = Type::number;
+				mNumericType = eNumberType::FLOATING;
+				mNumericValue.floatValue = _halfToLongDouble( uint16_t( _readCBORArgument( source, additional ) ) );
+				break;
+
+			case 26:
+			{
+				const uint32_t bits = uint32_t( _readCBORArgument( source, additional ) );
+				float singlePrecision;
+				std::memcpy( &singlePrecision, &bits, sizeof( singlePrecision ) );
+				mType = Type::number;
+				mNumericType = eNumberType::FLOATING;
+				mNumericValue.floatValue = singlePrecision;
+				break;
+			}
+
+			case 27:
+			{
+				const uint64_t bits = _readCBORArgument( source, additional );
+				double doublePrecision;
+				std::memcpy( &doublePrecision, &bits, sizeof( doublePrecision ) );
+				mType = Type::number;
+				mNumericType = eNumberType::FLOATING;
+				mNumericValue.floatValue = doublePrecision;
+				break;
+			}
+
+			default:
+				throw ParseError( "fromCBOR", source );
+			}
+			break;
+		}
 	}
 
-	/**
-	 * Array move initialization constructor.
-	 * @param array R-Value to an ArrayType to initialize the JsonValue to.
-	 */
-	JsonValue( ArrayType&& array )
+	// Write a MessagePack marker followed by the {@param width} low bytes of {@param value}, big endian.
+	static void _writeMessagePackMarker( JsonSink& sink, eMessagePackMarker marker, uint64_t value, size_t width )
 	{
-		_initPrimitiveVariables( Type::array );
-		mElements = std::move( array );
+		char buffer[ 9 ];
+		buffer[ 0 ] = char( marker );
+
+		for ( size_t position( 0 ); position < width; ++position )
+		{
+			buffer[ 1 + position ] = char( value >> ( 8 * ( width - 1 - position ) ) );
+		}
+
+		sink.append( buffer, 1 + width );
 	}
 
-	/**
-	 * String copy initialization constructor.
-	 * @param string Const reference to a string to initialize the JsonValue to.
-	 */
-	JsonValue( const std::string& string )
+	// Write the marker and length of a string, array or map, selecting the narrowest
+	// form: the fixed form if {@param length} fits under {@param fixedLimit}, then 8, 16
+	// and 32 bit lengths. {@param marker8} is null where the type has no 8 bit form.
+	static void _writeMessagePackLength( JsonSink& sink, uint8_t fixedMarker, size_t fixedLimit, const eMessagePackMarker* marker8,
+		eMessagePackMarker marker16, eMessagePackMarker marker32, size_t length )
 	{
-		_initPrimitiveVariables( Type::string );
-		mStringValue = string;
+		if ( length < fixedLimit )
+		{
+			const char marker = char( fixedMarker | uint8_t( length ) );
+			sink.append( &marker, 1 );
+		}
+		else if ( ( nullptr != marker8 ) and ( length <= 0xFF ) )
+		{
+			_writeMessagePackMarker( sink, *marker8, length, 1 );
+		}
+		else if ( length <= 0xFFFF )
+		{
+			_writeMessagePackMarker( sink, marker16, length, 2 );
+		}
+		else if ( length <= 0xFFFFFFFF )
+		{
+			_writeMessagePackMarker( sink, marker32, length, 4 );
+		}
+		else
+		{
+			throw std::length_error( "Length exceeds the MessagePack limit of 2^32 - 1" );
+		}
 	}
 
-	/**
-	 * String move initialization constructor.
-	 * @param string R-Value to a string to initialize the JsonValue to.
-	 */
-	JsonValue( std::string&& string )
+	// Write an integer in the narrowest MessagePack form that holds it exactly.
+	static void _writeMessagePackInteger( JsonSink& sink, bool isNegative, uint64_t bits )
 	{
-		_initPrimitiveVariables( Type::string );
-		mStringValue = std::move( string );
+		const int64_t value = int64_t( bits );
+
+		if ( not isNegative )
+		{
+			if ( bits <= 0x7F )
+			{
+				const char fixedInteger = char( bits );
+				sink.append( &fixedInteger, 1 );
+			}
+			else if ( bits <= 0xFF )
+			{
+				_writeMessagePackMarker( sink, eMessagePackMarker::UINT8, bits, 1 );
+			}
+			else if ( bits <= 0xFFFF )
+			{
+				_writeMessagePackMarker( sink, eMessagePackMarker::UINT16, bits, 2 );
+			}
+			else if ( bits <= 0xFFFFFFFF )
+			{
+				_writeMessagePackMarker( sink, eMessagePackMarker::UINT32, bits, 4 );
+			}
+			else
+			{
+				_writeMessagePackMarker( sink, eMessagePackMarker::UINT64, bits, 8 );
+			}
+		}
+		else if ( -32 <= value )
+		{
+			const char fixedInteger = char( value );
+			sink.append( &fixedInteger, 1 );
+		}
+		else if ( INT8_MIN <= value )
+		{
+			_writeMessagePackMarker( sink, eMessagePackMarker::INT8, bits, 1 );
+		}
+		else if ( INT16_MIN <= value )
+		{
+			_writeMessagePackMarker( sink, eMessagePackMarker::INT16, bits, 2 );
+		}
+		else if ( INT32_MIN <= value )
+		{
+			_writeMessagePackMarker( sink, eMessagePackMarker::INT32, bits, 4 );
+		}
+		else
+		{
+			_writeMessagePackMarker( sink, eMessagePackMarker::INT64, bits, 8 );
+		}
 	}
 
-	/**
-	 * Boolean initialization constructor.
-	 * @param boolean Boolean value to initialize the JsonValue to.
-	 */
-	JsonValue( bool boolean )
+	// Write a floating number as a float 32 if that is exact, else as a float 64.
+	static void _writeMessagePackFloat( JsonSink& sink, long double value )
 	{
-		_initPrimitiveVariables( Type::boolean );
-		mBoolean = boolean;
+		const float singlePrecision = float( value );
+		if ( ( value == static_cast< long double >( singlePrecision ) ) or std::isnan( value ) )
+		{
+			uint32_t bits;
+			std::memcpy( &bits, &singlePrecision, sizeof( bits ) );
+			_writeMessagePackMarker( sink, eMessagePackMarker::FLOAT32, bits, 4 );
+			return;
+		}
+
+		const double doublePrecision = double( value );
+		uint64_t bits;
+		std::memcpy( &bits, &doublePrecision, sizeof( bits ) );
+		_writeMessagePackMarker( sink, eMessagePackMarker::FLOAT64, bits, 8 );
 	}
 
-	/**
-	 * Arithmetic number initialization constructor.
-	 * @param arithmeticValue An arithmetic number to initialize the JsonValue with.
-	 */
-	template < typename ArithmeticType,
-		typename = typename std::enable_if< std::is_arthmetic< ArithmeticType >::value >::type >
-	JsonValue( ArithmeticType arithmeticValue )
+	// Write this JsonValue out to the given sink as MessagePack.
+	void _writeMessagePack( JsonSink& sink ) const
 	{
-		_initPrimitiveVariables( Type::number );
+		const eMessagePackMarker STRING8 = eMessagePackMarker::STRING8;
 
-		if ( std::is_floating_point< ArithmeticType >::value )
+		switch ( mType )
 		{
-			mNumericType = eNumberType::FLOATING;
-			mNumericValue.floatValue = arithmeticValue;
+		case Type::object:
+			_writeMessagePackLength( sink, 0x80, 16, nullptr, eMessagePackMarker::MAP16, eMessagePackMarker::MAP32, mMembers.size() );
+			for ( const auto& member : mMembers )
+			{
+				_writeMessagePackLength( sink, 0xA0, 32, &STRING8, eMessagePackMarker::STRING16, eMessagePackMarker::STRING32, member.first.length() );
+				sink.append( member.first.data(), member.first.length() );
+				member.second._writeMessagePack( sink );
+			}
+			break;
+
+		case Type::array:
+			_writeMessagePackLength( sink, 0x90, 16, nullptr, eMessagePackMarker::ARRAY16, eMessagePackMarker::ARRAY32, mElements.size() );
+			for ( const auto& element : mElements )
+			{
+				element._writeMessagePack( sink );
+			}
+			break;
+
+		case Type::string:
+			_writeMessagePackLength( sink, 0xA0, 32, &STRING8, eMessagePackMarker::STRING16, eMessagePackMarker::STRING32, mStringValue.length() );
+			sink.append( mStringValue.data(), mStringValue.length() );
+			break;
+
+		case Type::number:
+			switch ( mNumericType )
+			{
+			case eNumberType::SIGNED_INTEGRAL:
+				_writeMessagePackInteger( sink, mNumericValue.signedIntegral < 0, uint64_t( mNumericValue.signedIntegral ) );
+				break;
+
+			case eNumberType::UNSIGNED_INTEGRAL:
+				_writeMessagePackInteger( sink, false, uint64_t( mNumericValue.unsignedIntegral ) );
+				break;
+
+			case eNumberType::FLOATING:
+				_writeMessagePackFloat( sink, mNumericValue.floatValue );
+				break;
+
+#ifdef INCLUDE_GMP
+			case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
+				if ( mpz_fits_slong_p( mNumericValue.MPIntegralValue ) )
+				{
+					const long value = mpz_get_si( mNumericValue.MPIntegralValue );
+					_writeMessagePackInteger( sink, value < 0, uint64_t( value ) );
+					break;
+				}
+
+				throw std::runtime_error( "Cannot encode a multiple precision integral beyond 64 bits as MessagePack" );
+
+			case eNumberType::MULTIPLE_PRECISION_FLOAT:
+				_writeMessagePackFloat( sink, mpf_get_d( mNumericValue.MPFloatValue ) );
+				break;
+#endif
+
+			default:
+				throw std::runtime_error( "Cannot encode an unresolved number as MessagePack" );
+			}
+			break;
+
+		case Type::boolean:
+			_writeMessagePackMarker( sink, mBoolean ? eMessagePackMarker::TRUE_VALUE : eMessagePackMarker::FALSE_VALUE, 0, 0 );
+			break;
+
+		case Type::null:
+		case Type::undefined:
+			_writeMessagePackMarker( sink, eMessagePackMarker::NIL, 0, 0 );
+			break;
 		}
-		else if ( std::is_unsigned< ArithmeticType >::value )
+	}
+
+	// Read a {@param width} byte big endian unsigned integer
+	static uint64_t _readMessagePackInteger( ParseSource& source, size_t width )
+	{
+		if ( not source.available( width ) )
 		{
-			mNumericType = eNumberType::UNSIGNED_INTEGRAL;
-			mNumericValue.unsignedIntegral = arithmeticValue;
+			throw ParseError( "fromMessagePack", source );
 		}
-		else
+
+		uint64_t value = 0;
+		for ( size_t position( 0 ); position < width; ++position )
 		{
-			mNumericType = eNumberType::SIGNED_INTEGRAL;
-			mNumericValue.signedIntegral = arithmeticValue;
+			value = ( value << 8 ) | uint8_t( source.peek( uint32_t( position ) ) );
 		}
+
+		source.update( uint32_t( width ) );
+		return value;
 	}
 
-#ifdef INCLUDE_GMP
-	/**
-	 * Multiple precision integral copy initialization constructor.
-	 * @param array Const reference to an ArrayType to initialize the JsonValue to.
-	 */
-	JsonValue( mpz_t multiplePrecisionIntegral )
+	// Read the length that follows a str, bin or ext marker,
+	// given the marker for the 8 bit length form of its family.
+	static size_t _readMessagePackLength( ParseSource& source, uint8_t marker, eMessagePackMarker marker8 )
 	{
-		_initPrimitiveVariables( Type::number );
-		mNumericType = eNumberType::MULTIPLE_PRECISION_INTEGRAL;
-		mpz_init_set( mNumericValue.MPIntegralValue, multiplePrecisionIntegral );
+		return size_t( _readMessagePackInteger( source, size_t( 1 ) << ( marker - uint8_t( marker8 ) ) ) );
 	}
 
-	/**
-	 * Multiple precision floating copy initialization constructor.
-	 * @param array Const reference to an ArrayType to initialize the JsonValue to.
-	 */
-	JsonValue( mpf_t multiplePrecisionFloat )
+	// Read the payload of a string of {@param length} bytes onto {@param destination}.
+	static void _readMessagePackString( ParseSource& source, size_t length, std::string& destination )
 	{
-		_initPrimitiveVariables( Type::number );
-		mNumericType = eNumberType::MULTIPLE_PRECISION_FLOAT;
-		mpf_init_set( mNumericValue.MPFloatValue, multiplePrecisionFloat );
+		if ( not source.append( destination, length ) )
+		{
+			throw ParseError( "fromMessagePack", source );
+		}
 	}
-#endif
 
-	/**
-	 * Null initialization constructor.
-	 */
-	JsonValue( std::nullptr_t )
+	// Read a map key, which must be a string or an integer.
+	static void _readMessagePackKey( ParseSource& source, std::string& key, size_t depth )
 	{
-		_initPrimitiveVariables( Type::null );
+		JsonValue keyValue;
+		keyValue._readMessagePack( source, depth );
+
+		if ( Type::string == keyValue.mType )
+		{
+			key.swap( keyValue.mStringValue );
+		}
+		else if ( ( Type::number == keyValue.mType ) and ( eNumberType::SIGNED_INTEGRAL == keyValue.mNumericType ) )
+		{
+			key = std::to_string( keyValue.mNumericValue.signedIntegral );
+		}
+		else if ( ( Type::number == keyValue.mType ) and ( eNumberType::UNSIGNED_INTEGRAL == keyValue.mNumericType ) )
+		{
+			key = std::to_string( keyValue.mNumericValue.unsignedIntegral );
+		}
+		else
+		{
+			throw ParseError( "fromMessagePack", source );
+		}
 	}
 
-	/**
-	 * Destructor.
-	 */
-	~JsonValue()
+	// Read the elements of an array of {@param count} elements into this instance.
+	void _readMessagePackArray( ParseSource& source, size_t count, size_t depth )
 	{
-		this->clear();
+		mType = Type::array;
+
+		// Grow as elements arrive, so a corrupt count cannot force a huge allocation.
+		mElements.reserve( std::min< size_t >( count, 4096 ) );
+		for ( size_t position( 0 ); position < count; ++position )
+		{
+			mElements.emplace_back();
+			mElements.back()._readMessagePack( source, depth + 1 );
+		}
 	}
 
-	/**
-	 * Return an iterator to the beginning of either an object or array JsonValue instance.
-	 * @return The iterator to the beginning of either an object or array JsonValue instance.
-	 * @throw std::runtime_error is thrown if the JsonValue type is non-iterable.
-	 */
-	iterator begin()
+	// Read the members of a map of {@param count} members into this instance.
+	void _readMessagePackMap( ParseSource& source, size_t count, size_t depth )
 	{
-		if ( JsonValue::Type::object == mType )
+		mType = Type::object;
+		std::string key;
+
+		for ( size_t position( 0 ); position < count; ++position )
+		{
+			key.clear();
+			_readMessagePackKey( source, key, depth + 1 );
+
+			// Like the text parser, the last of any duplicate keys wins.
+			JsonValue& member = mMembers[ key ];
+			member.clear();
+			member._readMessagePack( source, depth + 1 );
+		}
+	}
+
+	// Read an extension of {@param length} bytes. Only the timestamp extension, type -1,
+	// is defined by the specification, and it is read as a number of seconds.
+	void _readMessagePackExtension( ParseSource& source, size_t length )
+	{
+		const int8_t extensionType = int8_t( _readMessagePackInteger( source, 1 ) );
+
+		if ( -1 != extensionType )
+		{
+			throw ParseError( "fromMessagePack", source );
+		}
+
+		mType = Type::number;
+
+		if ( 4 == length )
+		{
+			mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+			mNumericValue.unsignedIntegral = _readMessagePackInteger( source, 4 );
+		}
+		else if ( 8 == length )
+		{
+			// 30 bits of nanoseconds, then 34 bits of seconds
+			const uint64_t bits = _readMessagePackInteger( source, 8 );
+			mNumericType = eNumberType::FLOATING;
+			mNumericValue.floatValue = static_cast< long double >( bits & 0x3FFFFFFFFULL )
+				+ ( static_cast< long double >( bits >> 34 ) / 1e9L );
+		}
+		else if ( 12 == length )
+		{
+			// 32 bits of nanoseconds, then 64 bits of signed seconds
+			const uint64_t nanoseconds = _readMessagePackInteger( source, 4 );
+			const int64_t seconds = int64_t( _readMessagePackInteger( source, 8 ) );
+			mNumericType = eNumberType::FLOATING;
+			mNumericValue.floatValue = static_cast< long double >( seconds ) + ( static_cast< long double >( nanoseconds ) / 1e9L );
+		}
+		else
+		{
+			throw ParseError( "fromMessagePack", source );
+		}
+	}
+
+	// Read a single MessagePack object from the source into this instance.
+	void _readMessagePack( ParseSource& source, size_t depth )
+	{
+		if ( ( DECODER_NESTING_DEPTH < depth ) or not source.available( 1 ) )
+		{
+			throw ParseError( "fromMessagePack", source );
+		}
+
+		const uint8_t marker = uint8_t( source.peek() );
+		source.update();
+
+		// Fixed forms hold their value or length in the marker itself.
+		if ( marker <= 0x7F )
+		{
+			mType = Type::number;
+			mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+			mNumericValue.unsignedIntegral = marker;
+			return;
+		}
+
+		if ( 0xE0 <= marker )
+		{
+			mType = Type::number;
+			mNumericType = eNumberType::SIGNED_INTEGRAL;
+			mNumericValue.signedIntegral = int8_t( marker );
+			return;
+		}
+
+		if ( marker <= 0x8F )
+		{
+			_readMessagePackMap( source, marker & 0x0F, depth );
+			return;
+		}
+
+		if ( marker <= 0x9F )
 		{
-			return iterator( mMembers.begin() );
+			_readMessagePackArray( source, marker & 0x0F, depth );
+			return;
 		}
 
-		if ( JsonValue::Type::array == mType )
+		if ( marker <= 0xBF )
 		{
-			return iterator( mElements.begin() );
+			mType = Type::string;
+			_readMessagePackString( source, marker & 0x1F, mStringValue );
+			return;
 		}
 
-		throw std::runtime_error( "Cannot create iterator for non-iterable type: " + _getTypeString() );
-	}
+		switch ( eMessagePackMarker( marker ) )
+		{
+		case eMessagePackMarker::NIL:
+			mType = Type::null;
+			break;
 
-	/**
-	 * Return a const_iterator to the beginning of either an object or array JsonValue instance.
-	 * @return The const_iterator to the beginning of either an object or array JsonValue instance.
-	 * @throw std::runtime_error is thrown if the JsonValue type is non-iterable.
-	 */
-	const_iterator begin() const
-	{
-		if ( JsonValue::Type::object == mType )
+		case eMessagePackMarker::FALSE_VALUE:
+		case eMessagePackMarker::TRUE_VALUE:
+			mType = Type::boolean;
+			mBoolean = eMessagePackMarker::TRUE_VALUE == eMessagePackMarker( marker );
+			break;
+
+		case eMessagePackMarker::BINARY8:
+		case eMessagePackMarker::BINARY16:
+		case eMessagePackMarker::BINARY32:
 		{
-			return const_iterator( mMembers.cbegin() );
+			std::string bytes;
+			_readMessagePackString( source, _readMessagePackLength( source, marker, eMessagePackMarker::BINARY8 ), bytes );
+			mType = Type::string;
+			_base64Encode( bytes, mStringValue, true );
+			break;
 		}
 
-		if ( JsonValue::Type::array == mType )
+		case eMessagePackMarker::EXTENSION8:
+		case eMessagePackMarker::EXTENSION16:
+		case eMessagePackMarker::EXTENSION32:
+			_readMessagePackExtension( source, _readMessagePackLength( source, marker, eMessagePackMarker::EXTENSION8 ) );
+			break;
+
+		case eMessagePackMarker::FLOAT32:
 		{
-			return const_iterator( mElements.cbegin() );
+			const uint32_t bits = uint32_t( _readMessagePackInteger( source, 4 ) );
+			float singlePrecision;
+			std::memcpy( &singlePrecision, &bits, sizeof( singlePrecision ) );
+			mType = Type::number;
+			mNumericType = eNumberType::FLOATING;
+			mNumericValue.floatValue = singlePrecision;
+			break;
 		}
 
-		throw std::runtime_error( "Cannot create iterator for non-iterable type: " + _getTypeString() );
-	}
-
-	/**
-	 * Return a const_iterator to the beginning of either an object or array JsonValue instance.
-	 * @return The const_iterator to the beginning of either an object or array JsonValue instance.
-	 * @throw std::runtime_error is thrown if the JsonValue type is non-iterable.
-	 */
-	const_iterator cbegin() const
-	{
-		if ( JsonValue::Type::object == mType )
+		case eMessagePackMarker::FLOAT64:
 		{
-			return const_iterator( mMembers.cbegin() );
+			const uint64_t bits = _readMessagePackInteger( source, 8 );
+			double doublePrecision;
+			std::memcpy( &doublePrecision, &bits, sizeof( doublePrecision ) );
+			mType = Type::number;
+			mNumericType = eNumberType::FLOATING;
+			mNumericValue.floatValue = doublePrecision;
+			break;
 		}
 
-		if ( JsonValue::Type::array == mType )
+		case eMessagePackMarker::UINT8:
+		case eMessagePackMarker::UINT16:
+		case eMessagePackMarker::UINT32:
+		case eMessagePackMarker::UINT64:
+			mType = Type::number;
+			mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+			mNumericValue.unsignedIntegral = _readMessagePackInteger( source, size_t( 1 ) << ( marker - uint8_t( eMessagePackMarker::UINT8 ) ) );
+			break;
+
+		case eMessagePackMarker::INT8:
+		case eMessagePackMarker::INT16:
+		case eMessagePackMarker::INT32:
+		case eMessagePackMarker::INT64:
 		{
-			return const_iterator( mElements.cbegin() );
+			// Sign extend from the integer width.
+			const size_t width = size_t( 1 ) << ( marker - uint8_t( eMessagePackMarker::INT8 ) );
+			const unsigned shift = unsigned( 64 - ( 8 * width ) );
+			mType = Type::number;
+			mNumericType = eNumberType::SIGNED_INTEGRAL;
+			mNumericValue.signedIntegral = intmax_t( int64_t( _readMessagePackInteger( source, width ) << shift ) >> shift );
+			break;
 		}
 
-		throw std::runtime_error( "Cannot create iterator for non-iterable type: " + _getTypeString() );
+		case eMessagePackMarker::FIXED_EXTENSION1:
+		case eMessagePackMarker::FIXED_EXTENSION2:
+		case eMessagePackMarker::FIXED_EXTENSION4:
+		case eMessagePackMarker::FIXED_EXTENSION8:
+		case eMessagePackMarker::FIXED_EXTENSION16:
+			_readMessagePackExtension( source, size_t( 1 ) << ( marker - uint8_t( eMessagePackMarker::FIXED_EXTENSION1 ) ) );
+			break;
+
+		case eMessagePackMarker::STRING8:
+		case eMessagePackMarker::STRING16:
+		case eMessagePackMarker::STRING32:
+			mType = Type::string;
+			_readMessagePackString( source, _readMessagePackLength( source, marker, eMessagePackMarker::STRING8 ), mStringValue );
+			break;
+
+		case eMessagePackMarker::ARRAY16:
+		case eMessagePackMarker::ARRAY32:
+			_readMessagePackArray( source, size_t( _readMessagePackInteger( source, ( eMessagePackMarker::ARRAY16 == eMessagePackMarker( marker ) ) ? 2 : 4 ) ), depth );
+			break;
+
+		case eMessagePackMarker::MAP16:
+		case eMessagePackMarker::MAP32:
+			_readMessagePackMap( source, size_t( _readMessagePackInteger( source, ( eMessagePackMarker::MAP16 == eMessagePackMarker( marker ) ) ? 2 : 4 ) ), depth );
+			break;
+
+		default:
+			// 0xC1 is never used.
+			throw ParseError( "fromMessagePack", source );
+		}
 	}
 
-	/**
-	 * Return a const_iterator to the end of either an object or array JsonValue instance.
-	 * @return The const_iterator to the end of either an object or array JsonValue instance.
-	 * @throw std::runtime_error is thrown if the JsonValue type is non-iterable.
-	 */
-	const_iterator cend() const
+	// Append the {@param width} low bytes of {@param value}, little endian, as BSON stores numbers.
+	static void _appendBSONInteger( std::string& buffer, uint64_t value, size_t width )
 	{
-		if ( JsonValue::Type::object == mType )
+		for ( size_t position( 0 ); position < width; ++position )
 		{
-			return const_iterator( mMembers.cend() );
+			buffer.push_back( char( value >> ( 8 * position ) ) );
 		}
+	}
 
-		if ( JsonValue::Type::array == mType )
+	// Append the type and key of an element. Keys are C strings, so they may not hold '\0'.
+	static void _appendBSONKey( std::string& buffer, eBSONType type, const std::string& key )
+	{
+		if ( std::string::npos != key.find( '\0' ) )
 		{
-			return const_iterator( mElements.cend() );
+			throw std::invalid_argument( "BSON keys may not contain a null character" );
 		}
 
-		throw std::runtime_error( "Cannot create iterator for non-iterable type: " + _getTypeString() );
+		buffer.push_back( char( type ) );
+		buffer.append( key.c_str(), key.length() + 1 );
 	}
 
-	/**
-	 * Clear the contents of this JsonValue instance.
-	 * The type of this JsonValue instance shall be undefined after calling this method.
-	 */
-	void clear() noexcept
+	// Append a length prefixed, null terminated string.
+	static void _appendBSONString( std::string& buffer, const std::string& string )
 	{
-#ifdef INCLUDE_GMP
-		switch ( mNumericType )
+		if ( size_t( INT32_MAX ) <= string.length() )
 		{
-		case eNumberType::MULTIPLE_PRECISION_FLOAT:
-			mpf_clear( mMPFloatValue );
-			break;
-		case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
-			mpz_clear( mMPIntegralValue );
-			break;
+			throw std::length_error( "String exceeds the BSON limit of 2^31 - 2 bytes" );
 		}
-#endif
 
-		mType = Type::undefined;
-		mStringValue.clear();
-		mElements.clear();
-		mMembers.clear();
-		mBoolean = false;
-		mNumericType = eNumberType::NONE;
-		std::memset( &mNumericValue, 0, sizeof( mNumericValue ) );
+		_appendBSONInteger( buffer, string.length() + 1, 4 );
+		buffer.append( string.c_str(), string.length() + 1 );
 	}
 
-	/**
-	 * Write the string representation of this JsonValue out to file.
-	 * By default, the dense representation is generated. If a beautified,
-	 * or human readable, version is desired, then the indent can be set to
-	 * use tabs or spaces. The indentLevel is by default set to 4 for spaces.
-	 * @param jsonFile Pointer to the FILE handle to write to.
-	 * @param indent The character to use for indentation. [default: Indent:NONE]
-	 * @param indentationLevel This parameter is only used if {@param indent} is set
-	 *                         to Indent::SPACE, in which case it is the number of space
-	 *                         characters used for each level of indentation. [default: 4]
-	 */
-	void dump( FILE* jsonFile, Indent indent = Indent::NONE, size_t indentLevel = 4 ) const
+	// Overwrite the length prefix reserved at {@param start} with the length from there to the end of the buffer.
+	static void _patchBSONLength( std::string& buffer, size_t start )
 	{
-		JsonSink sink( jsonFile, indent, indentLevel );
-		_writeJSON( *this, sink );
-	}
+		const size_t length = buffer.length() - start;
+		if ( size_t( INT32_MAX ) < length )
+		{
+			throw std::length_error( "Document exceeds the BSON limit of 2^31 - 1 bytes" );
+		}
 
-	/**
-	 * Write the string representation of this JsonValue out to file.
-	 * By default, the dense representation is generated. If a beautified,
-	 * or human readable, version is desired, then the indent can be set to
-	 * use tabs or spaces. The indentLevel is by default set to 4 for spaces.
-	 * @param jsonOFStream Reference to the std::ofstream to write to.
-	 * @param indent The character to use for indentation. [default: Indent:NONE]
-	 * @param indentationLevel This parameter is only used if {@param indent} is set
-	 *                         to Indent::SPACE, in which case it is the number of space
-	 *                         characters used for each level of indentation. [default: 4]
-	 */
-	void dump( std::ofstream& jsonOFStream, Indent indent = Indent::NONE, size_t indentLevel = 4 ) const
-	{
-		JsonSink sink( jsonOFStream, indent, indentLevel );
-		_writeJSON( *this, sink );
+		for ( size_t position( 0 ); position < 4; ++position )
+		{
+			buffer[ start + position ] = char( length >> ( 8 * position ) );
+		}
 	}
 
-	/**
-	 * Write the string representation of this JsonValue out to file.
-	 * By default, the dense representation is generated. If a beautified,
-	 * or human readable, version is desired, then the indent can be set to
-	 * use tabs or spaces. The indentLevel is by default set to 4 for spaces.
-	 * @param jsonString Reference to the std::string to write to.
-	 * @param indent The character to use for indentation. [default: Indent:NONE]
-	 * @param indentationLevel This parameter is only used if {@param indent} is set
-	 *                         to Indent::SPACE, in which case it is the number of space
-	 *                         characters used for each level of indentation. [default: 4]
-	 */
-	void dumps( std::string& jsonString, Indent indent = Indent::NONE, size_t indentLevel = 4 ) const
+	// Encode {@param length} bytes as lowercase hexadecimal
+	static void _hexEncode( const char* bytes, size_t length, std::string& text )
 	{
-		JsonSink sink( jsonString, indent, indentLevel );
-		_writeJSON( *this, sink );
+		const char DIGITS[] = "0123456789abcdef";
+
+		text.clear();
+		text.reserve( 2 * length );
+		for ( size_t position( 0 ); position < length; ++position )
+		{
+			text.push_back( DIGITS[ uint8_t( bytes[ position ] ) >> 4 ] );
+			text.push_back( DIGITS[ uint8_t( bytes[ position ] ) & 0x0F ] );
+		}
 	}
 
-	/**
-	 * Return an iterator to the end of either an object or array JsonValue instance.
-	 * @return The iterator to the end of either an object or array JsonValue instance.
-	 * @throw std::runtime_error is thrown if the JsonValue type is non-iterable.
-	 */
-	iterator end()
+	// Decode hexadecimal of either case. Returns false if {@param text} is not hexadecimal.
+	static bool _hexDecode( const std::string& text, std::string& bytes )
 	{
-		if ( JsonValue::Type::object == mType )
+		if ( ( 0 != ( text.length() % 2 ) ) or ( std::string::npos != text.find_first_not_of( "0123456789abcdefABCDEF" ) ) )
 		{
-			return iterator( mMembers.end() );
+			return false;
 		}
 
-		if ( JsonValue::Type::array == mType )
+		bytes.clear();
+		for ( size_t position( 0 ); position < text.length(); position += 2 )
 		{
-			return iterator( mElements.end() );
+			bytes.push_back( char( std::stoi( text.substr( position, 2 ), nullptr, 16 ) ) );
 		}
 
-		throw std::runtime_error( "Cannot create iterator for non-iterable type: " + _getTypeString() );
+		return true;
 	}
 
-	/**
-	 * Return a const_iterator to the end of either an object or array JsonValue instance.
-	 * @return The const_iterator to the end of either an object or array JsonValue instance.
-	 * @throw std::runtime_error is thrown if the JsonValue type is non-iterable.
-	 */
-	const_iterator end() const
+	// Get the value of an integral number, or of a string holding one, as an int64_t.
+	static bool _getInt64( const JsonValue* value, int64_t& integral )
 	{
-		if ( JsonValue::Type::object == mType )
+		if ( nullptr == value )
 		{
-			return const_iterator( mMembers.cend() );
+			return false;
 		}
 
-		if ( JsonValue::Type::array == mType )
+		if ( ( Type::number == value->mType ) and ( eNumberType::SIGNED_INTEGRAL == value->mNumericType ) )
 		{
-			return const_iterator( mElements.cend() );
+			integral = int64_t( value->mNumericValue.signedIntegral );
+			return true;
 		}
 
-		throw std::runtime_error( "Cannot create iterator for non-iterable type: " + _getTypeString() );
-	}
+		if ( ( Type::number == value->mType ) and ( eNumberType::UNSIGNED_INTEGRAL == value->mNumericType )
+			and ( value->mNumericValue.unsignedIntegral <= uintmax_t( INT64_MAX ) ) )
+		{
+			integral = int64_t( value->mNumericValue.unsignedIntegral );
+			return true;
+		}
 
-	/**
-	 * Check if the given key is present under the constraint that the JsonValue is an object.
-	 * @param key Member key to check existance for.
-	 * @return True is returned if the key is present. False is returned if either the member
-	 *         key is not present or if the JsonValue is not an object.
-	 */
-	bool hasMember( const std::string& key ) const noexcept
-	{
-		if ( Type::object == mType )
+		if ( ( Type::string == value->mType ) and not value->mStringValue.empty() )
 		{
-			return mMembers.end() != mMembers.find( key );
+			char* end = nullptr;
+			errno = 0;
+			const long long parsed = strtoll( value->mStringValue.c_str(), &end, 10 );
+			integral = int64_t( parsed );
+			return ( 0 == errno ) and ( value->mStringValue.c_str() + value->mStringValue.length() == end );
 		}
 
 		return false;
 	}
 
-	/**
-	 * Check if this JsonValue is the same type as the requested.
-	 * @param type JsonValue::Type to check the present type against.
-	 * @return True is retured if the given and the present JsonValue::Type are the same.
-	 */
-	bool is( Type type ) const noexcept
+	// Convert a Decimal128, in the binary integer decimal encoding BSON uses, to its
+	// string form as defined by the General Decimal Arithmetic specification.
+	static std::string _decimal128ToString( uint64_t low, uint64_t high )
 	{
-		return type == mType;
-	}
+		const bool isNegative = 0 != ( high >> 63 );
+		std::string text( isNegative ? "-" : "" );
+		uint32_t limbs[ 4 ] = { uint32_t( low ), uint32_t( low >> 32 ), 0, 0 };
+		int exponent;
 
-	/**
-	 * Return a vector of keys under the constraint that the JsonValue is an object.
-	 * @return Return a vector of keys.
-	 * @throw An exception is thrown if the JsonValue is not an object.
-	 */
-	std::vector< std::string > keys() const
-	{
-		if ( Type::object == mType )
+		if ( 3 == ( ( high >> 61 ) & 3 ) )
 		{
-			std::vector< std::string > memberKeys( mMembers.size() );
+			if ( 0x1E == ( ( high >> 58 ) & 0x1F ) )
+			{
+				return text + "Infinity";
+			}
 
-			std::transform(
-				mMembers.begin(), mMembers.end(),
-				std::back_inserter( memberKeys ),
-				[]( const auto& keyValuePair )
-				{
-					return keyValuePair.first;
-				}
-			);
+			if ( 0x1F == ( ( high >> 58 ) & 0x1F ) )
+			{
+				return "NaN";
+			}
 
-			return objectKeys;
+			// The coefficient of this form always exceeds 34 digits, so it is non-canonical and read as zero.
+			exponent = int( ( high >> 47 ) & 0x3FFF ) - 6176;
+			limbs[ 0 ] = 0;
+			limbs[ 1 ] = 0;
+		}
+		else
+		{
+			exponent = int( ( high >> 49 ) & 0x3FFF ) - 6176;
+			limbs[ 2 ] = uint32_t( high );
+			limbs[ 3 ] = uint32_t( ( high >> 32 ) & 0x1FFFF );
 		}
 
-		throw std::runtime_error( "Operation 'keys()' is not defined for non-object type" );
-	}
+		// Divide the coefficient down by 10 for its digits, least significant first.
+		std::string digits;
+		do
+		{
+			uint64_t remainder = 0;
+			for ( size_t limb( 4 ); 0 < limb--; )
+			{
+				const uint64_t current = ( remainder << 32 ) | limbs[ limb ];
+				limbs[ limb ] = uint32_t( current / 10 );
+				remainder = current % 10;
+			}
 
-	/**
-	 * Parse a JsonValue from the given FILE and assign to this instance.
-	 * @param jsonFile Pointer to a FILE handle from whence to read the JSON from.
-	 * @throw ParseError is thrown if there is a parsing error.
-	 */
-	void load( FILE* jsonFile )
-	{
-		this->parse( jsonIFStream );
-	}
+			digits.push_back( char( '0' + remainder ) );
+		}
+		while ( 0 != ( limbs[ 0 ] | limbs[ 1 ] | limbs[ 2 ] | limbs[ 3 ] ) );
 
-	/**
-	 * Parse a JsonValue from the the given std::ifstream and assign to this instance.
-	 * @param jsonIFStream Reference to a std::ifstream from whence to read the JSON from.
-	 * @throw ParseError is thrown if there is a parsing error.
-	 */
-	void load( std::ifstream& jsonIFStream )
-	{
-		this->parse( jsonIFStream );
-	}
+		std::reverse( digits.begin(), digits.end() );
 
-	/**
-	 * Parse a JsonValue from the given string and assign to this instance.
-	 * @param jsonString A string object containing the JSON to be parsed.
-	 * @throw ParseError is thrown if there is a parsing error.
-	 */
-	void loads( const std::string& jsonString )
-	{
-		this->parse( jsonString );
+		// Limit coefficients beyond 34 digits to zero, as non-canonical.
+		if ( 34 < digits.length() )
+		{
+			digits = "0";
+		}
+
+		const int adjustedExponent = exponent + int( digits.length() ) - 1;
+		if ( ( exponent <= 0 ) and ( -6 <= adjustedExponent ) )
+		{
+			const int pointPosition = int( digits.length() ) + exponent;
+			if ( 0 == exponent )
+			{
+				text += digits;
+			}
+			else if ( 0 < pointPosition )
+			{
+				text += digits.substr( 0, size_t( pointPosition ) ) + "." + digits.substr( size_t( pointPosition ) );
+			}
+			else
+			{
+				text += "0." + std::string( size_t( -pointPosition ), '0' ) + digits;
+			}
+		}
+		else
+		{
+			text += digits.substr( 0, 1 );
+			if ( 1 < digits.length() )
+			{
+				text += "." + digits.substr( 1 );
+			}
+
+			text += ( ( adjustedExponent < 0 ) ? "E-" : "E+" ) + std::to_string( std::abs( adjustedExponent ) );
+		}
+
+		return text;
 	}
 
-	/**
-	 * Copy assignment operator.
-	 * @param other Const reference to the JsonValue to copy.
-	 * @return Reference to this JsonValue instance.
-	 */
-	JsonValue& operator=( const JsonValue& other )
+	// Convert the string form of a decimal into a Decimal128. Returns false if {@param text}
+	// is not a decimal, or would need rounding to fit in 34 digits.
+	static bool _stringToDecimal128( const std::string& text, uint64_t& low, uint64_t& high )
 	{
-		if ( *this != other )
+		size_t position = 0;
+		const bool isNegative = ( not text.empty() ) and ( '-' == text[ 0 ] );
+		position += ( ( not text.empty() ) and ( ( '-' == text[ 0 ] ) or ( '+' == text[ 0 ] ) ) ) ? 1 : 0;
+
+		const std::string magnitude = text.substr( position );
+		if ( ( "Infinity" == magnitude ) or ( "Inf" == magnitude ) or ( "NaN" == magnitude ) )
 		{
-			this->clear();
-			_copyAssign( other );
+			low = 0;
+			high = ( uint64_t( isNegative ? 1 : 0 ) << 63 ) | ( uint64_t( ( 'N' == magnitude[ 0 ] ) ? 0x1F : 0x1E ) << 58 );
+			return true;
 		}
 
-		return *this;
-	}
+		std::string digits;
+		int exponent = 0;
+		bool isFraction = false;
+		bool hasDigits = false;
 
-	/**
-	 * Move assignment operator.
-	 * @param other R-Value to the JsonValue to move.
-	 * @return Reference to this JsonValue instance.
-	 */
-	JsonValue& operator=( JsonValue&& other )
-	{
-		if ( *this != other )
+		for ( ; position < text.length(); ++position )
 		{
-			this->clear();
-			_moveAssign( std::move( other ) );
+			const char character = text[ position ];
+			if ( isdigit( character ) )
+			{
+				hasDigits = true;
+				if ( not ( digits.empty() and ( '0' == character ) ) )
+				{
+					digits.push_back( character );
+				}
+
+				exponent -= isFraction ? 1 : 0;
+			}
+			else if ( ( '.' == character ) and not isFraction )
+			{
+				isFraction = true;
+			}
+			else
+			{
+				break;
+			}
 		}
 
-		return *this;
-	}
+		if ( ( position < text.length() ) and ( ( 'e' == text[ position ] ) or ( 'E' == text[ position ] ) ) )
+		{
+			char* end = nullptr;
+			const char* start = text.c_str() + position + 1;
+			const long explicitExponent = strtol( start, &end, 10 );
+			if ( ( start == end ) or ( ( explicitExponent < -10000 ) or ( 10000 < explicitExponent ) ) )
+			{
+				return false;
+			}
 
-	/**
-	 * Object copy assignment operator.
-	 * @param object Const reference to an object to assign to this JsonValue.
-	 * @return Reference to this JsonValue instance is returned.
-	 */
-	JsonValue& operator=( const ObjectType& object )
-	{
-		this->clear();
-		mType = Type::object;
-		mMembers = object;
+			exponent += int( explicitExponent );
+			position = size_t( end - text.c_str() );
+		}
 
-		return *this;
-	}
+		// Move the exponent into range by trailing zeros, where that is exact.
+		while ( ( exponent < -6176 ) and ( not digits.empty() ) and ( '0' == digits.back() ) )
+		{
+			digits.pop_back();
+			++exponent;
+		}
 
-	/**
-	 * Object move assignment operator.
-	 * @param object R-Value to an object to assign to this JsonValue.
-	 * @return Reference to this JsonValue instance is returned.
-	 */
-	JsonValue& operator=( ObjectType&& object )
-	{
-		this->clear();
-		mType = Type::object;
-		mMembers = std::move( object );
+		while ( ( 6111 < exponent ) and ( not digits.empty() ) and ( digits.length() < 34 ) )
+		{
+			digits.push_back( '0' );
+			--exponent;
+		}
 
-		return *this;
-	}
+		exponent = digits.empty() ? std::min( std::max( exponent, -6176 ), 6111 ) : exponent;
 
-	/**
-	 * Array copy assignment operator.
-	 * @param array R-Value to an array to assign to this JsonValue.
-	 * @return Reference to this JsonValue instance is returned.
-	 */
-	JsonValue& operator=( const ArrayType& array )
-	{
-		this->clear();
-		mType = Type::array;
-		mElements = array;
+		const int biasedExponent = exponent + 6176;
+		if ( ( not hasDigits ) or ( position != text.length() ) or ( 34 < digits.length() )
+			or ( biasedExponent < 0 ) or ( 12287 < biasedExponent ) )
+		{
+			return false;
+		}
 
-		return *this;
+		// Multiply the coefficient up by 10 for each digit.
+		uint32_t limbs[ 4 ] = { 0, 0, 0, 0 };
+		for ( char digit : digits )
+		{
+			uint64_t carry = uint64_t( digit - '0' );
+			for ( size_t limb( 0 ); limb < 4; ++limb )
+			{
+				const uint64_t current = ( uint64_t( limbs[ limb ] ) * 10 ) + carry;
+				limbs[ limb ] = uint32_t( current );
+				carry = current >> 32;
+			}
+		}
+
+		low = ( uint64_t( limbs[ 1 ] ) << 32 ) | limbs[ 0 ];
+		high = ( uint64_t( isNegative ? 1 : 0 ) << 63 ) | ( uint64_t( biasedExponent ) << 49 )
+			| ( uint64_t( limbs[ 3 ] ) << 32 ) | limbs[ 2 ];
+		return true;
 	}
 
-	/**
-	 * Array copy assignment operator.
-	 * @param array R-Value to an array to assign to this JsonValue.
-	 * @return Reference to this JsonValue instance is returned.
-	 */
-	JsonValue& operator=( ArrayType&& array )
+	// Write this object as one of the BSON types that JSON has no counterpart for, if it is
+	// in the MongoDB Extended JSON v2 canonical form fromBSON() reads such types into.
+	// Returns false, writing nothing, if it is not.
+	bool _writeBSONExtended( std::string& buffer, const std::string& key ) const
 	{
-		this->clear();
-		mType = Type::array;
-		mElements = std::move( array );
+		if ( ( mMembers.empty() ) or ( 2 < mMembers.size() ) or ( '$' != mMembers.begin()->first[ 0 ] ) )
+		{
+			return false;
+		}
 
-		return *this;
-	}
+		const std::string& name = mMembers.begin()->first;
+		const JsonValue& value = mMembers.begin()->second;
+		const bool isString = Type::string == value.mType;
+		std::string bytes;
+		int64_t integral;
 
-	/**
-	 * String copy assignment operator.
-	 * @param string Const reference to a string to assign to this JsonValue.
-	 * @return Reference to this JsonValue instance is returned.
-	 */
-	JsonValue& operator=( const std::string& string )
-	{
-		this->clear();
-		mType = Type::string;
-		mStringValue = string;
+		if ( 2 == mMembers.size() )
+		{
+			// { "$code": ..., "$scope": { ... } }, prefixed by the length of the code and scope together
+			const JsonValue* scope = find( "$scope" );
+			if ( ( "$code" != name ) or not isString or ( nullptr == scope ) or ( Type::object != scope->mType ) )
+			{
+				return false;
+			}
 
-		return *this;
-	}
+			_appendBSONKey( buffer, eBSONType::JAVASCRIPT_WITH_SCOPE, key );
+			const size_t start = buffer.length();
+			buffer.append( 4, '\0' );
+			_appendBSONString( buffer, value.mStringValue );
+			scope->_writeBSONDocument( buffer );
+			_patchBSONLength( buffer, start );
+			return true;
+		}
 
-	/**
-	 * String move assignment operator.
-	 * @param string R-Value to a string to assign to this JsonValue.
-	 * @return Reference to this JsonValue instance is returned.
-	 */
-	JsonValue& operator=( std::string&& string )
-	{
-		this->clear();
-		mType = Type::string;
-		mStringValue = std::move( string );
+		if ( ( "$oid" == name ) and isString and ( 24 == value.mStringValue.length() ) and _hexDecode( value.mStringValue, bytes ) )
+		{
+			_appendBSONKey( buffer, eBSONType::OBJECT_ID, key );
+			buffer.append( bytes );
+			return true;
+		}
 
-		return *this;
-	}
+		if ( ( "$date" == name ) and ( _getInt64( &value, integral ) or _getInt64( value.find( "$numberLong" ), integral ) ) )
+		{
+			_appendBSONKey( buffer, eBSONType::DATETIME, key );
+			_appendBSONInteger( buffer, uint64_t( integral ), 8 );
+			return true;
+		}
 
-	/**
-	 * Numeric assignment operator.
-	 * @param arithmeticValue Arithmetic number to assign to this JsonValue.
-	 * @return Reference to this JsonValue instance is returned.
-	 */
-	template < typename ArithmeticType,
-		typename = typename std::enable_if< std::is_arithmetic< ArithmeticType >::value >::type >
-	JsonValue& operator=( ArithmeticType arithmeticValue )
-	{
-		this->clear();
-		mType = Type::number;
-		if ( std::is_floating_point< ArithmeticType >::value )
+		if ( ( "$numberLong" == name ) and isString and _getInt64( &value, integral ) )
 		{
-			mNumericType = eNumberType::FLOATING;
-			mNumericValue.floatValue = arithmeticValue;
+			_appendBSONKey( buffer, eBSONType::INT64, key );
+			_appendBSONInteger( buffer, uint64_t( integral ), 8 );
+			return true;
 		}
-		else if ( std::is_unsigned< ArithmeticType >::value )
+
+		if ( ( "$numberInt" == name ) and isString and _getInt64( &value, integral )
+			and ( INT32_MIN <= integral ) and ( integral <= INT32_MAX ) )
 		{
-			mNumericType = eNumberType::UNSIGNED_INTEGRAL;
-			mNumericValue.unsignedIntegral = arithmeticValue;
+			_appendBSONKey( buffer, eBSONType::INT32, key );
+			_appendBSONInteger( buffer, uint64_t( integral ), 4 );
+			return true;
 		}
-		else
+
+		if ( ( "$numberDouble" == name ) and isString and not value.mStringValue.empty() )
 		{
-			mNumericType = eNumberType::SIGNED_INTEGRAL;
-			mNumericValue.signedIntegral = arithmeticValue;
+			char* end = nullptr;
+			const double doublePrecision = ( "Infinity" == value.mStringValue ) ? HUGE_VAL
+				: ( ( "-Infinity" == value.mStringValue ) ? -HUGE_VAL : strtod( value.mStringValue.c_str(), &end ) );
+			if ( ( nullptr != end ) and ( value.mStringValue.c_str() + value.mStringValue.length() != end ) )
+			{
+				return false;
+			}
+
+			uint64_t bits;
+			std::memcpy( &bits, &doublePrecision, sizeof( bits ) );
+			_appendBSONKey( buffer, eBSONType::DOUBLE, key );
+			_appendBSONInteger( buffer, bits, 8 );
+			return true;
 		}
 
-		return *this;
-	}
+		if ( "$numberDecimal" == name )
+		{
+			uint64_t low;
+			uint64_t high;
+			if ( not isString or not _stringToDecimal128( value.mStringValue, low, high ) )
+			{
+				return false;
+			}
 
-#ifdef INCLUDE_GMP
-	/**
-	 * Multiple precision integral numeric assignment operator.
-	 * @param multiplePrecisionIntegral mpz_t object.
-	 * @return Return reference to this JsonValue instance.
-	 */
-	JsonValue& operator=( mpz_t multiplePrecisionIntegral )
-	{
-		this->clear();
-		mType = Type::number;
-		mNumericType = eNumberType::MULTIPLE_PRECISION_INTEGRAL;
-		mpz_init_set( mNumericValue.MPIntegralValue, multiplePrecisionIntegral );
+			_appendBSONKey( buffer, eBSONType::DECIMAL128, key );
+			_appendBSONInteger( buffer, low, 8 );
+			_appendBSONInteger( buffer, high, 8 );
+			return true;
+		}
 
-		return *this;
-	}
+		if ( "$binary" == name )
+		{
+			const JsonValue* base64 = value.find( "base64" );
+			const JsonValue* subType = value.find( "subType" );
+			std::string subTypeByte;
+			if ( ( nullptr == base64 ) or ( nullptr == subType ) or ( Type::string != base64->mType ) or ( Type::string != subType->mType )
+				or ( 2 < subType->mStringValue.length() ) or not _hexDecode( std::string( 2 - subType->mStringValue.length(), '0' ) + subType->mStringValue, subTypeByte )
+				or not _base64Decode( base64->mStringValue, bytes ) or ( size_t( INT32_MAX - 4 ) < bytes.length() ) )
+			{
+				return false;
+			}
 
-	/**
-	 * Multiple precision float numeric assignment operator.
-	 * @param multiplePrecisionFloat mpf_t object.
-	 * @return Return reference to this JsonValue instance.
-	 */
-	JsonValue& operator=( mpf_t multiplePrecitionFloat )
-	{
-		this->clear();
-		mType = Type::number;
-		mNumericType = eNumberType::MULTIPLE_PRECISION_FLOAT;
-		mpf_init_set( mNumericValue.MPFloatValue, multiplePrecisionFloat );
+			// The deprecated subtype 2 repeats the length inside the payload.
+			const bool isOldBinary = 0x02 == subTypeByte[ 0 ];
+			_appendBSONKey( buffer, eBSONType::BINARY, key );
+			_appendBSONInteger( buffer, bytes.length() + ( isOldBinary ? 4 : 0 ), 4 );
+			buffer.append( subTypeByte );
+			if ( isOldBinary )
+			{
+				_appendBSONInteger( buffer, bytes.length(), 4 );
+			}
 
-		return *this;
-	}
-#endif
+			buffer.append( bytes );
+			return true;
+		}
 
-	/**
-	 * Boolean assignment operator.
-	 * @param boolean Boolean value to assign to this JsonValue.
-	 * @return Return reference to this JsonValue instance.
-	 */
-	JsonValue& operator=( bool boolean )
-	{
-		this->clear();
-		mType = Type::boolean;
-		mBoolean = boolean;
+		if ( "$regularExpression" == name )
+		{
+			const JsonValue* pattern = value.find( "pattern" );
+			const JsonValue* options = value.find( "options" );
+			if ( ( nullptr == pattern ) or ( nullptr == options ) or ( Type::string != pattern->mType ) or ( Type::string != options->mType )
+				or ( std::string::npos != pattern->mStringValue.find( '\0' ) ) or ( std::string::npos != options->mStringValue.find( '\0' ) ) )
+			{
+				return false;
+			}
 
-		return *this;
-	}
+			_appendBSONKey( buffer, eBSONType::REGULAR_EXPRESSION, key );
+			buffer.append( pattern->mStringValue.c_str(), pattern->mStringValue.length() + 1 );
+			buffer.append( options->mStringValue.c_str(), options->mStringValue.length() + 1 );
+			return true;
+		}
 
-	/**
-	 * Null assignment operator.
-	 * @return Return reference to this JsonValue instance.
-	 */
-	JsonValue& operator=( std::nullptr_t )
-	{
-		this->clear();
-		mType = Type::null;
+		if ( "$timestamp" == name )
+		{
+			int64_t time;
+			int64_t increment;
+			if ( not _getInt64( value.find( "t" ), time ) or not _getInt64( value.find( "i" ), increment )
+				or ( time < 0 ) or ( UINT32_MAX < time ) or ( increment < 0 ) or ( UINT32_MAX < increment ) )
+			{
+				return false;
+			}
+
+			_appendBSONKey( buffer, eBSONType::TIMESTAMP, key );
+			_appendBSONInteger( buffer, ( uint64_t( time ) << 32 ) | uint64_t( increment ), 8 );
+			return true;
+		}
+
+		if ( ( ( "$minKey" == name ) or ( "$maxKey" == name ) ) and _getInt64( &value, integral ) and ( 1 == integral ) )
+		{
+			_appendBSONKey( buffer, ( "$minKey" == name ) ? eBSONType::MIN_KEY : eBSONType::MAX_KEY, key );
+			return true;
+		}
+
+		if ( ( ( "$code" == name ) or ( "$symbol" == name ) ) and isString )
+		{
+			_appendBSONKey( buffer, ( "$code" == name ) ? eBSONType::JAVASCRIPT : eBSONType::SYMBOL, key );
+			_appendBSONString( buffer, value.mStringValue );
+			return true;
+		}
+
+		if ( "$dbPointer" == name )
+		{
+			const JsonValue* reference = value.find( "$ref" );
+			const JsonValue* identifier = value.find( "$id" );
+			const JsonValue* objectId = ( nullptr == identifier ) ? nullptr : identifier->find( "$oid" );
+			if ( ( nullptr == reference ) or ( Type::string != reference->mType ) or ( nullptr == objectId ) or ( Type::string != objectId->mType )
+				or ( 24 != objectId->mStringValue.length() ) or not _hexDecode( objectId->mStringValue, bytes ) )
+			{
+				return false;
+			}
+
+			_appendBSONKey( buffer, eBSONType::DB_POINTER, key );
+			_appendBSONString( buffer, reference->mStringValue );
+			buffer.append( bytes );
+			return true;
+		}
 
-		return *this;
+		return false;
 	}
 
-	/**
-	 * Compare equals operator.
-	 * @param other Const reference to the JsonValue object to compare against.
-	 * @return True is returned if this and other are equal, else false.
-	 */
-	bool operator==( const JsonValue& other ) const noexcept
+	// Write this JsonValue as the element {@param key} of a BSON document.
+	void _writeBSONElement( std::string& buffer, const std::string& key ) const
 	{
-		if ( mType != other.mType )
-		{
-			return false;
-		}
-
 		switch ( mType )
 		{
 		case Type::object:
-			return mMembers == other.mMembers;
+			if ( not _writeBSONExtended( buffer, key ) )
+			{
+				_appendBSONKey( buffer, eBSONType::DOCUMENT, key );
+				_writeBSONDocument( buffer );
+			}
+			break;
 
 		case Type::array:
-			return mElements == other.mElements;
+			_appendBSONKey( buffer, eBSONType::ARRAY, key );
+			_writeBSONDocument( buffer );
+			break;
 
 		case Type::string:
-			return mStringValue == other.mStringValue;
+			_appendBSONKey( buffer, eBSONType::STRING, key );
+			_appendBSONString( buffer, mStringValue );
+			break;
 
 		case Type::number:
+		{
+			int64_t integral;
+			if ( _getInt64( this, integral ) )
+			{
+				const bool isInt32 = ( INT32_MIN <= integral ) and ( integral <= INT32_MAX );
+				_appendBSONKey( buffer, isInt32 ? eBSONType::INT32 : eBSONType::INT64, key );
+				_appendBSONInteger( buffer, uint64_t( integral ), isInt32 ? 4 : 8 );
+				break;
+			}
+
+			double doublePrecision;
 			switch ( mNumericType )
 			{
 			case eNumberType::FLOATING:
-				return mNumericValue.floatValue == other.mNumericValue.floatValue;
-
-			case eNumberType::SIGNED_INTEGRAL:
-				return mNumericValue.signedIntegral == other.mNumericValue.signedIntegral;
+				doublePrecision = double( mNumericValue.floatValue );
+				break;
 
-			case eNumberType::UNSIGNED_INTEGRAL:
-				return mNumericValue.unsignedIntegral == other.mNumericValue.unsignedIntegral;
 #ifdef INCLUDE_GMP
-			case eNumberType::MULTIPLE_PRECISION_FLOAT:
-				return mpf_cmp( mNumericValue.MPFloatValue, other.mNumericValue.MPFloatValue );
-
 			case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
-				return mpz_cmp( mNumericValue.MPIntegralValue, other.mNumericValue.MPIntegralValue );
+				if ( mpz_fits_slong_p( mNumericValue.MPIntegralValue ) )
+				{
+					_appendBSONKey( buffer, eBSONType::INT64, key );
+					_appendBSONInteger( buffer, uint64_t( mpz_get_si( mNumericValue.MPIntegralValue ) ), 8 );
+					return;
+				}
+
+				throw std::runtime_error( "Cannot encode a multiple precision integral beyond 64 bits as BSON" );
+
+			case eNumberType::MULTIPLE_PRECISION_FLOAT:
+				doublePrecision = mpf_get_d( mNumericValue.MPFloatValue );
+				break;
 #endif
+
+			case eNumberType::UNSIGNED_INTEGRAL:
+				throw std::runtime_error( "Cannot encode an unsigned integral beyond the int64 range as BSON" );
+
+			default:
+				throw std::runtime_error( "Cannot encode an unresolved number as BSON" );
 			}
 
-			return false;
+			uint64_t bits;
+			std::memcpy( &bits, &doublePrecision, sizeof( bits ) );
+			_appendBSONKey( buffer, eBSONType::DOUBLE, key );
+			_appendBSONInteger( buffer, bits, 8 );
+			break;
+		}
 
 		case Type::boolean:
-			return mBoolean == other.mBoolean;
+			_appendBSONKey( buffer, eBSONType::BOOLEAN, key );
+			buffer.push_back( mBoolean ? '\x01' : '\x00' );
+			break;
 
 		case Type::null:
-			return true;
-		}
+			_appendBSONKey( buffer, eBSONType::NULL_VALUE, key );
+			break;
 
-		return false;
+		case Type::undefined:
+			_appendBSONKey( buffer, eBSONType::UNDEFINED, key );
+			break;
+		}
 	}
 
-	/**
-	 * Compare not equal operator.
-	 * @param other Const reference to the JsonValue object to compare against.
-	 * @return True is returned if this and other are not equal, else false.
-	 */
-	bool operator!=( const JsonValue& other ) const noexcept
+	// Write the members, or the elements keyed by their position, of this JsonValue as a BSON
+	// document. The length prefix is reserved up front and backpatched once the document is
+	// complete, so the document is written in a single pass.
+	void _writeBSONDocument( std::string& buffer ) const
 	{
-		return not this->operator==( other );
-	}
+		const size_t start = buffer.length();
+		buffer.append( 4, '\0' );
 
-	/**
-	 * Member access for object type JsonValue instances.
-	 * @param key Pointer to a const char
-	 * @return Reference to the member JsonValue.
-	 */
-	JsonValue& operator[]( const char* const key )
-	{
-		if ( Type::object != mType )
+		if ( Type::array == mType )
 		{
-			throw std::runtime_error( "Member access 'operator[]( const char* const )' is not defined for non-object type" );
+			for ( size_t position( 0 ); position < mElements.size(); ++position )
+			{
+				mElements[ position ]._writeBSONElement( buffer, std::to_string( position ) );
+			}
 		}
-
-		if ( nullptr == key )
+		else
 		{
-			throw std::invalid_argument( "Key may not be a null pointer" );
+			for ( const auto& member : mMembers )
+			{
+				member.second._writeBSONElement( buffer, member.first );
+			}
 		}
 
-		return this->operator[]( std::string( key ) );
+		buffer.push_back( '\0' );
+		_patchBSONLength( buffer, start );
 	}
 
-	/**
-	 * Mutable member access for object type JsonValue instances.
-	 * If the key is not present, then the member is added.
-	 * @param key Const reference to a std::string.
-	 * @return Reference to the member JsonValue.
-	 */
-	JsonValue& operator[]( const std::string& key )
+	// Encode this object as a BSON document, appended to {@param buffer}.
+	void _writeBSON( std::string& buffer ) const
 	{
 		if ( Type::object != mType )
 		{
-			throw std::runtime_error( "Member access 'operator[]( const std::string& )' is not defined for non-object type" );
+			throw std::runtime_error( "Cannot encode non-object type as a BSON document: " + _getTypeString() );
 		}
 
-		return mMembers[ key ];
+		_writeBSONDocument( buffer );
 	}
 
-	/**
-	 * Mutable element access for array JSON values.
-	 * If the index is positive and exceeds the size, then the array is filled
-	 * with undefined elements up to the new index. Negative indices may not
-	 * exceed the size of the array.
-	 * @param index Index into the array.
-	 * @return Reference to the element JsonValue.
-	 * @throw std::out_of_range is thrown if the index is negative and exceeds the range.
-	 */
-	template < typename IntegralType,
-		typename = typename std::enable_if< std::is_integral< IntegralType >::value >::type >
-	JsonValue& operator[]( IntegralType index )
+	// Make this JsonValue the unsigned integral {@param value}.
+	void _setUnsigned( uintmax_t value ) noexcept
 	{
-		size_t absoluteIndex;
+		mType = Type::number;
+		mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+		mNumericValue.unsignedIntegral = value;
+	}
 
-		if ( Type::array != mType )
+	// Read a {@param width} byte little endian integer
+	static uint64_t _readBSONInteger( ParseSource& source, size_t width )
+	{
+		if ( not source.available( width ) )
 		{
-			throw std::runtime_error( "Integral index access 'operator[]( IntegralType )' is not defined for non-array type" );
+			throw ParseError( "fromBSON", source );
 		}
 
-		// Convert the given index into an absolute offset
-		// from the beginning of the elements array.
-		if ( std::is_signed< IntegralType >::value )
-		{
-			if ( index < IntegralType( 0 ) )
-			{
-				absoluteIndex = size_t( -index );
-				if ( mElements.size() < absoluteIndex )
-				{
-					throw std::out_of_range( "Negative indices may not exceed the length of the array." );
-				}
-
-				absoluteIndex = mElments.size() - absoluteIndex;
-			}
-			else
-			{
-				absoluteIndex = size_t( index );
-			}
-		}
-		else
+		uint64_t value = 0;
+		for ( size_t position( width ); 0 < position--; )
 		{
-			absoluteIndex = size_t( index );
+			value = ( value << 8 ) | uint8_t( source.peek( uint32_t( position ) ) );
 		}
 
-		// Fill in the difference with undefined JSON values.
-		if ( absoluteIndex <= mElements.size() )
+		source.update( uint32_t( width ) );
+		return value;
+	}
+
+	// Read a length prefix, which is a signed 32 bit integer of at least {@param minimum}.
+	static uint32_t _readBSONLength( ParseSource& source, uint32_t minimum )
+	{
+		const int32_t length = int32_t( uint32_t( _readBSONInteger( source, 4 ) ) );
+		if ( length < int32_t( minimum ) )
 		{
-			mElements.resize( absoluteIndex + 1 );
+			throw ParseError( "fromBSON", source );
 		}
 
-		return mElements[ absoluteIndex ];
+		return uint32_t( length );
 	}
 
-	/**
-	 * Immutable member access for object type JsonValue instances.
-	 * @param key Pointer to a const char
-	 * @return Reference to the member JsonValue.
-	 */
-	JsonValue& operator[]( const char* const key ) const
+	// Read a null terminated C string onto {@param destination}.
+	static void _readBSONCString( ParseSource& source, std::string& destination )
 	{
-		if ( Type::object != mType )
+		uint32_t length = 0;
+		while ( source.available( size_t( length ) + 1 ) and ( '\0' != source.peek( length ) ) )
 		{
-			throw std::runtime_error( "Member access 'operator[]( const char* const ) const' is not defined for non-object type" );
+			++length;
 		}
 
-		if ( nullptr == key )
+		if ( not source.available( size_t( length ) + 1 ) )
 		{
-			throw std::invalid_argument( "Key may not be null" );
+			throw ParseError( "fromBSON", source );
 		}
 
-		return this->operator[]( std::string( key ) );
+		source.append( destination, length );
+		source.update();
 	}
 
-	/**
-	 * Immutable member access for object type JsonValue instances.
-	 * If the key is not present, then std::out_of_range is thrown.
-	 * @param key Const reference to a std::string.
-	 * @return Reference to the member JsonValue.
-	 */
-	JsonValue& operator[]( const std::string& key ) const
+	// Read a length prefixed, null terminated string onto {@param destination}.
+	static void _readBSONString( ParseSource& source, std::string& destination )
 	{
-		if ( Type::object != mType )
+		const uint32_t length = _readBSONLength( source, 1 );
+
+		if ( not source.append( destination, length - 1 ) or ( '\0' != source.peek() ) or source.endOfSource() )
 		{
-			throw std::runtime_error( "Member access 'operator[]( const std::string& ) const' is not defined for non-object type" );
+			throw ParseError( "fromBSON", source );
 		}
 
-		return mMembers.at( key );
+		source.update();
 	}
 
-	/**
-	 * Immutable element access for array JSON values.
-	 * If the index exceeds the bounds 
-	 * If the index is positive and exceeds the size, then the array is filled
-	 * with undefined elements up to the new index. Negative indices may not
-	 * exceed the size of the array.
-	 * @param index Index into the array.
-	 * @return Reference to the element JsonValue.
-	 */
-	template < typename IntegralType,
-		typename = typename std::enable_if< std::is_integral< IntegralType >::value >::type >
-	JsonValue& operator[]( IntegralType index ) const
+	// Read an object id as its Extended JSON form, { "$oid": "<hex>" }.
+	static JsonValue _readBSONObjectId( ParseSource& source )
 	{
-		size_t absoluteIndex;
+		std::string bytes;
+		std::string text;
 
-		if ( Type::array != mType )
+		if ( not source.append( bytes, 12 ) )
 		{
-			throw std::runtime_error( "Integral index access 'operator[]( IntegralType ) const' is not defined for non-array type" );
+			throw ParseError( "fromBSON", source );
 		}
 
-		if ( std::is_signed< IntegralType >::value )
+		_hexEncode( bytes.data(), bytes.length(), text );
+		return JsonValue( ObjectType { { "$oid", std::move( text ) } } );
+	}
+
+	// Move past a value of the given type without reading it. Strings, binary data and
+	// documents are skipped whole by their length prefixes.
+	static void _skipBSONValue( ParseSource& source, eBSONType type )
+	{
+		uint64_t length = 0;
+
+		switch ( type )
 		{
-			if ( index < IntegralType( 0 ) )
-			{
-				absoluteIndex = size_t( -index );
-				if ( mElements.size() < absoluteIndex )
-				{
-					throw std::out_of_range( "Negative indices may not exceed the length of the array." );
-				}
+		case eBSONType::UNDEFINED:
+		case eBSONType::NULL_VALUE:
+		case eBSONType::MIN_KEY:
+		case eBSONType::MAX_KEY:
+			return;
+
+		case eBSONType::BOOLEAN:
+			length = 1;
+			break;
 
-				absoluteIndex = mElments.size() - absoluteIndex;
-			}
-			else
-			{
-				absoluteIndex = size_t( index );
-			}
-		}
-		else
+		case eBSONType::INT32:
+			length = 4;
+			break;
+
+		case eBSONType::DOUBLE:
+		case eBSONType::DATETIME:
+		case eBSONType::TIMESTAMP:
+		case eBSONType::INT64:
+			length = 8;
+			break;
+
+		case eBSONType::OBJECT_ID:
+			length = 12;
+			break;
+
+		case eBSONType::DECIMAL128:
+			length = 16;
+			break;
+
+		case eBSONType::STRING:
+		case eBSONType::JAVASCRIPT:
+		case eBSONType::SYMBOL:
+			length = _readBSONLength( source, 1 );
+			break;
+
+		case eBSONType::DB_POINTER:
+			length = uint64_t( _readBSONLength( source, 1 ) ) + 12;
+			break;
+
+		case eBSONType::BINARY:
+			length = uint64_t( _readBSONLength( source, 0 ) ) + 1;
+			break;
+
+		case eBSONType::DOCUMENT:
+		case eBSONType::ARRAY:
+		case eBSONType::JAVASCRIPT_WITH_SCOPE:
+			length = _readBSONLength( source, 5 ) - 4;
+			break;
+
+		case eBSONType::REGULAR_EXPRESSION:
 		{
-			absoluteIndex = size_t( index );
+			std::string ignored;
+			_readBSONCString( source, ignored );
+			_readBSONCString( source, ignored );
+			return;
 		}
 
-		return mElements.at( absoluteIndex );
+		default:
+			throw ParseError( "fromBSON", source );
+		}
+
+		if ( not source.skip( length ) )
+		{
+			throw ParseError( "fromBSON", source );
+		}
 	}
 
-	/**
-	 * Cast the value held by the JsonValue object to either true or false.
-	 * If the type is object or array, then true is returned. For string type,
-	 * true shall be returned if the string is non-zero in length. For number
-	 * type, if the value is non-zero, then true is returned else false.
-	 * For all other types, false is returned.
-	 */
-	operator bool() const
+	// Read a value of a type JSON has no counterpart for, as its Extended JSON form. Kept out of
+	// _readBSONValue, so every level of nested documents takes a small stack frame.
+	static JsonValue _readBSONExtendedValue( ParseSource& source, eBSONType type )
 	{
-		switch ( mType )
+		switch ( type )
 		{
-			case Type::array:
-			case Type::object:
-				return true;
+		case eBSONType::BINARY:
+		{
+			const uint32_t length = _readBSONLength( source, 0 );
+			const uint8_t subType = uint8_t( _readBSONInteger( source, 1 ) );
+			std::string bytes;
+			std::string base64;
+			std::string subTypeText;
 
-			case Type::string:
-				return not mStringValue.empty();
+			if ( not source.append( bytes, length ) )
+			{
+				throw ParseError( "fromBSON", source );
+			}
 
-			case Type::number:
-				switch ( mNumericType )
-				{
-					case eNumberType::FLOATING:
-						return 0.0 != mNumericValue.floatValue;
+			// The deprecated subtype 2 repeats the length inside the payload.
+			if ( ( 0x02 == subType ) and ( 4 <= bytes.length() ) )
+			{
+				bytes.erase( 0, 4 );
+			}
 
-					case eNumberType::SIGNED_INTEGRAL:
-						return 0 != mNumericValue.signedIntegral;
+			_base64Encode( bytes, base64, false );
+			_hexEncode( reinterpret_cast< const char* >( &subType ), 1, subTypeText );
+			return JsonValue( ObjectType { { "$binary", JsonValue( ObjectType {
+				{ "base64", std::move( base64 ) }, { "subType", std::move( subTypeText ) } } ) } } );
+		}
 
-					case eNumberType::UNSIGNED_INTEGRAL:
-						return 0 != mNumericValue.unsignedIntegral;
+		case eBSONType::OBJECT_ID:
+			return _readBSONObjectId( source );
 
-#ifdef INCLUDE_GMP
-					case eNumberType::MULTIPLE_PRECISION_FLOAT:
-						return 0 != mpf_sgn( mNumericValue.MPFloatValue );
+		case eBSONType::DATETIME:
+			return JsonValue( ObjectType { { "$date", JsonValue( ObjectType {
+				{ "$numberLong", std::to_string( int64_t( _readBSONInteger( source, 8 ) ) ) } } ) } } );
 
-					case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
-						return 0 != mpz_sgn( mNumericValue.MPIntegralValue );
-#endif
+		case eBSONType::REGULAR_EXPRESSION:
+		{
+			std::string pattern;
+			std::string options;
+			_readBSONCString( source, pattern );
+			_readBSONCString( source, options );
+			return JsonValue( ObjectType { { "$regularExpression", JsonValue( ObjectType {
+				{ "pattern", std::move( pattern ) }, { "options", std::move( options ) } } ) } } );
+		}
+
+		case eBSONType::DB_POINTER:
+		{
+			std::string reference;
+			_readBSONString( source, reference );
+			JsonValue objectId = _readBSONObjectId( source );
+			return JsonValue( ObjectType { { "$dbPointer", JsonValue( ObjectType {
+				{ "$ref", std::move( reference ) }, { "$id", std::move( objectId ) } } ) } } );
+		}
 
-					default:
-						return false;
-				}
+		case eBSONType::JAVASCRIPT:
+		case eBSONType::SYMBOL:
+		{
+			std::string text;
+			_readBSONString( source, text );
+			return JsonValue( ObjectType { { ( eBSONType::JAVASCRIPT == type ) ? "$code" : "$symbol", std::move( text ) } } );
+		}
 
-				// If we get to here, then the JsonValue
-				// is clearly in an invalid state.
-				return false;
+		case eBSONType::TIMESTAMP:
+		{
+			const uint64_t timestamp = _readBSONInteger( source, 8 );
+			JsonValue time;
+			JsonValue increment;
+			time._setUnsigned( timestamp >> 32 );
+			increment._setUnsigned( timestamp & 0xFFFFFFFF );
+			return JsonValue( ObjectType { { "$timestamp", JsonValue( ObjectType {
+				{ "t", std::move( time ) }, { "i", std::move( increment ) } } ) } } );
+		}
 
-			case Type::boolean:
-				return mBoolean;
+		case eBSONType::DECIMAL128:
+		{
+			const uint64_t low = _readBSONInteger( source, 8 );
+			const uint64_t high = _readBSONInteger( source, 8 );
+			return JsonValue( ObjectType { { "$numberDecimal", _decimal128ToString( low, high ) } } );
+		}
 
-			default:
-				return false;
+		case eBSONType::MIN_KEY:
+		case eBSONType::MAX_KEY:
+		{
+			JsonValue key( Type::object );
+			key.mMembers[ ( eBSONType::MIN_KEY == type ) ? "$minKey" : "$maxKey" ]._setUnsigned( 1 );
+			return key;
 		}
 
-		return false;
+		default:
+			throw ParseError( "fromBSON", source );
+		}
 	}
 
-	/**
-	 * Cast the JsonValue to a string.
-	 */
-	operator std::string() const
+	// Read JavaScript code with a scope document nested {@param depth} levels deep into this instance.
+	void _readBSONCodeWithScope( ParseSource& source, size_t depth )
 	{
-#ifdef INCLUDE_GMP
-		mp_exp_t exponent;
-		char* cstring = nullptr;
-		void ( *freeFunction )( void*, size_t );
-#endif
-		std::string returnString;
+		const uint64_t start = source.position();
+		const uint32_t length = _readBSONLength( source, 14 );
+		std::string code;
+		JsonValue scope;
+		_readBSONString( source, code );
+		scope._readBSONDocument( source, false, nullptr, depth );
+
+		if ( ( source.position() - start ) != length )
+		{
+			throw ParseError( "fromBSON", source );
+		}
 
-		switch ( mType )
+		*this = JsonValue( ObjectType { { "$code", std::move( code ) }, { "$scope", std::move( scope ) } } );
+	}
+
+	// Read a value of the given type, nested {@param depth} levels deep, into this instance. If
+	// {@param projection} is set, only the parts of a document on the paths of its pointers are read.
+	void _readBSONValue( ParseSource& source, eBSONType type, const std::vector< const Pointer* >* projection, size_t depth )
+	{
+		switch ( type )
 		{
-		case Type::object:
-			returnString = std::string( "[object Object]" );
+		case eBSONType::DOUBLE:
+		{
+			const uint64_t bits = _readBSONInteger( source, 8 );
+			double doublePrecision;
+			std::memcpy( &doublePrecision, &bits, sizeof( doublePrecision ) );
+			mType = Type::number;
+			mNumericType = eNumberType::FLOATING;
+			mNumericValue.floatValue = doublePrecision;
 			break;
+		}
 
-		case Type::array:
-			if ( 0 < mElements.size() )
-			{
-				returnString = std::string( mElements[ 0 ] );
-				for ( size_t index( 0 ); ++index < mElements.size(); )
-				{
-					returnString.append( "," ).append( std::string( mElements[ index ] ) );
-				}
-			}
+		case eBSONType::STRING:
+			mType = Type::string;
+			_readBSONString( source, mStringValue );
 			break;
 
-		case Type::string:
-			returnString = mStringValue;
+		case eBSONType::DOCUMENT:
+		case eBSONType::ARRAY:
+			_readBSONDocument( source, eBSONType::ARRAY == type, projection, depth );
 			break;
 
-		case Type::number:
-			switch ( mNumericType )
+		case eBSONType::UNDEFINED:
+			mType = Type::undefined;
+			break;
+
+		case eBSONType::BOOLEAN:
+		{
+			const uint64_t boolean = _readBSONInteger( source, 1 );
+			if ( 1 < boolean )
 			{
-			case eNumberType::FLOATING:
-				returnString = std::to_string( mNumericValue.floatValue );
-				break;
+				throw ParseError( "fromBSON", source );
+			}
 
-			case eNumberType::SIGNED_INTEGRAL:
-				returnString = std::to_string( mNumericValue.signedIntegral );
-				break;
+			mType = Type::boolean;
+			mBoolean = 1 == boolean;
+			break;
+		}
 
-			case eNumberType::UNSIGNED_INTEGRAL:
-				returnString = std::to_string( mNumericValue.unsignedIntegral );
-				break;
+		case eBSONType::NULL_VALUE:
+			mType = Type::null;
+			break;
 
-#ifdef INCLUDE_GMP
-			case eNumberType::MULTIPLE_PRECISION_FLOAT:
-				mp_get_memory_functions( nullptr, nullptr, &freeFunction );
-				cstring = mpz_get_str( nullptr, 10, mNumericValue.MPFloatValue );
-				returnString = std::string( cstring );
-				freeFunction( cstring, strlen( cstring ) + 1 );
-				cstring = nullptr;
-				break;
+		case eBSONType::JAVASCRIPT_WITH_SCOPE:
+			_readBSONCodeWithScope( source, depth );
+			break;
 
-			case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
-				mp_get_memory_functions( nullptr, nullptr, &freeFunction );
-				cstring = mpf_get_str( nullptr, &exponent, 10, 0, mNumericValue.MPIntegralValue );
-				if ( 0 == strlen( cstring ) )
-				{
-					returnString = std::string( "0.0" );
-				}
-				else
-				{
-					// This is going to be fairly complicated.
-				}
-				freeFunction( cstring, strlen( cstring ) + 1 );
-				cstring = nullptr;
-				break;
-#endif
-			}
+		case eBSONType::INT32:
+			mType = Type::number;
+			mNumericType = eNumberType::SIGNED_INTEGRAL;
+			mNumericValue.signedIntegral = int32_t( uint32_t( _readBSONInteger( source, 4 ) ) );
 			break;
 
-		case Type::boolean:
-			returnString = std::string( ( mBoolean ) ? "true" : "false" );
+		case eBSONType::INT64:
+			mType = Type::number;
+			mNumericType = eNumberType::SIGNED_INTEGRAL;
+			mNumericValue.signedIntegral = int64_t( _readBSONInteger( source, 8 ) );
 			break;
 
-		case Type::null:
-			returnString = std::string( "null" );
+		default:
+			*this = _readBSONExtendedValue( source, type );
 			break;
 		}
-
-		return returnString;
 	}
 
-	/**
-	 * Cast the JsonValue to an ArithmeticType value.
-	 */
-	template < typename ArithmeticType,
-		typename = typename std::enable_if< std::is_arithmetic< ArithmeticType >::value >::type >
-	operator ArithmeticType() const
+	// Read a document, or an array stored as a document, into this instance. Its nesting
+	// {@param depth} is also the token of the pointers in {@param projection} its keys are
+	// matched against, and elements off the path of every pointer are skipped by their lengths.
+	void _readBSONDocument( ParseSource& source, bool isArray, const std::vector< const Pointer* >* projection, size_t depth )
 	{
-		switch ( mType )
+		if ( DECODER_NESTING_DEPTH < depth )
 		{
-		case Type::object:
-		case Type::array:
-		case Type::string:
-		case Type::number:
-		case Type::boolean:
-			return ArithmeticType( mBoolean );
-
-		case Type::null:
-			return ArithmeticType( 0 );
+			throw ParseError( "fromBSON", source );
 		}
 
-		// Something
-	}
+		const uint64_t start = source.position();
+		const uint32_t length = _readBSONLength( source, 5 );
+		std::vector< const Pointer* > matched;
+		std::string key;
 
-	/**
-	 * Cast the JsonValue to an ObjectType.
-	 */
-	operator ObjectType() const
-	{
-	}
+		mType = isArray ? Type::array : Type::object;
 
-	/**
-	 * Cast the JsonValue to an ArrayType.
-	 */
-	operator ArrayType() const
-	{
-	}
+		for ( eBSONType type = eBSONType( _readBSONInteger( source, 1 ) ); eBSONType::END != type; type = eBSONType( _readBSONInteger( source, 1 ) ) )
+		{
+			key.clear();
+			_readBSONCString( source, key );
 
-	/**
-	 * Parse a JsonValue from the given FILE object to this instance.
-	 * @param jsonFile A pointer to a FILE object from whence to parse the JSON from.
-	 * @throw ParseError is thrown if there is a parsing error.
-	 */
-	void parse( FILE* jsonFile )
-	{
-		this->clear();
-		ParseSource source( jsonFile );
-		_parseValue( source );
-	}
+			bool isWhole = nullptr == projection;
+			size_t index = mElements.size();
+			matched.clear();
 
-	/**
-	 * Parse a JsonValue from the given std::ifstream to this instance.
-	 * @param jsonIFStream A reference to the std::ifstream to parse the JSON from.
-	 * @throw ParseError is thrown if there is a parsing error.
-	 */
-	void parse( std::ifstream& jsonIFStream )
-	{
-		this->clear();
-		ParseSource source( jsonIFStream );
-		_parseValue( source );
+			if ( nullptr != projection )
+			{
+				for ( const Pointer* pointer : *projection )
+				{
+					const Pointer::Token& token = ( *pointer )[ depth ];
+					if ( token.key == key )
+					{
+						index = token.isIndex ? token.index : index;
+						isWhole = isWhole or ( pointer->size() == ( depth + 1 ) );
+						matched.push_back( pointer );
+					}
+				}
+			}
+
+			// Deeper paths can only be followed into documents and arrays.
+			if ( not isWhole and ( matched.empty() or ( ( eBSONType::DOCUMENT != type ) and ( eBSONType::ARRAY != type ) ) ) )
+			{
+				_skipBSONValue( source, type );
+				continue;
+			}
+
+			JsonValue* value;
+			if ( isArray )
+			{
+				// Projected elements keep their positions, with the skipped ones left undefined.
+				if ( mElements.size() <= index )
+				{
+					// Every element takes at least three bytes, which bounds any real position.
+					if ( length < index )
+					{
+						throw ParseError( "fromBSON", source );
+					}
+
+					mElements.resize( index + 1 );
+				}
+
+				value = &mElements[ index ];
+			}
+			else
+			{
+				value = &mMembers[ key ];
+			}
+
+			value->clear();
+			value->_readBSONValue( source, type, isWhole ? nullptr : &matched, depth + 1 );
+		}
+
+		if ( ( source.position() - start ) != length )
+		{
+			throw ParseError( "fromBSON", source );
+		}
 	}
 
-	/**
-	 * Parse a JsonValue from the given string an assign to this instance.
-	 * @param jsonString A string object containing the JSON to be parsed.
-	 * @throw ParseError is thrown if there is a parsing error.
-	 */
-	void parse( const std::string& jsonString )
+	// Read a BSON document from the source into this instance, limited to {@param projection}.
+	void _readBSON( ParseSource& source, const std::vector< Pointer >& projection )
 	{
-		this->clear();
-		ParseSource source( jsonString );
-		_parseValue( source );
+		std::vector< const Pointer* > pointers;
+		bool isWhole = projection.empty();
+
+		for ( const auto& pointer : projection )
+		{
+			isWhole = isWhole or pointer.empty();
+			pointers.push_back( &pointer );
+		}
+
+		_readBSONDocument( source, false, isWhole ? nullptr : &pointers, 0 );
 	}
 
-	/**
-	 * Length of the JsonValue, assuming the type is: object, array, or string.
-	 * @return Length of the JsonValue.
-	 * @throw An exception is thrown if the JsonValue is not an object, array, or string.
-	 */
-	size_t size() const
+	// Payload width of the fixed width numeric UBJSON and BJData markers, or 0 for other markers.
+	static size_t _getUBJSONWidth( uint8_t marker, bool isBJData ) noexcept
 	{
-		switch ( mType )
+		switch ( eUBJSONMarker( marker ) )
 		{
-		case Type::object:
-			return mMembers.size();
+		case eUBJSONMarker::INT8:
+		case eUBJSONMarker::UINT8:
+			return 1;
 
-		case Type::array:
-			return mElements.size();
+		case eUBJSONMarker::INT16:
+			return 2;
 
-		case Type::string:
-			return mStringValue.size();
-		}
+		case eUBJSONMarker::INT32:
+		case eUBJSONMarker::FLOAT32:
+			return 4;
 
-		throw std::runtime_error( "Operation 'size()' is not defined for type: " + _getTypeString() );
-	}
+		case eUBJSONMarker::INT64:
+		case eUBJSONMarker::FLOAT64:
+			return 8;
 
-	/**
-	 * Generate the string representation of this JsonValue.
-	 * By default, the dense representation is generated. If a beautified,
-	 * or human readable, version is desired, then the indent can be set to
-	 * use tabs or spaces. The indentLevel is by default set to 4 for spaces.
-	 * @param indent The character to use for indentation. [default: Indent:NONE]
-	 * @param indentationLevel This parameter is only used if {@param indent} is set
-	 *                         to Indent::SPACE, in which case it is the number of space
-	 *                         characters used for each level of indentation. [default: 4]
-	 * @return The string representation of this JsonValue is returned.
-	 */
-	std::string stringify( Indent indent = Indent::NONE, size_t indentLevel = 4 ) const
-	{
-		std::string jsonString;
-		JsonSink sink( jsonString, indent, indentLevel );
-		_writeJSON( *this, sink );
-		return jsonString;
+		case eUBJSONMarker::BYTE:
+			return isBJData ? 1 : 0;
+
+		case eUBJSONMarker::FLOAT16:
+		case eUBJSONMarker::UINT16:
+			return isBJData ? 2 : 0;
+
+		case eUBJSONMarker::UINT32:
+			return isBJData ? 4 : 0;
+
+		case eUBJSONMarker::UINT64:
+			return isBJData ? 8 : 0;
+
+		default:
+			return 0;
+		}
 	}
 
-	/**
-	 * Retrieve the type of the JsonValue.
-	 * @return Return the type of the JsonValue.
-	 */
-	Type type() const noexcept
+	// Write {@param width} bytes of {@param bits} to {@param bytes}, big endian for UBJSON and little endian for BJData.
+	static void _storeUBJSONBits( char* bytes, uint64_t bits, size_t width, bool isBJData ) noexcept
 	{
-		return mType;
+		for ( size_t position( 0 ); position < width; ++position )
+		{
+			bytes[ isBJData ? position : ( width - 1 - position ) ] = char( bits >> ( 8 * position ) );
+		}
 	}
 
-	/**
-	 * Get a string representation of the type.
-	 * @return Return a string representation of the JsonValue type.
-	 */
-	const std::string& typeString() const
+	// Read {@param width} bytes from {@param bytes}, big endian for UBJSON and little endian for BJData.
+	static uint64_t _loadUBJSONBits( const char* bytes, size_t width, bool isBJData ) noexcept
 	{
-		return _getTypeString();
-	}
+		uint64_t bits = 0;
+		for ( size_t position( 0 ); position < width; ++position )
+		{
+			bits = ( bits << 8 ) | uint8_t( bytes[ isBJData ? ( width - 1 - position ) : position ] );
+		}
 
-private:
+		return bits;
+	}
 
-	// Initialize our variables
-	void _initPrimitiveVariables( Type type )
+	// Write a marker followed by {@param width} bytes of {@param bits}.
+	static void _writeUBJSONMarker( JsonSink& sink, eUBJSONMarker marker, uint64_t bits, size_t width, bool isBJData )
 	{
-		mType = type;
-		mBoolean = false;
-		mNumericType = eNumberType::NONE;
-		std::memset( &mNumericValue, 0, sizeof( mNumericValue ) );
+		char buffer[ 9 ];
+		buffer[ 0 ] = char( marker );
+		_storeUBJSONBits( buffer + 1, bits, width, isBJData );
+		sink.append( buffer, 1 + width );
 	}
 
-	// Copy from other into this instance
-	void _copyAssign( const JsonValue& other )
+	// Select the narrowest integer marker that holds the value exactly. Returns the
+	// high precision marker for unsigned values beyond int64, which UBJSON cannot hold.
+	static eUBJSONMarker _selectUBJSONInteger( bool isNegative, uint64_t bits, bool isBJData ) noexcept
 	{
-		mType = other.mType;
-		mStringValue = other.mStringValue;
-		mElements = other.mElements;
-		mMembers = other.mMembers;
-		mBoolean = other.mBoolean;
-		mNumericType = other.mNumericType;
+		const int64_t value = int64_t( bits );
 
-		switch ( mNumericType )
+		if ( isNegative )
 		{
-		case eNumberType::FLOATING:
-		case eNumberType::SIGNED_INTEGRAL:
-		case eNumberType::UNSIGNED_INTEGRAL:
-			std::memcpy( &mNumericValue, &other.mNumericValue, sizeof( mNumericValue ) );
-			break;
-#ifdef INCLUDE_GMP
-		case eNumberType::MULTIPLE_PRECISION_FLOAT:
-			mpf_init_set( mMPFloatValue, other.mMPFloatValue );
-			break;
-		case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
-			mpz_init_set( mMPIntegralValue, other.mMPIntegralValue );
-			break;
-#endif
-		default:
-			std::memset( &mNumericValue, 0, sizeof( mNumericValue ) );
-			break;
+			return ( INT8_MIN <= value ) ? eUBJSONMarker::INT8
+				: ( ( INT16_MIN <= value ) ? eUBJSONMarker::INT16
+				: ( ( INT32_MIN <= value ) ? eUBJSONMarker::INT32 : eUBJSONMarker::INT64 ) );
 		}
-	}
 
-	// Move other instance into this instance
-	void _moveAssign( JsonValue&& other )
-	{
-		mType = std::exchange( other.mType, Type::undefined );
-		mStringValue = std::move( other.mStringValue );
-		mElements = std::move( other.mElements );
-		mMembers = std::move( other.mMembers );
-		mBoolean = std::exchange( other.mBoolean, false );
-		mNumericType = std::exchange( other.mNumericType, eNumberType::NONE );
+		if ( bits <= 0xFF )
+		{
+			return ( bits <= 0x7F ) ? eUBJSONMarker::INT8 : eUBJSONMarker::UINT8;
+		}
 
-		// We don't need to worry about the numeric type because, regardless
-		// of the type, if we copy the complete byte representation and
-		// then zero the bytes for mNumericValue in other, then we can be sure
-		// that there is only one set of the bytes between the 2 objects.
-		// If there are any pointers in the GMP objects, then they will be
-		// released by this object and not by other.
-		std::memcpy( &mNumericValue, &other.mNumericValue, sizeof( mNumericValue ) );
-		std::memset( &other.mNumericValue, 0, sizeof( mNumericValue ) );
+		if ( isBJData )
+		{
+			return ( bits <= 0x7FFF ) ? eUBJSONMarker::INT16
+				: ( ( bits <= 0xFFFF ) ? eUBJSONMarker::UINT16
+				: ( ( bits <= 0x7FFFFFFF ) ? eUBJSONMarker::INT32
+				: ( ( bits <= 0xFFFFFFFF ) ? eUBJSONMarker::UINT32
+				: ( ( bits <= uint64_t( INT64_MAX ) ) ? eUBJSONMarker::INT64 : eUBJSONMarker::UINT64 ) ) ) );
+		}
+
+		return ( bits <= 0x7FFF ) ? eUBJSONMarker::INT16
+			: ( ( bits <= 0x7FFFFFFF ) ? eUBJSONMarker::INT32
+			: ( ( bits <= uint64_t( INT64_MAX ) ) ? eUBJSONMarker::INT64 : eUBJSONMarker::HIGH_PRECISION ) );
 	}
 
-	// Get the type as a string
-	const std::string& _getTypeString() const
+	// Write an integer in the narrowest form that holds it exactly.
+	static void _writeUBJSONInteger( JsonSink& sink, bool isNegative, uint64_t bits, bool isBJData )
 	{
-		static const std::map< JsonValue::Type, std::string > TYPE_STRING_MAP
+		const eUBJSONMarker marker = _selectUBJSONInteger( isNegative, bits, isBJData );
+
+		if ( eUBJSONMarker::HIGH_PRECISION == marker )
 		{
-			{ Type::object,    "object"    },
-			{ Type::array,     "array"     },
-			{ Type::string,    "string"    },
-			{ Type::number,    "number"    },
-			{ Type::boolean,   "boolean"   },
-			{ Type::null,      "null"      },
-			{ Type::undefined, "undefined" }
-		};
+			_writeUBJSONHighPrecision( sink, std::to_string( bits ), isBJData );
+			return;
+		}
 
-		return TYPE_STRING_MAP.at( mType );
+		_writeUBJSONMarker( sink, marker, bits, _getUBJSONWidth( uint8_t( marker ), isBJData ), isBJData );
 	}
 
-	union
+	// Write a high precision number from its decimal text.
+	static void _writeUBJSONHighPrecision( JsonSink& sink, const std::string& text, bool isBJData )
 	{
-		long double floatValue;      // The parsed number is floating.
-		intmax_t signedIntegral;     // The parsed number is signed.
-		uintmax_t unsignedIntegral;  // The parsed number is unsigned.
-#ifdef INCLUDE_GMP
-		mpz_t MPIntegralValue;      // Store the number as a multi-precision integral.
-		mpf_t MPFloatValue;         // Store the number as a multi-precision floating.
-#endif
+		const char marker = char( eUBJSONMarker::HIGH_PRECISION );
+		sink.append( &marker, 1 );
+		_writeUBJSONInteger( sink, false, text.length(), isBJData );
+		sink.append( text.data(), text.length() );
 	}
-	mNumericValue;             // Anonymous union for holding numeric values.
-	Type mType;                // Type of this JsonValue.
-	eNumberType mNumericType;  // The best representation of mValue.
-	std::string mStringValue;  // Variable for holding string, non-mp numbers.
-	ArrayType mElements;       // Array of JsonValues.
-	ObjectType mMembers;       // Mapping of JsonValues.
-	bool mBoolean;             // Store the boolean value here.
 
-	// Just skip over any whitespace
-	void _parseWhitespace( ParseSource& source )
+	// Write a floating number as a float 32 if that is exact, else as a float 64.
+	static void _writeUBJSONFloat( JsonSink& sink, long double value, bool isBJData )
 	{
-		const char STRING_WHITESPACE[] = " \r\n\t";
-		while ( ( not source.endOfSource() )
-			and ( nullptr != strchr( STRING_WHITESPACE, source.peek() ) ) )
+		const float singlePrecision = float( value );
+		if ( ( value == static_cast< long double >( singlePrecision ) ) or std::isnan( value ) )
 		{
-			source.update();
+			uint32_t bits;
+			std::memcpy( &bits, &singlePrecision, sizeof( bits ) );
+			_writeUBJSONMarker( sink, eUBJSONMarker::FLOAT32, bits, 4, isBJData );
+			return;
 		}
+
+		const double doublePrecision = double( value );
+		uint64_t bits;
+		std::memcpy( &bits, &doublePrecision, sizeof( bits ) );
+		_writeUBJSONMarker( sink, eUBJSONMarker::FLOAT64, bits, 8, isBJData );
 	}
 
-	// Parse a string
-	void _parseString( ParseSource& source )
+	// Write an array of numbers as a strongly typed container, [$<type>#<count>, of the narrowest
+	// type that holds every element, followed by the packed elements without markers. Returns
+	// false if the elements are not all integral or all floating, in which case nothing is written.
+	bool _writeUBJSONTypedArray( JsonSink& sink, bool isBJData ) const
 	{
-		const char STRING_ESCAPE_CHARACTER[] = "\"\\/bfnrtu";
+		bool isIntegral = true;
+		bool isFloating = true;
+		bool isSinglePrecision = true;
+		uintmax_t maximum = 0;
+		intmax_t minimum = 0;
 
-		if ( '"' != source.peek() )
+		for ( const auto& element : mElements )
 		{
-			throw ParseError( "parseString", source );
+			if ( Type::number != element.mType )
+			{
+				return false;
+			}
+
+			switch ( element.mNumericType )
+			{
+			case eNumberType::SIGNED_INTEGRAL:
+				isFloating = false;
+				minimum = std::min( minimum, element.mNumericValue.signedIntegral );
+				maximum = std::max( maximum, uintmax_t( std::max< intmax_t >( 0, element.mNumericValue.signedIntegral ) ) );
+				break;
+
+			case eNumberType::UNSIGNED_INTEGRAL:
+				isFloating = false;
+				maximum = std::max( maximum, element.mNumericValue.unsignedIntegral );
+				break;
+
+			case eNumberType::FLOATING:
+				isIntegral = false;
+				isSinglePrecision = isSinglePrecision
+					and ( ( element.mNumericValue.floatValue == static_cast< long double >( float( element.mNumericValue.floatValue ) ) )
+						or std::isnan( element.mNumericValue.floatValue ) );
+				break;
+
+			default:
+				return false;
+			}
 		}
 
-		source.update();
-		uint32_t stringLength = 0;
-		while ( ( not source.endOfSource() ) and ( '"' != source.peek( stringLength ) ) )
+		if ( mElements.empty() or not ( isIntegral or isFloating ) or ( ( minimum < 0 ) and ( uintmax_t( INT64_MAX ) < maximum ) ) )
+		{
+			return false;
+		}
+
+		eUBJSONMarker marker = isSinglePrecision ? eUBJSONMarker::FLOAT32 : eUBJSONMarker::FLOAT64;
+		if ( isIntegral and ( minimum < 0 ) )
+		{
+			marker = ( ( INT8_MIN <= minimum ) and ( maximum <= INT8_MAX ) ) ? eUBJSONMarker::INT8
+				: ( ( ( INT16_MIN <= minimum ) and ( maximum <= INT16_MAX ) ) ? eUBJSONMarker::INT16
+				: ( ( ( INT32_MIN <= minimum ) and ( maximum <= INT32_MAX ) ) ? eUBJSONMarker::INT32 : eUBJSONMarker::INT64 ) );
+		}
+		else if ( isIntegral )
 		{
-			if ( '\\' == source.peek( stringLength ) )
+			marker = _selectUBJSONInteger( false, maximum, isBJData );
+			if ( eUBJSONMarker::HIGH_PRECISION == marker )
 			{
-				++stringLength;
+				return false;
+			}
+		}
 
-				if ( nullptr == strchr( STRING_ESCAPE_CHARACTER, source.peek( stringLength ) ) )
-				{
-					throw ParseError( "parseString", source, stringLength );
-				}
+		const size_t width = _getUBJSONWidth( uint8_t( marker ), isBJData );
+		const char header[ 3 ] = { char( eUBJSONMarker::ARRAY_START ), char( eUBJSONMarker::TYPE ), char( marker ) };
+		const char count = char( eUBJSONMarker::COUNT );
+		sink.append( header, 3 );
+		sink.append( &count, 1 );
+		_writeUBJSONInteger( sink, false, mElements.size(), isBJData );
+
+		// Pack every element first, so the payload goes out to the sink in one piece.
+		std::string bytes( mElements.size() * width, '\0' );
+		char* byte = &bytes[ 0 ];
+		for ( const auto& element : mElements )
+		{
+			uint64_t bits = 0;
 
-				if ( 'u' == source.peek( stringLength ) )
-				{
-					if ( isxdigit( source.peek( stringLength + 1 ) ) and isxdigit( source.peek( stringLength + 2 ) )
-						and isxdigit( source.peek( stringLength + 3 ) ) and isxdigit( source.peek( stringLength + 4 ) ) )
-					{
-						stringLength += 5;
-					}
-					else
-					{
-						throw ParseError( "parseString", source, stringLength );
-					}
-				}
-				else
-				{
-					++stringLength;
-				}
+			if ( isFloating and ( 4 == width ) )
+			{
+				const float singlePrecision = float( element.mNumericValue.floatValue );
+				uint32_t singleBits;
+				std::memcpy( &singleBits, &singlePrecision, sizeof( singleBits ) );
+				bits = singleBits;
 			}
-			else if ( ( '\0' <= source.peek( stringLength ) ) and ( source.peek( stringLength ) < ' ' ) )
+			else if ( isFloating )
 			{
-				throw ParseError( "parseString", source, stringLength );
+				const double doublePrecision = double( element.mNumericValue.floatValue );
+				std::memcpy( &bits, &doublePrecision, sizeof( bits ) );
 			}
 			else
 			{
-				++stringLength;
+				bits = ( eNumberType::SIGNED_INTEGRAL == element.mNumericType )
+					? uint64_t( element.mNumericValue.signedIntegral ) : uint64_t( element.mNumericValue.unsignedIntegral );
 			}
-		}
 
-		if ( '"' != source.peek( stringLength ) )
-		{
-			throw ParseError( "parseString", source, stringLength );
+			_storeUBJSONBits( byte, bits, width, isBJData );
+			byte += width;
 		}
 
-		source.copy( mStringValue, stringLength );
-		source.update( stringLength + 1 );
-		mType = Type::string;
+		sink.append( bytes.data(), bytes.length() );
+		return true;
 	}
 
-	// Parse a number
-	void _parseNumber( ParseSource& source )
+	// Write this JsonValue out to the given sink as UBJSON, or as BJData if {@param isBJData} is set.
+	void _writeUBJSON( JsonSink& sink, bool isBJData ) const
 	{
-		// TODO: Implement
-	}
+		const char countMarker = char( eUBJSONMarker::COUNT );
 
-	// Parse an array
-	void _parseArray( ParseSource& source )
-	{
-		if ( '[' != source.peek() )
+		switch ( mType )
 		{
-			throw ParseError( "parseArray", source );
+		case Type::object:
+		{
+			const char objectStart = char( eUBJSONMarker::OBJECT_START );
+			sink.append( &objectStart, 1 );
+			sink.append( &countMarker, 1 );
+			_writeUBJSONInteger( sink, false, mMembers.size(), isBJData );
+
+			for ( const auto& member : mMembers )
+			{
+				_writeUBJSONInteger( sink, false, member.first.length(), isBJData );
+				sink.append( member.first.data(), member.first.length() );
+				member.second._writeUBJSON( sink, isBJData );
+			}
+			break;
 		}
 
-		source.update();
-		_parseWhitespace( source );
-		while ( ( not source.endOfSource() ) and ( ']' != source.peek() ) )
+		case Type::array:
+			if ( not _writeUBJSONTypedArray( sink, isBJData ) )
+			{
+				const char arrayStart = char( eUBJSONMarker::ARRAY_START );
+				sink.append( &arrayStart, 1 );
+				sink.append( &countMarker, 1 );
+				_writeUBJSONInteger( sink, false, mElements.size(), isBJData );
+
+				for ( const auto& element : mElements )
+				{
+					element._writeUBJSON( sink, isBJData );
+				}
+			}
+			break;
+
+		case Type::string:
 		{
-			mElements.push_back( JsonValue( Type::undefined, source ) );
+			const char stringMarker = char( eUBJSONMarker::STRING );
+			sink.append( &stringMarker, 1 );
+			_writeUBJSONInteger( sink, false, mStringValue.length(), isBJData );
+			sink.append( mStringValue.data(), mStringValue.length() );
+			break;
+		}
 
-			if ( ',' == source.peek() )
+		case Type::number:
+			switch ( mNumericType )
 			{
-				source.update();
-			}
-			else if ( ']' != source.peek() )
+			case eNumberType::SIGNED_INTEGRAL:
+				_writeUBJSONInteger( sink, mNumericValue.signedIntegral < 0, uint64_t( mNumericValue.signedIntegral ), isBJData );
+				break;
+
+			case eNumberType::UNSIGNED_INTEGRAL:
+				_writeUBJSONInteger( sink, false, uint64_t( mNumericValue.unsignedIntegral ), isBJData );
+				break;
+
+			case eNumberType::FLOATING:
+				_writeUBJSONFloat( sink, mNumericValue.floatValue, isBJData );
+				break;
+
+#ifdef INCLUDE_GMP
+			case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
 			{
-				throw ParseError( "parseArray", source );
+				std::string text( mpz_sizeinbase( mNumericValue.MPIntegralValue, 10 ) + 2, '\0' );
+				mpz_get_str( &text[ 0 ], 10, mNumericValue.MPIntegralValue );
+				text.resize( strlen( text.c_str() ) );
+				_writeUBJSONHighPrecision( sink, text, isBJData );
+				break;
+			}
+
+			case eNumberType::MULTIPLE_PRECISION_FLOAT:
+				_writeUBJSONFloat( sink, mpf_get_d( mNumericValue.MPFloatValue ), isBJData );
+				break;
+#endif
+
+			default:
+				throw std::runtime_error( "Cannot encode an unresolved number as UBJSON" );
 			}
+			break;
+
+		case Type::boolean:
+		{
+			const char boolean = char( mBoolean ? eUBJSONMarker::TRUE_VALUE : eUBJSONMarker::FALSE_VALUE );
+			sink.append( &boolean, 1 );
+			break;
 		}
 
-		if ( ']' != source.peek() )
+		case Type::null:
+		case Type::undefined:
 		{
-			source.update();
-			throw ParseError( "parseArray", source );
+			const char null = char( eUBJSONMarker::NULL_VALUE );
+			sink.append( &null, 1 );
+			break;
 		}
-		else
+		}
+	}
+
+	// Read a single marker byte.
+	static uint8_t _readUBJSONMarker( ParseSource& source )
+	{
+		if ( not source.available( 1 ) )
 		{
-			source.update();
+			throw ParseError( "fromUBJSON", source );
 		}
 
-		mType = Type::array;
+		const uint8_t marker = uint8_t( source.peek() );
+		source.update();
+		return marker;
 	}
 
-	// Parse an object
-	void _parseObject( ParseSource& source )
+	// Read the {@param width} byte payload of a fixed width number.
+	static uint64_t _readUBJSONBits( ParseSource& source, size_t width, bool isBJData )
 	{
-		if ( '{' != source.peek() )
+		char bytes[ 8 ];
+		for ( size_t position( 0 ); position < width; ++position )
 		{
-			throw ParseError( "parseObject", source );
+			bytes[ position ] = char( _readUBJSONMarker( source ) );
 		}
 
-		source.update();
-		_parseWhitespace( source );
-		while ( ( not source.endOfSource() ) and ( '}' != source.peek() ) )
+		return _loadUBJSONBits( bytes, width, isBJData );
+	}
+
+	// Make this JsonValue the number of the fixed width {@param marker} held in {@param bits}.
+	void _setUBJSONNumber( uint8_t marker, uint64_t bits ) noexcept
+	{
+		mType = Type::number;
+
+		switch ( eUBJSONMarker( marker ) )
 		{
-			JsonValue key( Type::string, source );
+		case eUBJSONMarker::INT8:
+			mNumericType = eNumberType::SIGNED_INTEGRAL;
+			mNumericValue.signedIntegral = int8_t( bits );
+			break;
 
-			if ( ':' != source.peek() )
-			{
-				throw ParseError( "parseObject", source );
-			}
+		case eUBJSONMarker::INT16:
+			mNumericType = eNumberType::SIGNED_INTEGRAL;
+			mNumericValue.signedIntegral = int16_t( bits );
+			break;
 
-			source.update();
-			mMembers[ std::string( key ) ] = JsonValue( Type::undefined, source );
+		case eUBJSONMarker::INT32:
+			mNumericType = eNumberType::SIGNED_INTEGRAL;
+			mNumericValue.signedIntegral = int32_t( bits );
+			break;
 
-			if ( ',' == source.peek() )
-			{
-				source.update();
-			}
-			else if ( '}' != source.peek() )
-			{
-				throw ParseError( "parseObject", source );
-			}
+		case eUBJSONMarker::INT64:
+			mNumericType = eNumberType::SIGNED_INTEGRAL;
+			mNumericValue.signedIntegral = int64_t( bits );
+			break;
+
+		case eUBJSONMarker::FLOAT16:
+			mNumericType = eNumberType::FLOATING;
+			mNumericValue.floatValue = _halfToLongDouble( uint16_t( bits ) );
+			break;
+
+		case eUBJSONMarker::FLOAT32:
+		{
+			const uint32_t singleBits = uint32_t( bits );
+			float singlePrecision;
+			std::memcpy( &singlePrecision, &singleBits, sizeof( singlePrecision ) );
+			mNumericType = eNumberType::FLOATING;
+			mNumericValue.floatValue = singlePrecision;
+			break;
+		}
+
+		case eUBJSONMarker::FLOAT64:
+		{
+			double doublePrecision;
+			std::memcpy( &doublePrecision, &bits, sizeof( doublePrecision ) );
+			mNumericType = eNumberType::FLOATING;
+			mNumericValue.floatValue = doublePrecision;
+			break;
+		}
+
+		default:
+			// UINT8, BYTE, and the BJData unsigned markers
+			mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+			mNumericValue.unsignedIntegral = bits;
+			break;
 		}
+	}
 
-		if ( '}' != source.peek() )
+	// Read a count or length, which is an integer of any marker that must not be negative.
+	static uint64_t _readUBJSONCount( ParseSource& source, uint8_t marker, bool isBJData )
+	{
+		const size_t width = _getUBJSONWidth( marker, isBJData );
+		if ( ( 0 == width ) or ( eUBJSONMarker::FLOAT16 == eUBJSONMarker( marker ) )
+			or ( eUBJSONMarker::FLOAT32 == eUBJSONMarker( marker ) ) or ( eUBJSONMarker::FLOAT64 == eUBJSONMarker( marker ) ) )
 		{
-			source.update();
-			throw ParseError( "parseObject", source );
+			throw ParseError( "fromUBJSON", source );
 		}
-		else
+
+		JsonValue count;
+		count._setUBJSONNumber( marker, _readUBJSONBits( source, width, isBJData ) );
+		if ( ( eNumberType::SIGNED_INTEGRAL == count.mNumericType ) and ( count.mNumericValue.signedIntegral < 0 ) )
 		{
-			source.update();
+			throw ParseError( "fromUBJSON", source );
 		}
 
-		mType = Type::object;
+		return ( eNumberType::SIGNED_INTEGRAL == count.mNumericType )
+			? uint64_t( count.mNumericValue.signedIntegral ) : uint64_t( count.mNumericValue.unsignedIntegral );
 	}
 
-	// Root of the parser
-	void _parseValue( ParseSource& source )
+	// Read a length prefixed string, as used for strings, keys and high precision numbers.
+	static void _readUBJSONString( ParseSource& source, bool isBJData, std::string& destination )
 	{
-		const char STRING_TRUE[] = "true";
-		const char STRING_FALSE[] = "false";
-		const char STRING_NULL[] = "null";
+		const uint64_t length = _readUBJSONCount( source, _readUBJSONMarker( source ), isBJData );
 
-		_parseWhitespace( source );
-
-		if ( '"' == source.peek() )
+		if ( ( SIZE_MAX < length ) or not source.append( destination, size_t( length ) ) )
 		{
-			_parseString( source );
+			throw ParseError( "fromUBJSON", source );
 		}
-		else if ( ( '-' == source.peek() ) or isdigit( source.peek() ) )
+	}
+
+	// Read a high precision number, held as its decimal text.
+	void _readUBJSONHighPrecision( ParseSource& source, bool isBJData )
+	{
+		std::string text;
+		_readUBJSONString( source, isBJData, text );
+
+		const size_t digits = text.find_first_not_of( '-' );
+		if ( ( 1 < digits ) or text.empty() or ( std::string::npos != text.find_first_not_of( "+-.0123456789Ee" ) )
+			or ( std::string::npos == digits ) or not isdigit( text[ digits ] ) )
 		{
-			_parseNumber( source );
+			throw ParseError( "fromUBJSON", source );
 		}
-		else if ( '{' == source.peek() )
+
+		char* end = nullptr;
+		mType = Type::number;
+		errno = 0;
+
+		if ( std::string::npos == text.find_first_of( ".Ee" ) )
 		{
-			_parseObject( source );
+			if ( '-' == text[ 0 ] )
+			{
+				mNumericType = eNumberType::SIGNED_INTEGRAL;
+				mNumericValue.signedIntegral = strtoll( text.c_str(), &end, 10 );
+			}
+			else
+			{
+				mNumericType = eNumberType::UNSIGNED_INTEGRAL;
+				mNumericValue.unsignedIntegral = strtoull( text.c_str(), &end, 10 );
+			}
+
+#ifdef INCLUDE_GMP
+			if ( ERANGE == errno )
+			{
+				mNumericType = eNumberType::MULTIPLE_PRECISION_INTEGRAL;
+				mpz_init_set_str( mNumericValue.MPIntegralValue, text.c_str(), 10 );
+				return;
+			}
+#endif
 		}
-		else if ( '[' == source.peek() )
+
+		// Without GMP, integers beyond 64 bits are approximated, like fractions, by a long double.
+		if ( ( std::string::npos != text.find_first_of( ".Ee" ) ) or ( ERANGE == errno ) )
 		{
-			_parseArray( source );
+			mNumericType = eNumberType::FLOATING;
+			mNumericValue.floatValue = strtold( text.c_str(), &end );
 		}
-		else if ( source.strncmp( STRING_TRUE, strlen( STRING_TRUE ) ) )
+
+		if ( text.c_str() + text.length() != end )
 		{
-			// Parse a boolean
-			mType = Type::boolean;
-			mBoolean = true;
-			source.update( strlen( STRING_TRUE ) );
+			throw ParseError( "fromUBJSON", source );
 		}
-		else if ( source.strncmp( STRING_FALSE, strlen( STRING_FALSE ) ) )
+	}
+
+	// Read the packed payload of a strongly typed array of a fixed width numeric
+	// {@param marker}. The payload is copied out of the source in one piece and
+	// decoded into elements allocated up front.
+	void _readUBJSONTypedArray( ParseSource& source, uint8_t marker, uint64_t count, bool isBJData )
+	{
+		const size_t width = _getUBJSONWidth( marker, isBJData );
+		std::string bytes;
+
+		if ( ( ( SIZE_MAX / width ) < count ) or not source.append( bytes, size_t( count ) * width ) )
 		{
-			// Parse a boolean
-			mType = Type::boolean;
-			mBoolean = false;
-			source.update( strlen( STRING_FALSE ) );
+			throw ParseError( "fromUBJSON", source );
 		}
-		else if ( source.strncmp( STRING_NULL, strlen( STRING_NULL ) ) )
+
+		mElements.resize( size_t( count ) );
+		const char* byte = bytes.data();
+		for ( auto& element : mElements )
 		{
-			// Parse a null
-			mType = Type::null;
-			source.update( strlen( STRING_NULL ) );
+			element._setUBJSONNumber( marker, _loadUBJSONBits( byte, width, isBJData ) );
+			byte += width;
 		}
-		else
+	}
+
+	// Fold the flat elements of a BJData N-dimensional array into nested arrays, row major.
+	void _reshapeUBJSONArray( const std::vector< uint64_t >& dimensions )
+	{
+		for ( size_t dimension( dimensions.size() - 1 ); 0 < dimension; --dimension )
 		{
-			throw ParseError( "parseValue", source );
-		}
+			const size_t length = size_t( dimensions[ dimension ] );
+			ArrayType rows( ( 0 == length ) ? 0 : ( mElements.size() / length ) );
 
-		_parseWhitespace( source );
+			for ( size_t row( 0 ); row < rows.size(); ++row )
+			{
+				rows[ row ].mType = Type::array;
+				rows[ row ].mElements.assign( std::make_move_iterator( mElements.begin() + ( row * length ) ),
+					std::make_move_iterator( mElements.begin() + ( ( row + 1 ) * length ) ) );
+			}
+
+			mElements.swap( rows );
+		}
 	}
 
-	// Write the given JsonValue out to the given sink.
-	void _writeJSON( const JsonValue& value, JsonSink& sink, size_t level = 0 )
+	// Read an array or object, after its opening marker. Optimized containers declare a
+	// count, which leaves out the closing marker, and may declare a type before it, which
+	// leaves out the marker of every value. Other containers run to their closing marker.
+	void _readUBJSONContainer( ParseSource& source, bool isObject, bool isBJData, size_t depth )
 	{
-		// This string is for use with array and object.
-		std::string indentationPrefix( "\n" );
-
-		if ( JsonValue::Indent::TAB == sink.indentation )
+		if ( DECODER_NESTING_DEPTH < depth )
 		{
-			indentationPrefix.append( level, '\t' );
+			throw ParseError( "fromUBJSON", source );
 		}
 
-		if ( JsonValue::Indent::SPACE == sink.indentation )
+		const uint8_t endMarker = uint8_t( isObject ? eUBJSONMarker::OBJECT_END : eUBJSONMarker::ARRAY_END );
+		std::vector< uint64_t > dimensions;
+		uint8_t valueMarker = 0;
+		uint64_t count = 0;
+		bool isCounted = false;
+		bool isPayloadFree = false;
+		std::string key;
+
+		mType = isObject ? Type::object : Type::array;
+
+		if ( eUBJSONMarker::TYPE == eUBJSONMarker( source.peek() ) )
 		{
-			indentationPrefix.append( level * sink.indentSpaces, ' ' );
+			source.update();
+			valueMarker = _readUBJSONMarker( source );
+
+			// BJData only permits the fixed width types, and a count must follow the type.
+			const bool isFixedWidth = ( 0 != _getUBJSONWidth( valueMarker, isBJData ) ) or ( eUBJSONMarker::CHAR == eUBJSONMarker( valueMarker ) );
+			const bool isVariableWidth = ( eUBJSONMarker::STRING == eUBJSONMarker( valueMarker ) ) or ( eUBJSONMarker::HIGH_PRECISION == eUBJSONMarker( valueMarker ) )
+				or ( eUBJSONMarker::ARRAY_START == eUBJSONMarker( valueMarker ) ) or ( eUBJSONMarker::OBJECT_START == eUBJSONMarker( valueMarker ) );
+			isPayloadFree = ( eUBJSONMarker::NULL_VALUE == eUBJSONMarker( valueMarker ) ) or ( eUBJSONMarker::NO_OP == eUBJSONMarker( valueMarker ) )
+				or ( eUBJSONMarker::TRUE_VALUE == eUBJSONMarker( valueMarker ) ) or ( eUBJSONMarker::FALSE_VALUE == eUBJSONMarker( valueMarker ) );
+			if ( not ( isFixedWidth or ( ( isVariableWidth or isPayloadFree ) and not isBJData ) )
+				or ( eUBJSONMarker::COUNT != eUBJSONMarker( source.peek() ) ) )
+			{
+				throw ParseError( "fromUBJSON", source );
+			}
 		}
 
-		switch ( value.mType )
+		if ( eUBJSONMarker::COUNT == eUBJSONMarker( source.peek() ) )
 		{
-		case JsonValue::Type::object:
-			sink.append( "{" );
+			source.update();
+			isCounted = true;
+			const uint8_t countMarker = _readUBJSONMarker( source );
 
-			if ( 0 < value.mMembers.size() )
+			if ( isBJData and not isObject and ( eUBJSONMarker::ARRAY_START == eUBJSONMarker( countMarker ) ) )
 			{
-				for ( auto iter = value.mMembers.begin(); iter != value.mMembers.end(); ++iter )
-				{
-					if ( JsonValue::Indent::NONE != sink.indentation )
-					{
-						sink.append( indentationPrefix );
-					}
-
-					sink.append( "\"" );
-					sink.append( iter->first );
-					sink.append( "\":" );
+				// An N-dimensional array, counted by the product of its dimensions.
+				JsonValue shape;
+				shape._readUBJSONContainer( source, false, isBJData, depth + 1 );
+				count = shape.mElements.empty() ? 0 : 1;
 
-					if ( JsonValue::Indent::NONE != sink.indentation )
+				for ( const auto& dimension : shape.mElements )
+				{
+					const bool isUnsigned = eNumberType::UNSIGNED_INTEGRAL == dimension.mNumericType;
+					if ( ( Type::number != dimension.mType ) or not ( isUnsigned
+						or ( ( eNumberType::SIGNED_INTEGRAL == dimension.mNumericType ) and ( 0 <= dimension.mNumericValue.signedIntegral ) ) ) )
 					{
-						sink.append( " " );
+						throw ParseError( "fromUBJSON", source );
 					}
 
-					_writeJSON( iter->second, sink, level + 1 );
-
-					if ( value.mMembers.end() != std::next( iter ) )
+					const uint64_t length = isUnsigned ? uint64_t( dimension.mNumericValue.unsignedIntegral ) : uint64_t( dimension.mNumericValue.signedIntegral );
+					if ( ( 0 != length ) and ( ( UINT64_MAX / length ) < count ) )
 					{
-						sink.append( "," );
+						throw ParseError( "fromUBJSON", source );
 					}
-				}
 
-				if ( JsonValue::Indent::NONE != sink.indentation )
-				{
-					sink.append( indentationPrefix );
+					count *= length;
+					dimensions.push_back( length );
 				}
 			}
+			else
+			{
+				count = _readUBJSONCount( source, countMarker, isBJData );
+			}
+		}
 
-			sink.append( "}" );
-			break;
+		if ( isCounted and ( 0 != _getUBJSONWidth( valueMarker, isBJData ) ) and not isObject )
+		{
+			_readUBJSONTypedArray( source, valueMarker, count, isBJData );
+		}
+		else if ( isPayloadFree and not isObject )
+		{
+			// The values take no bytes, so the count alone sizes the array. No-ops are
+			// skipped wherever they appear, which leaves an array of them empty.
+			if ( DECODER_PAYLOAD_FREE_COUNT < count )
+			{
+				throw ParseError( "fromUBJSON", source );
+			}
 
-		case JsonValue::Type::array:
-			sink.append( "[" );
+			if ( eUBJSONMarker::NO_OP != eUBJSONMarker( valueMarker ) )
+			{
+				JsonValue value;
+				value._readUBJSONValue( source, valueMarker, isBJData, depth + 1 );
+				mElements.assign( size_t( count ), value );
+			}
+		}
+		else if ( eUBJSONMarker::NO_OP == eUBJSONMarker( valueMarker ) )
+		{
+			// A member needs a value, which a no-op is not.
+			throw ParseError( "fromUBJSON", source );
+		}
+		else
+		{
+			// Grow as values arrive, so a corrupt count cannot force a huge allocation.
+			mElements.reserve( size_t( isObject ? 0 : std::min< uint64_t >( count, 4096 ) ) );
 
-			if ( 0 < value.mElements.size() )
+			for ( uint64_t position( 0 ); not isCounted or ( position < count ); ++position )
 			{
-				for ( size_t index( -1 ); ++index < value.mElements.size(); )
+				if ( not isCounted )
 				{
-					if ( JsonValue::Indent::NONE != sink.indentation )
+					// No-ops may pad containers that run to their closing marker.
+					while ( eUBJSONMarker::NO_OP == eUBJSONMarker( source.peek() ) )
 					{
-						sink.append( indentationPrefix );
+						source.update();
 					}
 
-					_writeJSON( value.mElements[ index ], sink, level + 1 );
-
-					if ( ( index + 1 ) != value.mElements.size() )
+					if ( endMarker == uint8_t( source.peek() ) )
 					{
-						sink.append( "," );
+						source.update();
+						break;
 					}
 				}
 
-				if ( JsonValue::Indent::NONE != sink.indentation )
+				JsonValue* value;
+				if ( isObject )
+				{
+					key.clear();
+					_readUBJSONString( source, isBJData, key );
+
+					// Like the text parser, the last of any duplicate keys wins.
+					value = &mMembers[ key ];
+					value->clear();
+				}
+				else
+				{
+					mElements.emplace_back();
+					value = &mElements.back();
+				}
+
+				if ( 0 == valueMarker )
+				{
+					value->_readUBJSON( source, isBJData, depth + 1 );
+				}
+				else
 				{
-					sink.append( indentationPrefix );
+					value->_readUBJSONValue( source, valueMarker, isBJData, depth + 1 );
 				}
 			}
+		}
+
+		if ( not dimensions.empty() )
+		{
+			_reshapeUBJSONArray( dimensions );
+		}
+	}
+
+	// Read the value that follows {@param marker} into this instance.
+	void _readUBJSONValue( ParseSource& source, uint8_t marker, bool isBJData, size_t depth )
+	{
+		const size_t width = _getUBJSONWidth( marker, isBJData );
+		if ( 0 < width )
+		{
+			_setUBJSONNumber( marker, _readUBJSONBits( source, width, isBJData ) );
+			return;
+		}
 
-			sink.append( "]" );
+		switch ( eUBJSONMarker( marker ) )
+		{
+		case eUBJSONMarker::NULL_VALUE:
+			mType = Type::null;
 			break;
 
-		case JsonValue::Type::string:
-			sink.append( value.mStringValue );
+		case eUBJSONMarker::TRUE_VALUE:
+		case eUBJSONMarker::FALSE_VALUE:
+			mType = Type::boolean;
+			mBoolean = eUBJSONMarker::TRUE_VALUE == eUBJSONMarker( marker );
 			break;
 
-		case JsonValue::Type::number:
-			char buffer[ 128 ];
-			memset( buffer, 0, sizeof( buffer ) );
+		case eUBJSONMarker::HIGH_PRECISION:
+			_readUBJSONHighPrecision( source, isBJData );
+			break;
 
-			switch ( value.mNumericType )
+		case eUBJSONMarker::CHAR:
+			mType = Type::string;
+			mStringValue.assign( 1, char( _readUBJSONMarker( source ) ) );
+			break;
+
+		case eUBJSONMarker::STRING:
+			mType = Type::string;
+			_readUBJSONString( source, isBJData, mStringValue );
+			break;
+
+		case eUBJSONMarker::ARRAY_START:
+		case eUBJSONMarker::OBJECT_START:
+			_readUBJSONContainer( source, eUBJSONMarker::OBJECT_START == eUBJSONMarker( marker ), isBJData, depth );
+			break;
+
+		default:
+			throw ParseError( "fromUBJSON", source );
+		}
+	}
+
+	// Read a single UBJSON, or BJData if {@param isBJData} is set, value from the source into this instance.
+	void _readUBJSON( ParseSource& source, bool isBJData, size_t depth )
+	{
+		uint8_t marker;
+		do
+		{
+			marker = _readUBJSONMarker( source );
+		}
+		while ( eUBJSONMarker::NO_OP == eUBJSONMarker( marker ) );
+
+		_readUBJSONValue( source, marker, isBJData, depth );
+	}
+
+	// Append a tape node of {@param kind}, with {@param word} as its value.
+	static void _appendTapeNode( std::string& tape, eTapeKind kind, uint64_t word )
+	{
+		const uint64_t node[ 2 ] = { uint64_t( kind ), word };
+		tape.append( reinterpret_cast< const char* >( node ), sizeof( node ) );
+	}
+
+	// Store {@param word} at {@param offset} of the tape, to fill in a reserved slot.
+	static void _storeTapeWord( std::string& tape, size_t offset, uint64_t word ) noexcept
+	{
+		std::memcpy( &tape[ offset ], &word, sizeof( word ) );
+	}
+
+	// Append a string node, its bytes null terminated and padded to a word boundary.
+	static void _appendTapeString( std::string& tape, const std::string& string )
+	{
+		_appendTapeNode( tape, eTapeKind::STRING, string.length() );
+		tape.append( string );
+		tape.append( 8 - ( string.length() % 8 ), '\0' );
+	}
+
+	// Append this JsonValue, and everything below it, to the tape. Containers are followed
+	// by a table of the offsets of their children, filled in as the children are appended;
+	// the members of objects are in key order, so their table can be binary searched.
+	void _writeTape( std::string& tape ) const
+	{
+		switch ( mType )
+		{
+		case Type::object:
+		{
+			_appendTapeNode( tape, eTapeKind::OBJECT, mMembers.size() );
+			size_t slot = tape.length();
+			tape.append( 16 * mMembers.size(), '\0' );
+
+			for ( const auto& member : mMembers )
 			{
-			case eNumberType::FLOATING:
-				snprintf( buffer, sizeof( buffer ), "%.*Le", LDBL_DIG + 3, value.mNumericValue.floatValue );
-				sink.append( std::string( buffer ) );
-				break;
+				_storeTapeWord( tape, slot, tape.length() );
+				_appendTapeString( tape, member.first );
+				_storeTapeWord( tape, slot + 8, tape.length() );
+				member.second._writeTape( tape );
+				slot += 16;
+			}
+			break;
+		}
+
+		case Type::array:
+		{
+			_appendTapeNode( tape, eTapeKind::ARRAY, mElements.size() );
+			size_t slot = tape.length();
+			tape.append( 8 * mElements.size(), '\0' );
+
+			for ( const auto& element : mElements )
+			{
+				_storeTapeWord( tape, slot, tape.length() );
+				element._writeTape( tape );
+				slot += 8;
+			}
+			break;
+		}
 
+		case Type::string:
+			_appendTapeString( tape, mStringValue );
+			break;
+
+		case Type::number:
+			switch ( mNumericType )
+			{
 			case eNumberType::SIGNED_INTEGRAL:
-				snprintf( buffer, sizeof( buffer ), "%lld", value.mNumericValue.signedIntegral );
-				sink.append( std::string( buffer ) );
+				_appendTapeNode( tape, eTapeKind::SIGNED_INTEGRAL, uint64_t( mNumericValue.signedIntegral ) );
 				break;
 
 			case eNumberType::UNSIGNED_INTEGRAL:
-				snprintf( buffer, sizeof( buffer ), "%llu", value.mNumericValue.unsignedIntegral );
-				sink.append( std::string( buffer ) );
+				_appendTapeNode( tape, eTapeKind::UNSIGNED_INTEGRAL, uint64_t( mNumericValue.unsignedIntegral ) );
 				break;
 
-#ifdef INCLUDE_GMP
-			case eNumberType::MULTIPLE_PRECISION_FLOAT:
-				char* mpfString = mpf_get_str( nullptr, 10, value.mNumericValue. );
-				sink.append( std::string( mpfString ) );
-
-				// Now we need to free the buffer from gmp
-				void ( *freeFunction )( void*, size_t );
-				mp_get_memory_functions( nullptr, nullptr, &freeFunction );
-				freeFunction( mpzString, strlen( mpzString ) + 1 );
+			case eNumberType::FLOATING:
+			{
+				// The long double follows its node, in a slot the size of a node.
+				char payload[ TAPE_NODE_SIZE ] = {};
+				std::memcpy( payload, &mNumericValue.floatValue, sizeof( mNumericValue.floatValue ) );
+				_appendTapeNode( tape, eTapeKind::FLOATING, 0 );
+				tape.append( payload, sizeof( payload ) );
 				break;
+			}
 
-			case eNumberType::MULTIPLE_PRECISION_INTEGRAL:
-				char* mpzString = mpz_get_str( nullptr, 10, value.mNumericValue );
-				sink.append( std::string( mpzString ) );
-
-				// Now we need to free the buffer from gmp
-				void ( *freeFunction )( void*, size_t );
-				mp_get_memory_functions( nullptr, nullptr, &freeFunction );
-				freeFunction( mpzString, strlen( mpzString ) + 1 );
-				break;
-#endif
+			default:
+				throw std::runtime_error( "Cannot write an unresolved or multiple precision number to a tape" );
 			}
+			break;
 
+		case Type::boolean:
+			_appendTapeNode( tape, mBoolean ? eTapeKind::TRUE_VALUE : eTapeKind::FALSE_VALUE, 0 );
 			break;
-			
-		case JsonValue::Type::boolean:
-			sink.append( value.mBoolean ? "true" : "false" );
+
+		case Type::null:
+			_appendTapeNode( tape, eTapeKind::NULL_VALUE, 0 );
 			break;
 
-		case JsonValue::Type::null:
-			sink.append( "null" );
+		case Type::undefined:
+			_appendTapeNode( tape, eTapeKind::UNDEFINED, 0 );
 			break;
 		}
 	}
+
+	// Write this JsonValue as a whole tape: the header, recording the host format
+	// and the length of the tape, then the root value.
+	void _writeTapeDocument( std::string& tape ) const
+	{
+		static_assert( sizeof( long double ) <= TAPE_NODE_SIZE, "long double must fit in a tape node" );
+		const uint32_t hostFormat[ 2 ] = { uint32_t( TAPE_BYTE_ORDER ), uint32_t( sizeof( long double ) ) };
+
+		tape.clear();
+		tape.append( "JSONTAPE", 8 );
+		tape.append( reinterpret_cast< const char* >( hostFormat ), sizeof( hostFormat ) );
+		tape.append( TAPE_HEADER_SIZE - tape.length(), '\0' );
+		_writeTape( tape );
+		_storeTapeWord( tape, 16, tape.length() );
+	}
 };
+
+/**
+ * Compiled JSON Pointer (RFC 6901) for resolving values within a JsonValue.
+ */
+using JsonPointer = JsonValue::Pointer;
+
+/**
+ * Compiled JSONPath (RFC 9535) query for selecting values from a JsonValue or JSON text.
+ */
+using JsonPath = JsonValue::Path;
+
+/**
+ * Secondary hash index over an array of objects, keyed by a field of each element.
+ */
+using JsonIndex = JsonValue::Index;
+
+/**
+ * Journal of the changes made to a JsonValue through it, drained as JSON Patches (RFC 6902).
+ */
+using JsonJournal = JsonValue::Journal;
+
+/**
+ * A tape, the flat binary form of a document, loaded or mapped for querying in place.
+ */
+using JsonTape = JsonValue::Tape;
+
+/**
+ * Read-only view of a value within a tape.
+ */
+using JsonTapeView = JsonValue::TapeView;
+
+/**
+ * Compiled JSON Schema for validating a JsonValue, or JSON text while it is parsed.
+ */
+using JsonSchema = JsonValue::Schema;
+
+/**
+ * A document parsed at compile time from JSON text, see JsonValue::literal().
+ */
+template < size_t Nodes, size_t Length >
+using JsonLiteral = JsonValue::Literal< Nodes, Length >;
+
+/**
+ * Read-only view of a value within a literal.
+ */
+using JsonLiteralView = JsonValue::LiteralView;
@@ -13,13 +13,21 @@
  *   $ sudo cp *.so /usr/lib
  *
  * Compile the test:
- *   $ g++ -std=c++14 test_json.cpp -lgtest -lgtest_main -o gtest_json
+ *   $ g++ -std=c++14 test_json.cpp -lgtest -lgtest_main -pthread -o gtest_json
+ *
+ * Check the shared read tests for data races:
+ *   $ g++ -std=c++14 -g -O1 -fsanitize=thread test_json.cpp -lgtest -lgtest_main -pthread -o gtest_json
+ *   $ ./gtest_json --gtest_filter='JsonValueConstAccess.*'
  */
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <cstdio>
 #include <map>
 #include <gtest/gtest.h>
+#include <iterator>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 #include "Json.hpp"
@@ -84,6 +92,1547 @@ TEST( JsonValueConstructor, ObjectTypeMoveConstructorShouldSetJsonValueToTypeObj
 	
 }
 
+TEST( JsonValueDestructor, DestroyingDeeplyNestedArraysShouldNotOverflowTheStack )
+{
+	const size_t NESTING_DEPTH = 1000000;
+	JsonValue::ArrayType nested;
+
+	for ( size_t depth( 0 ); depth < NESTING_DEPTH; ++depth )
+	{
+		JsonValue::ArrayType outer;
+		outer.emplace_back( std::move( nested ) );
+		nested = std::move( outer );
+	}
+
+	JsonValue deep( std::move( nested ) );
+	deep.clear();
+
+	EXPECT_EQ( Type::undefined, deep.type() );
+}
+
+TEST( JsonValueReclaimer, ReclaimShouldReleaseTheValueOffTheCallingThread )
+{
+	std::thread::id releasingThread;
+	size_t released = 0;
+	JsonValue::Reclaimer reclaimer( [ &releasingThread, &released ]( size_t count )
+	{
+		releasingThread = std::this_thread::get_id();
+		released += count;
+	} );
+	JsonValue::ArrayType elements( 1024, JsonValue( JsonValue::ArrayType( 4, JsonValue( nullptr ) ) ) );
+	elements.emplace_back( std::string( 256, 'x' ) );
+	JsonValue document( std::move( elements ) );
+
+	reclaimer.reclaim( std::move( document ) );
+	reclaimer.reclaim( JsonValue( true ) );
+	reclaimer.flush();
+
+	EXPECT_EQ( Type::undefined, document.type() );
+	EXPECT_EQ( 1u, released );
+	EXPECT_NE( std::thread::id(), releasingThread );
+	EXPECT_NE( std::this_thread::get_id(), releasingThread );
+}
+
+TEST( JsonPointer, GetShouldResolveMembersAndElementsWithoutAddingThem )
+{
+	JsonValue document( JsonValue::ObjectType {
+		{ "a", JsonValue::ObjectType {
+			{ "b", JsonValue::ArrayType { JsonValue( JsonValue::ObjectType { { "c", true } } ) } },
+			{ "m~n/o", nullptr } } } } );
+	const JsonPointer pointer( "/a/b/0/c" );
+
+	ASSERT_NE( nullptr, pointer.get( document ) );
+	EXPECT_TRUE( pointer.get( document )->is( Type::boolean ) );
+	EXPECT_NE( nullptr, JsonPointer( "/a/m~0n~1o" ).get( document ) );
+	EXPECT_EQ( &document, JsonPointer( "" ).get( document ) );
+	EXPECT_EQ( nullptr, JsonPointer( "/a/b/1" ).get( document ) );
+	EXPECT_EQ( nullptr, JsonPointer( "/a/missing" ).get( document ) );
+	EXPECT_EQ( 2, document[ "a" ].size() );
+	EXPECT_EQ( 1, document[ "a" ][ "b" ].size() );
+}
+
+TEST( JsonPointer, ConstructorShouldRejectMalformedPointers )
+{
+	EXPECT_THROW( JsonPointer( "a/b" ), std::invalid_argument );
+	EXPECT_THROW( JsonPointer( "/a~2" ), std::invalid_argument );
+	EXPECT_EQ( "/a~1b/~0", JsonPointer( "/a~1b/~0" ).toString() );
+}
+
+static JsonValue makeBookStore()
+{
+	JsonValue::ArrayType books;
+	books.emplace_back( JsonValue::ObjectType { { "author", std::string( "Rees" ) }, { "price", 8.95 } } );
+	books.emplace_back( JsonValue::ObjectType { { "author", std::string( "Waugh" ) }, { "price", 12.99 } } );
+	books.emplace_back( JsonValue::ObjectType { { "author", std::string( "Melville" ) }, { "price", 8 }, { "isbn", std::string( "0-553-21311-3" ) } } );
+
+	return JsonValue( JsonValue::ObjectType {
+		{ "store", JsonValue::ObjectType {
+			{ "book", std::move( books ) },
+			{ "bicycle", JsonValue::ObjectType { { "price", 19.95 } } } } } } );
+}
+
+TEST( JsonPath, SelectShouldRunTheCompiledPlanOverAJsonValue )
+{
+	const JsonValue store( makeBookStore() );
+
+	EXPECT_EQ( 3, JsonPath( "$.store.book[*].author" ).select( store ).size() );
+	EXPECT_EQ( 4, JsonPath( "$..price" ).select( store ).size() );
+	EXPECT_EQ( 2, JsonPath( "$.store.book[?(@.price < 10)]" ).select( store ).size() );
+	EXPECT_EQ( 1, JsonPath( "$.store.book[?@.isbn && @.price >= 8]" ).select( store ).size() );
+	EXPECT_EQ( 2, JsonPath( "$.store.book[-2:]" ).select( store ).size() );
+	EXPECT_EQ( 2, JsonPath( "$['store']['book'][0,2]" ).select( store ).size() );
+	EXPECT_EQ( 3, JsonPath( "$.store.book[::-1]" ).select( store ).size() );
+	EXPECT_TRUE( JsonPath( "$.store.missing" ).select( store ).empty() );
+
+	const auto lastAuthor = JsonPath( "$.store.book[-1].author" ).select( store );
+	ASSERT_EQ( 1, lastAuthor.size() );
+	EXPECT_EQ( std::string( "Melville" ), std::string( *lastAuthor[ 0 ] ) );
+}
+
+TEST( JsonPath, ConstructorShouldRejectMalformedQueries )
+{
+	EXPECT_THROW( JsonPath( "store.book" ), std::invalid_argument );
+	EXPECT_THROW( JsonPath( "$.store[" ), std::invalid_argument );
+	EXPECT_THROW( JsonPath( "$[?(@..price < 10)]" ), std::invalid_argument );
+	EXPECT_THROW( JsonPath( "$[99999999999999999999]" ), std::invalid_argument );
+	EXPECT_THROW( JsonPath( "$[?(@.id > 99999999999999999999)]" ), std::invalid_argument );
+	EXPECT_THROW( JsonPath( "$[?(@.id > 1e99999)]" ), std::invalid_argument );
+	EXPECT_THROW( JsonPath( "$[?(@.id > 1-2)]" ), std::invalid_argument );
+	EXPECT_THROW( JsonPath( "$.store.book-list" ), std::invalid_argument );
+
+	JsonValue escaped;
+	escaped.parse( std::string( "{\"b\\u00f6k\": 1}" ) );
+	EXPECT_EQ( 1, JsonPath( "$['b\\u00f6k']" ).select( escaped ).size() );
+}
+
+TEST( JsonPath, StreamingSelectShouldOnlyBuildMatchedValues )
+{
+	const std::string jsonString(
+		"{ \"skipped\": { \"deep\": [ 1, 2, { \"a\": \"]\" } ] },"
+		"  \"items\": [ { \"id\": 1, \"tags\": [ \"x\" ] }, { \"id\": 2 }, { \"id\": 3 } ] }" );
+	std::vector< JsonValue > matches;
+
+	JsonPath( "$.items[1:].id" ).select( jsonString, [ &matches ]( JsonValue&& value )
+	{
+		matches.push_back( std::move( value ) );
+	} );
+
+	ASSERT_EQ( 2, matches.size() );
+	EXPECT_TRUE( matches[ 0 ].is( Type::number ) );
+
+	matches.clear();
+	JsonPath( "$.items[?(@.id > 1)]" ).select( jsonString, [ &matches ]( JsonValue&& value )
+	{
+		matches.push_back( std::move( value ) );
+	} );
+
+	EXPECT_EQ( 2, matches.size() );
+}
+
+TEST( JsonPath, StreamingSelectShouldRejectMalformedSkippedValues )
+{
+	const auto ignore = []( JsonValue&& ) {};
+	const JsonPath path( "$.b" );
+
+	EXPECT_THROW( path.select( std::string( "{\"a\": {], \"b\": 1}" ), ignore ), ParseError );
+	EXPECT_THROW( path.select( std::string( "{\"a\": [1 2 :: ,,], \"b\": 2}" ), ignore ), ParseError );
+	EXPECT_THROW( path.select( std::string( "{\"a\": 1-2-3e, \"b\": 3}" ), ignore ), ParseError );
+	EXPECT_THROW( path.select( std::string( "{\"a\": {\"k\" 1}, \"b\": 4}" ), ignore ), ParseError );
+	EXPECT_THROW( path.select( std::string( "{\"a\": [nul], \"b\": 5}" ), ignore ), ParseError );
+	EXPECT_THROW( path.select( std::string( "{\"a\": [1,], \"b\": 6}" ), ignore ), ParseError );
+	EXPECT_THROW( path.select( std::string( "{\"b\": 1} {\"b\": 2}" ), ignore ), ParseError );
+	EXPECT_THROW( JsonValue().parse( std::string( "{\"b\": 1} x" ) ), ParseError );
+
+	size_t count = 0;
+	path.select( std::string( "{\"a\": { \"x\": [ [], {}, -0.5e+2, \"]\", true, null ] }, \"b\": 7}" ),
+		[ &count ]( JsonValue&& ) { ++count; } );
+	EXPECT_EQ( 1u, count );
+}
+
+TEST( JsonValueLookup, FindShouldReturnNullWithoutAddingMissingMembers )
+{
+	JsonValue object( JsonValue::ObjectType { { STD_STRING_KEY, true } } );
+
+	ASSERT_NE( nullptr, object.find( STD_STRING_KEY ) );
+	EXPECT_TRUE( object.find( STD_STRING_KEY )->is( Type::boolean ) );
+	EXPECT_EQ( nullptr, object.find( CSTRING_KEY ) );
+	EXPECT_EQ( nullptr, object.find( static_cast< const char* >( nullptr ) ) );
+	EXPECT_EQ( 1, object.size() );
+	EXPECT_EQ( nullptr, JsonValue( Type::array ).find( STD_STRING_KEY ) );
+}
+
+TEST( JsonValueLookup, AtShouldReturnNullForOutOfRangeIndicesWithoutResizing )
+{
+	const JsonValue array( JsonValue::ArrayType { JsonValue( 1 ), JsonValue( 2 ), JsonValue( 3 ) } );
+
+	EXPECT_EQ( &*array.begin(), array.at( 0 ) );
+	EXPECT_EQ( array.at( 2 ), array.at( -1 ) );
+	EXPECT_EQ( nullptr, array.at( 3 ) );
+	EXPECT_EQ( nullptr, array.at( -4 ) );
+	EXPECT_EQ( 3, array.size() );
+}
+
+TEST( JsonValueLookup, GetIfShouldOnlyReturnTheStoredType )
+{
+	JsonValue string( std::string( "value" ) );
+	JsonValue number( intmax_t( -7 ) );
+
+	ASSERT_NE( nullptr, string.get_if< std::string >() );
+	EXPECT_EQ( "value", *string.get_if< std::string >() );
+	EXPECT_EQ( nullptr, string.get_if< bool >() );
+	ASSERT_NE( nullptr, number.get_if< intmax_t >() );
+	EXPECT_EQ( -7, *number.get_if< intmax_t >() );
+	EXPECT_EQ( nullptr, number.get_if< long double >() );
+}
+
+TEST( JsonValueKeys, KeysShouldVisitEveryKeyInOrderWithoutCopying )
+{
+	const JsonValue object( JsonValue::ObjectType { { "b", 2 }, { "a", 1 }, { "c", 3 } } );
+	std::vector< const std::string* > visited;
+
+	for ( const std::string& key : object.keys() )
+	{
+		visited.push_back( &key );
+	}
+
+	const std::vector< std::string > keys = object.keys();
+	ASSERT_EQ( 3, visited.size() );
+	EXPECT_EQ( ( std::vector< std::string > { "a", "b", "c" } ), keys );
+	EXPECT_EQ( &object.items().begin()->first, visited[ 0 ] );
+	EXPECT_THROW( JsonValue( Type::array ).keys(), std::runtime_error );
+}
+
+TEST( JsonValueKeys, ItemsShouldExposeTheKeyAndMutableValue )
+{
+	JsonValue object( JsonValue::ObjectType { { "a", 1 }, { "b", 2 } } );
+
+	for ( auto& item : object.items() )
+	{
+		item.second = item.first;
+	}
+
+	EXPECT_EQ( JsonValue( std::string( "a" ) ), *object.find( "a" ) );
+	EXPECT_EQ( JsonValue( std::string( "b" ) ), *object.find( "b" ) );
+}
+
+TEST( JsonValueElements, ElementsShouldBeAContiguousRandomAccessSpan )
+{
+	JsonValue array( JsonValue::ArrayType { JsonValue( 3 ), JsonValue( 1 ), JsonValue( 2 ) } );
+	auto elements = array.elements();
+
+	static_assert( std::is_same< JsonValue*, decltype( elements.begin() ) >::value, "span iterators are pointers" );
+	static_assert( std::is_same< std::random_access_iterator_tag,
+		std::iterator_traits< decltype( elements.begin() ) >::iterator_category >::value, "span iterators are random access" );
+
+	std::sort( elements.begin(), elements.end(), []( const JsonValue& left, const JsonValue& right )
+	{
+		return *left.get_if< intmax_t >() < *right.get_if< intmax_t >();
+	} );
+
+	EXPECT_EQ( 1, *array.at( 0 )->get_if< intmax_t >() );
+	EXPECT_EQ( 2, *array.at( 1 )->get_if< intmax_t >() );
+	EXPECT_EQ( 3, *array.at( 2 )->get_if< intmax_t >() );
+	EXPECT_EQ( 3, elements.size() );
+	EXPECT_THROW( JsonValue( Type::object ).elements(), std::runtime_error );
+}
+
+TEST( JsonValueElements, AssigningADescendantShouldNotReleaseItFirst )
+{
+	JsonValue array( JsonValue::ArrayType { JsonValue( JsonValue::ArrayType { JsonValue( true ) } ) } );
+
+	array = array.elements()[ 0 ];
+	ASSERT_TRUE( array.is( Type::array ) );
+	EXPECT_TRUE( array.elements()[ 0 ].is( Type::boolean ) );
+}
+
+TEST( JsonValueExtract, ExtractShouldFindEveryKeyInOnePassInRequestOrder )
+{
+	const JsonValue object( JsonValue::ObjectType { { "id", 7 }, { "name", std::string( "x" ) }, { "tags", JsonValue( Type::array ) } } );
+
+	const JsonValue* tags;
+	const JsonValue* missing;
+	const JsonValue* id;
+	std::tie( tags, missing, id ) = object.extract( std::string( "tags" ), "missing", "id" );
+
+	ASSERT_NE( nullptr, tags );
+	EXPECT_TRUE( tags->is( Type::array ) );
+	EXPECT_EQ( nullptr, missing );
+	ASSERT_NE( nullptr, id );
+	EXPECT_EQ( 7, *id->get_if< intmax_t >() );
+	EXPECT_EQ( nullptr, std::get< 0 >( JsonValue( Type::array ).extract( "id" ) ) );
+}
+
+TEST( JsonValueExtract, ExtractFromShouldSkipUnrequestedMembersAndStopEarly )
+{
+	auto values = JsonValue::extractFrom( R"( { "skip": { "deep": [ 1, "]", {} ] }, "b": [ true ], "a": "first", "a": "second" } trailing garbage )",
+		"a", std::string( "b" ), "c" );
+
+	EXPECT_EQ( JsonValue( std::string( "first" ) ), std::get< 0 >( values ) );
+	ASSERT_TRUE( std::get< 1 >( values ).is( Type::array ) );
+	EXPECT_EQ( 1, std::get< 1 >( values ).size() );
+	EXPECT_TRUE( std::get< 2 >( values ).is( Type::undefined ) );
+
+	values = JsonValue::extractFrom( R"( { "a": 1, "x": { "y": 2 }, "b": 3 } )", "a", std::string( "b" ), "c" );
+	EXPECT_TRUE( std::get< 1 >( values ).is( Type::number ) );
+	EXPECT_TRUE( std::get< 2 >( values ).is( Type::undefined ) );
+
+	EXPECT_THROW( JsonValue::extractFrom( R"( { "a": 1, )", "b" ), ParseError );
+	EXPECT_THROW( JsonValue::extractFrom( R"( { "a": 1 )", "b" ), ParseError );
+	EXPECT_THROW( JsonValue::extractFrom( R"( { "a": 1, "x": {]}, "b": 2 } )", "b" ), ParseError );
+	EXPECT_THROW( JsonValue::extractFrom( R"( { "a": 1, } )", "b" ), ParseError );
+}
+
+TEST( JsonValueIndex, IndexShouldFindElementsByFieldAndFollowArrayUpdates )
+{
+	JsonValue records( Type::array );
+	for ( int id = 0; id < 100; ++id )
+	{
+		records.push_back( JsonValue( JsonValue::ObjectType { { "id", id }, { "name", std::to_string( id ) } } ) );
+	}
+
+	JsonIndex byId = records.buildIndex( "/id" );
+
+	ASSERT_NE( nullptr, byId.find( JsonValue( 42 ) ) );
+	EXPECT_EQ( JsonValue( std::string( "42" ) ), *byId.find( JsonValue( 42.0 ) )->find( "name" ) );
+	EXPECT_EQ( nullptr, byId.find( JsonValue( std::string( "42" ) ) ) );
+
+	records.erase( 10 );
+	records.insert( 0, JsonValue( JsonValue::ObjectType { { "id", 42 } } ) );
+	records.push_back( JsonValue( JsonValue::ObjectType { { "name", std::string( "no id" ) } } ) );
+	records.pop_back();
+
+	EXPECT_EQ( nullptr, byId.find( JsonValue( 10 ) ) );
+	EXPECT_EQ( &*records.begin(), byId.find( JsonValue( 42 ) ) );
+	ASSERT_EQ( 2, byId.findAll( JsonValue( 42 ) ).size() );
+	EXPECT_EQ( JsonValue( std::string( "42" ) ), *byId.findAll( JsonValue( 42 ) )[ 1 ]->find( "name" ) );
+	EXPECT_EQ( JsonValue( std::string( "99" ) ), *byId.find( JsonValue( 99 ) )->find( "name" ) );
+	EXPECT_EQ( 100, byId.size() );
+
+	const JsonIndex& view = byId;
+	static_assert( std::is_same< const JsonValue*, decltype( view.find( JsonValue( 42 ) ) ) >::value, "const find" );
+	static_assert( std::is_same< std::vector< const JsonValue* >, decltype( view.findAll( JsonValue( 42 ) ) ) >::value, "const findAll" );
+	EXPECT_EQ( &*records.begin(), view.find( JsonValue( 42 ) ) );
+	EXPECT_EQ( byId.findAll( JsonValue( 42 ) )[ 1 ], view.findAll( JsonValue( 42 ) )[ 1 ] );
+}
+
+TEST( JsonValueIndex, IndexShouldFollowMovedArraysAndDetachOnReassignment )
+{
+	JsonValue records( JsonValue::ArrayType { JsonValue( JsonValue::ObjectType { { "id", 1 } } ) } );
+	JsonIndex byId = records.buildIndex( "/id" );
+
+	JsonValue moved( std::move( records ) );
+	ASSERT_TRUE( byId.attached() );
+	EXPECT_EQ( &*moved.begin(), byId.find( JsonValue( 1 ) ) );
+
+	moved = JsonValue( Type::array );
+	EXPECT_FALSE( byId.attached() );
+	EXPECT_EQ( nullptr, byId.find( JsonValue( 1 ) ) );
+	EXPECT_THROW( JsonValue( Type::object ).buildIndex( "/id" ), std::runtime_error );
+}
+
+TEST( JsonValueCBOR, ToCBORShouldUseTheShortestHeadsAndRoundTrip )
+{
+	JsonValue document( JsonValue::ObjectType {
+		{ "a", JsonValue( JsonValue::ArrayType { JsonValue( 1 ), JsonValue( -500 ), JsonValue( 1.5 ) } ) },
+		{ "b", std::string( "text" ) },
+		{ "c", nullptr },
+		{ "d", true } } );
+	std::string cbor;
+	document.toCBOR( cbor );
+
+	EXPECT_EQ( std::string( "\xA4\x61" "a\x83\x01\x39\x01\xF3\xFA\x3F\xC0\x00\x00\x61" "b\x64text\x61" "c\xF6\x61" "d\xF5", 26 ), cbor );
+
+	JsonValue decoded;
+	decoded.fromCBOR( cbor );
+	ASSERT_TRUE( decoded.is( Type::object ) );
+	EXPECT_EQ( 1, *decoded.find( "a" )->at( 0 )->get_if< uintmax_t >() );
+	EXPECT_EQ( -500, *decoded.find( "a" )->at( 1 )->get_if< intmax_t >() );
+	EXPECT_EQ( 1.5, *decoded.find( "a" )->at( 2 )->get_if< long double >() );
+	EXPECT_EQ( JsonValue( std::string( "text" ) ), *decoded.find( "b" ) );
+	EXPECT_TRUE( decoded.find( "c" )->is( Type::null ) );
+	EXPECT_EQ( JsonValue( true ), *decoded.find( "d" ) );
+	EXPECT_THROW( decoded.fromCBOR( cbor.substr( 0, 10 ) ), ParseError );
+
+	// Nesting past the decoder limit is rejected before it can overflow the stack.
+	decoded.fromCBOR( std::string( 1000, '\x81' ) + '\x01' );
+	EXPECT_TRUE( decoded.is( Type::array ) );
+	EXPECT_THROW( decoded.fromCBOR( std::string( 2 << 20, '\x81' ) ), ParseError );
+	EXPECT_THROW( decoded.fromCBOR( std::string( 2 << 20, '\xC6' ) ), ParseError );
+}
+
+TEST( JsonValueCBOR, TypedArraysAndIndefiniteItemsShouldStreamFromAFile )
+{
+	JsonValue numbers( JsonValue::ArrayType { JsonValue( -2 ), JsonValue( 300 ), JsonValue( 7 ) } );
+	std::string cbor;
+	numbers.toCBOR( cbor, true );
+
+	// Tag 77 (sint16, little endian) around a 6 byte string.
+	EXPECT_EQ( std::string( "\xD8\x4D\x46\xFE\xFF\x2C\x01\x07\x00", 9 ), cbor );
+
+	// An indefinite length map holding a chunked string, followed by a second item.
+	cbor.append( "\xBF\x61k\x7F\x62" "ab\x61" "c\xFF\xFF\x0A", 12 );
+
+	FILE* file = tmpfile();
+	ASSERT_NE( nullptr, file );
+	fwrite( cbor.data(), 1, cbor.length(), file );
+	rewind( file );
+
+	JsonValue decoded;
+	decoded.fromCBOR( file );
+	ASSERT_EQ( 3, decoded.size() );
+	EXPECT_EQ( -2, *decoded.at( 0 )->get_if< intmax_t >() );
+	EXPECT_EQ( 300, *decoded.at( 1 )->get_if< intmax_t >() );
+
+	decoded.fromCBOR( file );
+	EXPECT_EQ( JsonValue( std::string( "abc" ) ), *decoded.find( "k" ) );
+
+	decoded.fromCBOR( file );
+	EXPECT_EQ( 10, *decoded.get_if< uintmax_t >() );
+	fclose( file );
+}
+
+TEST( JsonValueCBOR, FloatingTypedArraysShouldUseTheFloatTagsAndRoundTrip )
+{
+	JsonValue singles( JsonValue::ArrayType { JsonValue( 1.5 ), JsonValue( -0.25 ) } );
+	std::string cbor;
+	singles.toCBOR( cbor, true );
+
+	// Tag 85 (float32, little endian) around an 8 byte string.
+	EXPECT_EQ( std::string( "\xD8\x55\x48\x00\x00\xC0\x3F\x00\x00\x80\xBE", 11 ), cbor );
+
+	JsonValue decoded;
+	decoded.fromCBOR( cbor );
+	EXPECT_EQ( singles, decoded );
+
+	JsonValue doubles( JsonValue::ArrayType { JsonValue( 0.1 ), JsonValue( -2.0 ) } );
+	std::string doubleCBOR;
+	doubles.toCBOR( doubleCBOR, true );
+
+	// Tag 86 (float64, little endian) around a 16 byte string.
+	ASSERT_EQ( 19, doubleCBOR.length() );
+	EXPECT_EQ( std::string( "\xD8\x56\x50", 3 ), doubleCBOR.substr( 0, 3 ) );
+	EXPECT_EQ( std::string( "\x00\x00\x00\x00\x00\x00\x00\xC0", 8 ), doubleCBOR.substr( 11 ) );
+
+	decoded.fromCBOR( doubleCBOR );
+	EXPECT_EQ( doubles, decoded );
+}
+
+TEST( JsonValueMessagePack, ToMessagePackShouldSelectTheExactIntegerWidth )
+{
+	JsonValue numbers( JsonValue::ArrayType { JsonValue( 5 ), JsonValue( -5 ), JsonValue( 200 ), JsonValue( -200 ),
+		JsonValue( 70000 ), JsonValue( uintmax_t( 1 ) << 40 ), JsonValue( 0.5 ) } );
+	std::string messagePack;
+	numbers.toMessagePack( messagePack );
+
+	EXPECT_EQ( std::string( "\x97\x05\xFB\xCC\xC8\xD1\xFF\x38\xCE\x00\x01\x11\x70"
+		"\xCF\x00\x00\x01\x00\x00\x00\x00\x00\xCA\x3F\x00\x00\x00", 27 ), messagePack );
+
+	JsonValue decoded;
+	decoded.fromMessagePack( messagePack );
+	ASSERT_EQ( 7, decoded.size() );
+	EXPECT_EQ( -5, *decoded.at( 1 )->get_if< intmax_t >() );
+	EXPECT_EQ( -200, *decoded.at( 3 )->get_if< intmax_t >() );
+	EXPECT_EQ( uintmax_t( 1 ) << 40, *decoded.at( 5 )->get_if< uintmax_t >() );
+	EXPECT_EQ( 0.5, *decoded.at( 6 )->get_if< long double >() );
+}
+
+TEST( JsonValueMessagePack, FromMessagePackShouldDecodeMapsStringsAndBinary )
+{
+	// { "name": "x", 7: bin[ 0xFF ], "ok": true, "none": nil }
+	const std::string messagePack( "\x84\xA4name\xD9\x01x\x07\xC4\x01\xFF\xA2ok\xC3\xA4none\xC0", 23 );
+
+	JsonValue decoded;
+	decoded.fromMessagePack( messagePack );
+	ASSERT_TRUE( decoded.is( Type::object ) );
+	EXPECT_EQ( JsonValue( std::string( "x" ) ), *decoded.find( "name" ) );
+	EXPECT_EQ( JsonValue( std::string( "_w" ) ), *decoded.find( "7" ) );
+	EXPECT_EQ( JsonValue( true ), *decoded.find( "ok" ) );
+	EXPECT_TRUE( decoded.find( "none" )->is( Type::null ) );
+
+	std::string encoded;
+	decoded.toMessagePack( encoded );
+	JsonValue roundTrip;
+	roundTrip.fromMessagePack( encoded );
+	EXPECT_EQ( decoded, roundTrip );
+	EXPECT_THROW( roundTrip.fromMessagePack( std::string( "\xC1", 1 ) ), ParseError );
+	EXPECT_THROW( roundTrip.fromMessagePack( std::string( 2 << 20, '\x91' ) ), ParseError );
+	EXPECT_THROW( roundTrip.fromMessagePack( std::string( 2 << 20, '\x81' ) ), ParseError );
+}
+
+TEST( JsonValueBSON, ToBSONShouldBackpatchLengthsAndRoundTripExtendedTypes )
+{
+	JsonValue hello( JsonValue::ObjectType { { "hello", std::string( "world" ) } } );
+	std::string bson;
+	hello.toBSON( bson );
+	EXPECT_EQ( std::string( "\x16\x00\x00\x00\x02hello\x00\x06\x00\x00\x00world\x00\x00", 22 ), bson );
+
+	JsonValue document( JsonValue::ObjectType {
+		{ "_id", JsonValue::ObjectType { { "$oid", std::string( "5f1d7c3a9b1e8a0001a2b3c4" ) } } },
+		{ "price", JsonValue::ObjectType { { "$numberDecimal", std::string( "-12.50" ) } } },
+		{ "tags", JsonValue::ArrayType { JsonValue( 1 ), JsonValue( intmax_t( 1 ) << 40 ), JsonValue( 0.25 ) } } } );
+	bson.clear();
+	document.toBSON( bson );
+	ASSERT_EQ( 85, bson.length() );
+	EXPECT_EQ( '\x07', bson[ 4 ] );
+
+	JsonValue decoded;
+	decoded.fromBSON( bson );
+	EXPECT_EQ( document, decoded );
+	EXPECT_EQ( 1, *decoded.find( "tags" )->at( 0 )->get_if< intmax_t >() );
+	EXPECT_THROW( JsonValue( JsonValue::ArrayType {} ).toBSON( bson ), std::runtime_error );
+	EXPECT_THROW( decoded.fromBSON( bson.substr( 0, 60 ) ), ParseError );
+
+	// Nesting past the decoder limit is rejected before it can overflow the stack. Each level
+	// is a document holding the next under the key "a", and is eight bytes longer than it.
+	const auto nestedDocuments = []( uint32_t levels )
+	{
+		std::string nested;
+		for ( uint32_t level = levels; 0 < level; --level )
+		{
+			const uint32_t length = 5 + 8 * level;
+			const char prefix[] = { char( length ), char( length >> 8 ), char( length >> 16 ), char( length >> 24 ), '\x03', 'a', '\0' };
+			nested.append( prefix, sizeof( prefix ) );
+		}
+		return nested.append( "\x05\0\0\0\0", 5 ).append( levels, '\0' );
+	};
+	decoded.fromBSON( nestedDocuments( 1000 ) );
+	EXPECT_TRUE( decoded.find( "a" )->find( "a" )->is( Type::object ) );
+	EXPECT_THROW( decoded.fromBSON( nestedDocuments( 300000 ) ), ParseError );
+}
+
+TEST( JsonValueBSON, FromBSONShouldSkipDocumentsOutsideTheProjection )
+{
+	JsonValue document( JsonValue::ObjectType {
+		{ "big", JsonValue::ObjectType { { "blob", std::string( 1000, 'x' ) }, { "nested", JsonValue::ArrayType { JsonValue( 1 ) } } } },
+		{ "keep", JsonValue::ObjectType { { "x", JsonValue( 1 ) }, { "y", JsonValue( 2 ) } } },
+		{ "list", JsonValue::ArrayType { JsonValue( 10 ), JsonValue( 20 ), JsonValue( 30 ) } } } );
+	std::string bson;
+	document.toBSON( bson );
+
+	JsonValue decoded;
+	decoded.fromBSON( bson, { JsonPointer( "/keep/y" ), JsonPointer( "/list/2" ) } );
+	EXPECT_EQ( nullptr, decoded.find( "big" ) );
+	EXPECT_EQ( nullptr, decoded.find( "keep" )->find( "x" ) );
+	EXPECT_EQ( 2, *decoded.find( "keep" )->find( "y" )->get_if< intmax_t >() );
+	ASSERT_EQ( 3, decoded.find( "list" )->size() );
+	EXPECT_TRUE( decoded.find( "list" )->at( 0 )->is( Type::undefined ) );
+	EXPECT_EQ( 30, *decoded.find( "list" )->at( 2 )->get_if< intmax_t >() );
+}
+
+TEST( JsonValueUBJSON, ToUBJSONShouldEmitTypedArraysForNumericArrays )
+{
+	JsonValue samples( JsonValue::ArrayType { JsonValue( 0.5 ), JsonValue( -2.0 ), JsonValue( 1.25 ) } );
+	std::string ubjson;
+	samples.toUBJSON( ubjson );
+	EXPECT_EQ( std::string( "[$d#i\x03\x3F\x00\x00\x00\xC0\x00\x00\x00\x3F\xA0\x00\x00", 18 ), ubjson );
+
+	std::string bjData;
+	JsonValue( JsonValue::ArrayType { JsonValue( 1 ), JsonValue( 40000 ) } ).toBJData( bjData );
+	EXPECT_EQ( std::string( "[$u#i\x02\x01\x00\x40\x9C", 10 ), bjData );
+
+	JsonValue document( JsonValue::ObjectType { { "samples", samples }, { "name", std::string( "run" ) },
+		{ "mixed", JsonValue::ArrayType { JsonValue( 1 ), JsonValue( true ), nullptr } } } );
+	ubjson.clear();
+	document.toUBJSON( ubjson );
+	JsonValue decoded;
+	decoded.fromUBJSON( ubjson );
+	EXPECT_EQ( document, decoded );
+
+	bjData.clear();
+	document.toBJData( bjData );
+	decoded.fromBJData( bjData );
+	EXPECT_EQ( document, decoded );
+}
+
+TEST( JsonValueUBJSON, FromUBJSONShouldReadOptimizedAndPaddedContainers )
+{
+	JsonValue decoded;
+	decoded.fromUBJSON( std::string( "{#i\x02i\x01" "aSi\x01xi\x01" "b[$I#i\x02\x01\x00\xFF\xFF", 24 ) );
+	EXPECT_EQ( JsonValue( std::string( "x" ) ), *decoded.find( "a" ) );
+	ASSERT_EQ( 2, decoded.find( "b" )->size() );
+	EXPECT_EQ( 256, *decoded.find( "b" )->at( 0 )->get_if< intmax_t >() );
+	EXPECT_EQ( -1, *decoded.find( "b" )->at( 1 )->get_if< intmax_t >() );
+
+	decoded.fromUBJSON( std::string( "[Ni\x05NZ]" ) );
+	ASSERT_EQ( 2, decoded.size() );
+	EXPECT_TRUE( decoded.at( 1 )->is( Type::null ) );
+
+	// A 2 by 3 BJData N-dimensional array decodes to nested rows.
+	decoded.fromBJData( std::string( "[$U#[$i#i\x02\x02\x03\x01\x02\x03\x04\x05\x06", 18 ) );
+	ASSERT_EQ( 2, decoded.size() );
+	ASSERT_EQ( 3, decoded.at( 1 )->size() );
+	EXPECT_EQ( 6u, *decoded.at( 1 )->at( 2 )->get_if< uintmax_t >() );
+
+	// Typed containers of values without a payload repeat the value for the count.
+	decoded.fromUBJSON( std::string( "[$T#i\x03" ) );
+	EXPECT_EQ( JsonValue( JsonValue::ArrayType( 3, JsonValue( true ) ) ), decoded );
+	decoded.fromUBJSON( std::string( "{$Z#i\x01i\x01k" ) );
+	EXPECT_TRUE( decoded.find( "k" )->is( Type::null ) );
+	decoded.fromUBJSON( std::string( "[$N#i\x04" ) );
+	EXPECT_TRUE( decoded.is( Type::array ) and ( 0 == decoded.size() ) );
+
+	EXPECT_THROW( decoded.fromBJData( std::string( "[$F#i\x02" ) ), ParseError );
+	EXPECT_THROW( decoded.fromUBJSON( std::string( "{$N#i\x01i\x01k" ) ), ParseError );
+	EXPECT_THROW( decoded.fromUBJSON( std::string( "[$Z#L\x7F\xFF\xFF\xFF\xFF\xFF\xFF\xFF", 13 ) ), ParseError );
+	EXPECT_THROW( decoded.fromUBJSON( std::string( "[$d#i\x04\x3F\x00\x00\x00", 10 ) ), ParseError );
+	EXPECT_THROW( decoded.fromUBJSON( std::string( 2 << 20, '[' ) ), ParseError );
+}
+
+TEST( JsonTape, TapeViewShouldQueryTheDocumentInPlace )
+{
+	JsonValue document( JsonValue::ObjectType {
+		{ "name", std::string( "reference" ) },
+		{ "rows", JsonValue::ArrayType { JsonValue( -3 ), JsonValue( 0.1L ), JsonValue( true ), nullptr } },
+		{ "zeta", JsonValue::ObjectType { { "id", JsonValue( uintmax_t( 42 ) ) } } } } );
+	std::string bytes;
+	document.toTape( bytes );
+
+	const JsonTape tape( std::move( bytes ) );
+	const JsonTapeView root = tape.root();
+	ASSERT_TRUE( root.is( Type::object ) );
+	EXPECT_EQ( 3, root.size() );
+	EXPECT_STREQ( "reference", root.find( "name" ).c_str() );
+	EXPECT_FALSE( root.find( "missing" ) );
+	EXPECT_FALSE( root.find( "rows" ).at( 4 ) );
+
+	intmax_t integral = 0;
+	long double floating = 0.0L;
+	uintmax_t identifier = 0;
+	EXPECT_TRUE( root.find( "rows" ).at( 0 ).get( integral ) );
+	EXPECT_EQ( -3, integral );
+	EXPECT_TRUE( root.find( "rows" ).at( 1 ).get( floating ) );
+	EXPECT_EQ( 0.1L, floating );
+	EXPECT_TRUE( root.find( "zeta" ).find( "id" ).get( identifier ) );
+	EXPECT_EQ( 42u, identifier );
+	EXPECT_STREQ( "zeta", root.keyAt( 2 ).c_str() );
+	EXPECT_EQ( document, root.toJsonValue() );
+}
+
+TEST( JsonTape, LoadShouldMapATapeFileAndRejectOthers )
+{
+	const std::string path = ::testing::TempDir() + "test_Json.tape";
+	JsonValue document( JsonValue::ArrayType { JsonValue( std::string( "a" ) ), JsonValue( 7 ) } );
+	FILE* file = fopen( path.c_str(), "wb" );
+	ASSERT_NE( nullptr, file );
+	document.toTape( file );
+	fclose( file );
+
+	{
+		const JsonTape tape = JsonTape::load( path );
+		EXPECT_EQ( document, tape.root().toJsonValue() );
+	}
+
+	std::remove( path.c_str() );
+	EXPECT_THROW( JsonTape::load( path ), std::runtime_error );
+	EXPECT_THROW( JsonTape( std::string( 40, 'x' ) ), std::runtime_error );
+}
+
+TEST( JsonValueCompression, UncompressedDumpShouldRoundTripAndMissingCodecsThrow )
+{
+	JsonValue document( JsonValue::ObjectType {
+		{ "enabled", JsonValue( true ) },
+		{ "flags", JsonValue::ArrayType { JsonValue( true ), JsonValue( false ), nullptr } } } );
+	std::string text;
+	document.dumps( text, JsonValue::Compression::NONE, JsonValue::Indent::TAB );
+
+	std::string expected;
+	document.dumps( expected, JsonValue::Indent::TAB );
+	EXPECT_EQ( expected, text );
+
+	JsonValue decoded;
+	decoded.loads( text, JsonValue::Compression::NONE );
+	EXPECT_EQ( document, decoded );
+
+#ifndef INCLUDE_ZSTD
+	EXPECT_THROW( document.dumps( text, JsonValue::Compression::ZSTD ), std::runtime_error );
+	EXPECT_THROW( decoded.loads( text, JsonValue::Compression::ZSTD ), std::runtime_error );
+#endif
+}
+
+#ifdef INCLUDE_ZLIB
+TEST( JsonValueCompression, GzipShouldStreamDocumentsLargerThanABlock )
+{
+	// Booleans, unsigned and negative integers and fractions, so every number form crosses blocks.
+	JsonValue::ObjectType rows;
+	for ( size_t row = 0; row < 20000; ++row )
+	{
+		const std::string key = std::string( "row-" ) + std::to_string( row );
+		if ( 0 == ( row % 4 ) )
+		{
+			rows.emplace( key, JsonValue( 0 == ( row % 3 ) ) );
+		}
+		else if ( 1 == ( row % 4 ) )
+		{
+			rows.emplace( key, JsonValue( uintmax_t( row ) << 40 ) );
+		}
+		else if ( 2 == ( row % 4 ) )
+		{
+			rows.emplace( key, JsonValue( -intmax_t( row ) ) );
+		}
+		else
+		{
+			rows.emplace( key, JsonValue( row + 0.125L ) );
+		}
+	}
+	JsonValue document( std::move( rows ) );
+
+	const std::string path = ::testing::TempDir() + "test_Json.json.gz";
+	FILE* file = fopen( path.c_str(), "wb" );
+	ASSERT_NE( nullptr, file );
+	document.dump( file, JsonValue::Compression::GZIP );
+	fclose( file );
+
+	JsonValue first, second;
+	file = fopen( path.c_str(), "rb" );
+	ASSERT_NE( nullptr, file );
+	first.parse( file, JsonValue::Compression::GZIP );
+	fclose( file );
+	EXPECT_EQ( document, first );
+
+	std::string compressed;
+	document.dumps( compressed, JsonValue::Compression::GZIP );
+	EXPECT_EQ( 0x1F, uint8_t( compressed[ 0 ] ) );
+	second.loads( compressed, JsonValue::Compression::GZIP );
+	EXPECT_EQ( document, second );
+
+	compressed.resize( compressed.length() / 2 );
+	EXPECT_THROW( second.loads( compressed, JsonValue::Compression::GZIP ), std::runtime_error );
+	std::remove( path.c_str() );
+}
+#endif
+
+TEST( JsonSchema, ValidateShouldApplyKeywordsReferencesAndCombinators )
+{
+	JsonValue node( JsonValue::ObjectType {
+		{ "type", std::string( "object" ) },
+		{ "required", JsonValue::ArrayType { JsonValue( std::string( "name" ) ) } },
+		{ "properties", JsonValue::ObjectType {
+			{ "name", JsonValue::ObjectType { { "type", std::string( "string" ) }, { "pattern", std::string( "^[a-z]+$" ) } } },
+			{ "weight", JsonValue::ObjectType { { "type", std::string( "integer" ) }, { "minimum", JsonValue( 0 ) } } },
+			{ "children", JsonValue::ObjectType { { "type", std::string( "array" ) }, { "items", JsonValue::ObjectType { { "$ref", std::string( "#" ) } } } } },
+			{ "tag", JsonValue::ObjectType { { "anyOf", JsonValue::ArrayType {
+				JsonValue::ObjectType { { "type", std::string( "null" ) } },
+				JsonValue::ObjectType { { "enum", JsonValue::ArrayType { JsonValue( std::string( "red" ) ), JsonValue( true ) } } } } } } } } },
+		{ "additionalProperties", JsonValue( false ) } } );
+	const JsonSchema schema( node );
+
+	JsonValue leaf( JsonValue::ObjectType { { "name", std::string( "leaf" ) }, { "weight", JsonValue( 3 ) }, { "tag", JsonValue( true ) } } );
+	JsonValue tree( JsonValue::ObjectType { { "name", std::string( "root" ) }, { "children", JsonValue::ArrayType { leaf } } } );
+	EXPECT_TRUE( schema.validate( leaf ) );
+	EXPECT_TRUE( schema.validate( tree ) );
+
+	EXPECT_FALSE( schema.validate( JsonValue( JsonValue::ObjectType { { "weight", JsonValue( 1 ) } } ) ) );
+	EXPECT_FALSE( schema.validate( JsonValue( JsonValue::ObjectType { { "name", std::string( "Upper" ) } } ) ) );
+	EXPECT_FALSE( schema.validate( JsonValue( JsonValue::ObjectType { { "name", std::string( "a" ) }, { "weight", JsonValue( -1 ) } } ) ) );
+	EXPECT_FALSE( schema.validate( JsonValue( JsonValue::ObjectType { { "name", std::string( "a" ) }, { "weight", JsonValue( 1.5L ) } } ) ) );
+	EXPECT_FALSE( schema.validate( JsonValue( JsonValue::ObjectType { { "name", std::string( "a" ) }, { "tag", std::string( "blue" ) } } ) ) );
+	EXPECT_FALSE( schema.validate( JsonValue( JsonValue::ObjectType { { "name", std::string( "a" ) }, { "extra", nullptr } } ) ) );
+
+	tree[ "children" ][ 0 ][ "name" ] = JsonValue( false );
+	EXPECT_FALSE( schema.validate( tree ) );
+
+	const JsonSchema dependent( JsonValue( JsonValue::ObjectType { { "dependentSchemas", JsonValue::ObjectType {
+		{ "a", JsonValue::ObjectType { { "required", JsonValue::ArrayType { JsonValue( std::string( "b" ) ) } } } } } } } ) );
+	EXPECT_FALSE( dependent.validate( JsonValue( JsonValue::ObjectType { { "a", JsonValue( 1 ) } } ) ) );
+	EXPECT_TRUE( dependent.validate( JsonValue( JsonValue::ObjectType { { "a", JsonValue( 1 ) }, { "b", JsonValue( 2 ) } } ) ) );
+	EXPECT_TRUE( dependent.validate( JsonValue( JsonValue::ObjectType { { "c", JsonValue( 3 ) } } ) ) );
+	JsonValue parsed;
+	EXPECT_THROW( parsed.parse( std::string( "{ \"a\": 1 }" ), dependent ), ParseError );
+	parsed.parse( std::string( "{ \"a\": 1, \"b\": 2 }" ), dependent );
+
+	EXPECT_THROW( JsonSchema( JsonValue( JsonValue::ObjectType { { "$ref", std::string( "other.json#/item" ) } } ) ), std::invalid_argument );
+	EXPECT_THROW( JsonSchema( JsonValue( JsonValue::ObjectType { { "unevaluatedProperties", JsonValue( false ) } } ) ), std::invalid_argument );
+	EXPECT_THROW( JsonSchema( JsonValue( JsonValue::ObjectType { { "$anchor", std::string( "item" ) } } ) ), std::invalid_argument );
+	EXPECT_THROW( JsonSchema( JsonValue( JsonValue::ObjectType { { "additionalItems", JsonValue( false ) } } ) ), std::invalid_argument );
+	EXPECT_THROW( JsonSchema( JsonValue( JsonValue::ObjectType { { "type", std::string( "text" ) } } ) ), std::invalid_argument );
+}
+
+TEST( JsonSchema, ParseShouldValidateWhileParsingAndStopAtTheFirstViolation )
+{
+	const JsonSchema schema( JsonValue( JsonValue::ObjectType {
+		{ "type", std::string( "object" ) },
+		{ "required", JsonValue::ArrayType { JsonValue( std::string( "id" ) ), JsonValue( std::string( "rows" ) ) } },
+		{ "properties", JsonValue::ObjectType {
+			{ "id", JsonValue::ObjectType { { "type", std::string( "string" ) } } },
+			{ "rows", JsonValue::ObjectType { { "type", std::string( "array" ) }, { "items", JsonValue::ObjectType { { "type", std::string( "boolean" ) } } } } } } } } ) );
+
+	JsonValue document;
+	document.parse( std::string( "{ \"id\": \"a\", \"rows\": [ true, false ] }" ), schema );
+	JsonValue expected;
+	expected.parse( std::string( "{ \"id\": \"a\", \"rows\": [ true, false ] }" ) );
+	EXPECT_EQ( expected, document );
+
+	EXPECT_THROW( document.parse( std::string( "{ \"id\": \"a\" }" ), schema ), ParseError );
+	EXPECT_THROW( document.parse( std::string( "{ \"id\": \"a\", \"rows\": [ true, null ] }" ), schema ), ParseError );
+
+	// Numbers are checked against the numeric keywords as they are read.
+	const JsonSchema numbers( JsonValue( JsonValue::ObjectType {
+		{ "type", std::string( "array" ) },
+		{ "items", JsonValue::ObjectType { { "type", std::string( "integer" ) }, { "minimum", JsonValue( -10 ) },
+			{ "maximum", JsonValue( 100 ) }, { "multipleOf", JsonValue( 5 ) } } } } ) );
+	document.parse( std::string( "[ -10, 0, 5, 100 ]" ), numbers );
+	EXPECT_EQ( 4, document.size() );
+	EXPECT_THROW( document.parse( std::string( "[ 0, 105 ]" ), numbers ), ParseError );
+	EXPECT_THROW( document.parse( std::string( "[ -15 ]" ), numbers ), ParseError );
+	EXPECT_THROW( document.parse( std::string( "[ 7 ]" ), numbers ), ParseError );
+	EXPECT_THROW( document.parse( std::string( "[ 2.5 ]" ), numbers ), ParseError );
+
+	const JsonSchema ratios( JsonValue( JsonValue::ObjectType {
+		{ "exclusiveMinimum", JsonValue( 0 ) }, { "exclusiveMaximum", JsonValue( 1.5 ) }, { "multipleOf", JsonValue( 0.25 ) } } ) );
+	document.parse( std::string( "1.25" ), ratios );
+	EXPECT_THROW( document.parse( std::string( "0" ), ratios ), ParseError );
+	EXPECT_THROW( document.parse( std::string( "1.5" ), ratios ), ParseError );
+	EXPECT_THROW( document.parse( std::string( "0.3" ), ratios ), ParseError );
+
+	// The mistyped member comes first, so parsing stops long before the end of the file.
+	std::string text( "{ \"id\": false, \"rows\": [ true" );
+	for ( size_t row = 0; row < 100000; ++row )
+	{
+		text.append( ", true" );
+	}
+	text.append( " ] }" );
+
+	const std::string path = ::testing::TempDir() + "test_Json.schema.json";
+	FILE* file = fopen( path.c_str(), "w+b" );
+	ASSERT_NE( nullptr, file );
+	fwrite( text.data(), 1, text.length(), file );
+	rewind( file );
+	EXPECT_THROW( document.parse( file, schema ), ParseError );
+	EXPECT_LT( ftell( file ), 4096 );
+	fclose( file );
+	std::remove( path.c_str() );
+}
+
+struct BoundPoint
+{
+	int32_t x = 0;
+	int32_t y = 0;
+};
+
+constexpr auto jsonFields( const BoundPoint* )
+{
+	return std::make_tuple( JsonValue::bind( "x", &BoundPoint::x ), JsonValue::bind( "y", &BoundPoint::y ) );
+}
+
+struct BoundMessage
+{
+	std::string name;
+	uint8_t priority = 0;
+	double ratio = 0.0;
+	bool isUrgent = false;
+	std::vector< BoundPoint > path;
+	std::vector< bool > flags;
+	JsonValue extra;
+};
+
+constexpr auto jsonFields( const BoundMessage* )
+{
+	return std::make_tuple( JsonValue::bind( "name", &BoundMessage::name ), JsonValue::bind( "priority", &BoundMessage::priority ),
+		JsonValue::bind( "ratio", &BoundMessage::ratio ), JsonValue::bind( "urgent", &BoundMessage::isUrgent ),
+		JsonValue::bind( "path", &BoundMessage::path ), JsonValue::bind( "flags", &BoundMessage::flags ),
+		JsonValue::bind( "extra", &BoundMessage::extra ) );
+}
+
+TEST( JsonValueBinding, ParseIntoShouldFillBoundTypesAndSkipUnknownMembers )
+{
+	BoundMessage message;
+	message.ratio = 4.0;
+	JsonValue::parseInto( std::string( "{ \"name\": \"route\", \"priority\": 7, \"ignored\": { \"deep\": [ 1, { } ] },"
+		" \"urgent\": true, \"path\": [ { \"x\": -3, \"y\": 4 }, { \"y\": 1 } ], \"flags\": [ false, true ],"
+		" \"extra\": { \"n\": 5, \"d\": -12, \"r\": 0.5 } }" ), message );
+
+	EXPECT_EQ( "route", message.name );
+	EXPECT_EQ( 7, message.priority );
+	EXPECT_EQ( 4.0, message.ratio );
+	EXPECT_TRUE( message.isUrgent );
+	ASSERT_EQ( 2u, message.path.size() );
+	EXPECT_EQ( -3, message.path[ 0 ].x );
+	EXPECT_EQ( 4, message.path[ 0 ].y );
+	EXPECT_EQ( 0, message.path[ 1 ].x );
+	EXPECT_EQ( 1, message.path[ 1 ].y );
+	EXPECT_EQ( std::vector< bool >( { false, true } ), message.flags );
+	std::string extra;
+	message.extra.dumps( extra );
+	EXPECT_EQ( "{\"d\":-12,\"n\":5,\"r\":5.000000000000000000000e-01}", extra );
+
+	JsonValue::parseInto( std::string( "{ \"ratio\": -2.5e-1 }" ), message );
+	EXPECT_EQ( -0.25, message.ratio );
+}
+
+TEST( JsonValueBinding, ParseIntoShouldRejectValuesThatDoNotFitTheirField )
+{
+	BoundMessage message;
+	EXPECT_THROW( JsonValue::parseInto( std::string( "{ \"priority\": 256 }" ), message ), ParseError );
+	EXPECT_THROW( JsonValue::parseInto( std::string( "{ \"priority\": -1 }" ), message ), ParseError );
+	EXPECT_THROW( JsonValue::parseInto( std::string( "{ \"priority\": 1.5 }" ), message ), ParseError );
+	EXPECT_THROW( JsonValue::parseInto( std::string( "{ \"priority\": 01 }" ), message ), ParseError );
+	EXPECT_THROW( JsonValue::parseInto( std::string( "{ \"name\": 1 }" ), message ), ParseError );
+	EXPECT_THROW( JsonValue::parseInto( std::string( "{ \"urgent\": null }" ), message ), ParseError );
+	EXPECT_THROW( JsonValue::parseInto( std::string( "{ \"path\": [ { \"x\": 1 }, ] }" ), message ), ParseError );
+	EXPECT_THROW( JsonValue::parseInto( std::string( "[ ]" ), message ), ParseError );
+	EXPECT_THROW( JsonValue::parseInto( std::string( "{ \"ratio\": 1e309 }" ), message ), ParseError );
+	EXPECT_THROW( JsonValue::parseInto( std::string( "{ \"ratio\": -1e309 }" ), message ), ParseError );
+
+	BoundPoint point;
+	JsonValue::parseInto( std::string( "{ \"x\": 2147483647, \"y\": -2147483648 }" ), point );
+	EXPECT_EQ( INT32_MAX, point.x );
+	EXPECT_EQ( INT32_MIN, point.y );
+	EXPECT_THROW( JsonValue::parseInto( std::string( "{ \"x\": 2147483648 }" ), point ), ParseError );
+}
+
+TEST( JsonValueBinding, ParseIntoShouldReadFieldsInOrderAndFallBackOnTheFirstMismatch )
+{
+	BoundMessage message;
+	message.name = "feed";
+	message.priority = 9;
+	message.isUrgent = true;
+	message.path = { BoundPoint(), BoundPoint() };
+	message.path[ 1 ].y = -7;
+	message.extra = JsonValue( JsonValue::ArrayType { nullptr } );
+
+	for ( JsonValue::Indent indent : { JsonValue::Indent::NONE, JsonValue::Indent::TAB } )
+	{
+		std::string text;
+		JsonValue::serialize( message, text, indent );
+
+		BoundMessage decoded;
+		JsonValue::parseInto( text, decoded );
+		EXPECT_EQ( message.name, decoded.name );
+		EXPECT_EQ( message.priority, decoded.priority );
+		EXPECT_TRUE( decoded.isUrgent );
+		ASSERT_EQ( 2u, decoded.path.size() );
+		EXPECT_EQ( -7, decoded.path[ 1 ].y );
+		EXPECT_EQ( message.extra, decoded.extra );
+	}
+
+	BoundMessage decoded;
+	JsonValue::parseInto( std::string( "{\"name\":\"a\",\"unknown\":[1],\"ratio\":0.5,\"priority\":3,\"name\":\"b\"}" ), decoded );
+	EXPECT_EQ( "b", decoded.name );
+	EXPECT_EQ( 3, decoded.priority );
+	EXPECT_EQ( 0.5, decoded.ratio );
+
+	EXPECT_THROW( JsonValue::parseInto( std::string( "{\"name\":\"a\" \"priority\":1}" ), decoded ), ParseError );
+	EXPECT_THROW( JsonValue::parseInto( std::string( "{\"name\":\"a\",}" ), decoded ), ParseError );
+	EXPECT_THROW( JsonValue::parseInto( std::string( "{\"name\":\"a\",\"priority\":1" ), decoded ), ParseError );
+}
+
+struct BoundReport
+{
+	BoundPoint origin;
+	std::map< std::string, std::vector< double > > series;
+	std::string note;
+	JsonValue extra;
+};
+
+constexpr auto jsonFields( const BoundReport* )
+{
+	return std::make_tuple( JsonValue::bind( "origin", &BoundReport::origin ), JsonValue::bind( "series", &BoundReport::series ),
+		JsonValue::bind( "say \"hi\"\n", &BoundReport::note ), JsonValue::bind( "extra", &BoundReport::extra ) );
+}
+
+TEST( JsonValueBinding, SerializeShouldWriteBoundTypesAsDumpWouldWriteTheirTree )
+{
+	BoundReport report;
+	report.origin.x = -3;
+	report.origin.y = 4;
+	report.series[ "a\tb" ] = { 0.5 };
+	report.note = "line\nbreak";
+	report.extra = JsonValue( JsonValue::ArrayType { JsonValue( true ), nullptr } );
+
+	std::string text;
+	JsonValue::serialize( report, text );
+	EXPECT_EQ( "{\"origin\":{\"x\":-3,\"y\":4},\"series\":{\"a\\tb\":[" + JsonValue( 0.5L ).stringify()
+		+ "]},\"say \\\"hi\\\"\\n\":\"line\\nbreak\",\"extra\":[true,null]}", text );
+
+	std::string indented;
+	JsonValue::serialize( report.origin, indented, JsonValue::Indent::TAB );
+	EXPECT_EQ( "{\n\t\"x\": -3,\n\t\"y\": 4\n}", indented );
+	EXPECT_EQ( JsonValue( JsonValue::ObjectType { { "x", JsonValue( -3 ) }, { "y", JsonValue( 4 ) } } ).stringify( JsonValue::Indent::TAB ), indented );
+
+	BoundReport decoded;
+	JsonValue::parseInto( text, decoded );
+	EXPECT_EQ( -3, decoded.origin.x );
+	EXPECT_EQ( 4, decoded.origin.y );
+	EXPECT_EQ( report.series, decoded.series );
+	EXPECT_EQ( report.note, decoded.note );
+	EXPECT_EQ( report.extra, decoded.extra );
+
+	std::string flags;
+	JsonValue::serialize( std::vector< bool > { true, false }, flags );
+	EXPECT_EQ( "[true,false]", flags );
+
+	// An unset JsonValue field, like any undefined value, is written as null.
+	std::string unset;
+	JsonValue::serialize( BoundReport(), unset );
+	EXPECT_EQ( "\"extra\":null}", unset.substr( unset.length() - 13 ) );
+
+	JsonValue members( Type::object );
+	members[ "k" ];
+	EXPECT_EQ( "{\"k\":null}", members.stringify() );
+	EXPECT_EQ( "[null]", JsonValue( JsonValue::ArrayType { JsonValue() } ).stringify() );
+}
+
+TEST( JsonValueString, StringsShouldBeEscapedWhenWrittenAndUnescapedWhenParsed )
+{
+	JsonValue document( JsonValue::ObjectType { { "quote\"", std::string( "back\\slash\x01\u00e9" ) } } );
+	EXPECT_EQ( "{\"quote\\\"\":\"back\\\\slash\\u0001\u00e9\"}", document.stringify() );
+
+	JsonValue decoded;
+	decoded.parse( document.stringify() );
+	EXPECT_EQ( document, decoded );
+
+	decoded.parse( std::string( "\"\\u00e9\\ud83d\\ude00\\/\\ud800x\"" ) );
+	EXPECT_EQ( std::string( "\u00e9\U0001F600/\uFFFDx" ), std::string( decoded ) );
+}
+
+TEST( JsonValueString, ParseShouldAcceptWellFormedUTF8AtAnyOffset )
+{
+	const std::string characters[] = { "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80",
+		"\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF" };
+	JsonValue decoded;
+
+	for ( const std::string& character : characters )
+	{
+		for ( size_t padding( 0 ); padding < 40; padding += 7 )
+		{
+			const std::string text = std::string( padding, 'a' ) + character + std::string( 20, 'z' );
+			decoded.parse( "\"" + text + "\"" );
+			EXPECT_EQ( text, std::string( decoded ) );
+		}
+	}
+}
+
+TEST( JsonValueString, ParseShouldRejectMalformedUTF8WhereverItIsRead )
+{
+	const std::string sequences[] = { "\x80", "\xBF", "\xC0\xAF", "\xC1\xBF", "\xC2", "\xC2\x41", "\xE0\x80\x80",
+		"\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF", "\xE2\x82", "\xF0\x80\x80\x80", "\xF4\x90\x80\x80",
+		"\xF5\x80\x80\x80", "\xFF" };
+	JsonValue decoded;
+	BoundPoint point;
+
+	for ( const std::string& sequence : sequences )
+	{
+		for ( size_t padding( 0 ); padding < 40; padding += 13 )
+		{
+			const std::string text = "\"" + std::string( padding, 'a' ) + sequence + "\"";
+			EXPECT_THROW( decoded.parse( text ), ParseError ) << padding;
+			EXPECT_THROW( JsonValue::parseInto( "{ " + text + ": 1 }", point ), ParseError ) << padding;
+			EXPECT_THROW( JsonValue::parseInto( "{ \"x\": 1, \"skipped\": " + text + " }", point ), ParseError ) << padding;
+		}
+	}
+
+	EXPECT_THROW( decoded.parse( std::string( "\"tab\tinside\"" ) ), ParseError );
+	EXPECT_THROW( decoded.parse( std::string( "\"unterminated" ) ), ParseError );
+}
+
+static constexpr char LITERAL_TEXT[] = R"({
+	"name": "literal", "port": 8080, "limits": [ -3, 0.5, 1e3 ],
+	"escaped": "tab\t\u00e9\ud83d\ude00", "on": true, "none": null })";
+static constexpr auto LITERAL = JsonValue::literal< JsonValue::literalNodeCount( LITERAL_TEXT ) >( LITERAL_TEXT );
+
+constexpr uintmax_t literalPort()
+{
+	uintmax_t port = 0;
+	return LITERAL.root()[ "port" ].get( port ) ? port : 0;
+}
+
+TEST( JsonLiteral, LiteralShouldBeParsedAndQueriedAtCompileTime )
+{
+	static_assert( 8080 == literalPort(), "Lookups on a constexpr literal fold to their result" );
+	static_assert( 16 == LITERAL.size(), "Every key, element and container is a node" );
+	static_assert( LITERAL.root()[ "limits" ][ 2 ].is( Type::number ), "Elements are found by index" );
+	static_assert( not LITERAL.root()[ "missing" ], "Missing members give an invalid view" );
+
+	const JsonLiteralView root = LITERAL.root();
+	EXPECT_STREQ( "escaped", root.keyAt( 0 ).c_str() );
+	EXPECT_STREQ( "tab\t\xC3\xA9\xF0\x9F\x98\x80", root[ "escaped" ].c_str() );
+
+	intmax_t integral = 0;
+	long double floating = 0.0L;
+	EXPECT_TRUE( root[ "limits" ][ 0 ].get( integral ) );
+	EXPECT_EQ( -3, integral );
+	EXPECT_TRUE( root[ "limits" ][ 1 ].get( floating ) );
+	EXPECT_EQ( 0.5L, floating );
+
+	JsonValue document( JsonValue::ObjectType {
+		{ "name", std::string( "literal" ) },
+		{ "port", JsonValue( uintmax_t( 8080 ) ) },
+		{ "limits", JsonValue::ArrayType { JsonValue( -3 ), JsonValue( 0.5L ), JsonValue( 1000.0L ) } },
+		{ "escaped", std::string( "tab\t\xC3\xA9\xF0\x9F\x98\x80" ) },
+		{ "on", JsonValue( true ) },
+		{ "none", nullptr } } );
+	EXPECT_EQ( document, root.toJsonValue() );
+}
+
+TEST( JsonLiteral, LiteralShouldRejectInvalidTextWhenBuiltAtRunTime )
+{
+	const auto ordered = JsonValue::literal( "{ \"b\": -9223372036854775808, \"a\": 100000000000000000000 }" );
+	intmax_t minimum = 0;
+	long double beyond = 0.0L;
+	EXPECT_STREQ( "a", ordered.root().keyAt( 0 ).c_str() );
+	EXPECT_TRUE( ordered.root()[ "b" ].get( minimum ) );
+	EXPECT_EQ( INTMAX_MIN, minimum );
+	EXPECT_TRUE( ordered.root()[ "a" ].get( beyond ) );
+	EXPECT_EQ( 1e20L, beyond );
+
+	EXPECT_THROW( JsonValue::literal( "[ 1, ]" ), std::invalid_argument );
+	EXPECT_THROW( JsonValue::literal( "[ 1 ] 2" ), std::invalid_argument );
+	EXPECT_THROW( JsonValue::literal( "[ 01 ]" ), std::invalid_argument );
+	EXPECT_THROW( JsonValue::literal( "{ \"a\": 1, \"a\": 2 }" ), std::invalid_argument );
+	EXPECT_THROW( JsonValue::literal( "\"\\x\"" ), std::invalid_argument );
+	EXPECT_THROW( JsonValue::literal( "{ \"a\" 1 }" ), std::invalid_argument );
+	EXPECT_THROW( JsonValue::literal< 2 >( "[ 1, 2 ]" ), std::invalid_argument );
+}
+
+JsonValue parsedJson( const std::string& text )
+{
+	JsonValue value;
+	value.parse( text );
+	return value;
+}
+
+TEST( JsonValuePatch, ApplyPatchShouldApplyEveryOperationInPlace )
+{
+	JsonValue document = parsedJson( R"({ "foo": { "bar": "baz", "waldo": "fred" }, "qux": { "corge": "grault" },
+		"list": [ "a", "b", "c" ], "flag": true })" );
+
+	document.applyPatch( parsedJson( R"([
+		{ "op": "add", "path": "/list/1", "value": "x" },
+		{ "op": "add", "path": "/list/-", "value": [ null ] },
+		{ "op": "remove", "path": "/list/0" },
+		{ "op": "replace", "path": "/flag", "value": false },
+		{ "op": "move", "from": "/foo/waldo", "path": "/qux/thud" },
+		{ "op": "move", "from": "/list/0", "path": "/list/2" },
+		{ "op": "copy", "from": "/qux", "path": "/copied" },
+		{ "op": "add", "path": "/foo/bar", "value": "replaced" },
+		{ "op": "test", "path": "/copied/thud", "value": "fred" },
+		{ "op": "add", "path": "/~1escaped~0", "value": { } }
+	])" ) );
+
+	EXPECT_EQ( parsedJson( R"({ "foo": { "bar": "replaced" }, "qux": { "corge": "grault", "thud": "fred" },
+		"list": [ "b", "c", "x", [ null ] ], "flag": false, "copied": { "corge": "grault", "thud": "fred" },
+		"/escaped~": { } })" ), document );
+
+	document.applyPatch( parsedJson( R"([ { "op": "replace", "path": "", "value": [ "whole" ] } ])" ) );
+	EXPECT_EQ( parsedJson( R"([ "whole" ])" ), document );
+
+	JsonValue numbers( JsonValue::ArrayType { JsonValue( 1 ) } );
+	JsonValue test( JsonValue::ArrayType { JsonValue( JsonValue::ObjectType {
+		{ "op", std::string( "test" ) }, { "path", std::string( "/0" ) }, { "value", JsonValue( 1.0L ) } } ) } );
+	EXPECT_NO_THROW( numbers.applyPatch( test ) );
+}
+
+TEST( JsonValuePatch, AtomicApplyPatchShouldRollBackFromItsUndoLog )
+{
+	const JsonValue original = parsedJson( R"({ "a": { "b": [ "c", "d" ] }, "e": "f", "g": [ true, false ] })" );
+	const JsonValue failing = parsedJson( R"([
+		{ "op": "remove", "path": "/e" },
+		{ "op": "add", "path": "/a/b/0", "value": "new" },
+		{ "op": "add", "path": "/g/-", "value": null },
+		{ "op": "replace", "path": "/a", "value": "flat" },
+		{ "op": "move", "from": "/g/0", "path": "/moved" },
+		{ "op": "add", "path": "", "value": { "root": true } },
+		{ "op": "test", "path": "/root", "value": false }
+	])" );
+
+	JsonValue document = original;
+	EXPECT_THROW( document.applyPatch( failing ), std::runtime_error );
+	EXPECT_EQ( original, document );
+
+	EXPECT_THROW( document.applyPatch( parsedJson( R"([ { "op": "move", "from": "/g/0", "path": "/g/5" } ])" ), false ), std::runtime_error );
+	EXPECT_EQ( original, document );
+	EXPECT_THROW( document.applyPatch( parsedJson( R"([ { "op": "move", "from": "/a", "path": "/a/b/x" } ])" ) ), std::runtime_error );
+	EXPECT_THROW( document.applyPatch( parsedJson( R"([ { "op": "remove", "path": "/g/-" } ])" ) ), std::runtime_error );
+	EXPECT_THROW( document.applyPatch( parsedJson( R"([ { "op": "add", "path": "/missing/x", "value": 0 } ])" ) ), std::runtime_error );
+	EXPECT_EQ( original, document );
+
+	EXPECT_THROW( document.applyPatch( parsedJson( R"([ { "op": "remove", "path": "/e" }, { "op": "fly", "path": "" } ])" ) ), std::invalid_argument );
+	EXPECT_THROW( document.applyPatch( parsedJson( R"([ { "op": "add", "path": "/e" } ])" ) ), std::invalid_argument );
+	EXPECT_THROW( document.applyPatch( parsedJson( R"([ { "op": "copy", "path": "/e" } ])" ) ), std::invalid_argument );
+	EXPECT_THROW( document.applyPatch( parsedJson( R"([ { "op": "remove", "path": "e" } ])" ) ), std::invalid_argument );
+	EXPECT_EQ( original, document );
+
+	EXPECT_THROW( document.applyPatch( parsedJson( R"([ { "op": "remove", "path": "/e" }, { "op": "remove", "path": "/e" } ])" ), false ),
+		std::runtime_error );
+	EXPECT_EQ( nullptr, document.find( "e" ) );
+	EXPECT_NE( nullptr, document.find( "a" ) );
+}
+
+TEST( JsonValuePatch, ApplyPatchShouldKeepIndexesOverTheArrayUpToDate )
+{
+	JsonValue document = parsedJson( R"({ "records": [ { "id": 1 }, { "id": 2 }, { "id": 3 } ] })" );
+	JsonValue& records = *document.find( "records" );
+	JsonIndex byId = records.buildIndex( "/id" );
+
+	document.applyPatch( parsedJson( R"([
+		{ "op": "add", "path": "/records/0", "value": { "id": 0 } },
+		{ "op": "remove", "path": "/records/2" },
+		{ "op": "replace", "path": "/records/1", "value": { "id": 5 } },
+		{ "op": "move", "from": "/records/0", "path": "/records/-" }
+	])" ) );
+	EXPECT_EQ( parsedJson( R"([ { "id": 5 }, { "id": 3 }, { "id": 0 } ])" ), records );
+	EXPECT_EQ( records.at( 1 ), byId.find( JsonValue( 3 ) ) );
+	EXPECT_EQ( records.at( 2 ), byId.find( JsonValue( 0 ) ) );
+	EXPECT_EQ( records.at( 0 ), byId.find( JsonValue( 5 ) ) );
+	EXPECT_EQ( nullptr, byId.find( JsonValue( 1 ) ) );
+	EXPECT_EQ( nullptr, byId.find( JsonValue( 2 ) ) );
+	EXPECT_EQ( 3, byId.size() );
+
+	// Rolling back a failed atomic patch restores the index along with the elements.
+	EXPECT_THROW( document.applyPatch( parsedJson( R"([
+		{ "op": "add", "path": "/records/0", "value": { "id": 9 } },
+		{ "op": "replace", "path": "/records/2", "value": { "id": 8 } },
+		{ "op": "remove", "path": "/records/1" },
+		{ "op": "test", "path": "/records/0/id", "value": 0 }
+	])" ) ), std::runtime_error );
+	EXPECT_EQ( parsedJson( R"([ { "id": 5 }, { "id": 3 }, { "id": 0 } ])" ), records );
+	EXPECT_EQ( records.at( 1 ), byId.find( JsonValue( 3 ) ) );
+	EXPECT_EQ( records.at( 2 ), byId.find( JsonValue( 0 ) ) );
+	EXPECT_EQ( nullptr, byId.find( JsonValue( 9 ) ) );
+	EXPECT_EQ( nullptr, byId.find( JsonValue( 8 ) ) );
+	EXPECT_EQ( 3, byId.size() );
+}
+
+TEST( JsonValueMergePatch, MergePatchShouldFollowTheRfcExamples )
+{
+	const char* const EXAMPLES[][ 3 ] = {
+		{ R"({ "a": "b" })", R"({ "a": "c" })", R"({ "a": "c" })" },
+		{ R"({ "a": "b" })", R"({ "b": "c" })", R"({ "a": "b", "b": "c" })" },
+		{ R"({ "a": "b" })", R"({ "a": null })", R"({})" },
+		{ R"({ "a": "b", "b": "c" })", R"({ "a": null })", R"({ "b": "c" })" },
+		{ R"({ "a": [ "b" ] })", R"({ "a": "c" })", R"({ "a": "c" })" },
+		{ R"({ "a": "c" })", R"({ "a": [ "b" ] })", R"({ "a": [ "b" ] })" },
+		{ R"({ "a": { "b": "c" } })", R"({ "a": { "b": "d", "c": null } })", R"({ "a": { "b": "d" } })" },
+		{ R"({ "a": [ { "b": "c" } ] })", R"({ "a": [ true ] })", R"({ "a": [ true ] })" },
+		{ R"([ "a", "b" ])", R"([ "c", "d" ])", R"([ "c", "d" ])" },
+		{ R"({ "a": "b" })", R"([ "c" ])", R"([ "c" ])" },
+		{ R"({ "a": "foo" })", R"(null)", R"(null)" },
+		{ R"({ "e": null })", R"({ "a": true })", R"({ "e": null, "a": true })" },
+		{ R"([ true ])", R"({ "a": "b", "c": null })", R"({ "a": "b" })" },
+		{ R"({})", R"({ "a": { "bb": { "ccc": null } } })", R"({ "a": { "bb": {} } })" }
+	};
+
+	for ( const auto& example : EXAMPLES )
+	{
+		JsonValue moved = parsedJson( example[ 0 ] );
+		moved.mergePatch( parsedJson( example[ 1 ] ) );
+		EXPECT_EQ( parsedJson( example[ 2 ] ), moved ) << example[ 1 ];
+
+		const JsonValue patch = parsedJson( example[ 1 ] );
+		JsonValue copied = parsedJson( example[ 0 ] );
+		copied.mergePatch( patch );
+		EXPECT_EQ( parsedJson( example[ 2 ] ), copied ) << example[ 1 ];
+	}
+
+	JsonValue document = parsedJson( R"({ "a": { "b": null, "c": "d" }, "e": null })" );
+	document.mergePatch( document );
+	EXPECT_EQ( parsedJson( R"({ "a": { "c": "d" } })" ), document );
+
+	// Changes close together are found by stepping through the members, those far apart by a lookup.
+	JsonValue wide( Type::object );
+	JsonValue expected( Type::object );
+	for ( int key = 100; key < 200; ++key )
+	{
+		wide[ std::to_string( key ) ] = JsonValue( key );
+		if ( ( 101 != key ) and ( 199 != key ) )
+		{
+			expected[ std::to_string( key ) ] = JsonValue( key );
+		}
+	}
+
+	wide.mergePatch( parsedJson( R"({ "101": null, "1015": "new", "103": true, "150": { "x": 1, "y": null }, "199": null,
+		"2": [ null ], "3": null })" ) );
+	expected[ "1015" ] = JsonValue( std::string( "new" ) );
+	expected[ "103" ] = JsonValue( true );
+	expected[ "150" ] = parsedJson( R"({ "x": 1 })" );
+	expected[ "2" ] = parsedJson( "[ null ]" );
+	EXPECT_EQ( expected, wide );
+}
+
+TEST( JsonValueMergePatch, MovedMergePatchShouldMoveItsValuesIntoTheTarget )
+{
+	JsonValue document = parsedJson( R"({ "name": "base", "servers": [ "a" ], "tls": { "enabled": false, "ca": "x" } })" );
+	JsonValue layers[] = {
+		parsedJson( R"({ "servers": [ "b", "c" ], "tls": { "enabled": true } })" ),
+		parsedJson( R"({ "tls": { "ca": null, "mode": "strict" }, "extra": { "debug": true } })" )
+	};
+
+	const JsonValue* const servers = &layers[ 0 ][ "servers" ][ 0 ];
+	const JsonValue* const debug = &layers[ 1 ][ "extra" ][ "debug" ];
+	for ( JsonValue& layer : layers )
+	{
+		document.mergePatch( std::move( layer ) );
+	}
+
+	EXPECT_EQ( parsedJson( R"({ "name": "base", "servers": [ "b", "c" ], "tls": { "enabled": true, "mode": "strict" },
+		"extra": { "debug": true } })" ), document );
+	EXPECT_EQ( servers, &document[ "servers" ][ 0 ] );
+	EXPECT_NE( debug, &document[ "extra" ][ "debug" ] );
+
+	document.mergePatch( std::move( document[ "tls" ] ) );
+	EXPECT_EQ( JsonValue( true ), document[ "enabled" ] );
+	EXPECT_EQ( JsonValue( std::string( "strict" ) ), document[ "mode" ] );
+	EXPECT_EQ( JsonValue( std::string( "base" ) ), document[ "name" ] );
+}
+
+TEST( JsonValueDiff, DiffShouldProduceAPatchThatTurnsSourceIntoTarget )
+{
+	const char* const PAIRS[][ 2 ] = {
+		{ R"({ "a": "b", "c": { "d": "e", "f": [ "g" ] } })", R"({ "a": "b", "c": { "d": "x", "f": [ "g", "h" ] }, "i": true })" },
+		{ R"([ "a", "b", "c", "d", "e" ])", R"([ "x", "b", "d", "y", "e", "z" ])" },
+		{ R"([ "a", "b" ])", R"([])" },
+		{ R"([])", R"([ { "a": null }, [ "b" ] ])" },
+		{ R"({ "a/b": "c", "d~e": [ true ] })", R"({ "a/b": "x", "d~e": [ false ] })" },
+		{ R"([ [ "a", "b" ], { "c": "d" } ])", R"([ { "c": "e" }, [ "a", "b" ], "f" ])" },
+		{ R"({ "a": [ "b" ] })", R"([ "b" ])" },
+		{ R"("a")", R"(null)" }
+	};
+
+	for ( const auto& pair : PAIRS )
+	{
+		const JsonValue source = parsedJson( pair[ 0 ] );
+		const JsonValue target = parsedJson( pair[ 1 ] );
+
+		JsonValue patched = source;
+		patched.applyPatch( JsonValue::diff( source, target ) );
+		EXPECT_EQ( target, patched ) << pair[ 0 ] << " to " << pair[ 1 ];
+		EXPECT_EQ( parsedJson( "[]" ), JsonValue::diff( target, target ) );
+	}
+
+	// Arrays too long to align with a table are aligned on their unique elements.
+	JsonValue longSource( JsonValue::Type::array );
+	JsonValue longTarget( JsonValue::Type::array );
+	for ( size_t position( 0 ); position < 3000; ++position )
+	{
+		longSource.push_back( JsonValue( std::to_string( position ) ) );
+		if ( 0 != position % 100 )
+		{
+			longTarget.push_back( JsonValue( std::to_string( position ) ) );
+		}
+	}
+
+	longTarget.insert( 1500, JsonValue( std::string( "inserted" ) ) );
+	JsonValue longPatched = longSource;
+	const JsonValue longPatch = JsonValue::diff( longSource, longTarget );
+	longPatched.applyPatch( longPatch );
+	EXPECT_EQ( longTarget, longPatched );
+	EXPECT_EQ( 31u, longPatch.elements().size() );
+
+	const JsonValue source = parsedJson( R"({ "keep": [ "a", "b", "c" ], "change": { "deep": "old", "same": [ true ] }, "drop": null })" );
+	const JsonValue target = parsedJson( R"({ "keep": [ "a", "x", "b", "c" ], "change": { "deep": "new", "same": [ true ] } })" );
+	EXPECT_EQ( parsedJson( R"([
+		{ "op": "replace", "path": "/change/deep", "value": "new" },
+		{ "op": "remove", "path": "/drop" },
+		{ "op": "add", "path": "/keep/1", "value": "x" }
+	])" ), JsonValue::diff( source, target ) );
+
+	// Subtrees walked past, on either side, leave the hashes of those after them in step.
+	EXPECT_EQ( parsedJson( R"([
+		{ "op": "remove", "path": "/a" },
+		{ "op": "replace", "path": "/m/n/2/o", "value": 3 },
+		{ "op": "add", "path": "/z", "value": [ [ 4 ] ] }
+	])" ), JsonValue::diff( parsedJson( R"({ "a": { "big": [ 1, [ 2, 3 ] ] }, "m": { "n": [ [ 5, 6 ], 1, { "o": 2 } ] } })" ),
+		parsedJson( R"({ "m": { "n": [ [ 5, 6 ], 1, { "o": 3 } ] }, "z": [ [ 4 ] ] })" ) ) );
+}
+
+TEST( JsonValueDiff, KeyedDiffShouldPatchRecordsWhereTheyAre )
+{
+	const JsonValue source = parsedJson( R"({ "records": [
+		{ "id": "a", "name": "first", "tags": [ "x" ] },
+		{ "id": "b", "name": "second", "tags": [ "y" ] },
+		{ "id": "c", "name": "third", "tags": [ "z" ] }
+	] })" );
+	const JsonValue target = parsedJson( R"({ "records": [
+		{ "id": "new", "name": "zeroth", "tags": [] },
+		{ "id": "a", "name": "first", "tags": [ "x" ] },
+		{ "id": "b", "name": "renamed", "tags": [ "y", "w" ] }
+	] })" );
+
+	const JsonValue keyed = JsonValue::diff( source, target, JsonPointer( "/id" ) );
+	EXPECT_EQ( parsedJson( R"([
+		{ "op": "add", "path": "/records/0", "value": { "id": "new", "name": "zeroth", "tags": [] } },
+		{ "op": "replace", "path": "/records/2/name", "value": "renamed" },
+		{ "op": "add", "path": "/records/2/tags/1", "value": "w" },
+		{ "op": "remove", "path": "/records/3" }
+	])" ), keyed );
+
+	JsonValue patched = source;
+	patched.applyPatch( keyed );
+	EXPECT_EQ( target, patched );
+
+	patched = source;
+	patched.applyPatch( JsonValue::diff( source, target ) );
+	EXPECT_EQ( target, patched );
+
+	// Without a key on every element, elements are matched whole.
+	const JsonValue unkeyed = parsedJson( R"([ { "id": "a" }, { "name": "b" } ])" );
+	patched = unkeyed;
+	patched.applyPatch( JsonValue::diff( unkeyed, source[ "records" ], JsonPointer( "/id" ) ) );
+	EXPECT_EQ( source[ "records" ], patched );
+}
+
+TEST( JsonJournal, DrainShouldReturnThePatchOfTheChangesMadeThroughIt )
+{
+	JsonValue document = parsedJson( R"({ "name": "old", "tags": [ "a", "b", "c" ], "nested": { "x": true, "y/z": false } })" );
+	JsonValue replica = document;
+	JsonJournal journal( document );
+
+	journal[ "name" ] = JsonValue( std::string( "first" ) );
+	journal[ "name" ] = JsonValue( std::string( "second" ) );
+	journal[ "added" ] = parsedJson( R"({ "list": [] })" );
+	journal[ "added" ][ "list" ].push_back( JsonValue( true ) );
+	journal[ "tags" ].insert( 0, JsonValue( std::string( "start" ) ) );
+	journal[ "tags" ].erase( 2 );
+	journal[ "tags" ].pop_back();
+	journal[ "tags" ][ 1 ] = JsonValue( nullptr );
+	journal[ "nested" ].erase( "y/z" );
+	journal[ "nested" ].erase( "missing" );
+	EXPECT_EQ( "/nested/x", journal[ "nested" ][ "x" ].path() );
+
+	EXPECT_EQ( 8u, journal.size() );
+	const JsonValue patch = journal.drain();
+	EXPECT_EQ( parsedJson( R"([
+		{ "op": "replace", "path": "/name", "value": "second" },
+		{ "op": "add", "path": "/added", "value": { "list": [] } },
+		{ "op": "add", "path": "/added/list/0", "value": true },
+		{ "op": "add", "path": "/tags/0", "value": "start" },
+		{ "op": "remove", "path": "/tags/2" },
+		{ "op": "remove", "path": "/tags/2" },
+		{ "op": "replace", "path": "/tags/1", "value": null },
+		{ "op": "remove", "path": "/nested/y~1z" }
+	])" ), patch );
+	EXPECT_TRUE( journal.empty() );
+	replica.applyPatch( patch );
+	EXPECT_EQ( document, replica );
+
+	// Each drain holds only what changed since the one before.
+	document = parsedJson( R"({ "a": [ "b", "c" ] })" );
+	replica = document;
+	journal[ "a" ].erase( 0 );
+	journal[ "a" ][ 0 ] = JsonValue( std::string( "d" ) );
+	journal[ "a" ].push_back( replica );
+	journal.root()[ "e" ] = journal[ "a" ][ 0 ];
+	replica.applyPatch( journal.drain() );
+	EXPECT_EQ( document, replica );
+	EXPECT_EQ( parsedJson( "[]" ), journal.drain() );
+
+	// Assigning an element replaces it, even while undefined, as push_back() added it.
+	document = parsedJson( R"({ "list": [] })" );
+	replica = document;
+	journal[ "list" ].push_back( JsonValue() );
+	journal[ "count" ] = JsonValue( 1 );
+	journal[ "list" ][ 0 ] = JsonValue( true );
+	const JsonValue elementPatch = journal.drain();
+	ASSERT_EQ( 3, elementPatch.size() );
+	EXPECT_EQ( JsonValue( std::string( "add" ) ), *elementPatch.at( 0 )->find( "op" ) );
+	EXPECT_EQ( JsonValue( std::string( "add" ) ), *elementPatch.at( 1 )->find( "op" ) );
+	EXPECT_EQ( JsonValue( std::string( "replace" ) ), *elementPatch.at( 2 )->find( "op" ) );
+	replica.applyPatch( elementPatch );
+	EXPECT_EQ( document, replica );
+}
+
+TEST( JsonJournal, ReferencesShouldFailAsJsonValueDoesWithoutRecording )
+{
+	JsonValue document = parsedJson( R"({ "list": [ "a" ], "text": "b" })" );
+	JsonJournal journal( document );
+
+	EXPECT_THROW( journal[ "list" ][ 1 ], std::out_of_range );
+	EXPECT_THROW( journal[ "list" ][ -1 ], std::out_of_range );
+	EXPECT_THROW( journal[ "list" ].insert( 2, JsonValue( true ) ), std::out_of_range );
+	EXPECT_THROW( journal[ "text" ][ "member" ], std::runtime_error );
+	EXPECT_THROW( journal[ "text" ].push_back( JsonValue( true ) ), std::runtime_error );
+	EXPECT_THROW( journal[ "text" ].erase( "member" ), std::runtime_error );
+	EXPECT_THROW( journal[ "list" ].erase( 1 ), std::out_of_range );
+	EXPECT_THROW( journal[ 0 ], std::runtime_error );
+	EXPECT_TRUE( journal.empty() );
+
+	// Reading a missing member, or failing to reach through one, creates nothing.
+	const JsonValue before = document;
+	EXPECT_TRUE( journal[ "peek" ].value().is( Type::undefined ) );
+	EXPECT_THROW( journal[ "a" ][ "b" ] = JsonValue( 2 ), std::runtime_error );
+	EXPECT_THROW( journal[ "a" ].push_back( JsonValue( 2 ) ), std::runtime_error );
+	EXPECT_THROW( journal[ "a" ][ 0 ], std::runtime_error );
+	EXPECT_EQ( before, document );
+	EXPECT_TRUE( journal.empty() );
+
+	// A held reference to a missing member adds it once assigned.
+	auto later = journal[ "later" ];
+	later = JsonValue( 1 );
+	later = JsonValue( 2 );
+	EXPECT_EQ( parsedJson( R"([ { "op": "add", "path": "/later", "value": 2 } ])" ), journal.drain() );
+
+	journal.root() = parsedJson( R"([ "whole" ])" );
+	EXPECT_EQ( JsonValue( std::string( "whole" ) ), journal[ 0 ].value() );
+	EXPECT_EQ( parsedJson( R"([ { "op": "replace", "path": "", "value": [ "whole" ] } ])" ), journal.drain() );
+}
+
+TEST( JsonValueConstAccess, ConstAccessShouldReturnConstReferencesAndNeverAdd )
+{
+	static_assert( std::is_same< decltype( std::declval< const JsonValue& >()[ "key" ] ), const JsonValue& >::value,
+		"Member access of a const JsonValue must not hand out a mutable member" );
+	static_assert( std::is_same< decltype( std::declval< const JsonValue& >()[ std::string() ] ), const JsonValue& >::value,
+		"Member access of a const JsonValue must not hand out a mutable member" );
+	static_assert( std::is_same< decltype( std::declval< const JsonValue& >()[ 0 ] ), const JsonValue& >::value,
+		"Element access of a const JsonValue must not hand out a mutable element" );
+
+	const JsonValue document = parsedJson( R"({ "list": [ "a", "b" ], "text": "c" })" );
+	EXPECT_EQ( document.find( "text" ), &document[ "text" ] );
+	EXPECT_EQ( &document[ std::string( "list" ) ][ 1 ], &document[ "list" ][ -1 ] );
+	EXPECT_THROW( document[ "missing" ], std::out_of_range );
+	EXPECT_THROW( document[ std::string( "missing" ) ], std::out_of_range );
+	EXPECT_THROW( document[ "list" ][ 2 ], std::out_of_range );
+	EXPECT_THROW( document[ "list" ][ -3 ], std::out_of_range );
+	EXPECT_THROW( document[ "text" ][ 0 ], std::runtime_error );
+	EXPECT_THROW( document[ "list" ][ "a" ], std::runtime_error );
+	EXPECT_EQ( parsedJson( R"({ "list": [ "a", "b" ], "text": "c" })" ), document );
+}
+
+TEST( JsonValueConstAccess, ThreadsShouldReadOneFrozenDocumentAtOnce )
+{
+	const JsonValue config = parsedJson( R"({ "name": "service", "limits": { "soft": true, "hard": false },
+		"workers": [ { "host": "a", "tags": [ "x", "y" ] }, { "host": "b", "tags": [] } ], "empty": null })" );
+	const JsonValue copy = config;
+	const JsonPointer pointer( "/workers/1/host" );
+	const size_t hash = config.hash();
+	std::string text;
+	config.dumps( text );
+
+	std::vector< size_t > mismatches( 8, 0 );
+	std::vector< std::thread > threads;
+	for ( size_t thread( 0 ); thread < mismatches.size(); ++thread )
+	{
+		threads.emplace_back( [ &, thread ]()
+		{
+			for ( size_t round( 0 ); round < 200; ++round )
+			{
+				std::string dumped;
+				config.dumps( dumped );
+
+				size_t tags = 0;
+				for ( const JsonValue& worker : config[ "workers" ] )
+				{
+					tags += worker[ "tags" ].elements().size();
+				}
+
+				const bool isSame = ( text == dumped ) and ( hash == config.hash() ) and ( 2 == tags )
+					and ( std::string( "a" ) == std::string( config[ "workers" ][ 0 ][ "host" ] ) )
+					and ( &config[ "workers" ][ -1 ][ "host" ] == config.find( pointer ) )
+					and bool( config[ "limits" ][ "soft" ] ) and not bool( config[ "limits" ][ "hard" ] )
+					and ( nullptr == config.find( "missing" ) ) and config[ "empty" ].is( Type::null );
+				mismatches[ thread ] += isSame ? 0 : 1;
+			}
+		} );
+	}
+
+	for ( std::thread& thread : threads )
+	{
+		thread.join();
+	}
+
+	EXPECT_EQ( std::vector< size_t >( mismatches.size(), 0 ), mismatches );
+	EXPECT_EQ( copy, config );
+}
+
 int main( int argc, char** argv )
 {
 	::testing::InitGoogleTest( &argc, argv );